@@ -0,0 +1,204 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// AdaptiveFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// FFT.h
+// AdaptiveFilter.hpp
+//
+// Adaptive FIR filters, for echo and interference cancellation.
+//
+// LMSFilter adapts its taps every sample toward the desired signal d:
+//   y[n] = w . x[n]
+//   e[n] = d[n] - y[n]
+//   w += mu e[n] x[n]                        (LMS)
+//   w += mu e[n] x[n] / (eps + |x[n]|^2)      (NLMS)
+// The update from one sample is applied in the same pass over the taps as
+// the next output, so each sample reads the taps once. The history is kept
+// in a linear buffer (shifted back once per length samples), so both x[n]
+// and x[n - 1] are contiguous and the loop vectorizes.
+//
+// FDAFilter is a block frequency domain adaptive filter (constrained,
+// normalized, overlap save), for long cancellation paths. It processes
+// blocks of length samples with FFTs of twice the length, costing
+// O(log length) per sample instead of O(length).
+//
+// T should be a floating point type.
+
+#ifndef __ADAPTIVE_FILTER__
+#define __ADAPTIVE_FILTER__
+
+#include "Filter.h"
+#include "FFT.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+// number of partial sums in the LMS kernel.
+#define LMS_LANES 8
+
+template <class T>
+class LMSFilter: public Filter<T> {
+public:
+    // Constructor
+    // The taps start at zero.
+    // @param length - the number of taps.
+    // @param stepSize - the adaptation step size mu.
+    // @param normalized - normalize the step by the input power (NLMS).
+    // @param regularization - eps, added to the input power for NLMS.
+    LMSFilter(uint16_t length, T stepSize, bool normalized = false,
+            T regularization = (T)1e-6);
+
+    // filter
+    // Filters the next input without adapting.
+    // @param x - the input to the filter.
+    //
+    // @return - output of filter.
+    T filter(T x);
+
+    // getOutput
+    // @return - the last output of the filter.
+    T getOutput();
+
+    // adapt
+    // Filters the next input, and adapts the taps toward the desired output.
+    // @param x - the input to the filter.
+    // @param d - the desired output.
+    //
+    // @return - the error d - y, before adapting.
+    T adapt(T x, T d);
+
+    // adaptBlock
+    // Calls adapt on n samples.
+    // @param x - the inputs.
+    // @param d - the desired outputs.
+    // @param e - the errors are written here, may be NULL.
+    // @param n - the number of samples.
+    void adaptBlock(const T *x, const T *d, T *e, size_t n);
+
+    // getGains
+    // @return - the current taps.
+    const T *getGains();
+
+    // setGains
+    // Sets the taps, for starting from a known estimate.
+    // @param gains - length taps.
+    void setGains(const T *gains);
+
+    // getLength
+    uint16_t getLength() const { return length; }
+
+    // setStepSize
+    void setStepSize(T StepSize) { stepSize = StepSize; }
+
+    // reset
+    // clears the taps and history.
+    void reset();
+
+private:
+    // step
+    // pushes x, applies the pending update and computes the output.
+    T step(T x);
+
+    std::vector<T> gains;
+    std::vector<T> history; // x[n - i] = history[pos + i]
+    uint32_t pos;
+    uint16_t length;
+    T stepSize;
+    bool normalized;
+    T regularization;
+    T energy;  // |x[n]|^2 over the taps.
+    T pending; // the step to apply with x[n - 1] before the next output.
+    T output;
+};
+
+template <class T>
+class NLMSFilter: public LMSFilter<T> {
+public:
+    // Constructor
+    // @param length - the number of taps.
+    // @param stepSize - the normalized step size, between 0 and 2.
+    // @param regularization - eps, added to the input power.
+    NLMSFilter(uint16_t length, T stepSize, T regularization = (T)1e-6) :
+        LMSFilter<T>(length, stepSize, true, regularization) {}
+};
+
+
+template <class T>
+class FDAFilter {
+public:
+    // Constructor
+    // The taps start at zero.
+    // @param length - the number of taps, and the block length.
+    // @param stepSize - the normalized step size, between 0 and 1.
+    // @param forgetting - the forgetting factor of the power estimate per bin.
+    // @param regularization - added to the power estimate of each bin.
+    FDAFilter(uint16_t length, T stepSize, T forgetting = (T)0.9,
+            T regularization = (T)1e-6);
+
+    // adaptBlock
+    // Filters and adapts over n samples, which must be a multiple of the length.
+    // @param x - the inputs.
+    // @param d - the desired outputs.
+    // @param y - the outputs are written here, may be NULL.
+    // @param e - the errors are written here, may be NULL.
+    // @param n - the number of samples.
+    //
+    // @return - 0 for success, else failure.
+    int adaptBlock(const T *x, const T *d, T *y, T *e, size_t n);
+
+    // getGains
+    // Computes the time domain taps.
+    // @param gains - length taps are written here.
+    void getGains(T *gains);
+
+    // getLength
+    // returns the number of taps, also the block length.
+    uint16_t getLength() const { return length; }
+
+    // reset
+    // clears the taps and history.
+    void reset();
+
+private:
+    // block
+    // filters and adapts one block of length samples.
+    void block(const T *x, const T *d, T *y, T *e);
+
+    uint16_t length;
+    T stepSize;
+    T forgetting;
+    T regularization;
+    RealFFTPlan<T> plan;
+    std::vector<T> input;    // the last 2 length inputs.
+    std::vector<T> time;     // 2 length time domain scratch.
+    std::vector<std::complex<T> > inputSpectrum;
+    std::vector<std::complex<T> > weights;
+    std::vector<std::complex<T> > spectrum; // scratch.
+    std::vector<T> power;   // smoothed |X|^2 of each bin.
+    bool started;           // the power estimate has been set.
+};
+
+
+#include "AdaptiveFilter.hpp"
+
+#endif
@@ -0,0 +1,302 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// AdaptiveFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// AdaptiveFilter.h
+//
+// Adaptive FIR filters.
+// The implementation file.
+
+#ifndef __ADAPTIVE_FILTER_IMPL__
+#define __ADAPTIVE_FILTER_IMPL__
+
+#include "AdaptiveFilter.h"
+#include <algorithm>
+
+// Constructor
+// The taps start at zero.
+// @param length - the number of taps.
+// @param stepSize - the adaptation step size mu.
+// @param normalized - normalize the step by the input power (NLMS).
+// @param regularization - eps, added to the input power for NLMS.
+template <class T>
+LMSFilter<T>::LMSFilter(uint16_t Length, T StepSize, bool Normalized, T Regularization)
+{
+    length = (Length > 0) ? Length : 1;
+    stepSize = StepSize;
+    normalized = Normalized;
+    regularization = Regularization;
+    gains.resize(length);
+    // the slack lets length samples in before the history is shifted back.
+    history.resize(2 * (size_t)length + 1);
+    reset();
+} // end constructor
+
+// reset
+// clears the taps and history.
+template <class T>
+void LMSFilter<T>::reset()
+{
+    std::fill(gains.begin(), gains.end(), (T)0);
+    std::fill(history.begin(), history.end(), (T)0);
+    pos = length;
+    energy = 0;
+    pending = 0;
+    output = 0;
+}
+
+// filter
+// Filters the next input without adapting.
+// @param x - the input to the filter.
+//
+// @return - output of filter.
+template <class T>
+T LMSFilter<T>::filter(T x)
+{
+    return step(x);
+}
+
+// getOutput
+// @return - the last output of the filter.
+template <class T>
+T LMSFilter<T>::getOutput()
+{
+    return output;
+}
+
+// adapt
+// Filters the next input, and adapts the taps toward the desired output.
+// The update is left pending, and applied in the same pass as the next
+// output.
+// @param x - the input to the filter.
+// @param d - the desired output.
+//
+// @return - the error d - y, before adapting.
+template <class T>
+T LMSFilter<T>::adapt(T x, T d)
+{
+    T e = d - step(x);
+    pending = normalized ? stepSize * e / (regularization + energy) : stepSize * e;
+    return e;
+}
+
+// adaptBlock
+// Calls adapt on n samples.
+// @param x - the inputs.
+// @param d - the desired outputs.
+// @param e - the errors are written here, may be NULL.
+// @param n - the number of samples.
+template <class T>
+void LMSFilter<T>::adaptBlock(const T *x, const T *d, T *e, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        T err = adapt(x[i], d[i]);
+        if (e != NULL) { e[i] = err; }
+    }
+}
+
+// getGains
+// @return - the current taps.
+template <class T>
+const T *LMSFilter<T>::getGains()
+{
+    // apply the pending update, which uses the newest window.
+    const T *xw = &history[pos];
+    for (uint16_t i = 0; i < length; i++) { gains[i] += pending * xw[i]; }
+    pending = 0;
+    return &gains[0];
+}
+
+// setGains
+// Sets the taps, for starting from a known estimate.
+// @param gains - length taps.
+template <class T>
+void LMSFilter<T>::setGains(const T *Gains)
+{
+    std::copy(Gains, Gains + length, gains.begin());
+    pending = 0;
+}
+
+// step
+// pushes x, applies the pending update and computes the output.
+template <class T>
+T LMSFilter<T>::step(T x)
+{
+    if (pos == 0) {
+        // shift the newest length + 1 samples back to the end, and
+        // recompute the energy so round off doesn't build up.
+        std::copy_backward(history.begin(), history.begin() + length + 1, history.end());
+        pos = length;
+        energy = 0;
+        for (uint16_t i = 0; i < length; i++) { energy += history[pos + i] * history[pos + i]; }
+    }
+    pos--;
+    history[pos] = x;
+
+    // xw[i] = x[n - i], and xw[i + 1] = x[n - 1 - i] for the pending update.
+    const T *xw = &history[pos];
+    energy += x * x - xw[length] * xw[length];
+    if (energy < 0) { energy = 0; }
+
+    T *w = &gains[0];
+    T g = pending;
+    T acc[LMS_LANES];
+    for (int j = 0; j < LMS_LANES; j++) { acc[j] = 0; }
+
+    // update and filter in one pass, with partial sums so it vectorizes.
+    uint32_t end = length - length % LMS_LANES;
+    for (uint32_t i = 0; i < end; i += LMS_LANES) {
+        // all the loads come before the stores, so the lanes can be
+        // vectorized without worrying that w and xw overlap.
+        T cur[LMS_LANES], prev[LMS_LANES], tap[LMS_LANES];
+        for (int j = 0; j < LMS_LANES; j++) {
+            cur[j] = xw[i + j];
+            prev[j] = xw[i + j + 1];
+            tap[j] = w[i + j];
+        }
+        for (int j = 0; j < LMS_LANES; j++) {
+            tap[j] += g * prev[j];
+            acc[j] += tap[j] * cur[j];
+            w[i + j] = tap[j];
+        }
+    }
+    T y = 0;
+    for (int j = 0; j < LMS_LANES; j++) { y += acc[j]; }
+    for (uint32_t i = end; i < length; i++) {
+        w[i] += g * xw[i + 1];
+        y += w[i] * xw[i];
+    }
+
+    pending = 0;
+    output = y;
+    return y;
+} // end step
+
+
+// Constructor
+// The taps start at zero.
+// @param length - the number of taps, and the block length.
+// @param stepSize - the normalized step size, between 0 and 1.
+// @param forgetting - the forgetting factor of the power estimate per bin.
+// @param regularization - added to the power estimate of each bin.
+template <class T>
+FDAFilter<T>::FDAFilter(uint16_t Length, T StepSize, T Forgetting, T Regularization) :
+    length((Length > 0) ? Length : 1),
+    plan(2 * (uint32_t)((Length > 0) ? Length : 1))
+{
+    stepSize = StepSize;
+    forgetting = Forgetting;
+    regularization = Regularization;
+    input.resize(2 * (size_t)length);
+    time.resize(2 * (size_t)length);
+    inputSpectrum.resize(length + 1);
+    weights.resize(length + 1);
+    spectrum.resize(length + 1);
+    power.resize(length + 1);
+    reset();
+} // end constructor
+
+// reset
+// clears the taps and history.
+template <class T>
+void FDAFilter<T>::reset()
+{
+    std::fill(input.begin(), input.end(), (T)0);
+    std::fill(weights.begin(), weights.end(), std::complex<T>(0, 0));
+    std::fill(power.begin(), power.end(), (T)0);
+    started = false;
+}
+
+// adaptBlock
+// Filters and adapts over n samples, which must be a multiple of the length.
+// @param x - the inputs.
+// @param d - the desired outputs.
+// @param y - the outputs are written here, may be NULL.
+// @param e - the errors are written here, may be NULL.
+// @param n - the number of samples.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FDAFilter<T>::adaptBlock(const T *x, const T *d, T *y, T *e, size_t n)
+{
+    if (x == NULL || d == NULL || n % length != 0) { return -1; }
+    for (size_t i = 0; i < n; i += length) {
+        block(x + i, d + i, (y != NULL) ? y + i : NULL, (e != NULL) ? e + i : NULL);
+    }
+    return 0;
+}
+
+// getGains
+// Computes the time domain taps.
+// @param gains - length taps are written here.
+template <class T>
+void FDAFilter<T>::getGains(T *gains)
+{
+    plan.inverse(&weights[0], &time[0]);
+    T scale = (T)1 / (2 * (T)length);
+    for (uint16_t i = 0; i < length; i++) { gains[i] = time[i] * scale; }
+}
+
+// block
+// filters and adapts one block of length samples.
+template <class T>
+void FDAFilter<T>::block(const T *x, const T *d, T *y, T *e)
+{
+    uint32_t L = length;
+    uint32_t bins = L + 1;
+    T scale = (T)1 / (2 * (T)L);
+
+    // overlap save, the last 2 L inputs.
+    std::copy(input.begin() + L, input.end(), input.begin());
+    std::copy(x, x + L, input.begin() + L);
+    plan.forward(&input[0], &inputSpectrum[0]);
+
+    // filter, the last L outputs of the circular convolution are valid.
+    for (uint32_t k = 0; k < bins; k++) { spectrum[k] = inputSpectrum[k] * weights[k]; }
+    plan.inverse(&spectrum[0], &time[0]);
+    for (uint32_t j = 0; j < L; j++) {
+        T out = time[L + j] * scale;
+        if (y != NULL) { y[j] = out; }
+        time[L + j] = d[j] - out;
+        if (e != NULL) { e[j] = time[L + j]; }
+    }
+
+    // gradient, the correlation of the error with the input.
+    std::fill(time.begin(), time.begin() + L, (T)0);
+    plan.forward(&time[0], &spectrum[0]);
+    for (uint32_t k = 0; k < bins; k++) {
+        T p = std::norm(inputSpectrum[k]);
+        power[k] = started ? forgetting * power[k] + (1 - forgetting) * p : p;
+        spectrum[k] = std::conj(inputSpectrum[k]) * spectrum[k] / (power[k] + regularization);
+    }
+    started = true;
+
+    // constrain the gradient to length taps, so the filter stays linear.
+    plan.inverse(&spectrum[0], &time[0]);
+    std::fill(time.begin() + L, time.end(), (T)0);
+    plan.forward(&time[0], &spectrum[0]);
+    T mu = stepSize * scale;
+    for (uint32_t k = 0; k < bins; k++) { weights[k] += mu * spectrum[k]; }
+} // end block
+
+
+#endif
@@ -0,0 +1,78 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// BFloat16.h
+// Written Ian Rankin - October 2026
+//
+// A 16 bit brain float, the top half of an IEEE float. It has the same
+// range as float but only 8 bits of mantissa (about 2 to 3 decimal digits),
+// which is enough for the taps of long filters where the memory read for the
+// gains is the limit, e.g. FIRFilter<float, BFloat16, float>.
+//
+// There is no arithmetic on the type, it converts to float when read, so
+// products are done in the accumulator type of the filter.
+
+#ifndef __BFLOAT16__
+#define __BFLOAT16__
+
+#include <cstdint>
+#include <cstring>
+
+struct BFloat16 {
+    uint16_t bits;
+
+    BFloat16() = default;
+
+    // Constructor
+    // Rounds a float to the nearest bf16, ties to even. NaN stays a NaN.
+    // @param f - the value to round.
+    BFloat16(float f)
+    {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        if ((u & 0x7fffffff) > 0x7f800000) {
+            // keep the sign, and set a mantissa bit so it can't round to Inf.
+            bits = (uint16_t)((u >> 16) | 0x0040);
+        } else {
+            u += 0x7fff + ((u >> 16) & 1);
+            bits = (uint16_t)(u >> 16);
+        }
+    }
+
+    // operator float
+    // The bf16 is the top half of the float, so this is exact.
+    operator float() const
+    {
+        uint32_t u = (uint32_t)bits << 16;
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+
+    // fromBits
+    // returns the bf16 with the given bit pattern.
+    static BFloat16 fromBits(uint16_t b)
+    {
+        BFloat16 h;
+        h.bits = b;
+        return h;
+    }
+};
+
+#endif
@@ -0,0 +1,185 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// CoefficientBank.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FilterSnapshot.h
+// MappedFile.h
+// CoefficientBank.hpp
+//
+// Shared, read only sets of filter coefficients. With thousands of streams
+// and a few dozen distinct tap sets, each set is stored once and every
+// filter holds a reference counted pointer to it, so the taps live as long
+// as any filter using them and no longer.
+//
+// A bank names its sets and can be saved to a file which is mapped
+// directly when loaded, so the taps are used in place in the mapping with
+// no copies, and only pages of taps that are used become resident.
+//
+// File layout, in the byte order of the writer:
+//   CoefficientFileHeader
+//   CoefficientEntry[count], one per name
+//   the taps of each distinct set, each starting on a 64 byte boundary
+// Names with identical taps point to the same taps in the file.
+//
+// Example:
+// CoefficientBank<float> bank;
+// bank.add("lowpass", gains, 101);
+// bank.save("taps.coef");
+// ...
+// CoefficientBank<float> loaded;
+// loaded.load("taps.coef");
+// FIRFilter<float> filter(loaded.get("lowpass"));
+
+#ifndef __COEFFICIENT_BANK__
+#define __COEFFICIENT_BANK__
+
+#include "FilterSnapshot.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define COEFFICIENT_VERSION 1
+#define COEFFICIENT_MAGIC "DSPCOEF"
+#define COEFFICIENT_NAME_LENGTH 32 // including the terminating 0.
+#define COEFFICIENT_ALIGN 64
+
+// Start of the file.
+struct CoefficientFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;      // SNAPSHOT_ENDIAN as written.
+    uint16_t typeCode;    // snapshotTypeCode of the coefficient type.
+    uint16_t reserved;
+    uint32_t count;       // number of entries.
+    uint64_t size;        // size of the whole file.
+};
+
+// A named set of taps in the file.
+struct CoefficientEntry {
+    char name[COEFFICIENT_NAME_LENGTH];
+    uint64_t offset;      // of the taps from the start of the file.
+    uint32_t length;      // number of taps.
+    uint32_t reserved;
+    uint64_t hash;        // coefficientHash of the taps.
+};
+
+// CoefficientSet
+// An immutable set of taps. The storage is kept alive for as long as the
+// set is, whether it is a copy or a mapped file.
+template <class C>
+class CoefficientSet {
+public:
+    // Constructor
+    // @param coefficients - the taps, in storage owned by storage.
+    // @param length - the number of taps.
+    // @param hash - coefficientHash of the taps.
+    // @param storage - whatever holds the taps, released with the set.
+    CoefficientSet(const C *coefficients, uint32_t length, uint64_t hash,
+                std::shared_ptr<const void> storage);
+
+    // getData
+    // @return - the taps.
+    const C *getData() const { return data; }
+
+    // getLength
+    // @return - the number of taps.
+    uint32_t getLength() const { return length; }
+
+    // getHash
+    // @return - coefficientHash of the taps.
+    uint64_t getHash() const { return hash; }
+
+private:
+    CoefficientSet(const CoefficientSet &) = delete;
+    CoefficientSet &operator=(const CoefficientSet &) = delete;
+
+    const C *data;
+    uint32_t length;
+    uint64_t hash;
+    std::shared_ptr<const void> storage;
+};
+
+template <class C>
+class CoefficientBank {
+public:
+    typedef std::shared_ptr<const CoefficientSet<C> > SetPtr;
+
+    // add
+    // Copies a set of taps into the bank under a name. If the bank already
+    // has a set with the same taps, the name shares it.
+    // @param name - the name, shorter than COEFFICIENT_NAME_LENGTH.
+    // @param coefficients - the taps.
+    // @param length - the number of taps.
+    //
+    // @return - the set, NULL if the name is taken or invalid.
+    SetPtr add(const char *name, const C *coefficients, uint32_t length);
+
+    // get
+    // @param name - the name of the set.
+    //
+    // @return - the set, NULL if there is no set with that name.
+    SetPtr get(const char *name) const;
+
+    // getCount
+    // @return - the number of names.
+    uint32_t getCount() const { return (uint32_t)names.size(); }
+
+    // getSetCount
+    // @return - the number of distinct sets of taps.
+    uint32_t getSetCount() const { return (uint32_t)sets.size(); }
+
+    // save
+    // Writes the bank to a file.
+    // @param path - the file to write.
+    //
+    // @return - 0 for success, else failure.
+    int save(const char *path) const;
+
+    // load
+    // Replaces the contents of the bank with a file, mapped where mmap is
+    // available. The mapping stays open until the bank and every set from
+    // it are gone.
+    // @param path - the file to read.
+    // @param verify - check the hash of every set, which reads all of the taps.
+    //
+    // @return - 0 for success, else failure.
+    int load(const char *path, bool verify = false);
+
+    // clear
+    // removes every set from the bank, sets still in use stay valid.
+    void clear();
+
+private:
+    // find
+    // returns the index of a set with the same taps, -1 if none.
+    int32_t find(const C *coefficients, uint32_t length, uint64_t hash) const;
+
+    std::vector<SetPtr> sets;
+    std::map<std::string, uint32_t> names; // index into sets.
+};
+
+// include implementation file
+#include "CoefficientBank.hpp"
+#endif
@@ -0,0 +1,233 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// CoefficientBank.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// CoefficientBank.h
+//
+// Implementation of the coefficient sets and bank.
+
+#ifndef __COEFFICIENT_BANK_IMPL__
+#define __COEFFICIENT_BANK_IMPL__
+
+#include "CoefficientBank.h"
+#include <cstdio>
+#include <cstring>
+
+// coefficientAlign
+// rounds an offset up to COEFFICIENT_ALIGN bytes.
+inline uint64_t coefficientAlign(uint64_t offset)
+{
+    return (offset + COEFFICIENT_ALIGN - 1) & ~(uint64_t)(COEFFICIENT_ALIGN - 1);
+}
+
+template <class C>
+CoefficientSet<C>::CoefficientSet(const C *coefficients, uint32_t Length, uint64_t Hash,
+                                std::shared_ptr<const void> Storage)
+    : data(coefficients), length(Length), hash(Hash), storage(Storage)
+{
+}
+
+
+// add
+// Copies a set of taps into the bank under a name. If the bank already
+// has a set with the same taps, the name shares it.
+// @param name - the name, shorter than COEFFICIENT_NAME_LENGTH.
+// @param coefficients - the taps.
+// @param length - the number of taps.
+//
+// @return - the set, NULL if the name is taken or invalid.
+template <class C>
+typename CoefficientBank<C>::SetPtr CoefficientBank<C>::add(const char *name,
+                                        const C *coefficients, uint32_t length)
+{
+    if (name == NULL || strlen(name) >= COEFFICIENT_NAME_LENGTH ||
+            coefficients == NULL || length == 0 || names.count(name) != 0) {
+        return SetPtr();
+    }
+
+    uint64_t hash = coefficientHash(coefficients, length);
+    int32_t index = find(coefficients, length, hash);
+    if (index < 0) {
+        std::shared_ptr<std::vector<C> > copy =
+            std::make_shared<std::vector<C> >(coefficients, coefficients + length);
+        index = (int32_t)sets.size();
+        sets.push_back(std::make_shared<CoefficientSet<C> >(&(*copy)[0], length, hash, copy));
+    }
+    names[name] = (uint32_t)index;
+    return sets[index];
+} // end add
+
+// get
+// @param name - the name of the set.
+//
+// @return - the set, NULL if there is no set with that name.
+template <class C>
+typename CoefficientBank<C>::SetPtr CoefficientBank<C>::get(const char *name) const
+{
+    if (name == NULL) { return SetPtr(); }
+    std::map<std::string, uint32_t>::const_iterator it = names.find(name);
+    if (it == names.end()) { return SetPtr(); }
+    return sets[it->second];
+}
+
+// find
+// returns the index of a set with the same taps, -1 if none.
+template <class C>
+int32_t CoefficientBank<C>::find(const C *coefficients, uint32_t length, uint64_t hash) const
+{
+    for (size_t i = 0; i < sets.size(); i++) {
+        if (sets[i]->getHash() == hash && sets[i]->getLength() == length &&
+                memcmp(sets[i]->getData(), coefficients, length * sizeof(C)) == 0) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+// save
+// Writes the bank to a file.
+// @param path - the file to write.
+//
+// @return - 0 for success, else failure.
+template <class C>
+int CoefficientBank<C>::save(const char *path) const
+{
+    if (path == NULL) { return -1; }
+
+    // lay out the taps of each distinct set after the entries.
+    std::vector<uint64_t> offsets(sets.size());
+    uint64_t offset = sizeof(CoefficientFileHeader) + names.size() * sizeof(CoefficientEntry);
+    for (size_t i = 0; i < sets.size(); i++) {
+        offset = coefficientAlign(offset);
+        offsets[i] = offset;
+        offset += (uint64_t)sets[i]->getLength() * sizeof(C);
+    }
+
+    CoefficientFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COEFFICIENT_MAGIC, sizeof(header.magic));
+    header.version = COEFFICIENT_VERSION;
+    header.endian = SNAPSHOT_ENDIAN;
+    header.typeCode = snapshotTypeCode<C>();
+    header.count = (uint32_t)names.size();
+    header.size = offset;
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) { return -1; }
+    bool failed = fwrite(&header, sizeof(header), 1, file) != 1;
+    std::map<std::string, uint32_t>::const_iterator it;
+    for (it = names.begin(); it != names.end(); it++) {
+        CoefficientEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        memcpy(entry.name, it->first.c_str(), it->first.size());
+        entry.offset = offsets[it->second];
+        entry.length = sets[it->second]->getLength();
+        entry.hash = sets[it->second]->getHash();
+        failed |= fwrite(&entry, sizeof(entry), 1, file) != 1;
+    }
+    uint64_t at = sizeof(CoefficientFileHeader) + names.size() * sizeof(CoefficientEntry);
+    const char zeros[COEFFICIENT_ALIGN] = {0};
+    for (size_t i = 0; i < sets.size(); i++) {
+        size_t pad = (size_t)(offsets[i] - at);
+        if (pad > 0) { failed |= fwrite(zeros, 1, pad, file) != pad; }
+        size_t n = sets[i]->getLength();
+        failed |= fwrite(sets[i]->getData(), sizeof(C), n, file) != n;
+        at = offsets[i] + n * sizeof(C);
+    }
+    if (fclose(file) != 0) { failed = true; }
+    return failed ? -1 : 0;
+} // end save
+
+// load
+// Replaces the contents of the bank with a file, mapped where mmap is
+// available. The mapping stays open until the bank and every set from it
+// are gone.
+// @param path - the file to read.
+// @param verify - check the hash of every set, which reads all of the taps.
+//
+// @return - 0 for success, else failure.
+template <class C>
+int CoefficientBank<C>::load(const char *path, bool verify)
+{
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if (file->open(path) != 0) { return -1; }
+    const uint8_t *base = (const uint8_t *)file->getData();
+    size_t size = file->getSize();
+
+    const CoefficientFileHeader *header = (const CoefficientFileHeader *)base;
+    if (size < sizeof(CoefficientFileHeader) ||
+            memcmp(header->magic, COEFFICIENT_MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != COEFFICIENT_VERSION || header->endian != SNAPSHOT_ENDIAN ||
+            header->typeCode != snapshotTypeCode<C>() || header->size != size ||
+            header->count > (size - sizeof(CoefficientFileHeader)) / sizeof(CoefficientEntry)) {
+        return -1;
+    }
+
+    // check every entry before changing the bank, names sharing taps in
+    // the file share a set.
+    std::vector<SetPtr> loadedSets;
+    std::map<std::string, uint32_t> loadedNames;
+    std::map<uint64_t, uint32_t> byOffset;
+    const CoefficientEntry *entries = (const CoefficientEntry *)(base + sizeof(CoefficientFileHeader));
+    uint64_t tapsStart = sizeof(CoefficientFileHeader) +
+                        (uint64_t)header->count * sizeof(CoefficientEntry);
+    for (uint32_t i = 0; i < header->count; i++) {
+        const CoefficientEntry &entry = entries[i];
+        if (memchr(entry.name, 0, COEFFICIENT_NAME_LENGTH) == NULL || entry.length == 0 ||
+                (entry.offset % COEFFICIENT_ALIGN) != 0 || entry.offset < tapsStart ||
+                entry.offset > size ||
+                entry.length > (size - entry.offset) / sizeof(C) ||
+                loadedNames.count(entry.name) != 0) {
+            return -1;
+        }
+        const C *taps = (const C *)(base + entry.offset);
+        std::map<uint64_t, uint32_t>::iterator it = byOffset.find(entry.offset);
+        if (it != byOffset.end()) {
+            if (loadedSets[it->second]->getLength() != entry.length ||
+                    loadedSets[it->second]->getHash() != entry.hash) {
+                return -1;
+            }
+            loadedNames[entry.name] = it->second;
+            continue;
+        }
+        if (verify && coefficientHash(taps, entry.length) != entry.hash) { return -1; }
+        byOffset[entry.offset] = (uint32_t)loadedSets.size();
+        loadedNames[entry.name] = (uint32_t)loadedSets.size();
+        loadedSets.push_back(std::make_shared<CoefficientSet<C> >(taps, entry.length,
+                                                                entry.hash, file));
+    }
+
+    sets.swap(loadedSets);
+    names.swap(loadedNames);
+    return 0;
+} // end load
+
+// clear
+// removes every set from the bank, sets still in use stay valid.
+template <class C>
+void CoefficientBank<C>::clear()
+{
+    sets.clear();
+    names.clear();
+}
+
+#endif
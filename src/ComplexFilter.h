@@ -0,0 +1,213 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ComplexFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// ComplexFilter.hpp
+//
+// FIR and IIR filters for complex (I/Q) samples. Each takes either real
+// coefficients, the common case, where I and Q share every coefficient load
+// and the cost is two multiply-adds a tap, or complex coefficients, at four
+// multiply-adds a tap. FIRFilter<std::complex<T> > works, but goes through
+// the std::complex operators, which compilers vectorize poorly.
+//
+// Inside, samples and coefficients are kept as separate real and imaginary
+// arrays, and the FIR sums run across COMPLEX_LANE_COUNT partial sums, so
+// the complex multiply-add is plain arithmetic on contiguous arrays and
+// vectorizes. filterBlock takes interleaved std::complex samples, or split
+// real and imaginary arrays, which skips the interleaving.
+//
+// Both copy their coefficients. The IIR filter uses the same form and
+// coefficient convention as IIRFilter (a starts at a1).
+//
+// Example:
+// ComplexFIRFilter<float> fir(taps, 63);              // real taps
+// fir.filterBlock(iq, iq, n);                         // std::complex<float> *
+// fir.filterBlock(i, q, i, q, n);                     // split I and Q
+// ComplexIIRFilter<float> resonator(b, a, 1, 1);      // std::complex<float> b, a
+
+#ifndef __COMPLEX_FILTER__
+#define __COMPLEX_FILTER__
+
+#include "Filter.h"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// number of partial sums in the FIR kernels.
+#define COMPLEX_LANE_COUNT 8
+// inputs added to the FIR history between shifts.
+#define COMPLEX_FIR_CHUNK 256
+
+template <class T>
+class ComplexFIRFilter: public Filter<std::complex<T> > {
+public:
+    // Constructor
+    // Real taps, applied to I and Q alike.
+    // @param coefficients - the taps, copied.
+    // @param length - the number of taps, at least 1.
+    ComplexFIRFilter(const T *coefficients, uint32_t length);
+
+    // Constructor
+    // Complex taps.
+    // @param coefficients - the taps, copied.
+    // @param length - the number of taps, at least 1.
+    ComplexFIRFilter(const std::complex<T> *coefficients, uint32_t length);
+
+    // filter
+    // @param x - the input to the filter.
+    //
+    // @return - output of the filter.
+    std::complex<T> filter(std::complex<T> x);
+
+    // getOutput
+    // @return - the last output of the filter.
+    std::complex<T> getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n interleaved inputs, may be done in place.
+    // @param input - the array of inputs to the filter.
+    // @param out - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const std::complex<T> *input, std::complex<T> *out, size_t n);
+
+    // filterBlock
+    // Filters a block of n inputs given as split I and Q arrays, may be
+    // done in place.
+    // @param inRe - the real parts of the inputs.
+    // @param inIm - the imaginary parts of the inputs.
+    // @param outRe - the array to write the real parts of the outputs to.
+    // @param outIm - the array to write the imaginary parts of the outputs to.
+    // @param n - the number of samples in the block.
+    void filterBlock(const T *inRe, const T *inIm, T *outRe, T *outIm, size_t n);
+
+    // reset
+    // clears the history.
+    void reset();
+
+    uint32_t getLength() const { return length; }
+
+    // hasRealTaps
+    // @return - true if the taps are real, the faster kernel.
+    bool hasRealTaps() const { return reversedIm.empty(); }
+
+private:
+    void setLength(uint32_t length);
+    // makeRoom
+    // shifts the history when it is full.
+    // @return - the number of inputs that fit before the next shift, at most n.
+    size_t makeRoom(size_t n);
+    // dot
+    // the output for the newest input at history position p.
+    void dot(size_t p, T &yRe, T &yIm) const;
+
+    std::vector<T> reversedRe; // taps, oldest sample's tap first.
+    std::vector<T> reversedIm; // empty for real taps.
+    std::vector<T> historyRe;  // length - 1 old inputs, then room for a chunk.
+    std::vector<T> historyIm;
+    size_t fill;               // end of the inputs in history.
+    uint32_t length;
+    std::complex<T> output;
+};
+
+template <class T>
+class ComplexIIRFilter: public Filter<std::complex<T> > {
+public:
+    // Constructor
+    // Real coefficients, applied to I and Q alike.
+    // @param feedForwardCoef - the feed forward coefficients b, copied.
+    // @param feedbackCoef - the feedback coefficients a, from a1, copied.
+    // @param forwardLength - the number of feed forward coefficients.
+    // @param backLength - the number of feedback coefficients.
+    ComplexIIRFilter(const T *feedForwardCoef, const T *feedbackCoef,
+                     uint32_t forwardLength, uint32_t backLength);
+
+    // Constructor
+    // Complex coefficients.
+    // @param feedForwardCoef - the feed forward coefficients b, copied.
+    // @param feedbackCoef - the feedback coefficients a, from a1, copied.
+    // @param forwardLength - the number of feed forward coefficients.
+    // @param backLength - the number of feedback coefficients.
+    ComplexIIRFilter(const std::complex<T> *feedForwardCoef,
+                     const std::complex<T> *feedbackCoef,
+                     uint32_t forwardLength, uint32_t backLength);
+
+    // filter
+    // @param x - the input to the filter.
+    //
+    // @return - output of the filter.
+    std::complex<T> filter(std::complex<T> x);
+
+    // getOutput
+    // @return - the last output of the filter.
+    std::complex<T> getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n interleaved inputs, may be done in place.
+    // @param input - the array of inputs to the filter.
+    // @param out - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const std::complex<T> *input, std::complex<T> *out, size_t n);
+
+    // filterBlock
+    // Filters a block of n inputs given as split I and Q arrays, may be
+    // done in place.
+    // @param inRe - the real parts of the inputs.
+    // @param inIm - the imaginary parts of the inputs.
+    // @param outRe - the array to write the real parts of the outputs to.
+    // @param outIm - the array to write the imaginary parts of the outputs to.
+    // @param n - the number of samples in the block.
+    void filterBlock(const T *inRe, const T *inIm, T *outRe, T *outIm, size_t n);
+
+    // reset
+    // clears the delay line.
+    void reset();
+
+    uint32_t getFeedForwardLength() const { return (uint32_t)ffRe.size(); }
+    uint32_t getFeedbackLength() const { return (uint32_t)fbRe.size(); }
+
+    // hasRealCoefficients
+    // @return - true if the coefficients are real, the faster kernel.
+    bool hasRealCoefficients() const { return ffIm.empty(); }
+
+private:
+    void setLengths(uint32_t forwardLength, uint32_t backLength);
+    // step
+    // filters one input.
+    void step(T xRe, T xIm, T &yRe, T &yIm);
+
+    std::vector<T> ffRe;
+    std::vector<T> ffIm;       // empty for real coefficients.
+    std::vector<T> fbRe;
+    std::vector<T> fbIm;
+    // the delay line is written twice, at pos and pos + length, so the
+    // newest length values are always contiguous from pos.
+    std::vector<T> delayRe;
+    std::vector<T> delayIm;
+    size_t length;
+    size_t pos;
+    std::complex<T> output;
+};
+
+#include "ComplexFilter.hpp"
+#endif
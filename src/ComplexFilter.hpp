@@ -0,0 +1,403 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ComplexFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// ComplexFilter.h
+//
+// Implementation of the complex sample FIR and IIR filters.
+
+#ifndef __COMPLEX_FILTER_IMPL__
+#define __COMPLEX_FILTER_IMPL__
+
+#include "ComplexFilter.h"
+#include <algorithm>
+
+// Constructor
+// Real taps, applied to I and Q alike.
+// @param coefficients - the taps, copied.
+// @param length - the number of taps, at least 1.
+template <class T>
+ComplexFIRFilter<T>::ComplexFIRFilter(const T *coefficients, uint32_t Length)
+{
+    setLength((coefficients != NULL && Length > 0) ? Length : 1);
+    if (coefficients != NULL && Length > 0) {
+        for (uint32_t i = 0; i < length; i++) { reversedRe[i] = coefficients[length - 1 - i]; }
+    }
+}
+
+// Constructor
+// Complex taps.
+// @param coefficients - the taps, copied.
+// @param length - the number of taps, at least 1.
+template <class T>
+ComplexFIRFilter<T>::ComplexFIRFilter(const std::complex<T> *coefficients, uint32_t Length)
+{
+    setLength((coefficients != NULL && Length > 0) ? Length : 1);
+    reversedIm.assign(length, 0);
+    if (coefficients != NULL && Length > 0) {
+        for (uint32_t i = 0; i < length; i++) {
+            reversedRe[i] = coefficients[length - 1 - i].real();
+            reversedIm[i] = coefficients[length - 1 - i].imag();
+        }
+    }
+}
+
+// setLength
+// sizes the taps and history.
+template <class T>
+void ComplexFIRFilter<T>::setLength(uint32_t Length)
+{
+    length = Length;
+    reversedRe.assign(length, 0);
+    historyRe.assign((size_t)length - 1 + COMPLEX_FIR_CHUNK, 0);
+    historyIm.assign(historyRe.size(), 0);
+    reset();
+}
+
+// reset
+// clears the history.
+template <class T>
+void ComplexFIRFilter<T>::reset()
+{
+    std::fill(historyRe.begin(), historyRe.end(), (T)0);
+    std::fill(historyIm.begin(), historyIm.end(), (T)0);
+    fill = length - 1;
+    output = 0;
+}
+
+// makeRoom
+// shifts the history when it is full.
+// @param n - the number of inputs left to add.
+//
+// @return - the number of inputs that fit before the next shift, at most n.
+template <class T>
+size_t ComplexFIRFilter<T>::makeRoom(size_t n)
+{
+    if (fill == historyRe.size()) {
+        size_t keep = length - 1;
+        std::copy(historyRe.end() - keep, historyRe.end(), historyRe.begin());
+        std::copy(historyIm.end() - keep, historyIm.end(), historyIm.begin());
+        fill = keep;
+    }
+    return std::min(n, historyRe.size() - fill);
+}
+
+// complexLaneDot
+// sum a[i] b[i] + sign c[i] d[i] over COMPLEX_LANE_COUNT partial sums, where
+// sign is -1 when subtract is set. With c and d NULL it is the plain dot
+// product of a and b. Each half of the complex multiply gets its own pass,
+// so every pass is one contiguous multiply-add loop and vectorizes.
+// @param a, b, c, d - the arrays, length L.
+// @param L - the length of the arrays.
+// @param subtract - true to subtract the c d products.
+//
+// @return - the sum.
+template <class T>
+T complexLaneDot(const T *a, const T *b, const T *c, const T *d, size_t L, bool subtract)
+{
+    size_t end = L - L % COMPLEX_LANE_COUNT;
+    T acc[COMPLEX_LANE_COUNT];
+    for (int l = 0; l < COMPLEX_LANE_COUNT; l++) { acc[l] = 0; }
+    T y = 0;
+    if (c == NULL) {
+        for (size_t i = 0; i < end; i += COMPLEX_LANE_COUNT) {
+            for (int l = 0; l < COMPLEX_LANE_COUNT; l++) { acc[l] += a[i + l] * b[i + l]; }
+        }
+        for (size_t i = end; i < L; i++) { y += a[i] * b[i]; }
+    } else if (subtract) {
+        for (size_t i = 0; i < end; i += COMPLEX_LANE_COUNT) {
+            for (int l = 0; l < COMPLEX_LANE_COUNT; l++) {
+                acc[l] += a[i + l] * b[i + l] - c[i + l] * d[i + l];
+            }
+        }
+        for (size_t i = end; i < L; i++) { y += a[i] * b[i] - c[i] * d[i]; }
+    } else {
+        for (size_t i = 0; i < end; i += COMPLEX_LANE_COUNT) {
+            for (int l = 0; l < COMPLEX_LANE_COUNT; l++) {
+                acc[l] += a[i + l] * b[i + l] + c[i + l] * d[i + l];
+            }
+        }
+        for (size_t i = end; i < L; i++) { y += a[i] * b[i] + c[i] * d[i]; }
+    }
+    for (int l = 0; l < COMPLEX_LANE_COUNT; l++) { y += acc[l]; }
+    return y;
+}
+
+// dot
+// the output for the newest input at history position p, with the real or
+// complex tap kernel.
+// @param p - the history position of the newest input.
+// @param yRe - the real part of the output.
+// @param yIm - the imaginary part of the output.
+template <class T>
+void ComplexFIRFilter<T>::dot(size_t p, T &yRe, T &yIm) const
+{
+    size_t L = length;
+    const T *hr = &reversedRe[0];
+    const T *xr = &historyRe[p + 1 - L];
+    const T *xi = &historyIm[p + 1 - L];
+    const T *hi = reversedIm.empty() ? NULL : &reversedIm[0];
+    // re = hr xr - hi xi, im = hr xi + hi xr.
+    yRe = complexLaneDot(hr, xr, hi, hi ? xi : NULL, L, true);
+    yIm = complexLaneDot(hr, xi, hi, hi ? xr : NULL, L, false);
+} // end dot
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - output of the filter.
+template <class T>
+std::complex<T> ComplexFIRFilter<T>::filter(std::complex<T> x)
+{
+    makeRoom(1);
+    historyRe[fill] = x.real();
+    historyIm[fill] = x.imag();
+    T re, im;
+    dot(fill, re, im);
+    fill++;
+    output = std::complex<T>(re, im);
+    return output;
+}
+
+// filterBlock
+// Filters a block of n interleaved inputs, may be done in place. The
+// inputs of each chunk are split into the history before any of its
+// outputs are written.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void ComplexFIRFilter<T>::filterBlock(const std::complex<T> *input, std::complex<T> *out,
+                                      size_t n)
+{
+    size_t done = 0;
+    while (done < n) {
+        size_t count = makeRoom(n - done);
+        for (size_t j = 0; j < count; j++) {
+            historyRe[fill + j] = input[done + j].real();
+            historyIm[fill + j] = input[done + j].imag();
+        }
+        for (size_t j = 0; j < count; j++) {
+            T re, im;
+            dot(fill + j, re, im);
+            out[done + j] = std::complex<T>(re, im);
+        }
+        fill += count;
+        done += count;
+    }
+    if (n > 0) { output = out[n - 1]; }
+} // end filterBlock
+
+// filterBlock
+// Filters a block of n inputs given as split I and Q arrays, may be
+// done in place.
+// @param inRe - the real parts of the inputs.
+// @param inIm - the imaginary parts of the inputs.
+// @param outRe - the array to write the real parts of the outputs to.
+// @param outIm - the array to write the imaginary parts of the outputs to.
+// @param n - the number of samples in the block.
+template <class T>
+void ComplexFIRFilter<T>::filterBlock(const T *inRe, const T *inIm, T *outRe, T *outIm,
+                                      size_t n)
+{
+    size_t done = 0;
+    while (done < n) {
+        size_t count = makeRoom(n - done);
+        std::copy(inRe + done, inRe + done + count, historyRe.begin() + fill);
+        std::copy(inIm + done, inIm + done + count, historyIm.begin() + fill);
+        for (size_t j = 0; j < count; j++) {
+            dot(fill + j, outRe[done + j], outIm[done + j]);
+        }
+        fill += count;
+        done += count;
+    }
+    if (n > 0) { output = std::complex<T>(outRe[n - 1], outIm[n - 1]); }
+} // end filterBlock
+
+
+///////////////////////////// IIR /////////////////////////////
+
+// Constructor
+// Real coefficients, applied to I and Q alike.
+// @param feedForwardCoef - the feed forward coefficients b, copied.
+// @param feedbackCoef - the feedback coefficients a, from a1, copied.
+// @param forwardLength - the number of feed forward coefficients.
+// @param backLength - the number of feedback coefficients.
+template <class T>
+ComplexIIRFilter<T>::ComplexIIRFilter(const T *feedForwardCoef, const T *feedbackCoef,
+                                      uint32_t forwardLength, uint32_t backLength)
+{
+    if (feedForwardCoef == NULL) { forwardLength = 0; }
+    if (feedbackCoef == NULL) { backLength = 0; }
+    setLengths(forwardLength, backLength);
+    std::copy(feedForwardCoef, feedForwardCoef + forwardLength, ffRe.begin());
+    std::copy(feedbackCoef, feedbackCoef + backLength, fbRe.begin());
+}
+
+// Constructor
+// Complex coefficients.
+// @param feedForwardCoef - the feed forward coefficients b, copied.
+// @param feedbackCoef - the feedback coefficients a, from a1, copied.
+// @param forwardLength - the number of feed forward coefficients.
+// @param backLength - the number of feedback coefficients.
+template <class T>
+ComplexIIRFilter<T>::ComplexIIRFilter(const std::complex<T> *feedForwardCoef,
+                                      const std::complex<T> *feedbackCoef,
+                                      uint32_t forwardLength, uint32_t backLength)
+{
+    if (feedForwardCoef == NULL) { forwardLength = 0; }
+    if (feedbackCoef == NULL) { backLength = 0; }
+    setLengths(forwardLength, backLength);
+    ffIm.resize(forwardLength);
+    fbIm.resize(backLength);
+    for (uint32_t i = 0; i < forwardLength; i++) {
+        ffRe[i] = feedForwardCoef[i].real();
+        ffIm[i] = feedForwardCoef[i].imag();
+    }
+    for (uint32_t i = 0; i < backLength; i++) {
+        fbRe[i] = feedbackCoef[i].real();
+        fbIm[i] = feedbackCoef[i].imag();
+    }
+}
+
+// setLengths
+// sizes the coefficients and the delay line.
+template <class T>
+void ComplexIIRFilter<T>::setLengths(uint32_t forwardLength, uint32_t backLength)
+{
+    ffRe.assign(forwardLength, 0);
+    fbRe.assign(backLength, 0);
+    length = std::max((size_t)forwardLength, (size_t)backLength + 1);
+    delayRe.assign(2 * (size_t)length, 0);
+    delayIm.assign(2 * (size_t)length, 0);
+    reset();
+}
+
+// reset
+// clears the delay line.
+template <class T>
+void ComplexIIRFilter<T>::reset()
+{
+    std::fill(delayRe.begin(), delayRe.end(), (T)0);
+    std::fill(delayIm.begin(), delayIm.end(), (T)0);
+    pos = 0;
+    output = 0;
+}
+
+// step
+// filters one input in cannonical form, as IIRFilter does. The new
+// intermediate value goes in front of the last length - 1, so w[j] is the
+// value from j inputs ago.
+// @param xRe - the real part of the input.
+// @param xIm - the imaginary part of the input.
+// @param yRe - the real part of the output.
+// @param yIm - the imaginary part of the output.
+template <class T>
+void ComplexIIRFilter<T>::step(T xRe, T xIm, T &yRe, T &yIm)
+{
+    pos = (pos == 0) ? length - 1 : pos - 1;
+    T *wr = &delayRe[pos];
+    T *wi = &delayIm[pos];
+    size_t fb = fbRe.size();
+    size_t ff = ffRe.size();
+    const T *ar = fbRe.empty() ? NULL : &fbRe[0];
+    const T *br = ffRe.empty() ? NULL : &ffRe[0];
+    T sumRe = xRe;
+    T sumIm = xIm;
+    T re = 0;
+    T im = 0;
+    if (ffIm.empty()) {
+        for (size_t i = 0; i < fb; i++) {
+            sumRe -= ar[i] * wr[i + 1];
+            sumIm -= ar[i] * wi[i + 1];
+        }
+        wr[0] = wr[length] = sumRe;
+        wi[0] = wi[length] = sumIm;
+        for (size_t i = 0; i < ff; i++) {
+            re += br[i] * wr[i];
+            im += br[i] * wi[i];
+        }
+    } else {
+        const T *ai = fbIm.empty() ? NULL : &fbIm[0];
+        const T *bi = ffIm.empty() ? NULL : &ffIm[0];
+        for (size_t i = 0; i < fb; i++) {
+            sumRe -= ar[i] * wr[i + 1] - ai[i] * wi[i + 1];
+            sumIm -= ar[i] * wi[i + 1] + ai[i] * wr[i + 1];
+        }
+        wr[0] = wr[length] = sumRe;
+        wi[0] = wi[length] = sumIm;
+        for (size_t i = 0; i < ff; i++) {
+            re += br[i] * wr[i] - bi[i] * wi[i];
+            im += br[i] * wi[i] + bi[i] * wr[i];
+        }
+    }
+    yRe = re;
+    yIm = im;
+} // end step
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - output of the filter.
+template <class T>
+std::complex<T> ComplexIIRFilter<T>::filter(std::complex<T> x)
+{
+    T re, im;
+    step(x.real(), x.imag(), re, im);
+    output = std::complex<T>(re, im);
+    return output;
+}
+
+// filterBlock
+// Filters a block of n interleaved inputs, may be done in place.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void ComplexIIRFilter<T>::filterBlock(const std::complex<T> *input, std::complex<T> *out,
+                                      size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        T re, im;
+        step(input[i].real(), input[i].imag(), re, im);
+        out[i] = std::complex<T>(re, im);
+    }
+    if (n > 0) { output = out[n - 1]; }
+}
+
+// filterBlock
+// Filters a block of n inputs given as split I and Q arrays, may be
+// done in place.
+// @param inRe - the real parts of the inputs.
+// @param inIm - the imaginary parts of the inputs.
+// @param outRe - the array to write the real parts of the outputs to.
+// @param outIm - the array to write the imaginary parts of the outputs to.
+// @param n - the number of samples in the block.
+template <class T>
+void ComplexIIRFilter<T>::filterBlock(const T *inRe, const T *inIm, T *outRe, T *outIm,
+                                      size_t n)
+{
+    for (size_t i = 0; i < n; i++) { step(inRe[i], inIm[i], outRe[i], outIm[i]); }
+    if (n > 0) { output = std::complex<T>(outRe[n - 1], outIm[n - 1]); }
+}
+
+#endif
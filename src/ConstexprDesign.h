@@ -0,0 +1,144 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ConstexprDesign.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// DesignCache.h
+// ConstexprDesign.hpp
+//
+// Compile time versions of the filter design functions in FilterUtility.h,
+// for fixed filters. The coefficients are worked out by the compiler and
+// placed in read only data, so there is no startup cost and no allocation.
+// The tables are std::array, and are checked against the runtime designs
+// in ConstexprDesignSuite.
+//
+// This is C++11 constexpr, so every function is a single return statement
+// and loops are written as recursion. sin, cos, sqrt, exp, log and the
+// bessel function are approximated with series accurate to about 1e-15.
+// The tables are built with one pack expansion over the indices, so N is
+// limited by the compiler's constexpr limits rather than template depth;
+// a few thousand taps is fine with g++ defaults.
+//
+// Example:
+// static constexpr std::array<float, 101> taps =
+//     constexprDesign<float, 101>(DESIGN_LOWPASS, 0.3, WINDOW_KAISER, 60.0);
+// // the filter never writes to its gains.
+// FIRFilter<float> fir(const_cast<float *>(taps.data()), 101);
+
+#ifndef __CONSTEXPR_DESIGN__
+#define __CONSTEXPR_DESIGN__
+
+#include "DesignCache.h"
+#include <array>
+#include <cstddef>
+
+// constexprSin
+// @param x - the angle in radians, |x| < 5e7.
+//
+// @return - sin(x).
+constexpr double constexprSin(double x);
+
+// constexprCos
+// @param x - the angle in radians, |x| < 5e7.
+//
+// @return - cos(x).
+constexpr double constexprCos(double x);
+
+// constexprSqrt
+// @param x - a value >= 0.
+//
+// @return - sqrt(x).
+constexpr double constexprSqrt(double x);
+
+// constexprExp
+// @param x - the exponent.
+//
+// @return - e^x.
+constexpr double constexprExp(double x);
+
+// constexprLog
+// @param x - a value > 0.
+//
+// @return - the natural log of x.
+constexpr double constexprLog(double x);
+
+// constexprBesselFunc
+// the same series as besselFunc, the bessel function of the first order.
+constexpr double constexprBesselFunc(double x);
+
+// constexprKaiserAlpha
+// calculates the kaiser window shape parameter, as kaiserAlpha.
+// @param A - stopband attenuation required in dB
+//
+// @return - the alpha (beta) parameter of the kaiser window.
+constexpr double constexprKaiserAlpha(double A);
+
+// constexprIdealFilterCoef
+// the N gains of an ideal low or high pass filter, as idealFilterCoef.
+// NOTE: the length must be odd.
+// @param omegaCutoff - the cutoff frequency of the filter.
+// @param isHighPassFilter - false for lowpass, true for high pass filter.
+//
+// @return - the filter coefficients.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprIdealFilterCoef(double omegaCutoff,
+                                                   bool isHighPassFilter = false);
+
+// constexprIdealDifferentiatorCoef
+// the N gains of an ideal differentiator, as idealDifferentiatorCoef.
+// NOTE: the length must be odd.
+//
+// @return - the filter coefficients.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprIdealDifferentiatorCoef();
+
+// constexprHammingWindow
+// a hamming window of length N, as applyHammingWindow applies.
+//
+// @return - the window.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprHammingWindow();
+
+// constexprKaiserWindow
+// a kaiser window of length N, as applyKaiserWindow applies.
+// NOTE: the length must be odd.
+// @param A - stopband attenuation required in dB
+//
+// @return - the window.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprKaiserWindow(double A);
+
+// constexprDesign
+// a windowed filter design, the same design DesignCache makes.
+// WINDOW_KAISER_FAST gives the exact kaiser window.
+// NOTE: the length must be odd.
+// @param type - the type of filter.
+// @param omegaCutoff - the cutoff frequency, ignored for differentiators.
+// @param window - the window to apply.
+// @param A - stopband attenuation in dB, for kaiser windows.
+//
+// @return - the filter coefficients.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprDesign(FilterDesignType type, double omegaCutoff,
+                                           WindowType window, double A = 0.0);
+
+#include "ConstexprDesign.hpp"
+#endif
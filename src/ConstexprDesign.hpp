@@ -0,0 +1,376 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ConstexprDesign.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// ConstexprDesign.h
+//
+// Implementation of the compile time filter designs. Each loop is a tail
+// recursive helper, which carries the loop variables as parameters.
+
+#ifndef __CONSTEXPR_DESIGN_IMPL__
+#define __CONSTEXPR_DESIGN_IMPL__
+
+#include "ConstexprDesign.h"
+
+#define CONSTEXPR_PI 3.14159265358979323846
+#define CONSTEXPR_LN2 0.693147180559945309417
+// 2 pi split into three parts, the first two with 30 bit mantissas so
+// k * part is exact for k < 2^23, and large angles are reduced without
+// losing the low bits.
+#define CONSTEXPR_TWO_PI_HI 6.283185303211212
+#define CONSTEXPR_TWO_PI_MID 3.9683743166540886e-09
+#define CONSTEXPR_TWO_PI_LO 2.068073192717642e-18
+
+constexpr double constexprSquare(double x) { return x * x; }
+constexpr double constexprAbs(double x) { return x < 0 ? -x : x; }
+
+// constexprRound
+// rounds to the nearest whole number, |x| must fit in a long long.
+constexpr double constexprRound(double x)
+{
+    return (double)(long long)(x < 0 ? x - 0.5 : x + 0.5);
+}
+
+// constexprReduceAngle
+// x - k 2 pi, which is in [-pi, pi] for k = round(x / 2 pi).
+constexpr double constexprReduceAngle(double x, double k)
+{
+    return ((x - k * CONSTEXPR_TWO_PI_HI) - k * CONSTEXPR_TWO_PI_MID) - k * CONSTEXPR_TWO_PI_LO;
+}
+
+// constexprSinSeries
+// the taylor series of sin, summed until the terms no longer change it.
+// @param x2 - x squared.
+// @param term - the k'th term, x^(2k+1) / (2k+1)! with its sign.
+// @param k - the term number.
+// @param sum - the sum of the terms before k.
+constexpr double constexprSinSeries(double x2, double term, int k, double sum)
+{
+    return (sum + term == sum) ? sum :
+        constexprSinSeries(x2, -term * x2 / ((2 * k + 2) * (2 * k + 3)), k + 1, sum + term);
+}
+
+// constexprCosSeries
+// the taylor series of cos, with the k'th term x^2k / (2k)!.
+constexpr double constexprCosSeries(double x2, double term, int k, double sum)
+{
+    return (sum + term == sum) ? sum :
+        constexprCosSeries(x2, -term * x2 / ((2 * k + 1) * (2 * k + 2)), k + 1, sum + term);
+}
+
+// constexprSinReduced
+// sin of an angle in [-pi, pi], reflected into [-pi/2, pi/2] where the
+// series converges fastest.
+constexpr double constexprSinReduced(double r)
+{
+    return (r > CONSTEXPR_PI / 2) ? constexprSinSeries(constexprSquare(CONSTEXPR_PI - r),
+                                                       CONSTEXPR_PI - r, 0, 0.0) :
+        (r < -CONSTEXPR_PI / 2) ? constexprSinSeries(constexprSquare(-CONSTEXPR_PI - r),
+                                                     -CONSTEXPR_PI - r, 0, 0.0) :
+        constexprSinSeries(r * r, r, 0, 0.0);
+}
+
+// constexprCosReduced
+// cos of an angle in [-pi, pi], reflected into [-pi/2, pi/2].
+constexpr double constexprCosReduced(double r)
+{
+    return (constexprAbs(r) > CONSTEXPR_PI / 2) ?
+        -constexprCosSeries(constexprSquare(CONSTEXPR_PI - constexprAbs(r)), 1.0, 0, 0.0) :
+        constexprCosSeries(r * r, 1.0, 0, 0.0);
+}
+
+// constexprSin
+// @param x - the angle in radians.
+//
+// @return - sin(x).
+constexpr double constexprSin(double x)
+{
+    return constexprSinReduced(constexprReduceAngle(x,
+                constexprRound(x / (2 * CONSTEXPR_PI))));
+}
+
+// constexprCos
+// @param x - the angle in radians.
+//
+// @return - cos(x).
+constexpr double constexprCos(double x)
+{
+    return constexprCosReduced(constexprReduceAngle(x,
+                constexprRound(x / (2 * CONSTEXPR_PI))));
+}
+
+// constexprSqrtStep
+// newton's method from above, which stops once the guess stops falling.
+// @param x - the value to take the root of.
+// @param guess - the current guess, >= sqrt(x).
+// @param next - the next guess.
+constexpr double constexprSqrtStep(double x, double guess, double next)
+{
+    return (next >= guess) ? guess :
+        constexprSqrtStep(x, next, 0.5 * (next + x / next));
+}
+
+// constexprSqrt
+// @param x - a value >= 0.
+//
+// @return - sqrt(x).
+constexpr double constexprSqrt(double x)
+{
+    return (x <= 0) ? 0.0 :
+        (x > 1) ? constexprSqrtStep(x, x, 0.5 * (x + 1.0)) :
+        constexprSqrtStep(x, 1.0, 0.5 * (1.0 + x));
+}
+
+// constexprExpSeries
+// the taylor series of e^x, with the k'th term x^k / k!.
+constexpr double constexprExpSeries(double x, double term, int k, double sum)
+{
+    return (sum + term == sum) ? sum :
+        constexprExpSeries(x, term * x / (k + 1), k + 1, sum + term);
+}
+
+// constexprExp
+// halves x until the series converges quickly, then squares back up.
+// @param x - the exponent.
+//
+// @return - e^x.
+constexpr double constexprExp(double x)
+{
+    return (constexprAbs(x) > 0.5) ? constexprSquare(constexprExp(x / 2)) :
+        constexprExpSeries(x, 1.0, 0, 0.0);
+}
+
+// constexprLogSeries
+// the series ln(x) = 2 sum z^(2k+1) / (2k+1), where z = (x - 1) / (x + 1).
+// @param z2 - z squared.
+// @param power - z^(2k+1).
+constexpr double constexprLogSeries(double z2, double power, int k, double sum)
+{
+    return (sum + power / (2 * k + 1) == sum) ? sum :
+        constexprLogSeries(z2, power * z2, k + 1, sum + power / (2 * k + 1));
+}
+
+// constexprLogReduced
+// ln(x) for x in [1, 2].
+constexpr double constexprLogReduced(double z)
+{
+    return 2.0 * constexprLogSeries(z * z, z, 0, 0.0);
+}
+
+// constexprLog
+// scales x into [1, 2] by powers of 2, then uses the series.
+// @param x - a value > 0.
+//
+// @return - the natural log of x.
+constexpr double constexprLog(double x)
+{
+    return (x > 2) ? constexprLog(x / 2) + CONSTEXPR_LN2 :
+        (x < 1) ? constexprLog(x * 2) - CONSTEXPR_LN2 :
+        constexprLogReduced((x - 1) / (x + 1));
+}
+
+constexpr double constexprBesselNext(double x, int n, double S, double D);
+
+// constexprBesselTerm
+// one pass of the loop in besselFunc.
+// @param x - the argument of the bessel function.
+// @param n - the term number.
+// @param S - the sum so far.
+// @param D - the last term.
+constexpr double constexprBesselTerm(double x, int n, double S, double D)
+{
+    return (D > (1.E-9 * S)) ?
+        constexprBesselNext(x, n, S, D * constexprSquare(x / (2 * n))) : S;
+}
+
+constexpr double constexprBesselNext(double x, int n, double S, double D)
+{
+    return constexprBesselTerm(x, n + 1, S + D, D);
+}
+
+// constexprBesselFunc
+// the same series as besselFunc, the bessel function of the first order.
+constexpr double constexprBesselFunc(double x)
+{
+    return constexprBesselTerm(x, 1, 1.0, 1.0);
+}
+
+// constexprKaiserAlpha
+// calculates the kaiser window shape parameter, as kaiserAlpha.
+// @param A - stopband attenuation required in dB
+//
+// @return - the alpha (beta) parameter of the kaiser window.
+constexpr double constexprKaiserAlpha(double A)
+{
+    return (A >= 50.0) ? 0.1102 * (A - 8.7) :
+        (A > 21.0) ? 0.5842 * constexprExp(0.4 * constexprLog(A - 21)) + (0.07886 * (A - 21)) :
+        0.0;
+}
+
+// constexprIdealCoef
+// the tap j away from the center of an ideal filter.
+constexpr double constexprIdealCoef(FilterDesignType type, double omegaCutoff, long long j)
+{
+    return (type == DESIGN_DIFFERENTIATOR) ?
+            ((j == 0) ? 0.0 : (((j < 0 ? -j : j) % 2) ? -1.0 : 1.0) / j) :
+        (j == 0) ?
+            ((type == DESIGN_HIGHPASS) ? 1.0 - (omegaCutoff / CONSTEXPR_PI) :
+                                         omegaCutoff / CONSTEXPR_PI) :
+        ((type == DESIGN_HIGHPASS) ? -1.0 : 1.0) * constexprSin(omegaCutoff * j) /
+            (CONSTEXPR_PI * j);
+}
+
+// constexprKaiserCoef
+// tap n of a kaiser window centered on M.
+constexpr double constexprKaiserCoef(double alpha, double M, double n)
+{
+    return (M == 0) ? 1.0 :
+        constexprBesselFunc(alpha * constexprSqrt(1.0 - ((n - M) * (n - M) / (M * M))))
+            / constexprBesselFunc(alpha);
+}
+
+// constexprWindowCoef
+// tap n of a window of length N.
+// @param alpha - the kaiser shape parameter, unused by other windows.
+constexpr double constexprWindowCoef(WindowType window, size_t N, size_t n, double alpha)
+{
+    return (window == WINDOW_HAMMING) ?
+            ((N > 1) ? 0.54 - (0.46 * constexprCos(2 * CONSTEXPR_PI * n / (N - 1))) : 1.0) :
+        (window == WINDOW_KAISER || window == WINDOW_KAISER_FAST) ?
+            constexprKaiserCoef(alpha, (double)(N / 2), (double)n) :
+        1.0;
+}
+
+// ConstexprIndices
+// the indices of a table, 0 ... N-1, as a parameter pack.
+template <size_t... I>
+struct ConstexprIndices {};
+
+template <class A, class B>
+struct ConstexprJoin;
+
+template <size_t... I, size_t... J>
+struct ConstexprJoin<ConstexprIndices<I...>, ConstexprIndices<J...> > {
+    typedef ConstexprIndices<I..., (sizeof...(I) + J)...> type;
+};
+
+// ConstexprRange
+// builds ConstexprIndices<0, ..., N-1> from two halves, so the template
+// depth is log N.
+template <size_t N>
+struct ConstexprRange {
+    typedef typename ConstexprJoin<typename ConstexprRange<N / 2>::type,
+                                   typename ConstexprRange<N - N / 2>::type>::type type;
+};
+
+template <>
+struct ConstexprRange<0> { typedef ConstexprIndices<> type; };
+
+template <>
+struct ConstexprRange<1> { typedef ConstexprIndices<0> type; };
+
+// constexprTable
+// a table of N taps, each the ideal design (if design is set) times the window.
+template <class T, size_t N, size_t... I>
+constexpr std::array<T, N> constexprTable(ConstexprIndices<I...>, bool design,
+                                          FilterDesignType type, double omegaCutoff,
+                                          WindowType window, double alpha)
+{
+    return std::array<T, N>{{ (T)((design ? constexprIdealCoef(type, omegaCutoff,
+                                                (long long)I - (long long)(N / 2)) : 1.0) *
+                                  constexprWindowCoef(window, N, I, alpha))... }};
+}
+
+// constexprIdealFilterCoef
+// the N gains of an ideal low or high pass filter, as idealFilterCoef.
+// NOTE: the length must be odd.
+// @param omegaCutoff - the cutoff frequency of the filter.
+// @param isHighPassFilter - false for lowpass, true for high pass filter.
+//
+// @return - the filter coefficients.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprIdealFilterCoef(double omegaCutoff, bool isHighPassFilter)
+{
+    static_assert(N % 2 == 1, "the length must be odd");
+    return constexprTable<T, N>(typename ConstexprRange<N>::type(), true,
+                                isHighPassFilter ? DESIGN_HIGHPASS : DESIGN_LOWPASS,
+                                omegaCutoff, WINDOW_RECTANGULAR, 0.0);
+}
+
+// constexprIdealDifferentiatorCoef
+// the N gains of an ideal differentiator, as idealDifferentiatorCoef.
+// NOTE: the length must be odd.
+//
+// @return - the filter coefficients.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprIdealDifferentiatorCoef()
+{
+    static_assert(N % 2 == 1, "the length must be odd");
+    return constexprTable<T, N>(typename ConstexprRange<N>::type(), true,
+                                DESIGN_DIFFERENTIATOR, 0.0, WINDOW_RECTANGULAR, 0.0);
+}
+
+// constexprHammingWindow
+// a hamming window of length N, as applyHammingWindow applies.
+//
+// @return - the window.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprHammingWindow()
+{
+    return constexprTable<T, N>(typename ConstexprRange<N>::type(), false,
+                                DESIGN_LOWPASS, 0.0, WINDOW_HAMMING, 0.0);
+}
+
+// constexprKaiserWindow
+// a kaiser window of length N, as applyKaiserWindow applies.
+// NOTE: the length must be odd.
+// @param A - stopband attenuation required in dB
+//
+// @return - the window.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprKaiserWindow(double A)
+{
+    static_assert(N % 2 == 1, "the length must be odd");
+    return constexprTable<T, N>(typename ConstexprRange<N>::type(), false,
+                                DESIGN_LOWPASS, 0.0, WINDOW_KAISER, constexprKaiserAlpha(A));
+}
+
+// constexprDesign
+// a windowed filter design, the same design DesignCache makes.
+// WINDOW_KAISER_FAST gives the exact kaiser window.
+// NOTE: the length must be odd.
+// @param type - the type of filter.
+// @param omegaCutoff - the cutoff frequency, ignored for differentiators.
+// @param window - the window to apply.
+// @param A - stopband attenuation in dB, for kaiser windows.
+//
+// @return - the filter coefficients.
+template <class T, size_t N>
+constexpr std::array<T, N> constexprDesign(FilterDesignType type, double omegaCutoff,
+                                           WindowType window, double A)
+{
+    static_assert(N % 2 == 1, "the length must be odd");
+    return constexprTable<T, N>(typename ConstexprRange<N>::type(), true, type, omegaCutoff,
+                                window, constexprKaiserAlpha(A));
+}
+
+#endif
@@ -0,0 +1,119 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// DesignCache.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FilterUtility.h
+// WindowCache.h
+// DesignCache.hpp
+//
+// A least recently used cache of FIR filter designs, for retuning filters
+// many times a second. A design is the ideal filter coefficients with a
+// window applied, keyed by (type, cutoff, N, window, A). Repeated designs are
+// a lookup and copy, and new designs are computed into preallocated storage,
+// so no memory is allocated after the cache is made.
+//
+// Example:
+// DesignCache<float> cache(32, 255);
+// float gains[101];
+// cache.design(gains, DESIGN_LOWPASS, cutoff, 101, WINDOW_KAISER, 60.0);
+// filter.setGains(gains, 101);
+
+#ifndef __DESIGN_CACHE__
+#define __DESIGN_CACHE__
+
+#include "FilterUtility.h"
+#include "WindowCache.h"
+#include <cstdint>
+
+// The filter designs the cache can make.
+enum FilterDesignType {
+    DESIGN_LOWPASS,
+    DESIGN_HIGHPASS,
+    DESIGN_DIFFERENTIATOR
+};
+
+template <class T>
+class DesignCache {
+public:
+    // Constructor
+    // Allocates all the storage the cache will need.
+    // @param capacity - the number of designs to keep.
+    // @param maxLength - the longest filter that can be designed.
+    DesignCache(uint32_t capacity, uint32_t maxLength);
+    ~DesignCache();
+
+    // design
+    // Looks up a design, computing it if it isn't in the cache.
+    // The returned coefficients are valid until capacity other designs
+    // have been made.
+    // NOTE: the length must be odd.
+    // @param type - the type of filter.
+    // @param omegaCutoff - the cutoff frequency, ignored for differentiators.
+    // @param N - the length of the filter.
+    // @param window - the window to apply.
+    // @param A - stopband attenuation in dB, for kaiser windows.
+    //
+    // @return - the filter coefficients, NULL on failure.
+    const T *design(FilterDesignType type, double omegaCutoff, uint32_t N,
+                WindowType window = WINDOW_RECTANGULAR, double A = 0.0);
+
+    // design
+    // The same as above, but copies the coefficients into the given array.
+    // @param gains - the array to write the coefficients to (length N).
+    //
+    // @return - 0 for success, else failure.
+    int design(T *gains, FilterDesignType type, double omegaCutoff, uint32_t N,
+                WindowType window = WINDOW_RECTANGULAR, double A = 0.0);
+
+    // getHits / getMisses
+    // the number of designs found in the cache, and computed.
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+
+private:
+    struct Entry {
+        FilterDesignType type;
+        double omegaCutoff;
+        uint32_t N;
+        WindowType window;
+        double A;
+        uint64_t lastUsed; // 0 for an empty entry.
+    };
+
+    // not copyable, the cache owns its storage.
+    DesignCache(const DesignCache &);
+    DesignCache &operator=(const DesignCache &);
+
+    Entry *entries;
+    T *storage;       // capacity * maxLength coefficients.
+    double *windowBuf; // maxLength scratch for the window.
+    uint32_t capacity;
+    uint32_t maxLength;
+    uint64_t clock;
+    uint64_t hits;
+    uint64_t misses;
+};
+
+
+#include "DesignCache.hpp"
+
+#endif
@@ -0,0 +1,141 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// DesignCache.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FilterUtility.h
+// WindowCache.h
+// DesignCache.h
+//
+// A least recently used cache of FIR filter designs.
+// The implementation file.
+
+#ifndef __DESIGN_CACHE_IMPL__
+#define __DESIGN_CACHE_IMPL__
+
+#include "DesignCache.h"
+
+// Constructor
+// Allocates all the storage the cache will need.
+// @param capacity - the number of designs to keep.
+// @param maxLength - the longest filter that can be designed.
+template <class T>
+DesignCache<T>::DesignCache(uint32_t Capacity, uint32_t MaxLength)
+{
+    capacity = (Capacity > 0) ? Capacity : 1;
+    maxLength = MaxLength;
+    entries = new Entry[capacity];
+    storage = new T[(size_t)capacity * maxLength];
+    windowBuf = new double[maxLength];
+    for (uint32_t i = 0; i < capacity; i++) { entries[i].lastUsed = 0; }
+    clock = 0;
+    hits = 0;
+    misses = 0;
+} // end constructor
+
+template <class T>
+DesignCache<T>::~DesignCache()
+{
+    delete[] entries;
+    delete[] storage;
+    delete[] windowBuf;
+}
+
+
+// design
+// Looks up a design, computing it if it isn't in the cache.
+// The returned coefficients are valid until capacity other designs
+// have been made.
+// NOTE: the length must be odd.
+// @param type - the type of filter.
+// @param omegaCutoff - the cutoff frequency, ignored for differentiators.
+// @param N - the length of the filter.
+// @param window - the window to apply.
+// @param A - stopband attenuation in dB, for kaiser windows.
+//
+// @return - the filter coefficients, NULL on failure.
+template <class T>
+const T *DesignCache<T>::design(FilterDesignType type, double omegaCutoff, uint32_t N,
+                WindowType window, double A)
+{
+    if (N > maxLength || N % 2 == 0) { return NULL; }
+    // parameters that don't change the design aren't part of the key.
+    if (type == DESIGN_DIFFERENTIATOR) { omegaCutoff = 0.0; }
+    if (window != WINDOW_KAISER && window != WINDOW_KAISER_FAST) { A = 0.0; }
+
+    clock++;
+    uint32_t oldest = 0;
+    for (uint32_t i = 0; i < capacity; i++) {
+        Entry &e = entries[i];
+        if (e.lastUsed != 0 && e.type == type && e.N == N && e.window == window &&
+            e.omegaCutoff == omegaCutoff && e.A == A) {
+            e.lastUsed = clock;
+            hits++;
+            return storage + (size_t)i * maxLength;
+        }
+        if (e.lastUsed < entries[oldest].lastUsed) { oldest = i; }
+    }
+
+    // not found, replace the least recently used design.
+    misses++;
+    Entry &e = entries[oldest];
+    T *gains = storage + (size_t)oldest * maxLength;
+    int err;
+    if (type == DESIGN_DIFFERENTIATOR) { err = idealDifferentiatorCoef(gains, N); }
+    else { err = idealFilterCoef(gains, omegaCutoff, N, type == DESIGN_HIGHPASS); }
+
+    if (err == 0 && window != WINDOW_RECTANGULAR) {
+        err = generateWindow(windowBuf, window, N, A);
+        if (err == 0) { err = applyWindow(gains, windowBuf, N); }
+    }
+    if (err != 0) {
+        e.lastUsed = 0;
+        return NULL;
+    }
+
+    e.type = type;
+    e.omegaCutoff = omegaCutoff;
+    e.N = N;
+    e.window = window;
+    e.A = A;
+    e.lastUsed = clock;
+    return gains;
+} // end design
+
+
+// design
+// The same as above, but copies the coefficients into the given array.
+// @param gains - the array to write the coefficients to (length N).
+//
+// @return - 0 for success, else failure.
+template <class T>
+int DesignCache<T>::design(T *gains, FilterDesignType type, double omegaCutoff, uint32_t N,
+                WindowType window, double A)
+{
+    if (gains == NULL) { return -1; }
+    const T *cached = design(type, omegaCutoff, N, window, A);
+    if (cached == NULL) { return -1; }
+    for (uint32_t i = 0; i < N; i++) { gains[i] = cached[i]; }
+    return 0;
+} // end design
+
+
+#endif
@@ -0,0 +1,174 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FFT.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FFT.hpp
+//
+// A dependency free fast fourier transform.
+// FFTPlan does complex transforms of any size. The size is factored into
+// radix 4, 2, 3 and 5 stages, which have their own butterflies, and stages
+// of any other prime up to FFT_STACK_RADIX, which use a direct O(radix^2)
+// DFT. The plan precomputes the twiddle factors of every stage and the
+// digit reversal (bit reversal for powers of 2) table, so transforms do no
+// trig and no allocation.
+// Sizes with a prime factor above FFT_STACK_RADIX use Bluestein's algorithm
+// instead, a convolution done with power of 2 transforms of at least
+// 2N - 1, so they are still O(N log N) but a few times slower than a size
+// that factors, and allocate two buffers per transform.
+// RealFFTPlan does real transforms of even sizes with a complex transform of
+// half the size.
+//
+// The data is interleaved std::complex, and the butterflies work on its real
+// and imaginary parts, with the twiddles stored in the order they are used,
+// so the compiler can vectorize across butterflies without any intrinsics.
+//
+// The forward transform is X[k] = sum x[n] e^(-2 pi i k n / N), and the inverse
+// uses e^(+2 pi i k n / N) with no 1/N scaling.
+//
+// A plan can be shared between threads, as transforms don't change it.
+// RealFFTPlan keeps a scratch buffer, so each thread needs its own.
+
+#ifndef __FFT__
+#define __FFT__
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// the largest prime factor done as a stage, sizes with larger prime factors
+// use Bluestein's algorithm.
+#define FFT_STACK_RADIX 64
+
+template <class T>
+class FFTPlan {
+public:
+    // Constructor
+    // Builds the twiddle and reversal tables for a transform of size N.
+    // @param N - the size of the transform.
+    FFTPlan(uint32_t N);
+
+    // forward
+    // Computes the forward transform of input into output.
+    // input and output must not be the same array.
+    // @param input - N complex inputs.
+    // @param output - N complex outputs.
+    void forward(const std::complex<T> *input, std::complex<T> *output) const;
+
+    // inverse
+    // Computes the inverse transform of input into output, without scaling by 1/N.
+    // input and output must not be the same array.
+    // @param input - N complex inputs.
+    // @param output - N complex outputs.
+    void inverse(const std::complex<T> *input, std::complex<T> *output) const;
+
+    // getSize
+    // returns the size of the transform.
+    uint32_t getSize() const { return size; }
+
+private:
+    struct Stage {
+        uint32_t radix;
+        uint32_t span;        // size of the sub transforms being combined.
+        size_t twiddleOffset; // where this stage's twiddles start.
+    };
+
+    void transform(const std::complex<T> *input, std::complex<T> *output, bool inverse) const;
+    void bluestein(const std::complex<T> *input, std::complex<T> *output, bool inverse) const;
+    void radix2(std::complex<T> *data, const Stage &stage, bool inverse) const;
+    void radix3(std::complex<T> *data, const Stage &stage, bool inverse) const;
+    void radix4(std::complex<T> *data, const Stage &stage, bool inverse) const;
+    void radix5(std::complex<T> *data, const Stage &stage, bool inverse) const;
+    void radixN(std::complex<T> *data, const Stage &stage, bool inverse) const;
+
+    uint32_t size;
+    std::vector<Stage> stages;
+    std::vector<uint32_t> reversal;       // output[i] = input[reversal[i]]
+    std::vector<std::complex<T> > twiddles; // per stage, [q - 1][j] = W^(j q)
+    std::vector<std::complex<T> > roots;    // e^(-2 pi i k / N) for the general radix.
+
+    // Bluestein's algorithm, only for sizes with a large prime factor.
+    std::shared_ptr<const FFTPlan<T> > chirpPlan; // power of 2 size plan.
+    std::vector<std::complex<T> > chirp;          // e^(-pi i n^2 / N)
+    std::vector<std::complex<T> > chirpFilter;    // transform of conj(chirp), / M
+};
+
+
+template <class T>
+class RealFFTPlan {
+public:
+    // Constructor
+    // Builds the tables for a real transform of size N.
+    // N must be even, an odd (or 0) N gives a plan of size 0, whose
+    // transforms do nothing.
+    // @param N - the size of the transform.
+    RealFFTPlan(uint32_t N);
+
+    // forward
+    // Computes the transform of N real inputs, giving the N / 2 + 1
+    // non-negative frequency bins.
+    // @param input - N real inputs.
+    // @param output - N / 2 + 1 complex outputs.
+    void forward(const T *input, std::complex<T> *output);
+
+    // inverse
+    // Computes N real outputs from N / 2 + 1 frequency bins, without scaling by 1/N.
+    // @param input - N / 2 + 1 complex inputs.
+    // @param output - N real outputs.
+    void inverse(const std::complex<T> *input, T *output);
+
+    // getSize
+    // returns the size of the transform, 0 if N was odd.
+    uint32_t getSize() const { return size; }
+
+private:
+    uint32_t size;
+    FFTPlan<T> half;
+    std::vector<std::complex<T> > twiddles; // e^(-2 pi i k / N)
+    std::vector<std::complex<T> > scratchIn;
+    std::vector<std::complex<T> > scratchOut;
+};
+
+
+// welchPSD
+// Estimates the power spectral density of x with Welch's method. The signal
+// is split into segments of the plan size that overlap by the given amount,
+// each is windowed and transformed, and the squared magnitudes are averaged.
+// The result is scaled so it sums to the mean square of the windowed signal
+// (one-sided, with the bins other than DC and Nyquist doubled), per bin.
+// @param plan - the real transform plan, its size is the segment length.
+// @param x - the input signal.
+// @param n - the number of input samples.
+// @param window - the window of length plan size, NULL for rectangular.
+// @param overlap - the number of samples segments overlap by.
+// @param psd - the output, plan size / 2 + 1 bins.
+//
+// @return - the number of segments averaged, 0 on failure.
+template <class T>
+size_t welchPSD(RealFFTPlan<T> &plan, const T *x, size_t n, const double *window,
+                uint32_t overlap, T *psd);
+
+
+#include "FFT.hpp"
+
+#endif
@@ -0,0 +1,577 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FFT.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FFT.h
+//
+// A dependency free fast fourier transform.
+// The implementation file.
+//
+// The transform is a decimation in time FFT. The input is put in digit
+// reversed order, then each stage combines radix sub transforms of length
+// span into one of length span * radix:
+//   a_q = data[j + q * span] * W_L^(j q),  L = span * radix
+//   data[j + p * span] = sum_q a_q e^(-2 pi i p q / radix)
+//
+// Bluestein's algorithm writes the transform as a convolution, with
+// n k = (n^2 + k^2 - (k - n)^2) / 2:
+//   X[k] = c[k] sum_n (x[n] c[n]) conj(c[k - n]),  c[n] = e^(-pi i n^2 / N)
+// which is done with power of 2 transforms of size M >= 2N - 1.
+
+#ifndef __FFT_IMPL__
+#define __FFT_IMPL__
+
+#include "FFT.h"
+#include <cmath>
+
+// Constructor
+// Builds the twiddle and reversal tables for a transform of size N.
+// @param N - the size of the transform.
+template <class T>
+FFTPlan<T>::FFTPlan(uint32_t N)
+{
+    size = (N > 0) ? N : 1;
+
+    // factor the size, largest radix first.
+    std::vector<uint32_t> radices;
+    uint32_t rem = size;
+    while (rem % 4 == 0) { radices.push_back(4); rem /= 4; }
+    while (rem % 2 == 0) { radices.push_back(2); rem /= 2; }
+    for (uint32_t p = 3; rem > 1; p += 2) {
+        // anything left when p * p > rem is a prime.
+        if (p * p > rem) { p = rem; }
+        while (rem % p == 0) { radices.push_back(p); rem /= p; }
+    }
+
+    // a large prime factor would be an O(N p) stage, so use Bluestein's
+    // algorithm instead. The primes are found in increasing order.
+    if (!radices.empty() && radices.back() > FFT_STACK_RADIX) {
+        uint32_t M = 1;
+        while (M < 2 * (uint64_t)size - 1) { M *= 2; }
+        chirp.resize(size);
+        for (uint32_t n = 0; n < size; n++) {
+            // n^2 mod 2N keeps the angle exact for large n.
+            double angle = -M_PI * (double)((uint64_t)n * n % (2 * (uint64_t)size)) / size;
+            chirp[n] = std::complex<T>((T)cos(angle), (T)sin(angle));
+        }
+        // conj(c[m]) for m in (-N, N), wrapped around M.
+        std::vector<std::complex<T> > filter(M, std::complex<T>(0, 0));
+        for (uint32_t n = 0; n < size; n++) {
+            filter[n] = std::conj(chirp[n]);
+            if (n > 0) { filter[M - n] = filter[n]; }
+        }
+        chirpPlan = std::make_shared<const FFTPlan<T> >(M);
+        chirpFilter.resize(M);
+        chirpPlan->forward(&filter[0], &chirpFilter[0]);
+        for (uint32_t k = 0; k < M; k++) { chirpFilter[k] /= (T)M; }
+        return;
+    }
+
+    // twiddles for each stage, computed in double then rounded to T.
+    bool needRoots = false;
+    uint32_t span = 1;
+    for (size_t s = 0; s < radices.size(); s++) {
+        Stage stage;
+        stage.radix = radices[s];
+        stage.span = span;
+        stage.twiddleOffset = twiddles.size();
+        uint32_t L = span * stage.radix;
+        for (uint32_t q = 1; q < stage.radix; q++) {
+            for (uint32_t j = 0; j < span; j++) {
+                double angle = -2.0 * M_PI * (double)((uint64_t)j * q % L) / L;
+                twiddles.push_back(std::complex<T>((T)cos(angle), (T)sin(angle)));
+            }
+        }
+        if (stage.radix > 5) { needRoots = true; }
+        stages.push_back(stage);
+        span = L;
+    }
+
+    if (needRoots) {
+        roots.resize(size);
+        for (uint32_t k = 0; k < size; k++) {
+            double angle = -2.0 * M_PI * k / size;
+            roots[k] = std::complex<T>((T)cos(angle), (T)sin(angle));
+        }
+    }
+
+    // digit reversal, position = q * span + t of the last stage holds the
+    // sub transform q, which is made from inputs q, q + radix, ...
+    reversal.resize(size);
+    for (uint32_t pos = 0; pos < size; pos++) {
+        uint32_t idx = 0;
+        uint32_t mult = 1;
+        uint32_t r = pos;
+        uint32_t len = size;
+        for (size_t s = stages.size(); s > 0; s--) {
+            uint32_t radix = stages[s - 1].radix;
+            uint32_t subLen = len / radix;
+            idx += (r / subLen) * mult;
+            mult *= radix;
+            r %= subLen;
+            len = subLen;
+        }
+        reversal[pos] = idx;
+    }
+} // end constructor
+
+
+// forward
+// Computes the forward transform of input into output.
+// input and output must not be the same array.
+// @param input - N complex inputs.
+// @param output - N complex outputs.
+template <class T>
+void FFTPlan<T>::forward(const std::complex<T> *input, std::complex<T> *output) const
+{
+    transform(input, output, false);
+}
+
+// inverse
+// Computes the inverse transform of input into output, without scaling by 1/N.
+// input and output must not be the same array.
+// @param input - N complex inputs.
+// @param output - N complex outputs.
+template <class T>
+void FFTPlan<T>::inverse(const std::complex<T> *input, std::complex<T> *output) const
+{
+    transform(input, output, true);
+}
+
+
+// transform
+// reorders the input into the output, then runs each stage in place.
+template <class T>
+void FFTPlan<T>::transform(const std::complex<T> *input, std::complex<T> *output,
+                        bool inverse) const
+{
+    if (chirpPlan) {
+        bluestein(input, output, inverse);
+        return;
+    }
+    for (uint32_t i = 0; i < size; i++) { output[i] = input[reversal[i]]; }
+
+    for (size_t s = 0; s < stages.size(); s++) {
+        const Stage &stage = stages[s];
+        if (stage.radix == 4) { radix4(output, stage, inverse); }
+        else if (stage.radix == 2) { radix2(output, stage, inverse); }
+        else if (stage.radix == 3) { radix3(output, stage, inverse); }
+        else if (stage.radix == 5) { radix5(output, stage, inverse); }
+        else { radixN(output, stage, inverse); }
+    }
+} // end transform
+
+
+// bluestein
+// the transform as a convolution with the chirp, for sizes with a large
+// prime factor. The inverse is conj(forward(conj(x))).
+template <class T>
+void FFTPlan<T>::bluestein(const std::complex<T> *input, std::complex<T> *output,
+                        bool inverse) const
+{
+    uint32_t M = chirpPlan->getSize();
+    std::vector<std::complex<T> > a(M, std::complex<T>(0, 0));
+    std::vector<std::complex<T> > A(M);
+    for (uint32_t n = 0; n < size; n++) {
+        a[n] = (inverse ? std::conj(input[n]) : input[n]) * chirp[n];
+    }
+    chirpPlan->forward(&a[0], &A[0]);
+    for (uint32_t k = 0; k < M; k++) { A[k] *= chirpFilter[k]; }
+    chirpPlan->inverse(&A[0], &a[0]);
+    for (uint32_t k = 0; k < size; k++) {
+        std::complex<T> y = a[k] * chirp[k];
+        output[k] = inverse ? std::conj(y) : y;
+    }
+} // end bluestein
+
+
+// radix2
+// a stage of radix 2 butterflies.
+template <class T>
+void FFTPlan<T>::radix2(std::complex<T> *data, const Stage &stage, bool inverse) const
+{
+    T *d = reinterpret_cast<T *>(data);
+    const T *w = reinterpret_cast<const T *>(&twiddles[stage.twiddleOffset]);
+    T sign = inverse ? -1 : 1; // inverse uses the conjugate twiddles.
+    uint32_t span = stage.span;
+
+    for (uint32_t g = 0; g < size; g += 2 * span) {
+        T *a = d + 2 * g;
+        T *b = a + 2 * span;
+        for (uint32_t j = 0; j < span; j++) {
+            T wr = w[2 * j];
+            T wi = sign * w[2 * j + 1];
+            T br = b[2 * j] * wr - b[2 * j + 1] * wi;
+            T bi = b[2 * j] * wi + b[2 * j + 1] * wr;
+            T ar = a[2 * j];
+            T ai = a[2 * j + 1];
+            a[2 * j] = ar + br;
+            a[2 * j + 1] = ai + bi;
+            b[2 * j] = ar - br;
+            b[2 * j + 1] = ai - bi;
+        }
+    }
+} // end radix2
+
+
+// radix3
+// a stage of radix 3 butterflies.
+template <class T>
+void FFTPlan<T>::radix3(std::complex<T> *data, const Stage &stage, bool inverse) const
+{
+    T *d = reinterpret_cast<T *>(data);
+    uint32_t span = stage.span;
+    const T *w1 = reinterpret_cast<const T *>(&twiddles[stage.twiddleOffset]);
+    const T *w2 = w1 + 2 * span;
+    T sign = inverse ? -1 : 1;
+    const T s3 = (T)0.86602540378443864676; // sin(2 pi / 3)
+
+    for (uint32_t g = 0; g < size; g += 3 * span) {
+        T *a0 = d + 2 * g;
+        T *a1 = a0 + 2 * span;
+        T *a2 = a1 + 2 * span;
+        for (uint32_t j = 0; j < span; j++) {
+            T x0r = a0[2 * j], x0i = a0[2 * j + 1];
+            T wr = w1[2 * j], wi = sign * w1[2 * j + 1];
+            T x1r = a1[2 * j] * wr - a1[2 * j + 1] * wi;
+            T x1i = a1[2 * j] * wi + a1[2 * j + 1] * wr;
+            wr = w2[2 * j]; wi = sign * w2[2 * j + 1];
+            T x2r = a2[2 * j] * wr - a2[2 * j + 1] * wi;
+            T x2i = a2[2 * j] * wi + a2[2 * j + 1] * wr;
+
+            T t1r = x1r + x2r, t1i = x1i + x2i;
+            T t2r = x0r - t1r / 2, t2i = x0i - t1i / 2;
+            // t3 = -i sin(2 pi / 3) (x1 - x2) forward, +i inverse.
+            T t3r = sign * s3 * (x1i - x2i), t3i = -sign * s3 * (x1r - x2r);
+
+            a0[2 * j] = x0r + t1r;
+            a0[2 * j + 1] = x0i + t1i;
+            a1[2 * j] = t2r + t3r;
+            a1[2 * j + 1] = t2i + t3i;
+            a2[2 * j] = t2r - t3r;
+            a2[2 * j + 1] = t2i - t3i;
+        }
+    }
+} // end radix3
+
+
+// radix4
+// a stage of radix 4 butterflies.
+template <class T>
+void FFTPlan<T>::radix4(std::complex<T> *data, const Stage &stage, bool inverse) const
+{
+    T *d = reinterpret_cast<T *>(data);
+    uint32_t span = stage.span;
+    const T *w1 = reinterpret_cast<const T *>(&twiddles[stage.twiddleOffset]);
+    const T *w2 = w1 + 2 * span;
+    const T *w3 = w2 + 2 * span;
+    T sign = inverse ? -1 : 1;
+
+    for (uint32_t g = 0; g < size; g += 4 * span) {
+        T *a0 = d + 2 * g;
+        T *a1 = a0 + 2 * span;
+        T *a2 = a1 + 2 * span;
+        T *a3 = a2 + 2 * span;
+        for (uint32_t j = 0; j < span; j++) {
+            T x0r = a0[2 * j], x0i = a0[2 * j + 1];
+            T wr = w1[2 * j], wi = sign * w1[2 * j + 1];
+            T x1r = a1[2 * j] * wr - a1[2 * j + 1] * wi;
+            T x1i = a1[2 * j] * wi + a1[2 * j + 1] * wr;
+            wr = w2[2 * j]; wi = sign * w2[2 * j + 1];
+            T x2r = a2[2 * j] * wr - a2[2 * j + 1] * wi;
+            T x2i = a2[2 * j] * wi + a2[2 * j + 1] * wr;
+            wr = w3[2 * j]; wi = sign * w3[2 * j + 1];
+            T x3r = a3[2 * j] * wr - a3[2 * j + 1] * wi;
+            T x3i = a3[2 * j] * wi + a3[2 * j + 1] * wr;
+
+            T t0r = x0r + x2r, t0i = x0i + x2i;
+            T t1r = x0r - x2r, t1i = x0i - x2i;
+            T t2r = x1r + x3r, t2i = x1i + x3i;
+            // t3 = -i (x1 - x3) forward, +i (x1 - x3) inverse.
+            T t3r = sign * (x1i - x3i), t3i = -sign * (x1r - x3r);
+
+            a0[2 * j] = t0r + t2r;
+            a0[2 * j + 1] = t0i + t2i;
+            a2[2 * j] = t0r - t2r;
+            a2[2 * j + 1] = t0i - t2i;
+            a1[2 * j] = t1r + t3r;
+            a1[2 * j + 1] = t1i + t3i;
+            a3[2 * j] = t1r - t3r;
+            a3[2 * j + 1] = t1i - t3i;
+        }
+    }
+} // end radix4
+
+
+// radix5
+// a stage of radix 5 butterflies.
+template <class T>
+void FFTPlan<T>::radix5(std::complex<T> *data, const Stage &stage, bool inverse) const
+{
+    T *d = reinterpret_cast<T *>(data);
+    uint32_t span = stage.span;
+    const T *w1 = reinterpret_cast<const T *>(&twiddles[stage.twiddleOffset]);
+    const T *w2 = w1 + 2 * span;
+    const T *w3 = w2 + 2 * span;
+    const T *w4 = w3 + 2 * span;
+    T sign = inverse ? -1 : 1;
+    const T c1 = (T)0.30901699437494742410;  // cos(2 pi / 5)
+    const T c2 = (T)-0.80901699437494742410; // cos(4 pi / 5)
+    const T s1 = (T)0.95105651629515357212;  // sin(2 pi / 5)
+    const T s2 = (T)0.58778525229247312917;  // sin(4 pi / 5)
+
+    for (uint32_t g = 0; g < size; g += 5 * span) {
+        T *a0 = d + 2 * g;
+        T *a1 = a0 + 2 * span;
+        T *a2 = a1 + 2 * span;
+        T *a3 = a2 + 2 * span;
+        T *a4 = a3 + 2 * span;
+        for (uint32_t j = 0; j < span; j++) {
+            T x0r = a0[2 * j], x0i = a0[2 * j + 1];
+            T wr = w1[2 * j], wi = sign * w1[2 * j + 1];
+            T x1r = a1[2 * j] * wr - a1[2 * j + 1] * wi;
+            T x1i = a1[2 * j] * wi + a1[2 * j + 1] * wr;
+            wr = w2[2 * j]; wi = sign * w2[2 * j + 1];
+            T x2r = a2[2 * j] * wr - a2[2 * j + 1] * wi;
+            T x2i = a2[2 * j] * wi + a2[2 * j + 1] * wr;
+            wr = w3[2 * j]; wi = sign * w3[2 * j + 1];
+            T x3r = a3[2 * j] * wr - a3[2 * j + 1] * wi;
+            T x3i = a3[2 * j] * wi + a3[2 * j + 1] * wr;
+            wr = w4[2 * j]; wi = sign * w4[2 * j + 1];
+            T x4r = a4[2 * j] * wr - a4[2 * j + 1] * wi;
+            T x4i = a4[2 * j] * wi + a4[2 * j + 1] * wr;
+
+            T p1r = x1r + x4r, p1i = x1i + x4i;
+            T m1r = x1r - x4r, m1i = x1i - x4i;
+            T p2r = x2r + x3r, p2i = x2i + x3i;
+            T m2r = x2r - x3r, m2i = x2i - x3i;
+            // the real parts of outputs 1, 4 and of 2, 3.
+            T e1r = x0r + c1 * p1r + c2 * p2r, e1i = x0i + c1 * p1i + c2 * p2i;
+            T e2r = x0r + c2 * p1r + c1 * p2r, e2i = x0i + c2 * p1i + c1 * p2i;
+            // o = -i (s m) forward, +i inverse.
+            T o1r = sign * (s1 * m1i + s2 * m2i), o1i = -sign * (s1 * m1r + s2 * m2r);
+            T o2r = sign * (s2 * m1i - s1 * m2i), o2i = -sign * (s2 * m1r - s1 * m2r);
+
+            a0[2 * j] = x0r + p1r + p2r;
+            a0[2 * j + 1] = x0i + p1i + p2i;
+            a1[2 * j] = e1r + o1r;
+            a1[2 * j + 1] = e1i + o1i;
+            a4[2 * j] = e1r - o1r;
+            a4[2 * j + 1] = e1i - o1i;
+            a2[2 * j] = e2r + o2r;
+            a2[2 * j + 1] = e2i + o2i;
+            a3[2 * j] = e2r - o2r;
+            a3[2 * j + 1] = e2i - o2i;
+        }
+    }
+} // end radix5
+
+
+// radixN
+// a stage of butterflies of any other prime radix up to FFT_STACK_RADIX,
+// using an O(radix^2) DFT.
+template <class T>
+void FFTPlan<T>::radixN(std::complex<T> *data, const Stage &stage, bool inverse) const
+{
+    T *d = reinterpret_cast<T *>(data);
+    uint32_t span = stage.span;
+    uint32_t radix = stage.radix;
+    uint32_t rootStep = size / radix;
+    const T *w = reinterpret_cast<const T *>(&twiddles[stage.twiddleOffset]);
+    const T *root = reinterpret_cast<const T *>(&roots[0]);
+    T sign = inverse ? -1 : 1;
+
+    // larger primes use Bluestein's algorithm, so these fit on the stack.
+    T ar[FFT_STACK_RADIX], ai[FFT_STACK_RADIX];
+    for (uint32_t g = 0; g < size; g += radix * span) {
+        T *base = d + 2 * g;
+        for (uint32_t j = 0; j < span; j++) {
+            ar[0] = base[2 * j];
+            ai[0] = base[2 * j + 1];
+            for (uint32_t q = 1; q < radix; q++) {
+                const T *x = base + 2 * (j + q * span);
+                T wr = w[2 * ((q - 1) * span + j)];
+                T wi = sign * w[2 * ((q - 1) * span + j) + 1];
+                ar[q] = x[0] * wr - x[1] * wi;
+                ai[q] = x[0] * wi + x[1] * wr;
+            }
+            for (uint32_t p = 0; p < radix; p++) {
+                T sr = 0, si = 0;
+                // k = p q mod radix, stepped without a divide.
+                uint32_t k = 0;
+                for (uint32_t q = 0; q < radix; q++) {
+                    T rr = root[2 * k * rootStep];
+                    T ri = sign * root[2 * k * rootStep + 1];
+                    sr += ar[q] * rr - ai[q] * ri;
+                    si += ar[q] * ri + ai[q] * rr;
+                    k += p;
+                    if (k >= radix) { k -= radix; }
+                }
+                base[2 * (j + p * span)] = sr;
+                base[2 * (j + p * span) + 1] = si;
+            }
+        }
+    }
+} // end radixN
+
+
+// Constructor
+// Builds the tables for a real transform of size N.
+// N must be even, an odd (or 0) N gives a plan of size 0, whose
+// transforms do nothing.
+// @param N - the size of the transform.
+template <class T>
+RealFFTPlan<T>::RealFFTPlan(uint32_t N) : size((N % 2 == 0) ? N : 0), half(size / 2)
+{
+    if (size == 0) { return; }
+    uint32_t M = size / 2;
+    twiddles.resize(M + 1);
+    for (uint32_t k = 0; k <= M; k++) {
+        double angle = -2.0 * M_PI * k / size;
+        twiddles[k] = std::complex<T>((T)cos(angle), (T)sin(angle));
+    }
+    scratchIn.resize(M);
+    scratchOut.resize(M);
+} // end constructor
+
+
+// forward
+// Computes the transform of N real inputs, giving the N / 2 + 1
+// non-negative frequency bins.
+// @param input - N real inputs.
+// @param output - N / 2 + 1 complex outputs.
+template <class T>
+void RealFFTPlan<T>::forward(const T *input, std::complex<T> *output)
+{
+    if (size == 0) { return; }
+    uint32_t M = size / 2;
+    // pack even samples as real, odd samples as imaginary.
+    for (uint32_t k = 0; k < M; k++) {
+        scratchIn[k] = std::complex<T>(input[2 * k], input[2 * k + 1]);
+    }
+    half.forward(&scratchIn[0], &scratchOut[0]);
+
+    // split into the transforms of the even and odd samples:
+    // E[k] = (Z[k] + conj(Z[M-k])) / 2, O[k] = (Z[k] - conj(Z[M-k])) / 2i
+    // X[k] = E[k] + W^k O[k]
+    const T *z = reinterpret_cast<const T *>(&scratchOut[0]);
+    const T *w = reinterpret_cast<const T *>(&twiddles[0]);
+    T *x = reinterpret_cast<T *>(output);
+    for (uint32_t k = 0; k <= M; k++) {
+        uint32_t a = (k == M) ? 0 : k;
+        uint32_t b = (k == 0) ? 0 : M - k;
+        T zr = z[2 * a], zi = z[2 * a + 1];
+        T cr = z[2 * b], ci = -z[2 * b + 1];
+        T er = (zr + cr) / 2, ei = (zi + ci) / 2;
+        // (Z - conj(Z')) / 2i
+        T or_ = (zi - ci) / 2, oi = -(zr - cr) / 2;
+        T wr = w[2 * k], wi = w[2 * k + 1];
+        x[2 * k] = er + (or_ * wr - oi * wi);
+        x[2 * k + 1] = ei + (or_ * wi + oi * wr);
+    }
+} // end forward
+
+
+// inverse
+// Computes N real outputs from N / 2 + 1 frequency bins, without scaling by 1/N.
+// @param input - N / 2 + 1 complex inputs.
+// @param output - N real outputs.
+template <class T>
+void RealFFTPlan<T>::inverse(const std::complex<T> *input, T *output)
+{
+    if (size == 0) { return; }
+    uint32_t M = size / 2;
+    // Z[k] = (X[k] + conj(X[M-k])) + i conj(W^k) (X[k] - conj(X[M-k]))
+    const T *x = reinterpret_cast<const T *>(input);
+    const T *w = reinterpret_cast<const T *>(&twiddles[0]);
+    T *z = reinterpret_cast<T *>(&scratchIn[0]);
+    for (uint32_t k = 0; k < M; k++) {
+        T xr = x[2 * k], xi = x[2 * k + 1];
+        T cr = x[2 * (M - k)], ci = -x[2 * (M - k) + 1];
+        T dr = xr - cr, di = xi - ci;
+        // multiply by conj(W^k), then by i.
+        T wr = w[2 * k], wi = -w[2 * k + 1];
+        T pr = dr * wr - di * wi, pi = dr * wi + di * wr;
+        z[2 * k] = (xr + cr) - pi;
+        z[2 * k + 1] = (xi + ci) + pr;
+    }
+    half.inverse(&scratchIn[0], &scratchOut[0]);
+
+    for (uint32_t k = 0; k < M; k++) {
+        output[2 * k] = scratchOut[k].real();
+        output[2 * k + 1] = scratchOut[k].imag();
+    }
+} // end inverse
+
+
+// welchPSD
+// Estimates the power spectral density of x with Welch's method. The signal
+// is split into segments of the plan size that overlap by the given amount,
+// each is windowed and transformed, and the squared magnitudes are averaged.
+// The result is scaled so it sums to the mean square of the windowed signal
+// (one-sided, with the bins other than DC and Nyquist doubled), per bin.
+// @param plan - the real transform plan, its size is the segment length.
+// @param x - the input signal.
+// @param n - the number of input samples.
+// @param window - the window of length plan size, NULL for rectangular.
+// @param overlap - the number of samples segments overlap by.
+// @param psd - the output, plan size / 2 + 1 bins.
+//
+// @return - the number of segments averaged, 0 on failure.
+template <class T>
+size_t welchPSD(RealFFTPlan<T> &plan, const T *x, size_t n, const double *window,
+                uint32_t overlap, T *psd)
+{
+    uint32_t N = plan.getSize();
+    uint32_t M = N / 2;
+    if (x == NULL || psd == NULL || N == 0 || overlap >= N || n < N) { return 0; }
+
+    double windowPower = 0;
+    for (uint32_t i = 0; i < N; i++) {
+        windowPower += window ? window[i] * window[i] : 1.0;
+    }
+
+    std::vector<T> segment(N);
+    std::vector<std::complex<T> > spectrum(M + 1);
+    std::vector<double> sum(M + 1, 0.0);
+
+    size_t count = 0;
+    for (size_t start = 0; start + N <= n; start += N - overlap) {
+        for (uint32_t i = 0; i < N; i++) {
+            segment[i] = window ? (T)(x[start + i] * window[i]) : x[start + i];
+        }
+        plan.forward(&segment[0], &spectrum[0]);
+        for (uint32_t k = 0; k <= M; k++) { sum[k] += std::norm(spectrum[k]); }
+        count++;
+    }
+
+    double scale = 1.0 / ((double)count * N * windowPower);
+    for (uint32_t k = 0; k <= M; k++) {
+        double p = sum[k] * scale;
+        if (k != 0 && k != M) { p *= 2; }
+        psd[k] = (T)p;
+    }
+    return count;
+} // end welchPSD
+
+
+#endif
@@ -27,20 +27,35 @@
 // This is the class for all Infinte Impulse Response filters.
 // implemented using 2 circular buffers.
 //
+// The template takes the sample type, the coefficient type and the
+// accumulator type, where the last two default to the sample type.
+// Each product is computed in the accumulator type and the result is cast
+// back to the sample type, so int16 samples with float coefficients are
+// truncated towards zero.
+// Integer outputs saturate at the limits of the type instead of wrapping.
+// e.g. FIRFilter<int16_t, float, float>, or FIRFilter<float, BFloat16, float>
+// to halve the memory read for the gains.
+//
 
 #ifndef __FIR_FILTER__
 #define __FIR_FILTER__
 
 #include "Filter.h"
+#include "FilterInstrumentation.h"
 #include <cstdint>
 #include <iostream>
+#include <memory>
+#include <vector>
+
+// the shared taps, see CoefficientBank.h.
+template <class C> class CoefficientSet;
 
 
 
 
 
-template <class T>
-class FIRFilter: public Filter<T> {
+template <class SampleT, class CoefT = SampleT, class AccT = SampleT>
+class FIRFilter: public Filter<SampleT> {
 public:
     // Constructor
     // Give it your FIR coefficients as an array, and length of the array.
@@ -49,9 +64,14 @@ public:
     //
     // @param coefficients - the FIR coefficients for the filter.
     // @param length - the length of the filter. -1 for unknown.
-    FIRFilter(T *coefficients, uint16_t length);
+    FIRFilter(CoefT *coefficients, uint32_t length);
     FIRFilter();
 
+    // Constructor
+    // Uses a shared set of coefficients, see setGains.
+    // @param coefficients - the shared taps.
+    FIRFilter(std::shared_ptr<const CoefficientSet<CoefT> > coefficients);
+
     // update
     // The main function of all filter subclasses, is
     // the filter function, which given the next input to the
@@ -59,14 +79,52 @@ public:
     // @param x - the input to the filter.
     //
     // @return - output of filter, if there is an error NaN.
-    T filter(T x);
+    SampleT filter(SampleT x);
 
     // getOutput
     // This function simply gets the last output of the filter, without changing
     // internal state of the filter.
     //
     // @return - last output of filter, if there is an error NaN.
-    T getOutput();
+    SampleT getOutput();
+
+    // filterBlock
+    // Filters a block of n inputs. The output is identical to calling
+    // filter on each input in order, but the convolution is done over
+    // the input array directly instead of the circular buffer. May be done
+    // in place (output == input), other overlaps aren't supported.
+    // @param input - the array of inputs to the filter.
+    // @param output - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const SampleT *input, SampleT *output, size_t n);
+
+    // convolveRange
+    // Computes outputs [start, end) of the block input, without changing
+    // the internal state of the filter. Samples before input[0] are read from
+    // the filter's delay line. This is safe to call from multiple threads
+    // on different ranges of the same block. Outputs are computed last to
+    // first, so output can be input when one call covers the whole block.
+    // @param input - the array of inputs to the filter.
+    // @param output - the array to write outputs to, indexed the same as input.
+    // @param start - the first output index to compute.
+    // @param end - one past the last output index to compute.
+    void convolveRange(const SampleT *input, SampleT *output,
+                    size_t start, size_t end) const;
+
+    // advance
+    // Moves the filter state forward over n inputs, without computing
+    // the outputs for them. The state and getOutput afterwards are the same
+    // as if filter had been called on each input.
+    // @param input - the array of inputs to the filter.
+    // @param n - the number of samples in the block.
+    void advance(const SampleT *input, size_t n);
+
+    // setSteadyState
+    // Sets the delay line to the state the filter would be in after
+    // seeing the input x forever. reset() is the same as setSteadyState(0).
+    // @param x - the constant input to settle the filter to.
+    void setSteadyState(SampleT x);
+    void reset() { setSteadyState(0.0); }
 
 
     // setGains
@@ -75,25 +133,74 @@ public:
     //
     // @param coefficients - the coefficients used in the filter.
     // @param length - the length of the filter.
-    void setGains(T *coefficients, uint16_t length);
+    void setGains(CoefT *coefficients, uint32_t length);
+
+    // setGains
+    // Uses a shared, read only set of coefficients. The filter holds a
+    // reference to the set, so the taps stay valid as long as the filter
+    // uses them. Don't write to the taps through getGains.
+    // @param coefficients - the shared taps, from a CoefficientBank.
+    //
+    // @return - 0 for success, else failure (NULL or too many taps).
+    int setGains(std::shared_ptr<const CoefficientSet<CoefT> > coefficients);
 
     // getGains
     // This will return the array of the gains.
     // You will be free to change the set of gains. (Don't abuse this!)
     //
     // @return - the gains as a single array.
-    T *getGains() {  return gains; }
+    CoefT *getGains() {  return gains; }
 
     // getLength
     // returns the order of the FIR filter.
-    uint16_t getLength() const { return length; }
+    uint32_t getLength() const { return length; }
+
+    // getDelayLine
+    // returns the circular buffer of the last length inputs, for saving the
+    // state of the filter. See FilterSnapshot.h.
+    const SampleT *getDelayLine() const { return buffer.data(); }
+
+    // getDelayPosition
+    // returns the position in the delay line the next input goes to.
+    uint32_t getDelayPosition() const { return curBufLoc; }
+
+    // setState
+    // Restores a state saved from getDelayLine, getDelayPosition and
+    // getOutput of a filter with the same length.
+    // @param delayLine - length samples.
+    // @param position - the position of the next input.
+    // @param out - the last output.
+    //
+    // @return - 0 for success, else failure.
+    int setState(const SampleT *delayLine, uint32_t position, SampleT out);
+
+#ifdef DSP_LITE_INSTRUMENT
+    // getStats
+    // returns the instrumentation counters of this filter.
+    // These can be read from any thread.
+    const FilterStats &getStats() const { return stats; }
+    FilterStats &getStats() { return stats; }
+#endif
 
 private:
-    T *buffer;
-    T *gains;
-    uint16_t curBufLoc;
-    uint16_t length;
-    T output;
+    // step
+    // filter, probing only the accumulator.
+    SampleT step(SampleT x);
+    // accumulate
+    // places x in the delay line and returns the unconverted output,
+    // without any instrumentation probes.
+    AccT accumulate(SampleT x);
+
+#ifdef DSP_LITE_INSTRUMENT
+    mutable FilterStats stats; // convolveRange counts saturated outputs.
+#endif
+    std::vector<SampleT> buffer; // circular delay line of the last length inputs.
+    CoefT *gains;
+    std::shared_ptr<const CoefficientSet<CoefT> > shared; // owner of gains, if shared.
+    std::vector<SampleT> saved; // last inputs of a block, for filterBlock in place.
+    uint32_t curBufLoc;
+    uint32_t length;
+    SampleT output;
 };
 
 // include "Implementation file
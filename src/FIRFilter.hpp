@@ -40,8 +40,8 @@
 //
 // @param coefficients - the FIR coefficients for the filter.
 // @param length - the length of the filter. -1 for unknown.
-template <typename T>
-FIRFilter<T>::FIRFilter()
+template <typename SampleT, typename CoefT, typename AccT>
+FIRFilter<SampleT, CoefT, AccT>::FIRFilter()
 {
     length = -1; // set default to not got strange results.
     setGains(NULL, -1);
@@ -55,14 +55,26 @@ FIRFilter<T>::FIRFilter()
 //
 // @param coefficients - the FIR coefficients for the filter.
 // @param length - the length of the filter. -1 for unknown.
-template <typename T>
-FIRFilter<T>::FIRFilter(T *coefficients, uint16_t Length)
+template <typename SampleT, typename CoefT, typename AccT>
+FIRFilter<SampleT, CoefT, AccT>::FIRFilter(CoefT *coefficients, uint32_t Length)
 {
     length = -1; // set default to not got strange results.
     setGains(coefficients, Length);
     curBufLoc = 0;
 } // end constructor
 
+// Constructor
+// Uses a shared set of coefficients, see setGains.
+// @param coefficients - the shared taps.
+template <typename SampleT, typename CoefT, typename AccT>
+FIRFilter<SampleT, CoefT, AccT>::FIRFilter(
+                        std::shared_ptr<const CoefficientSet<CoefT> > coefficients)
+{
+    length = -1; // set default to not got strange results.
+    if (setGains(coefficients) != 0) { setGains(NULL, -1); }
+    curBufLoc = 0;
+} // end constructor
+
 
 // setGains
 // set gains lets you reset the current gains to any FIR
@@ -70,17 +82,39 @@ FIRFilter<T>::FIRFilter(T *coefficients, uint16_t Length)
 //
 // @param coefficients - the coefficients used in the filter.
 // @param length - the length of the filter.
-template <typename T>
-void FIRFilter<T>::setGains(T *coefficients, uint16_t Length)
+template <typename SampleT, typename CoefT, typename AccT>
+void FIRFilter<SampleT, CoefT, AccT>::setGains(CoefT *coefficients, uint32_t Length)
 {
     if (Length != length && Length > 0) {
         // reallocate correct size buffer
-        buffer = new T[Length];
-        for (uint16_t i = 0; i < Length; i++) { buffer[i] = 0.0; }
+        buffer.assign(Length, (SampleT)0.0);
     }
 
     length = Length;
     gains = coefficients;
+    shared.reset();
+}
+
+// setGains
+// Uses a shared, read only set of coefficients. The filter holds a
+// reference to the set, so the taps stay valid as long as the filter
+// uses them.
+// @param coefficients - the shared taps, from a CoefficientBank.
+//
+// @return - 0 for success, else failure (NULL or too many taps).
+template <typename SampleT, typename CoefT, typename AccT>
+int FIRFilter<SampleT, CoefT, AccT>::setGains(
+                        std::shared_ptr<const CoefficientSet<CoefT> > coefficients)
+{
+    if (!coefficients || coefficients->getLength() == 0 ||
+            coefficients->getLength() >= UINT32_MAX) {
+        return -1;
+    }
+    // the filter never writes to its gains, so they can be read only.
+    setGains(const_cast<CoefT *>(coefficients->getData()),
+            (uint32_t)coefficients->getLength());
+    shared = coefficients;
+    return 0;
 }
 
 
@@ -91,37 +125,200 @@ void FIRFilter<T>::setGains(T *coefficients, uint16_t Length)
 // @param x - the input to the filter.
 //
 // @return - output of filter, if there is an error NaN.
-template <typename T>
-T FIRFilter<T>::filter(T x)
+template <typename SampleT, typename CoefT, typename AccT>
+SampleT FIRFilter<SampleT, CoefT, AccT>::filter(SampleT x)
+{
+    FILTER_PROBE_START();
+    SampleT y = step(x);
+    FILTER_PROBE_END(stats, 1);
+    FILTER_PROBE_OUTPUT(stats, y);
+    return y;
+} // end filter function
+
+// step
+// filter, probing only the accumulator.
+template <typename SampleT, typename CoefT, typename AccT>
+SampleT FIRFilter<SampleT, CoefT, AccT>::step(SampleT x)
+{
+    AccT acc = accumulate(x);
+    FILTER_PROBE_ACC(stats, SampleT, acc);
+    output = saturateOutput<SampleT>(acc);
+    return output;
+} // end step function
+
+// accumulate
+// places x in the delay line and returns the unconverted output,
+// without any instrumentation probes.
+template <typename SampleT, typename CoefT, typename AccT>
+AccT FIRFilter<SampleT, CoefT, AccT>::accumulate(SampleT x)
 {
     // place into current buffer location.
     buffer[curBufLoc] = x;
 
-    output = 0.0;
+    AccT acc = 0.0;
     // perform convolutional step.
-    for (uint16_t i = 0; i < length; i++) {
+    for (uint32_t i = 0; i < length; i++) {
         // have circular buffer wrap around on itself, pull out
         // current gain.
-        output += buffer[(i + curBufLoc) % length] * gains[i];
+        acc += (AccT)buffer[(i + curBufLoc) % length] * (AccT)gains[i];
     }
     // update buffer location for next iteration.
     if (curBufLoc == 0) { curBufLoc = length; }
     curBufLoc--;
 
-    return output;
-} // end filter function
+    return acc;
+} // end accumulate function
 
 // getOutput
 // This function simply gets the last output of the filter, without changing
 // internal state of the filter.
 //
 // @return - last output of filter, if there is an error NaN.
-template <typename T>
-T FIRFilter<T>::getOutput()
+template <typename SampleT, typename CoefT, typename AccT>
+SampleT FIRFilter<SampleT, CoefT, AccT>::getOutput()
 {
     return output;
 } // end getOutput function.
 
 
+// filterBlock
+// Filters a block of n inputs. The output is identical to calling
+// filter on each input in order, but the convolution is done over
+// the input array directly instead of the circular buffer. May be done
+// in place (output == input).
+// @param input - the array of inputs to the filter.
+// @param output - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <typename SampleT, typename CoefT, typename AccT>
+void FIRFilter<SampleT, CoefT, AccT>::filterBlock(const SampleT *input, SampleT *output,
+                                                size_t n)
+{
+    if (n == 0) { return; }
+    FILTER_PROBE_START();
+    // the delay line afterwards only needs the last length inputs, kept
+    // before they can be overwritten by outputs.
+    size_t keep = (n < length) ? n : length;
+    saved.assign(input + n - keep, input + n);
+    convolveRange(input, output, 0, n);
+    advance(&saved[0], keep);
+    FILTER_PROBE_END(stats, n);
+#ifdef DSP_LITE_INSTRUMENT
+    for (size_t i = 0; i < n; i++) { FILTER_PROBE_OUTPUT(stats, output[i]); }
+#endif
+} // end filterBlock
+
+
+// convolveRange
+// Computes outputs [start, end) of the block input, without changing
+// the internal state of the filter. Samples before input[0] are read from
+// the filter's delay line. This is safe to call from multiple threads
+// on different ranges of the same block. The outputs are computed last
+// to first, so with output == input each input is only overwritten after
+// the outputs of the range that read it.
+// @param input - the array of inputs to the filter.
+// @param output - the array to write outputs to, indexed the same as input.
+// @param start - the first output index to compute.
+// @param end - one past the last output index to compute.
+template <typename SampleT, typename CoefT, typename AccT>
+void FIRFilter<SampleT, CoefT, AccT>::convolveRange(const SampleT *input, SampleT *output,
+                                                size_t start, size_t end) const
+{
+    // outputs from length - 1 on only need the input array.
+    size_t split = (length > 0) ? (size_t)length - 1 : 0;
+    if (split < start) { split = start; }
+    if (split > end) { split = end; }
+    for (size_t n = end; n > split; ) {
+        n--;
+        const SampleT *x = input + n;
+        AccT out = 0.0;
+        for (uint32_t i = 0; i < length; i++) {
+            out += (AccT)x[-(ptrdiff_t)i] * (AccT)gains[i];
+        }
+        FILTER_PROBE_ACC(stats, SampleT, out);
+        output[n] = saturateOutput<SampleT>(out);
+    }
+
+    // the first length-1 outputs of the block reach back into the
+    // delay line. buffer[curBufLoc + 1] holds the newest old sample.
+    for (size_t n = split; n > start; ) {
+        n--;
+        AccT out = 0.0;
+        uint32_t i = 0;
+        for (; i <= n; i++) { out += (AccT)input[n - i] * (AccT)gains[i]; }
+        // the delay line part is split at the wrap point of the circular
+        // buffer, so neither loop needs a modulo.
+        uint32_t wrap = length - curBufLoc + n;
+        if (wrap > length) { wrap = length; }
+        for (; i < wrap; i++) {
+            out += (AccT)buffer[curBufLoc + i - n] * (AccT)gains[i];
+        }
+        for (; i < length; i++) {
+            out += (AccT)buffer[curBufLoc + i - n - length] * (AccT)gains[i];
+        }
+        FILTER_PROBE_ACC(stats, SampleT, out);
+        output[n] = saturateOutput<SampleT>(out);
+    }
+} // end convolveRange
+
+
+// advance
+// Moves the filter state forward over n inputs, without computing
+// the outputs for them. The state and getOutput afterwards are the same
+// as if filter had been called on each input.
+// @param input - the array of inputs to the filter.
+// @param n - the number of samples in the block.
+template <typename SampleT, typename CoefT, typename AccT>
+void FIRFilter<SampleT, CoefT, AccT>::advance(const SampleT *input, size_t n)
+{
+    if (n == 0) { return; }
+    // only the last length samples are still in the delay line afterwards.
+    size_t i = (n > length) ? n - length : 0;
+    for (; i + 1 < n; i++) {
+        buffer[curBufLoc] = input[i];
+        if (curBufLoc == 0) { curBufLoc = length; }
+        curBufLoc--;
+    }
+    // the last output was already counted by whoever computed it,
+    // so it is recomputed here without the probes.
+    output = saturateOutput<SampleT>(accumulate(input[n - 1]));
+} // end advance
+
+
+// setState
+// Restores a state saved from getDelayLine, getDelayPosition and
+// getOutput of a filter with the same length.
+// @param delayLine - length samples.
+// @param position - the position of the next input.
+// @param out - the last output.
+//
+// @return - 0 for success, else failure.
+template <typename SampleT, typename CoefT, typename AccT>
+int FIRFilter<SampleT, CoefT, AccT>::setState(const SampleT *delayLine, uint32_t position,
+                                            SampleT out)
+{
+    if (delayLine == NULL || position >= length) { return -1; }
+    for (uint32_t i = 0; i < length; i++) { buffer[i] = delayLine[i]; }
+    curBufLoc = position;
+    output = out;
+    return 0;
+} // end setState
+
+
+// setSteadyState
+// Sets the delay line to the state the filter would be in after
+// seeing the input x forever. reset() is the same as setSteadyState(0).
+// @param x - the constant input to settle the filter to.
+template <typename SampleT, typename CoefT, typename AccT>
+void FIRFilter<SampleT, CoefT, AccT>::setSteadyState(SampleT x)
+{
+    AccT acc = 0.0;
+    for (uint32_t i = 0; i < length; i++) {
+        buffer[i] = x;
+        acc += (AccT)x * (AccT)gains[i];
+    }
+    output = saturateOutput<SampleT>(acc);
+} // end setSteadyState
+
+
 
 #endif
@@ -0,0 +1,191 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FIRKernels.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// FFT.h
+// FIRKernels.hpp
+//
+// Other ways of running an FIR filter, behind the same Filter<T> interface
+// as FIRFilter, for the tuner in FIRTuner.h to choose between. Each copies
+// its taps. They give the same outputs as FIRFilter to within rounding, the
+// sums are just done in a different order.
+//
+// LaneFIRFilter - the direct form with FIR_LANE_COUNT partial sums, over a
+//                 linear history, so the inner loop vectorizes.
+// SymmetricFIRFilter - for linear phase (symmetric) taps, each tap is
+//                 multiplied by the sum of its two samples, half the multiplies.
+// FFTFIRFilter - overlap save FFT convolution, a block of up to blockSize
+//                inputs costs two FFTs of the next power of 2 at or above
+//                length - 1 + blockSize. There is no added delay, every
+//                call to filterBlock returns the outputs of its inputs.
+// SegmentedFIRFilter - the lane kernel for very long filters, each chunk of
+//                outputs is summed FIR_SEGMENT_TAPS taps at a time, so a
+//                segment of taps and history stays in cache while every
+//                output of the chunk uses it, instead of streaming all of
+//                the taps from memory once per output.
+//
+// T should be a floating point type.
+
+#ifndef __FIR_KERNELS__
+#define __FIR_KERNELS__
+
+#include "Filter.h"
+#include "FFT.h"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// number of partial sums in the lane and symmetric kernels.
+#define FIR_LANE_COUNT 8
+// inputs added to the linear history between shifts.
+#define FIR_KERNEL_CHUNK 256
+// taps summed over a whole chunk at once in the segmented kernel.
+#define FIR_SEGMENT_TAPS 2048
+// the largest overlap save FFT, the largest power of 2 an FFT size holds.
+#define FIR_FFT_MAX_SIZE 0x80000000u
+
+template <class T>
+class LaneFIRFilter: public Filter<T> {
+public:
+    // Constructor
+    // @param coefficients - the taps, copied.
+    // @param length - the number of taps, at least 1.
+    LaneFIRFilter(const T *coefficients, uint32_t length);
+
+    T filter(T x);
+    T getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n inputs, may be done in place.
+    void filterBlock(const T *input, T *out, size_t n);
+
+    void reset();
+    uint32_t getLength() const { return length; }
+
+private:
+    std::vector<T> reversed; // taps, oldest sample's tap first.
+    std::vector<T> history;  // length - 1 old inputs, then room for a chunk.
+    size_t fill;             // end of the inputs in history.
+    uint32_t length;
+    T output;
+};
+
+template <class T>
+class SymmetricFIRFilter: public Filter<T> {
+public:
+    // Constructor
+    // Only the first half of the taps are used, the rest are assumed to
+    // mirror them, see isSymmetric.
+    // @param coefficients - the taps, copied.
+    // @param length - the number of taps, at least 1.
+    SymmetricFIRFilter(const T *coefficients, uint32_t length);
+
+    T filter(T x);
+    T getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n inputs, may be done in place.
+    void filterBlock(const T *input, T *out, size_t n);
+
+    void reset();
+    uint32_t getLength() const { return length; }
+
+    // isSymmetric
+    // @return - true if coefficients[i] == coefficients[length - 1 - i] for all i.
+    static bool isSymmetric(const T *coefficients, uint32_t length);
+
+private:
+    std::vector<T> half;    // the first (length + 1) / 2 taps.
+    std::vector<T> history; // as LaneFIRFilter.
+    size_t fill;
+    uint32_t length;
+    T output;
+};
+
+template <class T>
+class FFTFIRFilter: public Filter<T> {
+public:
+    // Constructor
+    // @param coefficients - the taps, copied.
+    // @param length - the number of taps, at least 1.
+    // @param blockSize - the most inputs done with each pair of FFTs,
+    //                    longer blocks are split. Cut down if length - 1 +
+    //                    blockSize is above FIR_FFT_MAX_SIZE, taps longer
+    //                    than that give a single zero tap, as NULL does.
+    FFTFIRFilter(const T *coefficients, uint32_t length, size_t blockSize);
+
+    // filter
+    // Correct, but a pair of FFTs per sample, use filterBlock.
+    T filter(T x);
+    T getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n inputs, may be done in place.
+    void filterBlock(const T *input, T *out, size_t n);
+
+    void reset();
+    uint32_t getLength() const { return length; }
+    uint32_t getFFTSize() const { return plan.getSize(); }
+
+private:
+    RealFFTPlan<T> plan;
+    std::vector<std::complex<T> > response; // FFT of the taps, scaled by 1/N.
+    std::vector<std::complex<T> > spectrum;
+    std::vector<T> window;                  // the newest N inputs, oldest first.
+    std::vector<T> result;
+    size_t blockSize;
+    uint32_t length;
+    T output;
+};
+
+template <class T>
+class SegmentedFIRFilter: public Filter<T> {
+public:
+    // Constructor
+    // @param coefficients - the taps, copied.
+    // @param length - the number of taps, at least 1.
+    SegmentedFIRFilter(const T *coefficients, uint32_t length);
+
+    T filter(T x);
+    T getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n inputs, may be done in place.
+    void filterBlock(const T *input, T *out, size_t n);
+
+    void reset();
+    uint32_t getLength() const { return length; }
+
+private:
+    std::vector<T> reversed; // as LaneFIRFilter.
+    std::vector<T> history;  // as LaneFIRFilter.
+    std::vector<T> sums;     // the outputs of the chunk so far.
+    size_t fill;
+    uint32_t length;
+    T output;
+};
+
+// include implementation file
+#include "FIRKernels.hpp"
+#endif
@@ -0,0 +1,394 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FIRKernels.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FIRKernels.h
+//
+// Other ways of running an FIR filter.
+// The implementation file.
+//
+// The lane and symmetric kernels keep the inputs oldest first in a linear
+// buffer, with the length - 1 inputs before the current chunk in front of
+// it, so the window of every output is a contiguous run, and the buffer is
+// shifted back once every FIR_KERNEL_CHUNK inputs. The segmented kernel
+// uses the same buffer, only the order of its loops differs.
+
+#ifndef __FIR_KERNELS_IMPL__
+#define __FIR_KERNELS_IMPL__
+
+#include "FIRKernels.h"
+#include <algorithm>
+
+// firFFTSize
+// the FFT size for overlap save, a power of 2 at least length - 1 + blockSize.
+// @return - the size, 0 if it would be above FIR_FFT_MAX_SIZE.
+inline uint32_t firFFTSize(uint32_t length, size_t blockSize)
+{
+    if (length == 0 || blockSize > FIR_FFT_MAX_SIZE) { return 0; }
+    uint64_t target = (uint64_t)length - 1 + blockSize;
+    if (target > FIR_FFT_MAX_SIZE) { return 0; }
+    uint64_t n = 2;
+    while (n < target) { n *= 2; }
+    return (uint32_t)n;
+}
+
+
+///////////////////////////// lanes /////////////////////////////
+
+// Constructor
+// @param coefficients - the taps, copied.
+// @param length - the number of taps, at least 1.
+template <class T>
+LaneFIRFilter<T>::LaneFIRFilter(const T *coefficients, uint32_t Length)
+{
+    length = (coefficients != NULL && Length > 0) ? Length : 1;
+    reversed.assign(length, 0);
+    if (coefficients != NULL && Length > 0) {
+        for (uint32_t i = 0; i < length; i++) { reversed[i] = coefficients[length - 1 - i]; }
+    }
+    history.assign((size_t)length - 1 + FIR_KERNEL_CHUNK, 0);
+    reset();
+}
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - output of the filter.
+template <class T>
+T LaneFIRFilter<T>::filter(T x)
+{
+    filterBlock(&x, &output, 1);
+    return output;
+}
+
+// filterBlock
+// Filters a block of n inputs, may be done in place. The inputs of each
+// chunk are copied in before any of its outputs are written.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void LaneFIRFilter<T>::filterBlock(const T *input, T *out, size_t n)
+{
+    size_t L = length;
+    size_t end = L - L % FIR_LANE_COUNT;
+    const T *r = &reversed[0];
+    size_t done = 0;
+    while (done < n) {
+        if (fill == history.size()) {
+            std::copy(history.end() - (L - 1), history.end(), history.begin());
+            fill = L - 1;
+        }
+        size_t count = std::min(n - done, history.size() - fill);
+        std::copy(input + done, input + done + count, history.begin() + fill);
+        for (size_t j = 0; j < count; j++) {
+            const T *w = &history[fill + j + 1 - L];
+            T acc[FIR_LANE_COUNT];
+            for (int l = 0; l < FIR_LANE_COUNT; l++) { acc[l] = 0; }
+            for (size_t i = 0; i < end; i += FIR_LANE_COUNT) {
+                for (int l = 0; l < FIR_LANE_COUNT; l++) { acc[l] += r[i + l] * w[i + l]; }
+            }
+            T y = 0;
+            for (int l = 0; l < FIR_LANE_COUNT; l++) { y += acc[l]; }
+            for (size_t i = end; i < L; i++) { y += r[i] * w[i]; }
+            out[done + j] = y;
+        }
+        fill += count;
+        done += count;
+    }
+    if (n > 0) { output = out[n - 1]; }
+} // end filterBlock
+
+// reset
+// clears the history.
+template <class T>
+void LaneFIRFilter<T>::reset()
+{
+    std::fill(history.begin(), history.end(), (T)0);
+    fill = length - 1;
+    output = 0;
+}
+
+
+///////////////////////////// symmetric /////////////////////////////
+
+// Constructor
+// @param coefficients - the taps, copied, only the first half are used.
+// @param length - the number of taps, at least 1.
+template <class T>
+SymmetricFIRFilter<T>::SymmetricFIRFilter(const T *coefficients, uint32_t Length)
+{
+    length = (coefficients != NULL && Length > 0) ? Length : 1;
+    half.assign((length + 1) / 2, 0);
+    if (coefficients != NULL && Length > 0) {
+        std::copy(coefficients, coefficients + half.size(), half.begin());
+    }
+    history.assign((size_t)length - 1 + FIR_KERNEL_CHUNK, 0);
+    reset();
+}
+
+// isSymmetric
+// @return - true if coefficients[i] == coefficients[length - 1 - i] for all i.
+template <class T>
+bool SymmetricFIRFilter<T>::isSymmetric(const T *coefficients, uint32_t length)
+{
+    if (coefficients == NULL) { return false; }
+    for (uint32_t i = 0; i < length / 2; i++) {
+        if (coefficients[i] != coefficients[length - 1 - i]) { return false; }
+    }
+    return true;
+}
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - output of the filter.
+template <class T>
+T SymmetricFIRFilter<T>::filter(T x)
+{
+    filterBlock(&x, &output, 1);
+    return output;
+}
+
+// filterBlock
+// Filters a block of n inputs, may be done in place. Each output is
+//   sum h[k] (w[k] + w[L - 1 - k]) (+ h[mid] w[mid] for odd L)
+// over the window w of the last L inputs, oldest first.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void SymmetricFIRFilter<T>::filterBlock(const T *input, T *out, size_t n)
+{
+    size_t L = length;
+    size_t K = L / 2;
+    size_t end = K - K % FIR_LANE_COUNT;
+    const T *h = &half[0];
+    T mid = (L & 1) ? half[K] : 0;
+    size_t done = 0;
+    while (done < n) {
+        if (fill == history.size()) {
+            std::copy(history.end() - (L - 1), history.end(), history.begin());
+            fill = L - 1;
+        }
+        size_t count = std::min(n - done, history.size() - fill);
+        std::copy(input + done, input + done + count, history.begin() + fill);
+        for (size_t j = 0; j < count; j++) {
+            const T *w = &history[fill + j + 1 - L];
+            const T *r = w + L - 1; // r[-k] = w[L - 1 - k]
+            T acc[FIR_LANE_COUNT];
+            for (int l = 0; l < FIR_LANE_COUNT; l++) { acc[l] = 0; }
+            for (size_t k = 0; k < end; k += FIR_LANE_COUNT) {
+                for (int l = 0; l < FIR_LANE_COUNT; l++) {
+                    acc[l] += h[k + l] * (w[k + l] + r[-(ptrdiff_t)(k + l)]);
+                }
+            }
+            T y = 0;
+            for (int l = 0; l < FIR_LANE_COUNT; l++) { y += acc[l]; }
+            for (size_t k = end; k < K; k++) { y += h[k] * (w[k] + r[-(ptrdiff_t)k]); }
+            out[done + j] = y + mid * w[K];
+        }
+        fill += count;
+        done += count;
+    }
+    if (n > 0) { output = out[n - 1]; }
+} // end filterBlock
+
+// reset
+// clears the history.
+template <class T>
+void SymmetricFIRFilter<T>::reset()
+{
+    std::fill(history.begin(), history.end(), (T)0);
+    fill = length - 1;
+    output = 0;
+}
+
+
+///////////////////////////// FFT /////////////////////////////
+
+// Constructor
+// @param coefficients - the taps, copied.
+// @param length - the number of taps, at least 1.
+// @param blockSize - the most inputs done with each pair of FFTs.
+template <class T>
+FFTFIRFilter<T>::FFTFIRFilter(const T *coefficients, uint32_t Length, size_t BlockSize)
+    : plan(2)
+{
+    // taps too long for any FFT are treated as NULL.
+    bool valid = coefficients != NULL && firFFTSize(Length, 1) != 0;
+    length = valid ? Length : 1;
+    blockSize = (BlockSize > 0) ? BlockSize : 1;
+    // longer blocks are split anyway, so cut the block down to what fits.
+    if (blockSize > FIR_FFT_MAX_SIZE - ((size_t)length - 1)) {
+        blockSize = FIR_FFT_MAX_SIZE - ((size_t)length - 1);
+    }
+    plan = RealFFTPlan<T>(firFFTSize(length, blockSize));
+    uint32_t N = plan.getSize();
+
+    std::vector<T> padded(N, 0);
+    if (valid) {
+        std::copy(coefficients, coefficients + length, padded.begin());
+    }
+    response.resize(N / 2 + 1);
+    plan.forward(&padded[0], &response[0]);
+    // the inverse transform isn't scaled, so scale the response instead.
+    for (size_t k = 0; k < response.size(); k++) { response[k] /= (T)N; }
+
+    spectrum.resize(N / 2 + 1);
+    window.assign(N, 0);
+    result.assign(N, 0);
+    output = 0;
+}
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - output of the filter.
+template <class T>
+T FFTFIRFilter<T>::filter(T x)
+{
+    filterBlock(&x, &output, 1);
+    return output;
+}
+
+// filterBlock
+// Filters a block of n inputs, may be done in place. For each chunk of up
+// to blockSize inputs the window is moved on by the chunk, and the last
+// outputs of the circular convolution of the window with the taps are the
+// outputs of the chunk. Only the first length - 1 outputs of the circular
+// convolution wrap around, and a chunk never reaches back that far.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void FFTFIRFilter<T>::filterBlock(const T *input, T *out, size_t n)
+{
+    size_t N = window.size();
+    size_t done = 0;
+    while (done < n) {
+        size_t count = std::min(n - done, blockSize);
+        std::copy(window.begin() + count, window.end(), window.begin());
+        std::copy(input + done, input + done + count, window.end() - count);
+        plan.forward(&window[0], &spectrum[0]);
+        for (size_t k = 0; k < spectrum.size(); k++) { spectrum[k] *= response[k]; }
+        plan.inverse(&spectrum[0], &result[0]);
+        std::copy(result.begin() + (N - count), result.end(), out + done);
+        done += count;
+    }
+    if (n > 0) { output = out[n - 1]; }
+} // end filterBlock
+
+// reset
+// clears the history.
+template <class T>
+void FFTFIRFilter<T>::reset()
+{
+    std::fill(window.begin(), window.end(), (T)0);
+    output = 0;
+}
+
+
+///////////////////////////// segmented /////////////////////////////
+
+// Constructor
+// @param coefficients - the taps, copied.
+// @param length - the number of taps, at least 1.
+template <class T>
+SegmentedFIRFilter<T>::SegmentedFIRFilter(const T *coefficients, uint32_t Length)
+{
+    length = (coefficients != NULL && Length > 0) ? Length : 1;
+    reversed.assign(length, 0);
+    if (coefficients != NULL && Length > 0) {
+        for (uint32_t i = 0; i < length; i++) { reversed[i] = coefficients[length - 1 - i]; }
+    }
+    history.assign((size_t)length - 1 + FIR_KERNEL_CHUNK, 0);
+    sums.assign(FIR_KERNEL_CHUNK, 0);
+    reset();
+}
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - output of the filter.
+template <class T>
+T SegmentedFIRFilter<T>::filter(T x)
+{
+    filterBlock(&x, &output, 1);
+    return output;
+}
+
+// filterBlock
+// Filters a block of n inputs, may be done in place. Each chunk is summed
+// one segment of taps at a time, every output of the chunk adding its part
+// of the segment before moving on to the next.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void SegmentedFIRFilter<T>::filterBlock(const T *input, T *out, size_t n)
+{
+    size_t L = length;
+    size_t done = 0;
+    while (done < n) {
+        if (fill == history.size()) {
+            std::copy(history.end() - (L - 1), history.end(), history.begin());
+            fill = L - 1;
+        }
+        size_t count = std::min(n - done, history.size() - fill);
+        std::copy(input + done, input + done + count, history.begin() + fill);
+        std::fill(sums.begin(), sums.begin() + count, (T)0);
+        for (size_t s = 0; s < L; s += FIR_SEGMENT_TAPS) {
+            size_t S = std::min((size_t)FIR_SEGMENT_TAPS, L - s);
+            size_t end = S - S % FIR_LANE_COUNT;
+            const T *r = &reversed[s];
+            for (size_t j = 0; j < count; j++) {
+                const T *w = &history[fill + j + 1 - L + s];
+                T acc[FIR_LANE_COUNT];
+                for (int l = 0; l < FIR_LANE_COUNT; l++) { acc[l] = 0; }
+                for (size_t i = 0; i < end; i += FIR_LANE_COUNT) {
+                    for (int l = 0; l < FIR_LANE_COUNT; l++) { acc[l] += r[i + l] * w[i + l]; }
+                }
+                T y = 0;
+                for (int l = 0; l < FIR_LANE_COUNT; l++) { y += acc[l]; }
+                for (size_t i = end; i < S; i++) { y += r[i] * w[i]; }
+                sums[j] += y;
+            }
+        }
+        std::copy(sums.begin(), sums.begin() + count, out + done);
+        fill += count;
+        done += count;
+    }
+    if (n > 0) { output = out[n - 1]; }
+} // end filterBlock
+
+// reset
+// clears the history.
+template <class T>
+void SegmentedFIRFilter<T>::reset()
+{
+    std::fill(history.begin(), history.end(), (T)0);
+    fill = length - 1;
+    output = 0;
+}
+
+#endif
@@ -0,0 +1,155 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FIRTuner.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FIRFilter.h
+// FIRKernels.h
+// CoefficientBank.h
+// FIRTuner.hpp
+//
+// Picks the fastest FIR implementation for a filter on this machine. The
+// best one depends on the number of taps, the block size and the CPU, so
+// rather than hardcoding the crossovers, the first time a tuner sees a
+// (type, length, block size, symmetric) it times each candidate on a short
+// run of blocks and remembers the fastest. The table can be kept in a file
+// so later startups skip the timing.
+//
+// Candidates:
+// FIR_KERNEL_DIRECT - FIRFilter, with its block convolution.
+// FIR_KERNEL_LANES - LaneFIRFilter, the direct form with partial sums.
+// FIR_KERNEL_SYMMETRIC - SymmetricFIRFilter, only for symmetric taps.
+// FIR_KERNEL_FFT - FFTFIRFilter, only for blocks of FIR_TUNE_MIN_FFT_BLOCK
+//                  or more, as a pair of FFTs per call is never faster for
+//                  the shorter ones, and only while length - 1 + blockSize
+//                  is at most FIR_FFT_MAX_SIZE.
+// FIR_KERNEL_SEGMENTED - SegmentedFIRFilter, only for FIR_SEGMENT_TAPS taps
+//                  or more, below that it's the lane kernel.
+//
+// The table file is text, one line per entry:
+//   typeCode length blockSize symmetric kernel nsPerSample
+// Lines that can't be read are skipped. A tuner isn't thread safe.
+// Every kernel's filterBlock may be done in place (output == input), so a
+// filter from create behaves the same whichever kernel wins.
+//
+// Example:
+// FIRTuner<float> tuner("fir_tuning.txt");
+// Filter<float> *filter = tuner.create(taps, 255, 64);
+// filter->filterBlock(in, out, 64);
+// delete filter;
+
+#ifndef __FIR_TUNER__
+#define __FIR_TUNER__
+
+#include "FIRFilter.h"
+#include "FIRKernels.h"
+#include "CoefficientBank.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+// the shortest block the FFT kernel is tried for.
+#define FIR_TUNE_MIN_FFT_BLOCK 8
+
+enum FIRKernel {
+    FIR_KERNEL_DIRECT,
+    FIR_KERNEL_LANES,
+    FIR_KERNEL_SYMMETRIC,
+    FIR_KERNEL_FFT,
+    FIR_KERNEL_SEGMENTED,
+    FIR_KERNEL_COUNT
+};
+
+// firKernelName
+// @return - the name of a kernel, as used in the table file.
+inline const char *firKernelName(FIRKernel kernel);
+
+template <class T>
+class FIRTuner {
+public:
+    // Constructor
+    // Loads the table from a file, if there is one.
+    // @param path - the table file, NULL to keep the table in memory only.
+    // @param seconds - how long to time each candidate for.
+    FIRTuner(const char *path = NULL, double seconds = 0.002);
+
+    // create
+    // Makes the fastest filter for these taps and block size, timing the
+    // candidates if this shape isn't in the table yet (and saving the table).
+    // The taps are copied, and the caller deletes the filter.
+    // @param coefficients - the taps.
+    // @param length - the number of taps.
+    // @param blockSize - the number of samples passed to each filterBlock.
+    //
+    // @return - the filter, NULL on failure.
+    Filter<T> *create(const T *coefficients, uint32_t length, size_t blockSize);
+
+    // choose
+    // The same as create, but returns which kernel it would use.
+    FIRKernel choose(const T *coefficients, uint32_t length, size_t blockSize);
+
+    // make
+    // Makes a filter with a given kernel, the taps are copied.
+    //
+    // @return - the filter, NULL if the kernel can't be used for these taps.
+    static Filter<T> *make(FIRKernel kernel, const T *coefficients, uint32_t length,
+                        size_t blockSize);
+
+    // load / save
+    // Reads or writes the table file given to the constructor. Entries for
+    // other types are kept.
+    //
+    // @return - 0 for success, else failure.
+    int load();
+    int save() const;
+
+    // getMeasurements
+    // @return - the number of shapes timed by this tuner.
+    uint32_t getMeasurements() const { return measurements; }
+
+private:
+    struct Key {
+        uint16_t typeCode;
+        uint32_t length;
+        uint32_t blockSize;
+        bool symmetric;
+        bool operator<(const Key &other) const;
+    };
+    struct Entry {
+        FIRKernel kernel;
+        double nsPerSample;
+    };
+
+    // measure
+    // times a filter running blocks of the input.
+    // @return - the time per sample in ns.
+    double measure(Filter<T> &filter, const T *input, size_t blockSize, T *output) const;
+
+    std::map<Key, Entry> table;
+    std::string path;
+    double seconds;
+    uint32_t measurements;
+};
+
+// include implementation file
+#include "FIRTuner.hpp"
+#endif
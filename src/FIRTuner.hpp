@@ -0,0 +1,251 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FIRTuner.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FIRTuner.h
+//
+// Implementation of the FIR tuner.
+
+#ifndef __FIR_TUNER_IMPL__
+#define __FIR_TUNER_IMPL__
+
+#include "FIRTuner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// firKernelName
+// @return - the name of a kernel, as used in the table file.
+inline const char *firKernelName(FIRKernel kernel)
+{
+    switch (kernel) {
+    case FIR_KERNEL_DIRECT: return "direct";
+    case FIR_KERNEL_LANES: return "lanes";
+    case FIR_KERNEL_SYMMETRIC: return "symmetric";
+    case FIR_KERNEL_FFT: return "fft";
+    case FIR_KERNEL_SEGMENTED: return "segmented";
+    default: return "unknown";
+    }
+}
+
+template <class T>
+bool FIRTuner<T>::Key::operator<(const Key &other) const
+{
+    if (typeCode != other.typeCode) { return typeCode < other.typeCode; }
+    if (length != other.length) { return length < other.length; }
+    if (blockSize != other.blockSize) { return blockSize < other.blockSize; }
+    return symmetric < other.symmetric;
+}
+
+// Constructor
+// Loads the table from a file, if there is one.
+// @param path - the table file, NULL to keep the table in memory only.
+// @param seconds - how long to time each candidate for.
+template <class T>
+FIRTuner<T>::FIRTuner(const char *Path, double Seconds)
+{
+    path = (Path != NULL) ? Path : "";
+    seconds = Seconds;
+    measurements = 0;
+    if (!path.empty()) { load(); }
+}
+
+// make
+// Makes a filter with a given kernel, the taps are copied.
+//
+// @return - the filter, NULL if the kernel can't be used for these taps.
+template <class T>
+Filter<T> *FIRTuner<T>::make(FIRKernel kernel, const T *coefficients, uint32_t length,
+                        size_t blockSize)
+{
+    if (coefficients == NULL || length == 0) { return NULL; }
+    switch (kernel) {
+    case FIR_KERNEL_DIRECT: {
+        // the filter keeps the copy of the taps alive.
+        std::shared_ptr<std::vector<T> > copy =
+            std::make_shared<std::vector<T> >(coefficients, coefficients + length);
+        return new FIRFilter<T>(std::make_shared<CoefficientSet<T> >(&(*copy)[0], length,
+                                coefficientHash(coefficients, length), copy));
+    }
+    case FIR_KERNEL_LANES:
+        return new LaneFIRFilter<T>(coefficients, length);
+    case FIR_KERNEL_SYMMETRIC:
+        if (!SymmetricFIRFilter<T>::isSymmetric(coefficients, length)) { return NULL; }
+        return new SymmetricFIRFilter<T>(coefficients, length);
+    case FIR_KERNEL_FFT:
+        if (firFFTSize(length, blockSize) == 0) { return NULL; }
+        return new FFTFIRFilter<T>(coefficients, length, blockSize);
+    case FIR_KERNEL_SEGMENTED:
+        return new SegmentedFIRFilter<T>(coefficients, length);
+    default:
+        return NULL;
+    }
+} // end make
+
+// measure
+// times a filter running blocks of the input.
+// @return - the time per sample in ns.
+template <class T>
+double FIRTuner<T>::measure(Filter<T> &filter, const T *input, size_t blockSize,
+                        T *output) const
+{
+    // warm up, then time at least 4 blocks.
+    filter.filterBlock(input, output, blockSize);
+    uint64_t blocks = 0;
+    double elapsed = 0.0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (blocks < 4 || elapsed < seconds) {
+        filter.filterBlock(input + (blocks & 3) * blockSize, output, blockSize);
+        blocks++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return elapsed * 1e9 / ((double)blocks * blockSize);
+}
+
+// choose
+// Looks up the fastest kernel for these taps and block size, timing the
+// candidates if this shape isn't in the table yet.
+// @param coefficients - the taps.
+// @param length - the number of taps.
+// @param blockSize - the number of samples passed to each filterBlock.
+//
+// @return - the kernel.
+template <class T>
+FIRKernel FIRTuner<T>::choose(const T *coefficients, uint32_t length, size_t blockSize)
+{
+    if (coefficients == NULL || length == 0) { return FIR_KERNEL_DIRECT; }
+    if (blockSize == 0) { blockSize = 1; }
+    Key key;
+    key.typeCode = snapshotTypeCode<T>();
+    key.length = length;
+    key.blockSize = (uint32_t)std::min(blockSize, (size_t)UINT32_MAX);
+    key.symmetric = SymmetricFIRFilter<T>::isSymmetric(coefficients, length);
+    typename std::map<Key, Entry>::const_iterator it = table.find(key);
+    if (it != table.end()) { return it->second.kernel; }
+
+    // time every candidate on the same input.
+    std::vector<T> input(4 * blockSize), output(blockSize);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < input.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        input[i] = (T)((int)(seed >> 16) - 32768) / (T)32768;
+    }
+    Entry best;
+    best.kernel = FIR_KERNEL_DIRECT;
+    best.nsPerSample = -1.0;
+    for (int k = 0; k < FIR_KERNEL_COUNT; k++) {
+        FIRKernel kernel = (FIRKernel)k;
+        if (kernel == FIR_KERNEL_FFT && blockSize < FIR_TUNE_MIN_FFT_BLOCK) { continue; }
+        if (kernel == FIR_KERNEL_SEGMENTED && length < FIR_SEGMENT_TAPS) { continue; }
+        Filter<T> *filter = make(kernel, coefficients, length, blockSize);
+        if (filter == NULL) { continue; }
+        double ns = measure(*filter, &input[0], blockSize, &output[0]);
+        delete filter;
+        if (best.nsPerSample < 0.0 || ns < best.nsPerSample) {
+            best.kernel = kernel;
+            best.nsPerSample = ns;
+        }
+    }
+    table[key] = best;
+    measurements++;
+    if (!path.empty()) { save(); }
+    return best.kernel;
+} // end choose
+
+// create
+// Makes the fastest filter for these taps and block size.
+// @param coefficients - the taps.
+// @param length - the number of taps.
+// @param blockSize - the number of samples passed to each filterBlock.
+//
+// @return - the filter, NULL on failure.
+template <class T>
+Filter<T> *FIRTuner<T>::create(const T *coefficients, uint32_t length, size_t blockSize)
+{
+    if (coefficients == NULL || length == 0) { return NULL; }
+    return make(choose(coefficients, length, blockSize), coefficients, length, blockSize);
+}
+
+// load
+// Reads the table file, skipping lines that can't be read.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FIRTuner<T>::load()
+{
+    if (path.empty()) { return -1; }
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == NULL) { return -1; }
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        unsigned typeCode, length, blockSize, symmetric;
+        char name[32];
+        double ns;
+        if (sscanf(line, "%u %u %u %u %31s %lf", &typeCode, &length, &blockSize,
+                &symmetric, name, &ns) != 6 || typeCode > UINT16_MAX ||
+                length == 0 || blockSize == 0 || symmetric > 1) {
+            continue;
+        }
+        int k = 0;
+        while (k < FIR_KERNEL_COUNT && strcmp(name, firKernelName((FIRKernel)k)) != 0) { k++; }
+        if (k == FIR_KERNEL_COUNT) { continue; }
+        Key key;
+        key.typeCode = (uint16_t)typeCode;
+        key.length = length;
+        key.blockSize = blockSize;
+        key.symmetric = symmetric != 0;
+        // a symmetric kernel for taps that aren't isn't possible.
+        if (k == FIR_KERNEL_SYMMETRIC && !key.symmetric) { continue; }
+        Entry entry;
+        entry.kernel = (FIRKernel)k;
+        entry.nsPerSample = ns;
+        table[key] = entry;
+    }
+    fclose(file);
+    return 0;
+} // end load
+
+// save
+// Writes the table file.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FIRTuner<T>::save() const
+{
+    if (path.empty()) { return -1; }
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == NULL) { return -1; }
+    bool failed = false;
+    typename std::map<Key, Entry>::const_iterator it;
+    for (it = table.begin(); it != table.end(); it++) {
+        failed |= fprintf(file, "%u %u %u %u %s %.3f\n", (unsigned)it->first.typeCode,
+                        (unsigned)it->first.length, (unsigned)it->first.blockSize,
+                        it->first.symmetric ? 1u : 0u, firKernelName(it->second.kernel),
+                        it->second.nsPerSample) < 0;
+    }
+    if (fclose(file) != 0) { failed = true; }
+    return failed ? -1 : 0;
+} // end save
+
+#endif
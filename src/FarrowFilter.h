@@ -0,0 +1,210 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FarrowFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// FarrowFilter.hpp
+//
+// Variable fractional delay and arbitrary ratio resampling with a Farrow
+// structure. The filter is order + 1 short FIR branches over the same
+// window of taps inputs, and the output at a fractional delay mu is the
+// polynomial
+//   y = v0 + mu (v1 + mu (v2 + ... mu vorder))
+// of the branch outputs v. Changing the delay or ratio only changes mu,
+// so it can change every sample with no redesign.
+//
+// The default design is Lagrange interpolation over an even number of
+// taps (4 is cubic), which puts the output between the middle two samples
+// of the window, at a delay of taps / 2 - 1 + mu samples. Other designs
+// can be given as order + 1 rows of taps coefficients, row m being the
+// branch multiplied by mu^m, using the same delay convention.
+//
+// The branches are stored [group][tap][lane] in groups of FARROW_LANES, so
+// the inner loop runs across the branches of a group with a fixed width,
+// and is vectorized.
+//
+// Example:
+// FarrowResampler<float> resampler(48000.0 / 44100.0);
+// std::vector<float> out(resampler.maxOutput(n));
+// size_t m = resampler.process(in, n, &out[0]);
+// resampler.setRatio(newRatio);  // e.g. clock drift, for the next block
+
+#ifndef __FARROW_FILTER__
+#define __FARROW_FILTER__
+
+#include "Filter.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// number of branches computed together in the kernel.
+#define FARROW_LANES 4
+
+// farrowLagrangeCoef
+// Designs a Lagrange interpolator in Farrow form.
+// @param coefficients - taps * taps coefficients, row m is the branch for mu^m.
+// @param taps - the number of taps, even and at least 2, the order is taps - 1.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int farrowLagrangeCoef(T *coefficients, uint16_t taps);
+
+template <class T>
+class FarrowFilter: public Filter<T> {
+public:
+    // Constructor
+    // A Lagrange interpolator.
+    // @param taps - the number of taps, even and at least 2, an odd number
+    //               is rounded up.
+    FarrowFilter(uint16_t taps = 4);
+
+    // Constructor
+    // @param coefficients - order + 1 rows of taps coefficients.
+    // @param taps - the number of taps of each branch.
+    // @param order - the order of the polynomial in mu.
+    FarrowFilter(const T *coefficients, uint16_t taps, uint16_t order);
+
+    // filter
+    // @param x - the input to the filter.
+    //
+    // @return - the input delayed by getDelay() samples.
+    T filter(T x);
+
+    // getOutput
+    // @return - the last output of the filter.
+    T getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block at the current delay, may be done in place.
+    // @param input - the array of inputs to the filter.
+    // @param output - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const T *input, T *output, size_t n);
+
+    // setDelay
+    // Sets the fractional part of the delay.
+    // @param mu - 0 to 1, clamped.
+    void setDelay(double mu);
+
+    // getDelay
+    // @return - the whole delay in samples, taps / 2 - 1 + mu.
+    double getDelay() const { return numTaps / 2 - 1 + mu; }
+
+    // push
+    // adds an input to the window without computing an output.
+    void push(T x);
+
+    // interpolate
+    // Evaluates the window at a fractional delay. The branches are only
+    // computed once per input, so many delays of the same window are cheap.
+    // @param mu - 0 to 1, the delay after taps / 2 - 1 samples.
+    //
+    // @return - the interpolated value.
+    T interpolate(T mu);
+
+    // reset
+    // clears the window.
+    void reset();
+
+    uint16_t getNumTaps() const { return numTaps; }
+    uint16_t getOrder() const { return order; }
+
+private:
+    // setGains
+    // copies order + 1 rows of taps coefficients into the kernel layout.
+    void setGains(const T *coefficients, uint16_t taps, uint16_t order);
+
+    // branches
+    // computes the output of every branch for the current window.
+    void branches();
+
+    std::vector<T> gains;   // [group][tap][lane]
+    std::vector<T> history; // the window, each input written twice.
+    std::vector<T> v;       // branch outputs, padded to FARROW_LANES.
+    uint16_t numTaps;
+    uint16_t order;
+    uint16_t pos;           // the newest input.
+    bool fresh;             // v is for the current window.
+    double mu;
+    T output;
+};
+
+template <class T>
+class FarrowResampler {
+public:
+    // Constructor
+    // A Lagrange resampler.
+    // @param ratio - the output rate over the input rate.
+    // @param taps - the number of taps of the interpolator.
+    FarrowResampler(double ratio, uint16_t taps = 4);
+
+    // Constructor
+    // @param coefficients - order + 1 rows of taps coefficients.
+    // @param taps - the number of taps of each branch.
+    // @param order - the order of the polynomial in mu.
+    // @param ratio - the output rate over the input rate.
+    FarrowResampler(const T *coefficients, uint16_t taps, uint16_t order, double ratio);
+
+    // setRatio
+    // Changes the ratio from the next output, with no redesign.
+    // @param ratio - the output rate over the input rate, > 0.
+    //
+    // @return - 0 for success, else failure.
+    int setRatio(double ratio);
+
+    // getRatio
+    double getRatio() const { return ratio; }
+
+    // maxOutput
+    // @param n - a number of inputs.
+    //
+    // @return - the most outputs process can write for n inputs.
+    size_t maxOutput(size_t n) const;
+
+    // process
+    // Resamples a block, the phase carries over to the next block.
+    // Outputs are spaced 1 / ratio inputs apart.
+    // @param input - the inputs.
+    // @param n - the number of inputs.
+    // @param output - at least maxOutput(n) long.
+    //
+    // @return - the number of outputs written.
+    size_t process(const T *input, size_t n, T *output);
+
+    // reset
+    // clears the window and phase.
+    void reset();
+
+    // getDelay
+    // @return - the delay in input samples of an output at phase 0.
+    double getDelay() const { return interpolator.getNumTaps() / 2; }
+
+private:
+    FarrowFilter<T> interpolator;
+    double ratio;
+    double step;   // inputs per output.
+    double phase;  // time of the next output after the newest input.
+};
+
+// include implementation file
+#include "FarrowFilter.hpp"
+#endif
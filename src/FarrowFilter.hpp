@@ -0,0 +1,318 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FarrowFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FarrowFilter.h
+//
+// Farrow fractional delay filter and resampler.
+// The implementation file.
+//
+// The window is a circular buffer of taps inputs, each written at pos and
+// pos + taps, so the newest taps inputs are always the contiguous run
+// starting at pos, newest first.
+
+#ifndef __FARROW_FILTER_IMPL__
+#define __FARROW_FILTER_IMPL__
+
+#include "FarrowFilter.h"
+#include <cmath>
+
+// farrowLagrangeCoef
+// Designs a Lagrange interpolator in Farrow form. Tap k is the input k
+// samples old, and its weight at a delay D = taps / 2 - 1 + mu is
+//   prod over j != k of (D - j) / (k - j)
+// which is expanded as a polynomial in mu.
+// @param coefficients - taps * taps coefficients, row m is the branch for mu^m.
+// @param taps - the number of taps, even and at least 2, the order is taps - 1.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int farrowLagrangeCoef(T *coefficients, uint16_t taps)
+{
+    if (coefficients == NULL || taps < 2 || (taps & 1) != 0) { return -1; }
+    double center = taps / 2 - 1;
+    std::vector<double> poly(taps);
+    for (uint16_t k = 0; k < taps; k++) {
+        poly.assign(taps, 0.0);
+        poly[0] = 1.0;
+        uint16_t degree = 0;
+        for (uint16_t j = 0; j < taps; j++) {
+            if (j == k) { continue; }
+            // multiply by (mu + center - j) / (k - j).
+            double c = center - j;
+            double scale = 1.0 / ((double)k - (double)j);
+            degree++;
+            for (uint16_t m = degree; m > 0; m--) {
+                poly[m] = (poly[m - 1] + c * poly[m]) * scale;
+            }
+            poly[0] *= c * scale;
+        }
+        for (uint16_t m = 0; m < taps; m++) {
+            coefficients[(size_t)m * taps + k] = (T)poly[m];
+        }
+    }
+    return 0;
+} // end farrowLagrangeCoef
+
+
+///////////////////////////// filter /////////////////////////////
+
+// Constructor
+// A Lagrange interpolator.
+// @param taps - the number of taps, even and at least 2, an odd number
+//               is rounded up.
+template <class T>
+FarrowFilter<T>::FarrowFilter(uint16_t taps)
+{
+    if (taps < 2) { taps = 2; }
+    if (taps & 1) { taps++; }
+    std::vector<T> coefficients((size_t)taps * taps);
+    farrowLagrangeCoef(&coefficients[0], taps);
+    setGains(&coefficients[0], taps, taps - 1);
+    mu = 0.0;
+}
+
+// Constructor
+// @param coefficients - order + 1 rows of taps coefficients.
+// @param taps - the number of taps of each branch.
+// @param order - the order of the polynomial in mu.
+template <class T>
+FarrowFilter<T>::FarrowFilter(const T *coefficients, uint16_t taps, uint16_t order)
+{
+    if (coefficients == NULL || taps == 0) {
+        // fall back to passing the input straight through.
+        T one = 1;
+        setGains(&one, 1, 0);
+    } else {
+        setGains(coefficients, taps, order);
+    }
+    mu = 0.0;
+}
+
+// setGains
+// copies order + 1 rows of taps coefficients into the kernel layout.
+template <class T>
+void FarrowFilter<T>::setGains(const T *coefficients, uint16_t taps, uint16_t Order)
+{
+    numTaps = taps;
+    order = Order;
+    size_t groups = ((size_t)order + FARROW_LANES) / FARROW_LANES;
+    gains.assign(groups * numTaps * FARROW_LANES, 0);
+    for (size_t m = 0; m <= order; m++) {
+        size_t g = m / FARROW_LANES;
+        size_t lane = m % FARROW_LANES;
+        for (size_t k = 0; k < numTaps; k++) {
+            gains[(g * numTaps + k) * FARROW_LANES + lane] = coefficients[m * numTaps + k];
+        }
+    }
+    v.assign(groups * FARROW_LANES, 0);
+    history.assign(2 * (size_t)numTaps, 0);
+    pos = 0;
+    fresh = false;
+    output = 0;
+}
+
+// push
+// adds an input to the window without computing an output.
+template <class T>
+void FarrowFilter<T>::push(T x)
+{
+    pos = (pos == 0) ? numTaps - 1 : pos - 1;
+    history[pos] = x;
+    history[pos + numTaps] = x;
+    fresh = false;
+}
+
+// branches
+// computes the output of every branch for the current window.
+template <class T>
+void FarrowFilter<T>::branches()
+{
+    const T *x = &history[pos];
+    const T *g = &gains[0];
+    T *out = &v[0];
+    size_t groups = v.size() / FARROW_LANES;
+    for (size_t b = 0; b < groups; b++) {
+        T acc[FARROW_LANES] = {0};
+        for (uint16_t k = 0; k < numTaps; k++) {
+            T xk = x[k];
+            for (int l = 0; l < FARROW_LANES; l++) { acc[l] += g[l] * xk; }
+            g += FARROW_LANES;
+        }
+        for (int l = 0; l < FARROW_LANES; l++) { out[l] = acc[l]; }
+        out += FARROW_LANES;
+    }
+    fresh = true;
+}
+
+// interpolate
+// Evaluates the window at a fractional delay.
+// @param mu - 0 to 1, the delay after taps / 2 - 1 samples.
+//
+// @return - the interpolated value.
+template <class T>
+T FarrowFilter<T>::interpolate(T mu)
+{
+    if (!fresh) { branches(); }
+    T y = v[order];
+    for (uint16_t m = order; m > 0; m--) { y = y * mu + v[m - 1]; }
+    return y;
+}
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - the input delayed by getDelay() samples.
+template <class T>
+T FarrowFilter<T>::filter(T x)
+{
+    push(x);
+    output = interpolate((T)mu);
+    return output;
+}
+
+// filterBlock
+// Filters a block at the current delay, may be done in place.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void FarrowFilter<T>::filterBlock(const T *input, T *out, size_t n)
+{
+    T m = (T)mu;
+    for (size_t i = 0; i < n; i++) {
+        push(input[i]);
+        out[i] = interpolate(m);
+    }
+    if (n > 0) { output = out[n - 1]; }
+}
+
+// setDelay
+// Sets the fractional part of the delay.
+// @param mu - 0 to 1, clamped.
+template <class T>
+void FarrowFilter<T>::setDelay(double Mu)
+{
+    mu = (Mu > 0.0) ? ((Mu < 1.0) ? Mu : 1.0) : 0.0;
+}
+
+// reset
+// clears the window.
+template <class T>
+void FarrowFilter<T>::reset()
+{
+    history.assign(history.size(), 0);
+    pos = 0;
+    fresh = false;
+    output = 0;
+}
+
+
+///////////////////////////// resampler /////////////////////////////
+
+// Constructor
+// A Lagrange resampler.
+// @param ratio - the output rate over the input rate.
+// @param taps - the number of taps of the interpolator.
+template <class T>
+FarrowResampler<T>::FarrowResampler(double Ratio, uint16_t taps)
+    : interpolator(taps)
+{
+    ratio = 1.0;
+    step = 1.0;
+    setRatio(Ratio);
+    phase = 0.0;
+}
+
+// Constructor
+// @param coefficients - order + 1 rows of taps coefficients.
+// @param taps - the number of taps of each branch.
+// @param order - the order of the polynomial in mu.
+// @param ratio - the output rate over the input rate.
+template <class T>
+FarrowResampler<T>::FarrowResampler(const T *coefficients, uint16_t taps, uint16_t order,
+                                    double Ratio)
+    : interpolator(coefficients, taps, order)
+{
+    ratio = 1.0;
+    step = 1.0;
+    setRatio(Ratio);
+    phase = 0.0;
+}
+
+// setRatio
+// Changes the ratio from the next output, with no redesign.
+// @param ratio - the output rate over the input rate, > 0.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FarrowResampler<T>::setRatio(double Ratio)
+{
+    if (!(Ratio > 0.0) || std::isinf(Ratio)) { return -1; }
+    ratio = Ratio;
+    step = 1.0 / ratio;
+    return 0;
+}
+
+// maxOutput
+// @param n - a number of inputs.
+//
+// @return - the most outputs process can write for n inputs.
+template <class T>
+size_t FarrowResampler<T>::maxOutput(size_t n) const
+{
+    return (size_t)std::ceil((double)n * ratio) + 1;
+}
+
+// process
+// Resamples a block. An output at phase p after the newest input x[n] is
+// the input at time n - taps / 2 + p, which is interpolate(1 - p).
+// @param input - the inputs.
+// @param n - the number of inputs.
+// @param output - at least maxOutput(n) long.
+//
+// @return - the number of outputs written.
+template <class T>
+size_t FarrowResampler<T>::process(const T *input, size_t n, T *output)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        interpolator.push(input[i]);
+        while (phase < 1.0) {
+            output[count++] = interpolator.interpolate((T)(1.0 - phase));
+            phase += step;
+        }
+        phase -= 1.0;
+    }
+    return count;
+} // end process
+
+// reset
+// clears the window and phase.
+template <class T>
+void FarrowResampler<T>::reset()
+{
+    interpolator.reset();
+    phase = 0.0;
+}
+
+#endif
@@ -0,0 +1,64 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FiltFilt.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// FiltFilt.hpp
+//
+// Zero-phase forward-backward filtering for offline signals.
+// The signal is run through the filter forwards, then backwards, which cancels
+// the phase response and squares the magnitude response.
+//
+// This follows the standard filtfilt method. The signal is extended at both ends
+// by an odd extension (reflection through the end point) of 3 * filter length
+// samples, and the filter is started in its steady state for the first extended
+// sample on each pass, which minimizes the start up transients.
+//
+// Only a fixed working buffer is used, the size of which depends on the filter
+// length and not the length of the signal. The forward pass is written into the
+// output array, and the backward pass is done in place, both in blocks.
+
+#ifndef __FILT_FILT__
+#define __FILT_FILT__
+
+#include "Filter.h"
+#include <cstddef>
+
+// filtfilt
+// Runs the filter forwards and backwards over the input to give a zero-phase
+// output. The filter can be an FIRFilter or IIRFilter (anything with
+// filter, filterBlock, setSteadyState and getLength). The filter state is
+// overwritten.
+// NOTE: n must be greater than 3 * filter length.
+// @param filter - the filter to run.
+// @param input - the array of inputs.
+// @param output - the array to write the outputs to (length n), can be the same as input.
+// @param n - the number of samples.
+//
+// @return - 0 for success, else failure.
+template <class F, class T>
+int filtfilt(F &filter, const T *input, T *output, size_t n);
+
+
+#include "FiltFilt.hpp"
+
+#endif
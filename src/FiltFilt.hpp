@@ -0,0 +1,109 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FiltFilt.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// FiltFilt.h
+//
+// Zero-phase forward-backward filtering for offline signals.
+// The implementation file.
+
+#ifndef __FILT_FILT_IMPL__
+#define __FILT_FILT_IMPL__
+
+#include "FiltFilt.h"
+
+// size of the blocks used for the backward pass.
+#define FILTFILT_BLOCK_LEN 1024
+
+// filtfilt
+// Runs the filter forwards and backwards over the input to give a zero-phase
+// output. The filter can be an FIRFilter or IIRFilter (anything with
+// filter, filterBlock, setSteadyState and getLength). The filter state is
+// overwritten.
+// NOTE: n must be greater than 3 * filter length.
+// @param filter - the filter to run.
+// @param input - the array of inputs.
+// @param output - the array to write the outputs to (length n), can be the same as input.
+// @param n - the number of samples.
+//
+// @return - 0 for success, else failure.
+template <class F, class T>
+int filtfilt(F &filter, const T *input, T *output, size_t n)
+{
+    size_t padLen = 3 * (size_t)filter.getLength();
+    if (input == NULL || output == NULL) { return -1; }
+    if (padLen == 0 || n <= padLen) { return -1; }
+
+    // working buffer: the forward output of the right extension, then
+    // two blocks for the backward pass.
+    T *work = new T[padLen + 2 * FILTFILT_BLOCK_LEN];
+    T *endExt = work;
+    T *blockIn = work + padLen;
+    T *blockOut = blockIn + FILTFILT_BLOCK_LEN;
+
+    T first = input[0];
+    T last = input[n - 1];
+
+    ////////////////// forward pass /////////////////
+    // left odd extension, ext[k] = 2 * x[0] - x[padLen - k]
+    filter.setSteadyState(2 * first - input[padLen]);
+    for (size_t k = padLen; k > 0; k--) { filter.filter(2 * first - input[k]); }
+
+    // the right extension is needed after output may have overwritten the
+    // input, so save it in the working buffer first.
+    for (size_t k = 1; k <= padLen; k++) { endExt[k - 1] = 2 * last - input[n - 1 - k]; }
+
+    // block filters read back over their input, so copy each block into
+    // the working buffer first in case input and output are the same.
+    for (size_t start = 0; start < n; start += FILTFILT_BLOCK_LEN) {
+        size_t len = (n - start < FILTFILT_BLOCK_LEN) ? n - start : FILTFILT_BLOCK_LEN;
+        for (size_t j = 0; j < len; j++) { blockIn[j] = input[start + j]; }
+        filter.filterBlock(blockIn, output + start, len);
+    }
+
+    // right odd extension, ext[k] = 2 * x[n-1] - x[n-1-k]
+    for (size_t k = 0; k < padLen; k++) { endExt[k] = filter.filter(endExt[k]); }
+
+    ////////////////// backward pass /////////////////
+    filter.setSteadyState(endExt[padLen - 1]);
+    for (size_t k = padLen; k > 0; k--) { filter.filter(endExt[k - 1]); }
+
+    // reverse each block into the working buffer, filter it, then write
+    // it back reversed. Blocks are taken from the end of the signal.
+    size_t end = n;
+    while (end > 0) {
+        size_t start = (end > FILTFILT_BLOCK_LEN) ? end - FILTFILT_BLOCK_LEN : 0;
+        size_t len = end - start;
+        for (size_t j = 0; j < len; j++) { blockIn[j] = output[end - 1 - j]; }
+        filter.filterBlock(blockIn, blockOut, len);
+        for (size_t j = 0; j < len; j++) { output[end - 1 - j] = blockOut[j]; }
+        end = start;
+    }
+    // the backward pass over the left extension isn't needed.
+
+    delete[] work;
+    return 0;
+} // end filtfilt
+
+
+#endif
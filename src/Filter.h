@@ -27,11 +27,46 @@
 #ifndef __FILTER__
 #define __FILTER__
 
+#include <cstddef>
+#include <limits>
+
+// SaturateOutput
+// The conversion done by saturateOutput, only integer types are clamped,
+// so types without an ordering (std::complex) still convert.
+template <typename T, bool isInteger = std::numeric_limits<T>::is_integer>
+struct SaturateOutput {
+    template <typename S>
+    static T convert(S x) { return (T)x; }
+};
+
+template <typename T>
+struct SaturateOutput<T, true> {
+    template <typename S>
+    static T convert(S x)
+    {
+        if (!(x == x)) { return 0; }
+        if (x >= (S)std::numeric_limits<T>::max()) { return std::numeric_limits<T>::max(); }
+        if (x <= (S)std::numeric_limits<T>::min()) { return std::numeric_limits<T>::min(); }
+        return (T)x;
+    }
+};
+
+// saturateOutput
+// Converts a value to the sample type T. For an integer T it is clamped
+// to the limits of T, and NaN gives 0, as converting an out of range value
+// to an integer is undefined.
+// @param x - the value to convert.
+//
+// @return - the value as a T.
+template <typename T, typename S>
+T saturateOutput(S x) { return SaturateOutput<T>::convert(x); }
+
 template <typename T>
 class Filter {
 public:
     Filter() {}
-    ~Filter() {}
+    // virtual, so filters made by a factory can be deleted through Filter.
+    virtual ~Filter() {}
 
     // update
     // The main function of all filter subclasses, is
@@ -48,6 +83,19 @@ public:
     //
     // @return - last output of filter, if there is an error NaN.
     virtual T getOutput() = 0;
+
+    // filterBlock
+    // Filters a block of n inputs, this is the same as calling filter on
+    // each input in order, and writing each result to output.
+    // Subclasses can override this with a faster block implementation,
+    // which like this one must allow output == input.
+    // @param input - the array of inputs to the filter.
+    // @param output - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    virtual void filterBlock(const T *input, T *output, size_t n)
+    {
+        for (size_t i = 0; i < n; i++) { output[i] = filter(input[i]); }
+    }
 };
 
 #endif
@@ -0,0 +1,211 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FilterInstrumentation.h
+// Written Ian Rankin - October 2026
+//
+// Optional instrumentation of the filter hot paths.
+// Define DSP_LITE_INSTRUMENT before including any filter (or pass
+// -DDSP_LITE_INSTRUMENT) to turn it on. When it is off the probe macros
+// compile to nothing and the filters have no extra members.
+//
+// When on, each filter keeps a FilterStats with:
+//  - the number of samples and calls (filter or filterBlock),
+//  - the total and max cycles per call, from the time stamp counter,
+//  - the number of integer outputs whose sum went past the limits of the
+//    type, so the output was saturated. This is checked on the accumulator
+//    before it is converted, so with a wider AccT every overflow is seen.
+//    A sum exactly at the limit is representable, so it isn't counted.
+//    With AccT the same integer type as the samples the sum wraps inside
+//    the accumulator and never goes past the limits, so overflow can't be
+//    detected at all; use a wider AccT to count it.
+//  - the number of NaN / Inf values seen in the output or IIR state.
+//
+// The counters are only written by the thread running the filter, and are
+// atomics so any other thread can read them without a lock. The saturated
+// count is the exception, parallelFilter's threads add to it at once.
+
+#ifndef __FILTER_INSTRUMENTATION__
+#define __FILTER_INSTRUMENTATION__
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define DSP_LITE_HAS_CYCLE_COUNTER 1
+#else
+#include <chrono>
+#define DSP_LITE_HAS_CYCLE_COUNTER 0
+#endif
+
+// readCycleCounter
+// returns the time stamp counter on x86. On other machines there isn't a
+// portable cycle counter, so this returns nanoseconds from a steady clock.
+inline uint64_t readCycleCounter()
+{
+#if DSP_LITE_HAS_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+#ifdef DSP_LITE_INSTRUMENT
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+// A copy of the counters at one point in time.
+struct FilterStatsSnapshot {
+    uint64_t samples;
+    uint64_t calls;
+    uint64_t totalCycles;
+    uint64_t maxCycles;
+    uint64_t saturated;
+    uint64_t nonFinite;
+
+    // averageCycles
+    // returns the average cycles per call.
+    double averageCycles() const { return calls ? (double)totalCycles / calls : 0.0; }
+};
+
+// The counters kept by each filter.
+class FilterStats {
+public:
+    FilterStats() { clear(); }
+    FilterStats(const FilterStats &other) { copy(other); }
+    FilterStats &operator=(const FilterStats &other) { copy(other); return *this; }
+
+    // record
+    // adds a call that took the given cycles and processed n samples.
+    // Only the filter's own thread writes, so a load and store is enough.
+    void record(uint64_t cycles, uint64_t n)
+    {
+        add(samples, n);
+        add(calls, 1);
+        add(totalCycles, cycles);
+        if (cycles > maxCycles.load(std::memory_order_relaxed)) {
+            maxCycles.store(cycles, std::memory_order_relaxed);
+        }
+    }
+
+    // checkOutput
+    // counts non finite float outputs.
+    template <class T>
+    void checkOutput(T y) { checkFinite(y, std::is_floating_point<T>()); }
+
+    // checkAcc
+    // counts an accumulator past the limits of the integer output
+    // type T, an output that saturates. Several threads can call this at
+    // once, so it adds atomically.
+    template <class T, class A>
+    void checkAcc(A acc) { checkAcc<T>(acc, std::is_integral<T>()); }
+
+    // checkState
+    // counts non finite values in the filter state.
+    template <class T>
+    void checkState(T w) { checkFinite(w, std::is_floating_point<T>()); }
+
+    // snapshot
+    // returns a copy of all of the counters, safe to call from any thread.
+    FilterStatsSnapshot snapshot() const
+    {
+        FilterStatsSnapshot s;
+        s.samples = samples.load(std::memory_order_relaxed);
+        s.calls = calls.load(std::memory_order_relaxed);
+        s.totalCycles = totalCycles.load(std::memory_order_relaxed);
+        s.maxCycles = maxCycles.load(std::memory_order_relaxed);
+        s.saturated = saturated.load(std::memory_order_relaxed);
+        s.nonFinite = nonFinite.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // clear
+    // zeros all of the counters.
+    void clear()
+    {
+        samples.store(0, std::memory_order_relaxed);
+        calls.store(0, std::memory_order_relaxed);
+        totalCycles.store(0, std::memory_order_relaxed);
+        maxCycles.store(0, std::memory_order_relaxed);
+        saturated.store(0, std::memory_order_relaxed);
+        nonFinite.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static void add(std::atomic<uint64_t> &counter, uint64_t n)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    template <class T, class A>
+    void checkAcc(A acc, std::true_type)
+    {
+        if (acc > (A)std::numeric_limits<T>::max() || acc < (A)std::numeric_limits<T>::min()) {
+            saturated.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    template <class T, class A>
+    void checkAcc(A, std::false_type) {}
+
+    template <class T>
+    void checkFinite(T w, std::true_type) { if (!std::isfinite(w)) { add(nonFinite, 1); } }
+    template <class T>
+    void checkFinite(T, std::false_type) {}
+
+    void copy(const FilterStats &other)
+    {
+        FilterStatsSnapshot s = other.snapshot();
+        samples.store(s.samples, std::memory_order_relaxed);
+        calls.store(s.calls, std::memory_order_relaxed);
+        totalCycles.store(s.totalCycles, std::memory_order_relaxed);
+        maxCycles.store(s.maxCycles, std::memory_order_relaxed);
+        saturated.store(s.saturated, std::memory_order_relaxed);
+        nonFinite.store(s.nonFinite, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> samples;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> totalCycles;
+    std::atomic<uint64_t> maxCycles;
+    std::atomic<uint64_t> saturated;
+    std::atomic<uint64_t> nonFinite;
+};
+
+#define FILTER_PROBE_START() uint64_t filterProbeStart = readCycleCounter()
+#define FILTER_PROBE_END(stats, n) (stats).record(readCycleCounter() - filterProbeStart, (n))
+#define FILTER_PROBE_OUTPUT(stats, y) (stats).checkOutput(y)
+#define FILTER_PROBE_ACC(stats, T, acc) (stats).checkAcc<T>(acc)
+#define FILTER_PROBE_STATE(stats, w) (stats).checkState(w)
+
+#else
+
+#define FILTER_PROBE_START() ((void)0)
+#define FILTER_PROBE_END(stats, n) ((void)0)
+#define FILTER_PROBE_OUTPUT(stats, y) ((void)0)
+#define FILTER_PROBE_ACC(stats, T, acc) ((void)0)
+#define FILTER_PROBE_STATE(stats, w) ((void)0)
+
+#endif // DSP_LITE_INSTRUMENT
+
+#endif
@@ -0,0 +1,246 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FilterSnapshot.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FIRFilter.h
+// IIRFilter.h
+// MappedFile.h
+// FilterSnapshot.hpp
+//
+// A binary snapshot of filter state, so a restarted process can carry on
+// filtering where it left off, instead of starting with zeroed delay lines.
+// Each record holds the delay line, its position, the last output, and a
+// hash of the coefficients, so a state is never restored into a filter
+// with different taps. The coefficients themselves aren't saved.
+//
+// File layout, all 8 byte aligned, in the byte order of the writer:
+//   SnapshotHeader
+//   records: SnapshotRecord, last output, delay line
+//   offset of each record, uint64_t[count]
+//   SnapshotTrailer (count and offset of the table)
+// The table and trailer go at the end, so the file is written in one
+// sequential pass. The reader maps the file and looks records up by index
+// in the table, so opening doesn't depend on the number of filters, and
+// restoring a filter is a few checks and a copy of its delay line.
+//
+// Example:
+// SnapshotWriter writer;
+// writer.open("filters.snap");
+// for (i...) { writer.add(filters[i]); }
+// writer.close();
+// ...
+// SnapshotReader reader;
+// reader.open("filters.snap");
+// for (i...) { reader.restore(i, filters[i]); }
+
+#ifndef __FILTER_SNAPSHOT__
+#define __FILTER_SNAPSHOT__
+
+#include "FIRFilter.h"
+#include "IIRFilter.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_MAGIC "DSPSNAP"
+#define SNAPSHOT_ENDIAN 0x01020304u
+
+// record kinds.
+#define SNAPSHOT_FIR 1
+#define SNAPSHOT_IIR 2
+
+// Start of the file.
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+};
+
+// Start of each record, followed by the last output and the delay line,
+// each padded to 8 bytes.
+struct SnapshotRecord {
+    uint32_t kind;        // SNAPSHOT_FIR or SNAPSHOT_IIR.
+    uint16_t sampleType;  // snapshotTypeCode of the sample type.
+    uint16_t stateType;   // snapshotTypeCode of the delay line type.
+    uint32_t length;      // delay line length.
+    uint32_t position;    // position of the next input in the delay line.
+    uint32_t ffLength;    // FIR length, or IIR feed forward length.
+    uint32_t fbLength;    // IIR feedback length, 0 for FIR.
+    uint64_t coefficients; // coefficientHash of the taps.
+    uint64_t tag;         // free for the user, e.g. a stream id.
+};
+
+// End of the file.
+struct SnapshotTrailer {
+    uint64_t tableOffset;
+    uint32_t count;
+    uint32_t version;
+    char magic[8];
+};
+
+// snapshotTypeCode
+// identifies a sample type by its size, and whether it is an integer and
+// signed, so a float state is never read as an int32.
+template <class T>
+uint16_t snapshotTypeCode();
+
+// coefficientHash
+// 64 bit FNV-1a hash of the bytes of a set of coefficients.
+// @param coefficients - the taps.
+// @param length - the number of taps.
+// @param hash - the hash to continue from, to hash more than one array.
+//
+// @return - the hash.
+template <class C>
+uint64_t coefficientHash(const C *coefficients, uint32_t length,
+                        uint64_t hash = 14695981039346656037ull);
+
+class SnapshotWriter {
+public:
+    SnapshotWriter();
+    ~SnapshotWriter();
+
+    // open
+    // Creates the file, and writes the header.
+    // @param path - the file to write.
+    //
+    // @return - 0 for success, else failure.
+    int open(const char *path);
+
+    // add
+    // Appends the state of a filter.
+    // @param filter - the filter to save.
+    // @param tag - stored with the record, for the user.
+    //
+    // @return - 0 for success, else failure.
+    template <class S, class C, class A>
+    int add(FIRFilter<S, C, A> &filter, uint64_t tag = 0);
+    template <class S, class C, class A>
+    int add(IIRFilter<S, C, A> &filter, uint64_t tag = 0);
+
+    // close
+    // Writes the table and trailer, and closes the file. The file is only
+    // valid once this returns 0.
+    //
+    // @return - 0 for success, else failure.
+    int close();
+
+    // getCount
+    // @return - the number of records added.
+    uint32_t getCount() const { return (uint32_t)offsets.size(); }
+
+private:
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    // addRecord
+    // writes a record, its last output and delay line.
+    int addRecord(const SnapshotRecord &record, const void *out, size_t outSize,
+                const void *line, size_t lineSize);
+
+    // write
+    // writes bytes, padded with zeros to 8 bytes.
+    void write(const void *data, size_t size);
+
+    FILE *file;
+    uint64_t offset;
+    std::vector<uint64_t> offsets;
+    bool failed;
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader();
+    ~SnapshotReader();
+
+    // open
+    // Maps a snapshot file (reads it in where there is no mmap), and
+    // checks the header and trailer.
+    // @param path - the file to read.
+    //
+    // @return - 0 for success, else failure.
+    int open(const char *path);
+
+    // openMemory
+    // Uses a snapshot already in memory, which must stay valid and be 8
+    // byte aligned.
+    // @param data - the snapshot.
+    // @param size - the size in bytes.
+    //
+    // @return - 0 for success, else failure.
+    int openMemory(const void *data, size_t size);
+
+    // close
+    // unmaps the file.
+    void close();
+
+    // getCount
+    // @return - the number of records.
+    uint32_t getCount() const { return count; }
+
+    // getRecord
+    // @param index - the record number, in the order they were added.
+    //
+    // @return - the record, or NULL if out of range or damaged.
+    const SnapshotRecord *getRecord(uint32_t index) const;
+
+    // restore
+    // Restores a filter from a record. Fails if the record is for a
+    // different kind of filter, types, lengths or coefficients.
+    // @param index - the record number.
+    // @param filter - the filter to restore, already set up with its taps.
+    //
+    // @return - 0 for success, else failure.
+    template <class S, class C, class A>
+    int restore(uint32_t index, FIRFilter<S, C, A> &filter) const;
+    template <class S, class C, class A>
+    int restore(uint32_t index, IIRFilter<S, C, A> &filter) const;
+
+private:
+    SnapshotReader(const SnapshotReader &) = delete;
+    SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+    // check
+    // checks the header and trailer, and finds the table.
+    int check(const void *bytes, size_t length);
+
+    // payload
+    // returns the last output and delay line of a record, checking they
+    // are inside the file.
+    const uint8_t *payload(const SnapshotRecord *record, size_t outSize,
+                        size_t lineSize) const;
+
+    const uint8_t *data;
+    size_t size;
+    const uint64_t *table;
+    uint64_t tableOffset;
+    uint32_t count;
+    MappedFile file;
+};
+
+// include implementation file
+#include "FilterSnapshot.hpp"
+
+#endif
@@ -0,0 +1,383 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FilterSnapshot.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FilterSnapshot.h
+//
+// A binary snapshot of filter state.
+// The implementation file.
+
+#ifndef __FILTER_SNAPSHOT_IMPL__
+#define __FILTER_SNAPSHOT_IMPL__
+
+#include "FilterSnapshot.h"
+#include <cstring>
+#include <limits>
+
+
+// snapshotPad
+// rounds a size up to 8 bytes.
+inline size_t snapshotPad(size_t size) { return (size + 7) & ~(size_t)7; }
+
+// snapshotTypeCode
+// identifies a sample type by its size, and whether it is an integer and
+// signed, so a float state is never read as an int32.
+template <class T>
+uint16_t snapshotTypeCode()
+{
+    uint16_t code = (uint16_t)sizeof(T);
+    if (std::numeric_limits<T>::is_integer) { code |= 0x100; }
+    if (!std::numeric_limits<T>::is_signed) { code |= 0x200; }
+    return code;
+}
+
+// coefficientHash
+// 64 bit FNV-1a hash of the bytes of a set of coefficients.
+// @param coefficients - the taps.
+// @param length - the number of taps.
+// @param hash - the hash to continue from, to hash more than one array.
+//
+// @return - the hash.
+template <class C>
+uint64_t coefficientHash(const C *coefficients, uint32_t length, uint64_t hash)
+{
+    if (coefficients == NULL) { return hash; }
+    const uint8_t *bytes = (const uint8_t *)coefficients;
+    size_t n = (size_t)length * sizeof(C);
+    for (size_t i = 0; i < n; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+
+///////////////////////////// writer /////////////////////////////
+
+inline SnapshotWriter::SnapshotWriter()
+{
+    file = NULL;
+    offset = 0;
+    failed = false;
+}
+
+inline SnapshotWriter::~SnapshotWriter()
+{
+    if (file != NULL) { close(); }
+}
+
+// open
+// Creates the file, and writes the header.
+// @param path - the file to write.
+//
+// @return - 0 for success, else failure.
+inline int SnapshotWriter::open(const char *path)
+{
+    if (file != NULL || path == NULL) { return -1; }
+    file = fopen(path, "wb");
+    if (file == NULL) { return -1; }
+    offset = 0;
+    offsets.clear();
+    failed = false;
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.endian = SNAPSHOT_ENDIAN;
+    write(&header, sizeof(header));
+    return failed ? -1 : 0;
+} // end open
+
+// write
+// writes bytes, padded with zeros to 8 bytes.
+inline void SnapshotWriter::write(const void *bytes, size_t size)
+{
+    static const uint8_t zeros[8] = {0};
+    size_t padded = snapshotPad(size);
+    if (fwrite(bytes, 1, size, file) != size ||
+            fwrite(zeros, 1, padded - size, file) != padded - size) {
+        failed = true;
+    }
+    offset += padded;
+}
+
+// addRecord
+// writes a record, its last output and delay line.
+inline int SnapshotWriter::addRecord(const SnapshotRecord &record, const void *out,
+                                    size_t outSize, const void *line, size_t lineSize)
+{
+    if (file == NULL || failed) { return -1; }
+    offsets.push_back(offset);
+    write(&record, sizeof(record));
+    write(out, outSize);
+    write(line, lineSize);
+    return failed ? -1 : 0;
+}
+
+// add
+// Appends the state of an FIR filter.
+// @param filter - the filter to save.
+// @param tag - stored with the record, for the user.
+//
+// @return - 0 for success, else failure.
+template <class S, class C, class A>
+int SnapshotWriter::add(FIRFilter<S, C, A> &filter, uint64_t tag)
+{
+    SnapshotRecord record;
+    memset(&record, 0, sizeof(record));
+    record.kind = SNAPSHOT_FIR;
+    record.sampleType = snapshotTypeCode<S>();
+    record.stateType = snapshotTypeCode<S>();
+    record.length = filter.getLength();
+    record.position = filter.getDelayPosition();
+    record.ffLength = filter.getLength();
+    record.coefficients = coefficientHash(filter.getGains(), filter.getLength());
+    record.tag = tag;
+    S out = filter.getOutput();
+    return addRecord(record, &out, sizeof(S), filter.getDelayLine(),
+                    (size_t)record.length * sizeof(S));
+}
+
+// add
+// Appends the state of an IIR filter.
+// @param filter - the filter to save.
+// @param tag - stored with the record, for the user.
+//
+// @return - 0 for success, else failure.
+template <class S, class C, class A>
+int SnapshotWriter::add(IIRFilter<S, C, A> &filter, uint64_t tag)
+{
+    SnapshotRecord record;
+    memset(&record, 0, sizeof(record));
+    record.kind = SNAPSHOT_IIR;
+    record.sampleType = snapshotTypeCode<S>();
+    record.stateType = snapshotTypeCode<A>();
+    record.length = filter.getLength();
+    record.position = filter.getDelayPosition();
+    record.ffLength = filter.getFeedForwardLength();
+    record.fbLength = filter.getFeedbackLength();
+    record.coefficients = coefficientHash(filter.getFeedbackGains(), record.fbLength,
+                    coefficientHash(filter.getFeedForwardGains(), record.ffLength));
+    record.tag = tag;
+    S out = filter.getOutput();
+    return addRecord(record, &out, sizeof(S), filter.getDelayLine(),
+                    (size_t)record.length * sizeof(A));
+}
+
+// close
+// Writes the table and trailer, and closes the file.
+//
+// @return - 0 for success, else failure.
+inline int SnapshotWriter::close()
+{
+    if (file == NULL) { return -1; }
+    SnapshotTrailer trailer;
+    memset(&trailer, 0, sizeof(trailer));
+    trailer.tableOffset = offset;
+    trailer.count = (uint32_t)offsets.size();
+    trailer.version = SNAPSHOT_VERSION;
+    memcpy(trailer.magic, SNAPSHOT_MAGIC, sizeof(trailer.magic));
+
+    if (!offsets.empty()) { write(&offsets[0], offsets.size() * sizeof(uint64_t)); }
+    write(&trailer, sizeof(trailer));
+    if (fclose(file) != 0) { failed = true; }
+    file = NULL;
+    return failed ? -1 : 0;
+} // end close
+
+
+///////////////////////////// reader /////////////////////////////
+
+inline SnapshotReader::SnapshotReader()
+{
+    data = NULL;
+    size = 0;
+    table = NULL;
+    tableOffset = 0;
+    count = 0;
+}
+
+inline SnapshotReader::~SnapshotReader()
+{
+    close();
+}
+
+// open
+// Maps a snapshot file, and checks the header and trailer.
+// @param path - the file to read.
+//
+// @return - 0 for success, else failure.
+inline int SnapshotReader::open(const char *path)
+{
+    close();
+    if (file.open(path) != 0 || check(file.getData(), file.getSize()) != 0) {
+        close();
+        return -1;
+    }
+    return 0;
+} // end open
+
+// openMemory
+// Uses a snapshot already in memory.
+// @param bytes - the snapshot.
+// @param length - the size in bytes.
+//
+// @return - 0 for success, else failure.
+inline int SnapshotReader::openMemory(const void *bytes, size_t length)
+{
+    close();
+    return check(bytes, length);
+}
+
+// check
+// Checks the header and trailer of a snapshot, and finds the table.
+// @param bytes - the snapshot.
+// @param length - the size in bytes.
+//
+// @return - 0 for success, else failure.
+inline int SnapshotReader::check(const void *bytes, size_t length)
+{
+    if (bytes == NULL || ((uintptr_t)bytes & 7) != 0 ||
+            length < sizeof(SnapshotHeader) + sizeof(SnapshotTrailer)) {
+        return -1;
+    }
+
+    const uint8_t *base = (const uint8_t *)bytes;
+    const SnapshotHeader *header = (const SnapshotHeader *)base;
+    const SnapshotTrailer *trailer =
+        (const SnapshotTrailer *)(base + length - sizeof(SnapshotTrailer));
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+            memcmp(trailer->magic, SNAPSHOT_MAGIC, sizeof(trailer->magic)) != 0 ||
+            header->version != SNAPSHOT_VERSION || trailer->version != SNAPSHOT_VERSION ||
+            header->endian != SNAPSHOT_ENDIAN) {
+        return -1;
+    }
+    // the table has to fit exactly between the records and the trailer.
+    if (trailer->tableOffset > length) { return -1; }
+    uint64_t tableEnd = trailer->tableOffset + snapshotPad((size_t)trailer->count * 8);
+    if (trailer->tableOffset < sizeof(SnapshotHeader) || (trailer->tableOffset & 7) != 0 ||
+            tableEnd != length - sizeof(SnapshotTrailer)) {
+        return -1;
+    }
+
+    data = base;
+    size = length;
+    tableOffset = trailer->tableOffset;
+    table = (const uint64_t *)(base + tableOffset);
+    count = trailer->count;
+    return 0;
+} // end check
+
+// close
+// unmaps the file.
+inline void SnapshotReader::close()
+{
+    file.close();
+    data = NULL;
+    table = NULL;
+    count = 0;
+}
+
+// getRecord
+// @param index - the record number, in the order they were added.
+//
+// @return - the record, or NULL if out of range or damaged.
+inline const SnapshotRecord *SnapshotReader::getRecord(uint32_t index) const
+{
+    if (data == NULL || index >= count) { return NULL; }
+    uint64_t at = table[index];
+    if (at < sizeof(SnapshotHeader) || (at & 7) != 0 ||
+            at + sizeof(SnapshotRecord) > tableOffset) {
+        return NULL;
+    }
+    return (const SnapshotRecord *)(data + at);
+}
+
+// payload
+// returns the last output and delay line of a record, checking they are
+// inside the file.
+inline const uint8_t *SnapshotReader::payload(const SnapshotRecord *record,
+                                            size_t outSize, size_t lineSize) const
+{
+    const uint8_t *start = (const uint8_t *)(record + 1);
+    uint64_t end = (uint64_t)(start - data) + snapshotPad(outSize) + snapshotPad(lineSize);
+    if (end > tableOffset) { return NULL; }
+    return start;
+}
+
+// restore
+// Restores an FIR filter from a record.
+// @param index - the record number.
+// @param filter - the filter to restore, already set up with its taps.
+//
+// @return - 0 for success, else failure.
+template <class S, class C, class A>
+int SnapshotReader::restore(uint32_t index, FIRFilter<S, C, A> &filter) const
+{
+    const SnapshotRecord *record = getRecord(index);
+    if (record == NULL || record->kind != SNAPSHOT_FIR ||
+            record->sampleType != snapshotTypeCode<S>() ||
+            record->stateType != snapshotTypeCode<S>() ||
+            record->length != filter.getLength() ||
+            record->coefficients != coefficientHash(filter.getGains(), filter.getLength())) {
+        return -1;
+    }
+    const uint8_t *p = payload(record, sizeof(S), (size_t)record->length * sizeof(S));
+    if (p == NULL) { return -1; }
+
+    S out;
+    memcpy(&out, p, sizeof(S));
+    return filter.setState((const S *)(p + snapshotPad(sizeof(S))), record->position, out);
+}
+
+// restore
+// Restores an IIR filter from a record.
+// @param index - the record number.
+// @param filter - the filter to restore, already set up with its taps.
+//
+// @return - 0 for success, else failure.
+template <class S, class C, class A>
+int SnapshotReader::restore(uint32_t index, IIRFilter<S, C, A> &filter) const
+{
+    const SnapshotRecord *record = getRecord(index);
+    if (record == NULL || record->kind != SNAPSHOT_IIR ||
+            record->sampleType != snapshotTypeCode<S>() ||
+            record->stateType != snapshotTypeCode<A>() ||
+            record->length != filter.getLength() ||
+            record->ffLength != filter.getFeedForwardLength() ||
+            record->fbLength != filter.getFeedbackLength()) {
+        return -1;
+    }
+    uint64_t hash = coefficientHash(filter.getFeedbackGains(), record->fbLength,
+                    coefficientHash(filter.getFeedForwardGains(), record->ffLength));
+    if (record->coefficients != hash) { return -1; }
+    const uint8_t *p = payload(record, sizeof(S), (size_t)record->length * sizeof(A));
+    if (p == NULL) { return -1; }
+
+    S out;
+    memcpy(&out, p, sizeof(S));
+    return filter.setState((const A *)(p + snapshotPad(sizeof(S))), record->position, out);
+}
+
+
+#endif
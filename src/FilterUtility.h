@@ -37,7 +37,7 @@
 //
 // @return - 0 for success, else failure.
 template <class T>
-int applyHammingWindow(T *input, uint16_t length);
+int applyHammingWindow(T *input, uint32_t length);
 
 
 // applyKaiserWindow
@@ -49,15 +49,16 @@ int applyHammingWindow(T *input, uint16_t length);
 //
 // @return - 0 for success, else failure.
 template <class T>
-int applyKaiserWindow(T *input, uint16_t N, double A);
+int applyKaiserWindow(T *input, uint32_t N, double A);
 
 // calcKaiserLen
 // This function applies a hamming window to an arbituary input
 // @param A - the stopband attenuation required (dB).
 // @param deltaW - the size of the frequency between pass and stop bands.
 //
-// @return - length of filter required.
-uint16_t calcKaiserLen(double A, double deltaW);
+// @return - length of filter required, 0 if deltaW isn't positive or the
+//            length doesn't fit in a uint32_t.
+uint32_t calcKaiserLen(double A, double deltaW);
 
 // idealFilterCoef
 // this function returns N gains from an ideal low pass filter.
@@ -70,7 +71,22 @@ uint16_t calcKaiserLen(double A, double deltaW);
 //
 // @return - the filter coefficients given as an array.
 template <class T>
-T *idealFilterCoef(double omegaCutoff, uint16_t N, bool isHighPassFilter = false);
+T *idealFilterCoef(double omegaCutoff, uint32_t N, bool isHighPassFilter = false);
+
+// idealFilterCoef
+// this function writes N gains from an ideal low pass filter into the
+// given array, without allocating any memory.
+// This is equivilent to a rectangular window.
+// NOTE: the length must be odd.
+// @param gains - the array to write the filter coefficients to (length N).
+// @param omegaCutoff - the cutoff frequency of the filter.
+// @param N - the length of the filter.
+// @param isHighPassFilter - says which filter type to compute, 0 for lowpass,
+//           1 for high pass filter.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int idealFilterCoef(T *gains, double omegaCutoff, uint32_t N, bool isHighPassFilter = false);
 
 
 // idealDifferentiatorCoef
@@ -81,13 +97,46 @@ T *idealFilterCoef(double omegaCutoff, uint16_t N, bool isHighPassFilter = false
 //
 // @return - the filter coefficients given as an array.
 template <class T>
-T *idealDifferentiatorCoef(uint16_t N);
+T *idealDifferentiatorCoef(uint32_t N);
+
+// idealDifferentiatorCoef
+// this function writes N gains from an ideal differentiator into the
+// given array, without allocating any memory.
+// NOTE: the length must be odd.
+// @param gains - the array to write the filter coefficients to (length N).
+// @param N - the length of the filter.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int idealDifferentiatorCoef(T *gains, uint32_t N);
 
 // besselFunc
 // calculate the bessel function of the first order.
 // This is taken directly from [1] p. 472.
 double besselFunc(double x);
 
+// kaiserAlpha
+// calculates the kaiser window shape parameter for a given attenuation.
+// @param A - stopband attenuation required in dB
+//
+// @return - the alpha (beta) parameter of the kaiser window.
+double kaiserAlpha(double A);
+
+// the most values sinCosBlock can compute in one call.
+#define SINCOS_BLOCK_LEN 256
+
+// sinCosBlock
+// Computes sin(n * theta) and cos(n * theta) for n = start, ..., start + len - 1.
+// Only the first value is computed with sin and cos, the rest are found by
+// rotating several points side by side, which vectorizes. The error is a
+// few ulps.
+// @param theta - the angle step.
+// @param start - the first n.
+// @param len - the number of values, at most SINCOS_BLOCK_LEN.
+// @param sinOut - array to write sin(n * theta) to, NULL if not needed.
+// @param cosOut - array to write cos(n * theta) to, NULL if not needed.
+void sinCosBlock(double theta, uint32_t start, uint32_t len, double *sinOut, double *cosOut);
+
 
 
 
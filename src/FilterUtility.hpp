@@ -42,9 +42,9 @@
 //
 // @return - 0 for success, else failure.
 template <class T>
-int applyHammingWindow(T *input, uint16_t N)
+int applyHammingWindow(T *input, uint32_t N)
 {
-    for (uint16_t n = 0; n < N; n++)
+    for (uint32_t n = 0; n < N; n++)
     {
         double w = 0.54 - (0.46 * cos(2 * M_PI * n / (N - 1)));
         input[n] = (T)((double)input[n] * w);
@@ -63,22 +63,14 @@ int applyHammingWindow(T *input, uint16_t N)
 //
 // @return - 0 for success, else failure.
 template <class T>
-int applyKaiserWindow(T *input, uint16_t N, double A)
+int applyKaiserWindow(T *input, uint32_t N, double A)
 {
-    double alpha;
-    if (A >= 50.0) {
-        alpha = 0.1102 * (A - 8.7);
-    } else if (A > 21.0) {
-        double lhs = 0.5842 * pow(A-21, 0.4);
-        alpha = lhs + (0.07886 * (A - 21));
-    } else {
-        alpha = 0;
-    }
+    double alpha = kaiserAlpha(A);
 
     double denominator = besselFunc(alpha);
     double M = (double)((int)(N / 2));
 
-    for (uint16_t n = 0; n < N; n++)
+    for (uint32_t n = 0; n < N; n++)
     {
         double w = besselFunc(alpha *
             sqrt(1.0 - ((n - M) * (n - M) / (M * M))))
@@ -103,33 +95,58 @@ int applyKaiserWindow(T *input, uint16_t N, double A)
 //
 // @return - the filter coefficients given as an array.
 template <class T>
-T *idealFilterCoef(double omegaCutoff, uint16_t N, bool isHighPassFilter)
+T *idealFilterCoef(double omegaCutoff, uint32_t N, bool isHighPassFilter)
 {
-    uint16_t M = N / 2; // returns the center index of the filter.
     if (N % 2 == 0) { return NULL; }
     // init the gains
     T *gains = new T[N];
-
-    for (int16_t k = 0; k < N; k++)
-    {
-        double w;
-        if (isHighPassFilter) {
-            // define coefficients for high pass filter.
-            if (k == M) { w = 1.0 - (omegaCutoff / M_PI); }
-            else { w = -sin(omegaCutoff * (k - M)) / (M_PI * (k - M)); }
-        } else {
-            // define coefficients for low pass filter.
-            if (k == M) { w = omegaCutoff / M_PI; }
-            else { w = sin(omegaCutoff * (k - M)) / (M_PI * (k - M)); }
-        } // end if else for high pass filtering
-
-        gains[k] = w;
-    } // end for loop.
+    idealFilterCoef(gains, omegaCutoff, N, isHighPassFilter);
 
     return gains;
 } // end idealLowpassCoef
 
 
+// idealFilterCoef
+// this function writes N gains from an ideal low pass filter into the
+// given array, without allocating any memory.
+// This is equivilent to a rectangular window.
+// NOTE: the length must be odd.
+// @param gains - the array to write the filter coefficients to (length N).
+// @param omegaCutoff - the cutoff frequency of the filter.
+// @param N - the length of the filter.
+// @param isHighPassFilter - says which filter type to compute, 0 for lowpass,
+//           1 for high pass filter.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int idealFilterCoef(T *gains, double omegaCutoff, uint32_t N, bool isHighPassFilter)
+{
+    uint32_t M = N / 2; // returns the center index of the filter.
+    if (N % 2 == 0 || gains == NULL) { return -1; }
+
+    double sign = isHighPassFilter ? -1.0 : 1.0;
+    // define coefficients for the center of the filter.
+    if (isHighPassFilter) { gains[M] = 1.0 - (omegaCutoff / M_PI); }
+    else { gains[M] = omegaCutoff / M_PI; }
+
+    // the filter is symmetric, so only compute sin(omegaCutoff * j) for
+    // j = 1 ... M, a block at a time.
+    double s[SINCOS_BLOCK_LEN];
+    for (uint32_t start = 1; start <= M; start += SINCOS_BLOCK_LEN) {
+        uint32_t len = (M + 1 - start < SINCOS_BLOCK_LEN) ? M + 1 - start : SINCOS_BLOCK_LEN;
+        sinCosBlock(omegaCutoff, start, len, s, NULL);
+        for (uint32_t i = 0; i < len; i++) {
+            uint32_t j = start + i;
+            double w = sign * s[i] / (M_PI * j);
+            gains[M + j] = w;
+            gains[M - j] = w;
+        }
+    } // end for loop.
+
+    return 0;
+} // end idealFilterCoef
+
+
 // idealDifferentiatorCoef
 // this function returns N gains from an ideal low pass filter.
 // This is equivilent to a rectangular window.
@@ -138,25 +155,42 @@ T *idealFilterCoef(double omegaCutoff, uint16_t N, bool isHighPassFilter)
 //
 // @return - the filter coefficients given as an array.
 template <class T>
-T *idealDifferentiatorCoef(uint16_t N)
+T *idealDifferentiatorCoef(uint32_t N)
 {
-    uint16_t M = N / 2; // returns the center index of the filter.
     if (N % 2 == 0) { return NULL; }
     // init the gains
     T *gains = new T[N];
+    idealDifferentiatorCoef(gains, N);
+
+    return gains;
+} // end idealDifferentiatorCoef
 
-    for (int16_t k = 0; k < N; k++)
-    {
-        double w;
-        if (k == M) { w = 0.0; }
-        else { w = (cos(M_PI * (k - M)) / (k - M)) -
-            (sin(M_PI * (k - M)) / (M_PI * (k - M) * (k - M))); }
 
-        gains[k] = w;
+// idealDifferentiatorCoef
+// this function writes N gains from an ideal differentiator into the
+// given array, without allocating any memory.
+// NOTE: the length must be odd.
+// @param gains - the array to write the filter coefficients to (length N).
+// @param N - the length of the filter.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int idealDifferentiatorCoef(T *gains, uint32_t N)
+{
+    uint32_t M = N / 2; // returns the center index of the filter.
+    if (N % 2 == 0 || gains == NULL) { return -1; }
+
+    // at integer j, cos(pi * j) / j - sin(pi * j) / (pi * j^2) is
+    // just (-1)^j / j, so no trig functions are needed.
+    gains[M] = 0.0;
+    for (uint32_t j = 1; j <= M; j++) {
+        double w = ((j % 2) ? -1.0 : 1.0) / j;
+        gains[M + j] = w;
+        gains[M - j] = -w;
     } // end for loop.
 
-    return gains;
-} // end idealLowpassCoef
+    return 0;
+} // end idealDifferentiatorCoef
 
 
 // calcKaiserLen
@@ -164,8 +198,9 @@ T *idealDifferentiatorCoef(uint16_t N)
 // @param A - the stopband attenuation required (dB).
 // @param deltaW - the size of the frequency between pass and stop bands.
 //
-// @return - length of filter required.
-uint16_t calcKaiserLen(double A, double deltaW)
+// @return - length of filter required, 0 if deltaW isn't positive or the
+//            length doesn't fit in a uint32_t.
+inline uint32_t calcKaiserLen(double A, double deltaW)
 {
     double D;
     if (A > 21.0) {
@@ -174,7 +209,11 @@ uint16_t calcKaiserLen(double A, double deltaW)
         D = 0.922;
     }
 
-    uint16_t N = ceil((D / deltaW) + 1);
+    // worked out in double, converting a length too big for the result
+    // would silently wrap.
+    double len = ceil((D / deltaW) + 1);
+    if (!(deltaW > 0.0) || !(len < (double)UINT32_MAX)) { return 0; }
+    uint32_t N = (uint32_t)len;
     if (N % 2 == 0) { N++; } // check to make sure is odd length.
 
     return N;
@@ -185,7 +224,7 @@ uint16_t calcKaiserLen(double A, double deltaW)
 // besselFunc
 // calculate the bessel function of the first order.
 // This is taken directly from [1] p. 472.
-double besselFunc(double x)
+inline double besselFunc(double x)
 {
     int n = 1;
     double S = 1;
@@ -201,6 +240,65 @@ double besselFunc(double x)
     return S;
 }
 
+// number of points rotated side by side in sinCosBlock.
+#define SINCOS_LANES 8
+
+// sinCosBlock
+// Computes sin(n * theta) and cos(n * theta) for n = start, ..., start + len - 1.
+// Only the first value is computed with sin and cos, the rest are found by
+// rotating several points side by side, which vectorizes. The error is a
+// few ulps.
+// @param theta - the angle step.
+// @param start - the first n.
+// @param len - the number of values, at most SINCOS_BLOCK_LEN.
+// @param sinOut - array to write sin(n * theta) to, NULL if not needed.
+// @param cosOut - array to write cos(n * theta) to, NULL if not needed.
+inline void sinCosBlock(double theta, uint32_t start, uint32_t len, double *sinOut, double *cosOut)
+{
+    double c[SINCOS_LANES];
+    double s[SINCOS_LANES];
+    for (int l = 0; l < SINCOS_LANES; l++) {
+        c[l] = cos((start + l) * theta);
+        s[l] = sin((start + l) * theta);
+    }
+    // each lane is rotated forward by SINCOS_LANES * theta each step.
+    double stepC = cos(SINCOS_LANES * theta);
+    double stepS = sin(SINCOS_LANES * theta);
+
+    for (uint32_t n = 0; n < len; n += SINCOS_LANES) {
+        for (int l = 0; l < SINCOS_LANES; l++) {
+            if (n + l < len) {
+                if (sinOut != NULL) { sinOut[n + l] = s[l]; }
+                if (cosOut != NULL) { cosOut[n + l] = c[l]; }
+            }
+        }
+        for (int l = 0; l < SINCOS_LANES; l++) {
+            double cn = c[l] * stepC - s[l] * stepS;
+            s[l] = s[l] * stepC + c[l] * stepS;
+            c[l] = cn;
+        }
+    }
+} // end sinCosBlock
+
+// kaiserAlpha
+// calculates the kaiser window shape parameter for a given attenuation.
+// @param A - stopband attenuation required in dB
+//
+// @return - the alpha (beta) parameter of the kaiser window.
+inline double kaiserAlpha(double A)
+{
+    double alpha;
+    if (A >= 50.0) {
+        alpha = 0.1102 * (A - 8.7);
+    } else if (A > 21.0) {
+        double lhs = 0.5842 * pow(A-21, 0.4);
+        alpha = lhs + (0.07886 * (A - 21));
+    } else {
+        alpha = 0;
+    }
+    return alpha;
+} // end kaiserAlpha
+
 
 
 
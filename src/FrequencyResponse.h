@@ -0,0 +1,181 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FrequencyResponse.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FFT.h
+// FIRFilter.h
+// IIRFilter.h
+// FrequencyResponse.hpp
+//
+// Evaluates the frequency response H(e^jw) of a filter on a grid of
+// N / 2 + 1 points from w = 0 to w = pi, where N is the FFT size.
+// The coefficients are zero padded (or folded modulo N if longer than N)
+// and transformed with a real FFT, which gives the exact response at the
+// grid points, rather than pushing tones through the filter.
+//
+// IIR filters use the IIRFilter form, H = B / A with
+// A(z) = 1 + a1 z^-1 + ... + aj z^-j
+//
+// The group delay is found without differentiating the phase:
+// tau(w) = Re(FFT(n b[n]) / FFT(b)) - Re(FFT(n a[n]) / FFT(a))
+// and is set to 0 where B or A are zero, as it isn't defined there.
+//
+// The batch functions evaluate a bank of filters stored one after another,
+// reusing the same plan and buffers for all of them.
+// A FrequencyResponse keeps scratch buffers, so each thread needs its own.
+
+#ifndef __FREQUENCY_RESPONSE__
+#define __FREQUENCY_RESPONSE__
+
+#include "FFT.h"
+#include "FIRFilter.h"
+#include "IIRFilter.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+class FrequencyResponse {
+public:
+    // Constructor
+    // @param N - the FFT size, must be even. The grid has N / 2 + 1 points.
+    FrequencyResponse(uint32_t N);
+
+    // getNumPoints
+    // returns the number of frequencies in the grid.
+    uint32_t getNumPoints() const { return size / 2 + 1; }
+
+    // getFrequency
+    // returns the frequency of grid point k in radians per sample.
+    double getFrequency(uint32_t k) const { return 2.0 * M_PI * k / size; }
+
+    // response
+    // Computes the complex frequency response B / A.
+    // @param b - the feed forward coefficients.
+    // @param bLength - the number of feed forward coefficients.
+    // @param a - the feedback coefficients a1...aj, NULL for an FIR filter.
+    // @param aLength - the number of feedback coefficients.
+    // @param H - the output, getNumPoints() values.
+    //
+    // @return - 0 for success, else failure.
+    template <class T>
+    int response(const T *b, uint32_t bLength, const T *a, uint32_t aLength,
+                std::complex<double> *H);
+
+    // response
+    // Computes the complex frequency response of an FIR filter.
+    // @param filter - the filter to evaluate.
+    // @param H - the output, getNumPoints() values.
+    //
+    // @return - 0 for success, else failure.
+    template <class S, class C, class A>
+    int response(FIRFilter<S, C, A> &filter, std::complex<double> *H);
+
+    // response
+    // Computes the complex frequency response of an IIR filter.
+    // @param filter - the filter to evaluate.
+    // @param H - the output, getNumPoints() values.
+    //
+    // @return - 0 for success, else failure.
+    template <class S, class C, class A>
+    int response(IIRFilter<S, C, A> &filter, std::complex<double> *H);
+
+    // groupDelay
+    // Computes the group delay in samples of B / A.
+    // @param b - the feed forward coefficients.
+    // @param bLength - the number of feed forward coefficients.
+    // @param a - the feedback coefficients a1...aj, NULL for an FIR filter.
+    // @param aLength - the number of feedback coefficients.
+    // @param delay - the output, getNumPoints() values.
+    //
+    // @return - 0 for success, else failure.
+    template <class T>
+    int groupDelay(const T *b, uint32_t bLength, const T *a, uint32_t aLength,
+                double *delay);
+
+    // magnitudeBatch
+    // Computes the magnitude response of a bank of FIR filters.
+    // @param taps - numFilters filters of length taps each, one after another.
+    // @param numFilters - the number of filters.
+    // @param length - the number of taps in each filter.
+    // @param magnitude - the output, getNumPoints() values for each filter.
+    //
+    // @return - 0 for success, else failure.
+    template <class T>
+    int magnitudeBatch(const T *taps, uint32_t numFilters, uint32_t length,
+                    double *magnitude);
+
+    // responseBatch
+    // Computes the complex response of a bank of IIR filters.
+    // @param b - numFilters sets of bLength feed forward coefficients.
+    // @param bLength - the number of feed forward coefficients in each filter.
+    // @param a - numFilters sets of aLength feedback coefficients, or NULL.
+    // @param aLength - the number of feedback coefficients in each filter.
+    // @param numFilters - the number of filters.
+    // @param H - the output, getNumPoints() values for each filter.
+    //
+    // @return - 0 for success, else failure.
+    template <class T>
+    int responseBatch(const T *b, uint32_t bLength, const T *a, uint32_t aLength,
+                    uint32_t numFilters, std::complex<double> *H);
+
+private:
+    // transform
+    // folds coef (weighted by n if weighted is set) into the FFT size and
+    // transforms it into out.
+    template <class T>
+    void transform(const T *coef, uint32_t length, bool leadingOne, bool weighted,
+                std::complex<double> *out);
+
+    uint32_t size;
+    RealFFTPlan<double> plan;
+    std::vector<double> folded;
+    std::vector<std::complex<double> > spectrumA;
+    std::vector<std::complex<double> > weightedB;
+    std::vector<std::complex<double> > weightedA;
+};
+
+// responseMagnitude
+// computes |H| for n points.
+// @param H - the complex response.
+// @param magnitude - the output.
+// @param n - the number of points.
+void responseMagnitude(const std::complex<double> *H, double *magnitude, uint32_t n);
+
+// responseMagnitudeDb
+// computes 20 log10 |H| for n points, with a floor of -400 dB.
+// @param H - the complex response.
+// @param magnitude - the output.
+// @param n - the number of points.
+void responseMagnitudeDb(const std::complex<double> *H, double *magnitude, uint32_t n);
+
+// responsePhase
+// computes the phase of H for n points in radians.
+// @param H - the complex response.
+// @param phase - the output.
+// @param n - the number of points.
+// @param unwrap - remove the 2 pi jumps between points.
+void responsePhase(const std::complex<double> *H, double *phase, uint32_t n, bool unwrap = true);
+
+
+#include "FrequencyResponse.hpp"
+
+#endif
@@ -0,0 +1,247 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FrequencyResponse.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FrequencyResponse.h
+//
+// Evaluates filter frequency responses with a real FFT.
+// The implementation file.
+
+#ifndef __FREQUENCY_RESPONSE_IMPL__
+#define __FREQUENCY_RESPONSE_IMPL__
+
+#include "FrequencyResponse.h"
+#include <algorithm>
+#include <cmath>
+
+// Constructor
+// @param N - the FFT size, must be even. The grid has N / 2 + 1 points.
+inline FrequencyResponse::FrequencyResponse(uint32_t N) :
+    size((N < 2) ? 2 : (N & ~1u)),
+    plan((N < 2) ? 2 : (N & ~1u)),
+    folded(size),
+    spectrumA(size / 2 + 1),
+    weightedB(size / 2 + 1),
+    weightedA(size / 2 + 1)
+{
+}
+
+// transform
+// folds coef (weighted by n if weighted is set) into the FFT size and
+// transforms it into out. leadingOne puts a 1 before the coefficients,
+// for the a0 of the feedback polynomial.
+template <class T>
+void FrequencyResponse::transform(const T *coef, uint32_t length, bool leadingOne,
+                            bool weighted, std::complex<double> *out)
+{
+    folded.assign(size, 0.0);
+    uint32_t offset = leadingOne ? 1 : 0;
+    if (leadingOne && !weighted) { folded[0] = 1.0; }
+    for (uint32_t i = 0; i < length; i++) {
+        uint32_t n = i + offset;
+        double c = (double)coef[i];
+        folded[n % size] += weighted ? c * n : c;
+    }
+    plan.forward(&folded[0], out);
+} // end transform
+
+// response
+// Computes the complex frequency response B / A.
+// @param b - the feed forward coefficients.
+// @param bLength - the number of feed forward coefficients.
+// @param a - the feedback coefficients a1...aj, NULL for an FIR filter.
+// @param aLength - the number of feedback coefficients.
+// @param H - the output, getNumPoints() values.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FrequencyResponse::response(const T *b, uint32_t bLength, const T *a,
+                            uint32_t aLength, std::complex<double> *H)
+{
+    if (b == NULL || H == NULL) { return -1; }
+
+    transform(b, bLength, false, false, H);
+    if (a != NULL) {
+        transform(a, aLength, true, false, &spectrumA[0]);
+        for (uint32_t k = 0; k < getNumPoints(); k++) { H[k] /= spectrumA[k]; }
+    }
+    return 0;
+} // end response
+
+// response
+// Computes the complex frequency response of an FIR filter.
+// @param filter - the filter to evaluate.
+// @param H - the output, getNumPoints() values.
+//
+// @return - 0 for success, else failure.
+template <class S, class C, class A>
+int FrequencyResponse::response(FIRFilter<S, C, A> &filter, std::complex<double> *H)
+{
+    return response(filter.getGains(), filter.getLength(), (const C *)NULL, 0, H);
+}
+
+// response
+// Computes the complex frequency response of an IIR filter.
+// @param filter - the filter to evaluate.
+// @param H - the output, getNumPoints() values.
+//
+// @return - 0 for success, else failure.
+template <class S, class C, class A>
+int FrequencyResponse::response(IIRFilter<S, C, A> &filter, std::complex<double> *H)
+{
+    return response(filter.getFeedForwardGains(), filter.getFeedForwardLength(),
+                    filter.getFeedbackGains(), filter.getFeedbackLength(), H);
+}
+
+// groupDelay
+// Computes the group delay in samples of B / A.
+// @param b - the feed forward coefficients.
+// @param bLength - the number of feed forward coefficients.
+// @param a - the feedback coefficients a1...aj, NULL for an FIR filter.
+// @param aLength - the number of feedback coefficients.
+// @param delay - the output, getNumPoints() values.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FrequencyResponse::groupDelay(const T *b, uint32_t bLength, const T *a,
+                            uint32_t aLength, double *delay)
+{
+    if (b == NULL || delay == NULL) { return -1; }
+    uint32_t M = getNumPoints();
+
+    // delay of each polynomial, in turn.
+    for (int p = 0; p < 2; p++) {
+        const T *coef = (p == 0) ? b : a;
+        uint32_t length = (p == 0) ? bLength : aLength;
+        bool leadingOne = (p == 1);
+        if (coef == NULL) { break; }
+
+        transform(coef, length, leadingOne, false, &spectrumA[0]);
+        transform(coef, length, leadingOne, true, &weightedA[0]);
+
+        double peak = 0;
+        for (uint32_t k = 0; k < M; k++) { peak = std::max(peak, std::norm(spectrumA[k])); }
+        double sign = (p == 0) ? 1.0 : -1.0;
+        for (uint32_t k = 0; k < M; k++) {
+            double power = std::norm(spectrumA[k]);
+            double tau = 0;
+            // undefined at zeros, the same threshold as the float round off.
+            if (power > peak * 1e-20) {
+                tau = (weightedA[k] * std::conj(spectrumA[k])).real() / power;
+            }
+            delay[k] = (p == 0) ? tau : delay[k] + sign * tau;
+        }
+    }
+    return 0;
+} // end groupDelay
+
+// magnitudeBatch
+// Computes the magnitude response of a bank of FIR filters.
+// @param taps - numFilters filters of length taps each, one after another.
+// @param numFilters - the number of filters.
+// @param length - the number of taps in each filter.
+// @param magnitude - the output, getNumPoints() values for each filter.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FrequencyResponse::magnitudeBatch(const T *taps, uint32_t numFilters,
+                                uint32_t length, double *magnitude)
+{
+    if (taps == NULL || magnitude == NULL) { return -1; }
+    uint32_t M = getNumPoints();
+    for (uint32_t f = 0; f < numFilters; f++) {
+        transform(taps + (size_t)f * length, length, false, false, &weightedB[0]);
+        responseMagnitude(&weightedB[0], magnitude + (size_t)f * M, M);
+    }
+    return 0;
+} // end magnitudeBatch
+
+// responseBatch
+// Computes the complex response of a bank of IIR filters.
+// @param b - numFilters sets of bLength feed forward coefficients.
+// @param bLength - the number of feed forward coefficients in each filter.
+// @param a - numFilters sets of aLength feedback coefficients, or NULL.
+// @param aLength - the number of feedback coefficients in each filter.
+// @param numFilters - the number of filters.
+// @param H - the output, getNumPoints() values for each filter.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int FrequencyResponse::responseBatch(const T *b, uint32_t bLength, const T *a,
+                                uint32_t aLength, uint32_t numFilters,
+                                std::complex<double> *H)
+{
+    if (b == NULL || H == NULL) { return -1; }
+    uint32_t M = getNumPoints();
+    for (uint32_t f = 0; f < numFilters; f++) {
+        const T *filterA = (a != NULL) ? a + (size_t)f * aLength : NULL;
+        response(b + (size_t)f * bLength, bLength, filterA, aLength, H + (size_t)f * M);
+    }
+    return 0;
+} // end responseBatch
+
+
+// responseMagnitude
+// computes |H| for n points.
+// @param H - the complex response.
+// @param magnitude - the output.
+// @param n - the number of points.
+inline void responseMagnitude(const std::complex<double> *H, double *magnitude, uint32_t n)
+{
+    for (uint32_t k = 0; k < n; k++) { magnitude[k] = std::abs(H[k]); }
+}
+
+// responseMagnitudeDb
+// computes 20 log10 |H| for n points, with a floor of -400 dB.
+// @param H - the complex response.
+// @param magnitude - the output.
+// @param n - the number of points.
+inline void responseMagnitudeDb(const std::complex<double> *H, double *magnitude, uint32_t n)
+{
+    for (uint32_t k = 0; k < n; k++) {
+        // 10 log10 of the power saves the square root.
+        double power = std::norm(H[k]);
+        magnitude[k] = (power > 1e-40) ? 10.0 * log10(power) : -400.0;
+    }
+}
+
+// responsePhase
+// computes the phase of H for n points in radians.
+// @param H - the complex response.
+// @param phase - the output.
+// @param n - the number of points.
+// @param unwrap - remove the 2 pi jumps between points.
+inline void responsePhase(const std::complex<double> *H, double *phase, uint32_t n, bool unwrap)
+{
+    double offset = 0;
+    for (uint32_t k = 0; k < n; k++) {
+        double p = std::arg(H[k]);
+        if (unwrap && k > 0) {
+            double jump = p + offset - phase[k - 1];
+            offset -= 2.0 * M_PI * floor((jump + M_PI) / (2.0 * M_PI));
+        }
+        phase[k] = p + offset;
+    }
+} // end responsePhase
+
+
+#endif
@@ -0,0 +1,140 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// GoertzelBank.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// GoertzelBank.hpp
+//
+// A bank of Goertzel filters, for detecting a fixed set of tones.
+// Each bin costs one multiply and two adds per sample, where a band pass
+// FIR filter per tone costs a multiply per tap.
+//
+// The input is split into blocks of blockLength samples. At the end of each
+// block the power of every bin is computed, and the bins are cleared for the
+// next block. The power is normalized so a sine of amplitude A exactly at a
+// bin's frequency gives A^2 / 4.
+//
+// The state of each bin is stored as separate arrays (coefficient, s1, s2),
+// and each sample updates every bin in one loop across the arrays, so the
+// compiler can vectorize across the tones.
+//
+// T is the sample type, S is the type of the bin state. Since the state
+// grows with the block length, S defaults to double.
+//
+// As a Filter, the output is the largest bin power of the last block,
+// saturated at the limits of an integer T, use getPower for the full value.
+//
+// Example:
+// double tones[] = {2 * M_PI * 697 / 8000.0, 2 * M_PI * 770 / 8000.0};
+// GoertzelBank<int16_t> bank(tones, 2, 205);
+// bank.filterBlock(input, output, n);
+// double p = bank.getPower(0);
+
+#ifndef __GOERTZEL_BANK__
+#define __GOERTZEL_BANK__
+
+#include "Filter.h"
+#include <cstdint>
+#include <vector>
+
+template <class T, class S = double>
+class GoertzelBank: public Filter<T> {
+public:
+    // Constructor
+    // @param frequencies - the frequency of each bin in radians per sample.
+    // @param numBins - the number of bins, with 0 the output is always 0.
+    // @param blockLength - the number of samples in each block.
+    GoertzelBank(const double *frequencies, uint16_t numBins, uint32_t blockLength);
+
+    // filter
+    // Adds the next input to every bin.
+    // @param x - the input to the filter.
+    //
+    // @return - the largest bin power of the last completed block.
+    T filter(T x);
+
+    // getOutput
+    // @return - the largest bin power of the last completed block.
+    T getOutput();
+
+    // filterBlock
+    // Filters a block of n inputs, this is the same as calling filter on
+    // each input in order, and writing each result to output.
+    // @param input - the array of inputs to the filter.
+    // @param out - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const T *input, T *out, size_t n);
+
+    // setBlockLength
+    // Changes the number of samples in each block, and starts a new block.
+    // @param blockLength - the number of samples in each block.
+    void setBlockLength(uint32_t blockLength);
+
+    // getBlockLength
+    uint32_t getBlockLength() const { return blockLength; }
+
+    // getNumBins
+    uint16_t getNumBins() const { return numBins; }
+
+    // getPowers
+    // @return - the power of every bin from the last completed block.
+    const S *getPowers() const { return power.data(); }
+
+    // getPower
+    // @param bin - the bin to get.
+    //
+    // @return - the power of the bin from the last completed block.
+    S getPower(uint16_t bin) const { return power[bin]; }
+
+    // getBlockCount
+    // @return - the number of blocks completed, so callers can tell when
+    //           new powers are ready.
+    uint32_t getBlockCount() const { return blockCount; }
+
+    // reset
+    // clears the bins, powers and output.
+    void reset();
+
+private:
+    // update
+    // adds n samples to the bins, n must not go past the end of the block.
+    void update(const T *input, size_t n);
+
+    // finishBlock
+    // computes the bin powers and clears the bins.
+    void finishBlock();
+
+    std::vector<S> coef; // 2 cos(w)
+    std::vector<S> s1;   // s[n - 1]
+    std::vector<S> s2;   // s[n - 2]
+    std::vector<S> power;
+    uint16_t numBins;
+    uint32_t blockLength;
+    uint32_t count; // samples in the current block.
+    uint32_t blockCount;
+    T output;
+};
+
+
+#include "GoertzelBank.hpp"
+
+#endif
@@ -0,0 +1,167 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// GoertzelBank.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// GoertzelBank.h
+//
+// A bank of Goertzel filters, for detecting a fixed set of tones.
+// The implementation file.
+//
+// Each bin runs s[n] = x[n] + 2 cos(w) s[n-1] - s[n-2], and at the end of
+// a block of N samples:
+// |X(w)|^2 = s[N-1]^2 + s[N-2]^2 - 2 cos(w) s[N-1] s[N-2]
+
+#ifndef __GOERTZEL_BANK_IMPL__
+#define __GOERTZEL_BANK_IMPL__
+
+#include "GoertzelBank.h"
+#include <cmath>
+
+// Constructor
+// @param frequencies - the frequency of each bin in radians per sample.
+// @param numBins - the number of bins, with 0 the output is always 0.
+// @param blockLength - the number of samples in each block.
+template <class T, class S>
+GoertzelBank<T, S>::GoertzelBank(const double *frequencies, uint16_t NumBins,
+                            uint32_t BlockLength) :
+    coef(NumBins), s1(NumBins), s2(NumBins), power(NumBins), numBins(NumBins)
+{
+    for (uint16_t k = 0; k < numBins; k++) {
+        coef[k] = (S)(2.0 * cos(frequencies[k]));
+    }
+    blockLength = (BlockLength > 0) ? BlockLength : 1;
+    reset();
+} // end constructor
+
+// filter
+// Adds the next input to every bin.
+// @param x - the input to the filter.
+//
+// @return - the largest bin power of the last completed block.
+template <class T, class S>
+T GoertzelBank<T, S>::filter(T x)
+{
+    update(&x, 1);
+    return output;
+}
+
+// getOutput
+// @return - the largest bin power of the last completed block.
+template <class T, class S>
+T GoertzelBank<T, S>::getOutput()
+{
+    return output;
+}
+
+// filterBlock
+// Filters a block of n inputs, this is the same as calling filter on
+// each input in order, and writing each result to output.
+// The input is split at the block boundaries, so the bins are updated in
+// runs without checking for the end of a block every sample.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T, class S>
+void GoertzelBank<T, S>::filterBlock(const T *input, T *out, size_t n)
+{
+    size_t i = 0;
+    while (i < n) {
+        size_t run = blockLength - count;
+        if (run > n - i) { run = n - i; }
+        // the output only changes at the end of a block.
+        for (size_t j = 0; j < run - 1; j++) { out[i + j] = output; }
+        update(input + i, run);
+        out[i + run - 1] = output;
+        i += run;
+    }
+} // end filterBlock
+
+// setBlockLength
+// Changes the number of samples in each block, and starts a new block.
+// @param blockLength - the number of samples in each block.
+template <class T, class S>
+void GoertzelBank<T, S>::setBlockLength(uint32_t BlockLength)
+{
+    blockLength = (BlockLength > 0) ? BlockLength : 1;
+    for (uint16_t k = 0; k < numBins; k++) {
+        s1[k] = 0;
+        s2[k] = 0;
+    }
+    count = 0;
+}
+
+// reset
+// clears the bins, powers and output.
+template <class T, class S>
+void GoertzelBank<T, S>::reset()
+{
+    for (uint16_t k = 0; k < numBins; k++) {
+        s1[k] = 0;
+        s2[k] = 0;
+        power[k] = 0;
+    }
+    count = 0;
+    blockCount = 0;
+    output = 0;
+}
+
+// update
+// adds n samples to the bins, n must not go past the end of the block.
+template <class T, class S>
+void GoertzelBank<T, S>::update(const T *input, size_t n)
+{
+    S *a = s1.data();
+    S *b = s2.data();
+    const S *c = coef.data();
+    for (size_t i = 0; i < n; i++) {
+        S x = (S)input[i];
+        // across the bins, so this loop vectorizes.
+        for (uint16_t k = 0; k < numBins; k++) {
+            S s0 = x + c[k] * a[k] - b[k];
+            b[k] = a[k];
+            a[k] = s0;
+        }
+    }
+    count += n;
+    if (count >= blockLength) { finishBlock(); }
+} // end update
+
+// finishBlock
+// computes the bin powers and clears the bins.
+template <class T, class S>
+void GoertzelBank<T, S>::finishBlock()
+{
+    S scale = (S)(1.0 / ((double)blockLength * blockLength));
+    S largest = 0;
+    for (uint16_t k = 0; k < numBins; k++) {
+        power[k] = (s1[k] * s1[k] + s2[k] * s2[k] - coef[k] * s1[k] * s2[k]) * scale;
+        if (power[k] > largest) { largest = power[k]; }
+        s1[k] = 0;
+        s2[k] = 0;
+    }
+    output = saturateOutput<T>(largest);
+    count = 0;
+    blockCount++;
+} // end finishBlock
+
+
+#endif
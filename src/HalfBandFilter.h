@@ -0,0 +1,198 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// HalfBandFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// HalfBandFilter.hpp
+//
+// A half band FIR filter, for cheap 2x decimation and interpolation.
+// A half band design (such as idealFilterCoef(M_PI / 2.0, N) with a window)
+// has every other tap zero apart from the center, and is symmetric:
+//   h[M] = c,  h[M + j] = h[M - j],  h[M + j] = 0 for even j != 0
+// so only the K taps at odd offsets 1, 3, ... 2K - 1 are stored, and each
+// is multiplied by the sum of its two samples. That's K multiplies per
+// output instead of the 4K - 1 an FIRFilter does.
+//
+// The input is split into even and odd samples. The taps only ever touch
+// samples of one parity, so each sum reads a contiguous run of one buffer.
+//
+// Modes (use one mode per filter, they share the history):
+// filter - one output per input, an FIRFilter with the same taps (but see
+//          the delay below).
+// decimate - one output per two inputs, the even outputs of filter.
+// interpolate - two outputs per input, filtering the input with zeros
+//               between samples, and a gain of 2 to keep the level.
+//
+// Delay: a design of length 4K - 1 (3, 7, 11, ...) has a delay of 2K - 1
+// samples, and filter gives exactly the outputs of FIRFilter with the same
+// taps. A design of length 4K + 1 (5, 9, 13, ...) has zero end taps, which
+// are dropped, so the delay is also 2K - 1, one less than FIRFilter's 2K.
+// Its output leads FIRFilter by one sample: output n of filter is output
+// n + 1 of FIRFilter. getDelay returns the delay in both cases.
+//
+// HalfBandCascade chains stages for 2^n rate changes.
+
+#ifndef __HALF_BAND_FILTER__
+#define __HALF_BAND_FILTER__
+
+#include "Filter.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// number of partial sums in the half band kernel.
+#define HALF_BAND_LANES 4
+
+template <class T>
+class HalfBandFilter: public Filter<T> {
+public:
+    // Constructor
+    // @param coefficients - the full half band design, odd length of at least 3.
+    // @param length - the length of the design.
+    HalfBandFilter(const T *coefficients, uint16_t length);
+
+    // filter
+    // Filters at the full rate.
+    // @param x - the input to the filter.
+    //
+    // @return - output of filter.
+    T filter(T x);
+
+    // getOutput
+    // @return - the last output of the filter.
+    T getOutput();
+
+    // decimate
+    // Filters and keeps every other output. An odd n is fine, the phase
+    // carries over to the next call.
+    // @param input - the inputs.
+    // @param out - the outputs, at least (n + 1) / 2 long.
+    // @param n - the number of inputs.
+    //
+    // @return - the number of outputs written.
+    size_t decimate(const T *input, T *out, size_t n);
+
+    // interpolate
+    // Doubles the sample rate.
+    // @param input - the inputs.
+    // @param out - the outputs, 2 n long.
+    // @param n - the number of inputs.
+    //
+    // @return - the number of outputs written.
+    size_t interpolate(const T *input, T *out, size_t n);
+
+    // getNumTaps
+    // returns the number of stored taps, not counting the center.
+    uint16_t getNumTaps() const { return numTaps; }
+
+    // getDelay
+    // returns the delay of the filter in input samples.
+    uint16_t getDelay() const { return 2 * numTaps - 1; }
+
+    // reset
+    // clears the history.
+    void reset();
+
+private:
+    // The newest 2K samples of one parity, newest first, in a linear buffer
+    // that is shifted back when it runs out of room.
+    struct Stream {
+        std::vector<T> buf;
+        uint32_t pos;
+
+        void push(T x, uint32_t window)
+        {
+            if (pos == 0) {
+                std::copy_backward(buf.begin(), buf.begin() + window, buf.end());
+                pos = (uint32_t)buf.size() - window;
+            }
+            buf[--pos] = x;
+        }
+        const T *get() const { return &buf[pos]; }
+    };
+
+    // kernel
+    // the sum of tap[i] (s[i] + s[2K - 1 - i]).
+    T kernel(const T *s) const;
+
+    std::vector<T> taps; // taps[i] = h[M - 2K + 1 + 2i], outer tap first.
+    T center;
+    uint16_t numTaps;
+    Stream streams[2]; // even and odd input samples.
+    uint8_t phase;     // parity of the next input.
+    T output;
+};
+
+
+template <class T>
+class HalfBandCascade {
+public:
+    // Constructor
+    // Every stage uses the same design.
+    // @param coefficients - the half band design.
+    // @param length - the length of the design.
+    // @param numStages - the number of 2x stages.
+    HalfBandCascade(const T *coefficients, uint16_t length, uint8_t numStages);
+
+    // Constructor
+    // Each stage has its own design, stage 0 runs at the highest rate.
+    // @param coefficients - a design for each stage.
+    // @param lengths - the length of each design.
+    // @param numStages - the number of 2x stages.
+    HalfBandCascade(const T *const *coefficients, const uint16_t *lengths,
+                uint8_t numStages);
+
+    // decimate
+    // Reduces the sample rate by 2^numStages.
+    // @param input - the inputs.
+    // @param output - the outputs, at least n / 2^numStages + 1 long.
+    // @param n - the number of inputs.
+    //
+    // @return - the number of outputs written.
+    size_t decimate(const T *input, T *output, size_t n);
+
+    // interpolate
+    // Increases the sample rate by 2^numStages.
+    // @param input - the inputs.
+    // @param output - the outputs, n 2^numStages long.
+    // @param n - the number of inputs.
+    //
+    // @return - the number of outputs written.
+    size_t interpolate(const T *input, T *output, size_t n);
+
+    // getNumStages
+    uint8_t getNumStages() const { return (uint8_t)stages.size(); }
+
+    // reset
+    // clears the history of every stage.
+    void reset();
+
+private:
+    std::vector<HalfBandFilter<T> > stages;
+    std::vector<T> scratch[2];
+};
+
+
+#include "HalfBandFilter.hpp"
+
+#endif
@@ -0,0 +1,263 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// HalfBandFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// HalfBandFilter.h
+//
+// A half band FIR filter, for cheap 2x decimation and interpolation.
+// The implementation file.
+//
+// With M = 2K - 1, the output at time n is
+//   y[n] = c x[n - M] + sum_i taps[i] (x[n - 2i] + x[n - 2(2K - 1 - i)])
+// where x[n - 2i] all come from the stream with the parity of n, and
+// x[n - M] is entry K - 1 of the other stream.
+
+#ifndef __HALF_BAND_FILTER_IMPL__
+#define __HALF_BAND_FILTER_IMPL__
+
+#include "HalfBandFilter.h"
+
+// Constructor
+// @param coefficients - the full half band design, odd length of at least 3.
+// @param length - the length of the design.
+template <class T>
+HalfBandFilter<T>::HalfBandFilter(const T *coefficients, uint16_t length)
+{
+    uint16_t M = (length > 0) ? (length - 1) / 2 : 0;
+    numTaps = (M + 1) / 2;
+    if (numTaps == 0) { numTaps = 1; }
+    uint16_t first = (M + 1 > 2 * numTaps) ? M + 1 - 2 * numTaps : 0;
+
+    taps.resize(numTaps);
+    for (uint16_t i = 0; i < numTaps; i++) {
+        uint32_t idx = first + 2 * (uint32_t)i;
+        taps[i] = (coefficients != NULL && idx < M) ? coefficients[idx] : (T)0;
+    }
+    center = (coefficients != NULL && length > 0) ? coefficients[M] : (T)0;
+
+    for (int s = 0; s < 2; s++) { streams[s].buf.resize(4 * (size_t)numTaps); }
+    reset();
+} // end constructor
+
+// reset
+// clears the history.
+template <class T>
+void HalfBandFilter<T>::reset()
+{
+    for (int s = 0; s < 2; s++) {
+        std::fill(streams[s].buf.begin(), streams[s].buf.end(), (T)0);
+        streams[s].pos = 2 * (uint32_t)numTaps;
+    }
+    phase = 0;
+    output = 0;
+}
+
+// kernel
+// the sum of tap[i] (s[i] + s[2K - 1 - i]), with partial sums so the
+// compiler can vectorize it.
+template <class T>
+T HalfBandFilter<T>::kernel(const T *s) const
+{
+    uint32_t K = numTaps;
+    const T *t = &taps[0];
+    const T *r = s + 2 * K - 1; // r[-i] = s[2K - 1 - i]
+    T acc[HALF_BAND_LANES];
+    for (int j = 0; j < HALF_BAND_LANES; j++) { acc[j] = 0; }
+
+    uint32_t end = K - K % HALF_BAND_LANES;
+    for (uint32_t i = 0; i < end; i += HALF_BAND_LANES) {
+        for (int j = 0; j < HALF_BAND_LANES; j++) {
+            acc[j] += t[i + j] * (s[i + j] + r[-(ptrdiff_t)(i + j)]);
+        }
+    }
+    T y = 0;
+    for (int j = 0; j < HALF_BAND_LANES; j++) { y += acc[j]; }
+    for (uint32_t i = end; i < K; i++) { y += t[i] * (s[i] + r[-(ptrdiff_t)i]); }
+    return y;
+} // end kernel
+
+// filter
+// Filters at the full rate.
+// @param x - the input to the filter.
+//
+// @return - output of filter.
+template <class T>
+T HalfBandFilter<T>::filter(T x)
+{
+    uint32_t window = 2 * (uint32_t)numTaps;
+    streams[phase].push(x, window);
+    output = kernel(streams[phase].get()) + center * streams[phase ^ 1].get()[numTaps - 1];
+    phase ^= 1;
+    return output;
+}
+
+// getOutput
+// @return - the last output of the filter.
+template <class T>
+T HalfBandFilter<T>::getOutput()
+{
+    return output;
+}
+
+// decimate
+// Filters and keeps every other output. An odd n is fine, the phase
+// carries over to the next call.
+// @param input - the inputs.
+// @param out - the outputs, at least (n + 1) / 2 long.
+// @param n - the number of inputs.
+//
+// @return - the number of outputs written.
+template <class T>
+size_t HalfBandFilter<T>::decimate(const T *input, T *out, size_t n)
+{
+    uint32_t window = 2 * (uint32_t)numTaps;
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        streams[phase].push(input[i], window);
+        // only the even outputs are computed.
+        if (phase == 0) {
+            output = kernel(streams[0].get()) + center * streams[1].get()[numTaps - 1];
+            out[count++] = output;
+        }
+        phase ^= 1;
+    }
+    return count;
+} // end decimate
+
+// interpolate
+// Doubles the sample rate. With zeros between the inputs, the even
+// outputs only see the side taps, and the odd outputs only the center.
+// @param input - the inputs.
+// @param out - the outputs, 2 n long.
+// @param n - the number of inputs.
+//
+// @return - the number of outputs written.
+template <class T>
+size_t HalfBandFilter<T>::interpolate(const T *input, T *out, size_t n)
+{
+    uint32_t window = 2 * (uint32_t)numTaps;
+    for (size_t i = 0; i < n; i++) {
+        streams[0].push(input[i], window);
+        const T *s = streams[0].get();
+        out[2 * i] = (T)2 * kernel(s);
+        out[2 * i + 1] = (T)2 * center * s[numTaps - 1];
+    }
+    if (n > 0) { output = out[2 * n - 1]; }
+    return 2 * n;
+} // end interpolate
+
+
+// Constructor
+// Every stage uses the same design.
+// @param coefficients - the half band design.
+// @param length - the length of the design.
+// @param numStages - the number of 2x stages.
+template <class T>
+HalfBandCascade<T>::HalfBandCascade(const T *coefficients, uint16_t length,
+                                uint8_t numStages)
+{
+    for (uint8_t i = 0; i < numStages; i++) {
+        stages.push_back(HalfBandFilter<T>(coefficients, length));
+    }
+}
+
+// Constructor
+// Each stage has its own design, stage 0 runs at the highest rate.
+// @param coefficients - a design for each stage.
+// @param lengths - the length of each design.
+// @param numStages - the number of 2x stages.
+template <class T>
+HalfBandCascade<T>::HalfBandCascade(const T *const *coefficients,
+                                const uint16_t *lengths, uint8_t numStages)
+{
+    for (uint8_t i = 0; i < numStages; i++) {
+        stages.push_back(HalfBandFilter<T>(coefficients[i], lengths[i]));
+    }
+}
+
+// reset
+// clears the history of every stage.
+template <class T>
+void HalfBandCascade<T>::reset()
+{
+    for (size_t i = 0; i < stages.size(); i++) { stages[i].reset(); }
+}
+
+// decimate
+// Reduces the sample rate by 2^numStages. Each stage runs over the whole
+// block before the next, and the scratch buffers only grow.
+// @param input - the inputs.
+// @param output - the outputs, at least n / 2^numStages + 1 long.
+// @param n - the number of inputs.
+//
+// @return - the number of outputs written.
+template <class T>
+size_t HalfBandCascade<T>::decimate(const T *input, T *output, size_t n)
+{
+    if (stages.empty()) {
+        std::copy(input, input + n, output);
+        return n;
+    }
+    const T *in = input;
+    for (size_t s = 0; s < stages.size(); s++) {
+        T *out = output;
+        if (s + 1 < stages.size()) {
+            std::vector<T> &buf = scratch[s % 2];
+            if (buf.size() < n / 2 + 1) { buf.resize(n / 2 + 1); }
+            out = &buf[0];
+        }
+        n = stages[s].decimate(in, out, n);
+        in = out;
+    }
+    return n;
+} // end decimate
+
+// interpolate
+// Increases the sample rate by 2^numStages, starting from the last stage.
+// @param input - the inputs.
+// @param output - the outputs, n 2^numStages long.
+// @param n - the number of inputs.
+//
+// @return - the number of outputs written.
+template <class T>
+size_t HalfBandCascade<T>::interpolate(const T *input, T *output, size_t n)
+{
+    if (stages.empty()) {
+        std::copy(input, input + n, output);
+        return n;
+    }
+    const T *in = input;
+    for (size_t s = stages.size(); s > 0; s--) {
+        T *out = output;
+        if (s > 1) {
+            std::vector<T> &buf = scratch[s % 2];
+            if (buf.size() < 2 * n) { buf.resize(2 * n); }
+            out = &buf[0];
+        }
+        n = stages[s - 1].interpolate(in, out, n);
+        in = out;
+    }
+    return n;
+} // end interpolate
+
+
+#endif
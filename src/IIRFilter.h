@@ -38,17 +38,25 @@
 // However computation is done in cannonical from, which reverse the order of operations,
 // and reduces the memory usage by half.
 //
+// The template takes the sample type, the coefficient type and the
+// accumulator type, where the last two default to the sample type.
+// The recursion and its delay line are kept in the accumulator type, and
+// only the output is cast back to the sample type. e.g.
+// IIRFilter<float, double, double> keeps narrow band sections stable
+// while reading and writing float samples.
+//
 // TODO: Need to re-write dealing buffer, lengths for 2 different buffer lengths
 
 #ifndef __IIR_FILTER__
 #define __IIR_FILTER__
 
 #include "Filter.h"
+#include "FilterInstrumentation.h"
 #include <cstdint>
 #include <iostream>
 
-template <class T>
-class IIRFilter: public Filter<T> {
+template <class SampleT, class CoefT = SampleT, class AccT = SampleT>
+class IIRFilter: public Filter<SampleT> {
 public:
     // Constructor
     // Give it your FIR coefficients as an array, and length of the array.
@@ -59,8 +67,8 @@ public:
     // @param feedbackCoef - the feedback coefficients for the filter.
     // @param forwardlength - the length of the feed foward filter.
     // @param feedbackLength - the length of the feedback gains.
-    IIRFilter(T *feedForwardCoef, T *feedbackCoef,
-         uint16_t forwardLength, uint16_t backLength);
+    IIRFilter(CoefT *feedForwardCoef, CoefT *feedbackCoef,
+         uint32_t forwardLength, uint32_t backLength);
     IIRFilter();
 
     // update
@@ -70,14 +78,31 @@ public:
     // @param x - the input to the filter.
     //
     // @return - output of filter, if there is an error NaN.
-    T filter(T x);
+    SampleT filter(SampleT x);
 
     // getOutput
     // This function simply gets the last output of the filter, without changing
     // internal state of the filter.
     //
     // @return - last output of filter, if there is an error NaN.
-    T getOutput();
+    SampleT getOutput();
+
+    // filterBlock
+    // Filters a block of n inputs, this is the same as calling filter on
+    // each input in order, and writing each result to output.
+    // @param input - the array of inputs to the filter.
+    // @param output - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const SampleT *input, SampleT *output, size_t n);
+
+    // setSteadyState
+    // Sets the delay line to the state the filter would be in after
+    // seeing the input x forever. If the filter has a pole at z = 1
+    // there is no steady state and the delay line is zeroed.
+    // reset() is the same as setSteadyState(0).
+    // @param x - the constant input to settle the filter to.
+    void setSteadyState(SampleT x);
+    void reset() { setSteadyState(0.0); }
 
 
     // setGains
@@ -88,36 +113,78 @@ public:
     // @param feedbackCoef - the feedback coefficients for the filter.
     // @param forwardlength - the length of the feed foward filter.
     // @param feedbackLength - the length of the feedback gains.
-    void setGains(T *feedForwardCoef, T *feedbackCoef,
-                uint16_t forwardLength, uint16_t backLength);
+    void setGains(CoefT *feedForwardCoef, CoefT *feedbackCoef,
+                uint32_t forwardLength, uint32_t backLength);
 
     // getFeedbackGains
     // This will return the array of the a vector gains.
     // You will be free to change the set of gains. (Don't abuse this!)
     //
     // @return - the gains as a single array.
-    T *getFeedbackGains(){  return fbGains; }
+    CoefT *getFeedbackGains(){  return fbGains; }
 
     // getFeedForwardGains
     // This will return the array of the b vector gains.
     // You will be free to change the set of gains. (Don't abuse this!)
     //
     // @return - the gains as a single array.
-    T *getFeedForwardGains(){  return ffGains; }
+    CoefT *getFeedForwardGains(){  return ffGains; }
 
     // getLength
     // returns the order of the FIR filter.
-    uint16_t getLength() const { return length; }
+    uint32_t getLength() const { return length; }
+
+    // getFeedForwardLength
+    // returns the number of feed forward gains.
+    uint32_t getFeedForwardLength() const { return ffLength; }
+
+    // getFeedbackLength
+    // returns the number of feedback gains.
+    uint32_t getFeedbackLength() const { return fbLength; }
+
+    // getDelayLine
+    // returns the circular buffer of the last length intermediate values,
+    // for saving the state of the filter. See FilterSnapshot.h.
+    const AccT *getDelayLine() const { return buffer; }
+
+    // getDelayPosition
+    // returns the position in the delay line the next value goes to.
+    uint32_t getDelayPosition() const { return curBufLoc; }
+
+    // setState
+    // Restores a state saved from getDelayLine, getDelayPosition and
+    // getOutput of a filter with the same lengths.
+    // @param delayLine - length intermediate values.
+    // @param position - the position of the next value.
+    // @param out - the last output.
+    //
+    // @return - 0 for success, else failure.
+    int setState(const AccT *delayLine, uint32_t position, SampleT out);
+
+#ifdef DSP_LITE_INSTRUMENT
+    // getStats
+    // returns the instrumentation counters of this filter.
+    // These can be read from any thread.
+    const FilterStats &getStats() const { return stats; }
+    FilterStats &getStats() { return stats; }
+#endif
 
 private:
-    T *buffer;
-    T *ffGains; // feedforward gains.
-    T *fbGains;
-    uint16_t curBufLoc;
-    uint16_t length;
-    uint16_t ffLength;
-    uint16_t fbLength;
-    T output;
+    // step
+    // filter without the instrumentation probes.
+    SampleT step(SampleT x);
+
+#ifdef DSP_LITE_INSTRUMENT
+    FilterStats stats;
+#endif
+    AccT *buffer;
+    CoefT *ffGains; // feedforward gains.
+    CoefT *fbGains;
+    uint32_t curBufLoc;
+    uint32_t length;
+    uint32_t ffLength;
+    uint32_t fbLength;
+    SampleT output;
 };
 
 // include "Implementation file
@@ -54,8 +54,8 @@
 // @param coefficients - the FIR coefficients for the filter.
 // @param forwardlength - the length of the feed foward filter.
 // @param feedbackLength - the length of the feedback gains.
-template <typename T>
-IIRFilter<T>::IIRFilter()
+template <typename SampleT, typename CoefT, typename AccT>
+IIRFilter<SampleT, CoefT, AccT>::IIRFilter()
 {
     length = -1; // set default to not got strange results.
     setGains(NULL, NULL, -1, -1);
@@ -70,9 +70,9 @@ IIRFilter<T>::IIRFilter()
 // @param feedForwardCoef - the feed forward coefficients for the filter.
 // @param feedbackCoef - the feedback coefficients for the filter.
 // @param length - the length of the filter. -1 for unknown.
-template <typename T>
-IIRFilter<T>::IIRFilter(T *feedForwardCoef, T *feedbackCoef,
-                    uint16_t forwardLength, uint16_t backLength)
+template <typename SampleT, typename CoefT, typename AccT>
+IIRFilter<SampleT, CoefT, AccT>::IIRFilter(CoefT *feedForwardCoef, CoefT *feedbackCoef,
+                    uint32_t forwardLength, uint32_t backLength)
 {
     length = -1; // set default to not got strange results.
     setGains(feedForwardCoef, feedbackCoef, forwardLength, backLength);
@@ -88,11 +88,11 @@ IIRFilter<T>::IIRFilter(T *feedForwardCoef, T *feedbackCoef,
 // @param feedbackCoef - the feedback coefficients for the filter.
 // @param forwardlength - the length of the feed foward filter.
 // @param feedbackLength - the length of the feedback gains.
-template <typename T>
-void IIRFilter<T>::setGains(T *feedForwardCoef, T *feedbackCoef,
-                    uint16_t forwardLength, uint16_t backLength)
+template <typename SampleT, typename CoefT, typename AccT>
+void IIRFilter<SampleT, CoefT, AccT>::setGains(CoefT *feedForwardCoef, CoefT *feedbackCoef,
+                    uint32_t forwardLength, uint32_t backLength)
 {
-    uint16_t newLength;
+    uint32_t newLength;
     // select the
     if (forwardLength > (backLength + 1)) { newLength = forwardLength; }
     else { newLength = backLength + 1; }
@@ -100,8 +100,8 @@ void IIRFilter<T>::setGains(T *feedForwardCoef, T *feedbackCoef,
     if (newLength != length && newLength > 0) {
         // reallocate correct size buffer
         length = newLength;
-        buffer = new T[length];
-        for (uint16_t i = 0; i < length; i++) { buffer[i] = 0.0; }
+        buffer = new AccT[length];
+        for (uint32_t i = 0; i < length; i++) { buffer[i] = 0.0; }
     }
 
     ffLength = forwardLength;
@@ -119,45 +119,123 @@ void IIRFilter<T>::setGains(T *feedForwardCoef, T *feedbackCoef,
 // @param x - the input to the filter.
 //
 // @return - output of filter, if there is an error NaN.
-template <typename T>
-T IIRFilter<T>::filter(T x)
+template <typename SampleT, typename CoefT, typename AccT>
+SampleT IIRFilter<SampleT, CoefT, AccT>::filter(SampleT x)
 {
-    T w0 = 0.0; // this is the intermediate value to place into the buffer.
+    FILTER_PROBE_START();
+    SampleT y = step(x);
+    FILTER_PROBE_END(stats, 1);
+    FILTER_PROBE_OUTPUT(stats, y);
+    return y;
+} // end filter function
+
+// filterBlock
+// Filters a block of n inputs, this is the same as calling filter on
+// each input in order, and writing each result to output.
+// @param input - the array of inputs to the filter.
+// @param output - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <typename SampleT, typename CoefT, typename AccT>
+void IIRFilter<SampleT, CoefT, AccT>::filterBlock(const SampleT *input, SampleT *output,
+                                                size_t n)
+{
+    FILTER_PROBE_START();
+    for (size_t i = 0; i < n; i++) { output[i] = step(input[i]); }
+    FILTER_PROBE_END(stats, n);
+#ifdef DSP_LITE_INSTRUMENT
+    for (size_t i = 0; i < n; i++) { FILTER_PROBE_OUTPUT(stats, output[i]); }
+#endif
+} // end filterBlock
+
+// step
+// filter without the instrumentation probes.
+template <typename SampleT, typename CoefT, typename AccT>
+SampleT IIRFilter<SampleT, CoefT, AccT>::step(SampleT x)
+{
+    AccT w0 = 0.0; // this is the intermediate value to place into the buffer.
     // multiply feedback gains first.
-    for (uint16_t i = 0; i < fbLength; i++) {
+    for (uint32_t i = 0; i < fbLength; i++) {
         // have circular buffer wrap around on itself, pull out
         // current gain.
-        w0 += -buffer[(i + curBufLoc + 1) % length] * fbGains[i];
+        w0 += -buffer[(i + curBufLoc + 1) % length] * (AccT)fbGains[i];
     }
 
     // place into current buffer location.
-    buffer[curBufLoc] = w0 + x;
+    buffer[curBufLoc] = w0 + (AccT)x;
+    FILTER_PROBE_STATE(stats, buffer[curBufLoc]);
 
-    output = 0.0;
+    AccT acc = 0.0;
     // perform feedfoward step.
-    for (uint16_t i = 0; i < ffLength; i++) {
+    for (uint32_t i = 0; i < ffLength; i++) {
         // have circular buffer wrap around on itself, pull out
         // current gain.
-        output += buffer[(i + curBufLoc) % length] * ffGains[i];
+        acc += buffer[(i + curBufLoc) % length] * (AccT)ffGains[i];
     }
+    FILTER_PROBE_ACC(stats, SampleT, acc);
+    output = saturateOutput<SampleT>(acc);
     // update buffer location for next iteration.
     if (curBufLoc == 0) { curBufLoc = length; }
     curBufLoc--;
 
     return output;
-} // end filter function
+} // end step function
 
 // getOutput
 // This function simply gets the last output of the filter, without changing
 // internal state of the filter.
 //
 // @return - last output of filter, if there is an error NaN.
-template <typename T>
-T IIRFilter<T>::getOutput()
+template <typename SampleT, typename CoefT, typename AccT>
+SampleT IIRFilter<SampleT, CoefT, AccT>::getOutput()
 {
     return output;
 } // end getOutput function.
 
 
+// setState
+// Restores a state saved from getDelayLine, getDelayPosition and
+// getOutput of a filter with the same lengths.
+// @param delayLine - length intermediate values.
+// @param position - the position of the next value.
+// @param out - the last output.
+//
+// @return - 0 for success, else failure.
+template <typename SampleT, typename CoefT, typename AccT>
+int IIRFilter<SampleT, CoefT, AccT>::setState(const AccT *delayLine, uint32_t position,
+                                            SampleT out)
+{
+    if (delayLine == NULL || position >= length) { return -1; }
+    for (uint32_t i = 0; i < length; i++) { buffer[i] = delayLine[i]; }
+    curBufLoc = position;
+    output = out;
+    return 0;
+} // end setState
+
+
+// setSteadyState
+// Sets the delay line to the state the filter would be in after
+// seeing the input x forever. If the filter has a pole at z = 1
+// there is no steady state and the delay line is zeroed.
+// reset() is the same as setSteadyState(0).
+// @param x - the constant input to settle the filter to.
+template <typename SampleT, typename CoefT, typename AccT>
+void IIRFilter<SampleT, CoefT, AccT>::setSteadyState(SampleT x)
+{
+    // in steady state every intermediate value w is the same, so
+    // w = x - (a1 + a2 + ... + ak) * w, or w = x / (1 + sum(a)).
+    AccT denominator = 1.0;
+    for (uint32_t i = 0; i < fbLength; i++) { denominator += (AccT)fbGains[i]; }
+
+    AccT w = 0.0;
+    if (denominator != (AccT)0.0) { w = (AccT)x / denominator; }
+
+    for (uint32_t i = 0; i < length; i++) { buffer[i] = w; }
+
+    AccT acc = 0.0;
+    for (uint32_t i = 0; i < ffLength; i++) { acc += w * (AccT)ffGains[i]; }
+    output = saturateOutput<SampleT>(acc);
+} // end setSteadyState
+
+
 
 #endif
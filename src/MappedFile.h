@@ -0,0 +1,84 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// MappedFile.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// MappedFile.hpp
+//
+// A read only file mapped into memory, for the snapshot and coefficient
+// files. Where there is no mmap the file is read into memory instead, so
+// callers see the same thing either way. The data is always 8 byte aligned.
+//
+// Example:
+// MappedFile file;
+// if (file.open("taps.coef") == 0) {
+//     const uint8_t *bytes = (const uint8_t *)file.getData();
+//     ... file.getSize() bytes
+// }
+
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // open
+    // Maps a file read only, or reads it in where there is no mmap.
+    // @param path - the file to open.
+    //
+    // @return - 0 for success, else failure (including an empty file).
+    int open(const char *path);
+
+    // close
+    // unmaps the file.
+    void close();
+
+    // getData
+    // @return - the contents of the file, NULL if not open.
+    const void *getData() const { return data; }
+
+    // getSize
+    // @return - the size of the file in bytes.
+    size_t getSize() const { return size; }
+
+    // isMapped
+    // @return - true if the file is mapped rather than copied.
+    bool isMapped() const { return mapping != NULL; }
+
+private:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const void *data;
+    size_t size;
+    void *mapping;
+    std::vector<uint64_t> copy; // the file, where there is no mmap.
+};
+
+// include implementation file
+#include "MappedFile.hpp"
+#endif
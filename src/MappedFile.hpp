@@ -0,0 +1,118 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// MappedFile.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// MappedFile.h
+//
+// Implementation of the mapped file.
+
+#ifndef __MAPPED_FILE_IMPL__
+#define __MAPPED_FILE_IMPL__
+
+#include "MappedFile.h"
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DSP_LITE_HAS_MMAP 1
+#else
+#define DSP_LITE_HAS_MMAP 0
+#endif
+
+inline MappedFile::MappedFile()
+{
+    data = NULL;
+    size = 0;
+    mapping = NULL;
+}
+
+inline MappedFile::~MappedFile()
+{
+    close();
+}
+
+// open
+// Maps a file read only, or reads it in where there is no mmap.
+// @param path - the file to open.
+//
+// @return - 0 for success, else failure (including an empty file).
+inline int MappedFile::open(const char *path)
+{
+    close();
+    if (path == NULL) { return -1; }
+#if DSP_LITE_HAS_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) { return -1; }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return -1;
+    }
+    size_t fileSize = (size_t)info.st_size;
+    void *mapped = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) { return -1; }
+    mapping = mapped;
+    data = mapped;
+    size = fileSize;
+    return 0;
+#else
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) { return -1; }
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize <= 0) {
+        fclose(file);
+        return -1;
+    }
+    // uint64_t so the copy is 8 byte aligned.
+    copy.resize(((size_t)fileSize + 7) / 8);
+    size_t got = fread(&copy[0], 1, (size_t)fileSize, file);
+    fclose(file);
+    if (got != (size_t)fileSize) {
+        close();
+        return -1;
+    }
+    data = &copy[0];
+    size = (size_t)fileSize;
+    return 0;
+#endif
+} // end open
+
+// close
+// unmaps the file.
+inline void MappedFile::close()
+{
+#if DSP_LITE_HAS_MMAP
+    if (mapping != NULL) { munmap(mapping, size); }
+#endif
+    mapping = NULL;
+    std::vector<uint64_t>().swap(copy);
+    data = NULL;
+    size = 0;
+}
+
+#endif
@@ -0,0 +1,196 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// MultichannelFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// MultichannelFilter.hpp
+//
+// FIR and IIR filters over interleaved frames, e.g. stereo or 8 channel
+// audio, without deinterleaving. Frame n of a block is
+//   input[n * numChannels + c] for channel c,
+// and the output is written in the same layout.
+//
+// Each channel has its own state, and either all channels share one set of
+// taps, or each has its own. The taps and history are stored [tap][channel],
+// so the inner loop of the kernel runs across the channels of a frame, and
+// is vectorized for 2, 4 and 8 channels (and any count that is large enough).
+// Each channel gives exactly the same output as FIRFilter / IIRFilter with
+// the same types and taps, including saturating integer outputs.
+//
+// The template types are the same as FIRFilter, the sample type, the
+// coefficient type and the accumulator type.
+
+#ifndef __MULTICHANNEL_FILTER__
+#define __MULTICHANNEL_FILTER__
+
+#include "Filter.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// number of frames the FIR kernel filters at once, for 1 or 2 channels.
+#define MULTICHANNEL_FRAMES 4
+
+template <class SampleT, class CoefT = SampleT, class AccT = SampleT>
+class MultichannelFIRFilter {
+public:
+    // Constructor
+    // @param coefficients - the taps, length long if shared, or numChannels
+    //                       runs of length taps (channel 0 first) if not.
+    // @param length - the number of taps per channel.
+    // @param numChannels - the number of interleaved channels.
+    // @param perChannel - true if each channel has its own taps.
+    MultichannelFIRFilter(const CoefT *coefficients, uint32_t length,
+                        uint32_t numChannels, bool perChannel = false);
+
+    // setGains
+    // Copies in a new set of taps, and clears the history if the length
+    // changed. The coefficients are copied, so they can be freed after.
+    // @param coefficients - the taps, in the same layout as the constructor.
+    // @param length - the number of taps per channel.
+    // @param perChannel - true if each channel has its own taps.
+    //
+    // @return - 0 for success, else failure.
+    int setGains(const CoefT *coefficients, uint32_t length, bool perChannel = false);
+
+    // filterFrame
+    // Filters one frame.
+    // @param in - numChannels inputs.
+    // @param out - numChannels outputs, may be the same as in.
+    void filterFrame(const SampleT *in, SampleT *out);
+
+    // filterBlock
+    // Filters a block of interleaved frames, may be done in place.
+    // @param input - numFrames * numChannels inputs.
+    // @param out - numFrames * numChannels outputs.
+    // @param numFrames - the number of frames.
+    void filterBlock(const SampleT *input, SampleT *out, size_t numFrames);
+
+    // getOutput
+    // @return - the last output frame, numChannels long.
+    const SampleT *getOutput() const { return &output[0]; }
+
+    // reset
+    // clears the history of every channel.
+    void reset();
+
+    uint32_t getNumChannels() const { return numChannels; }
+    uint32_t getLength() const { return length; }
+
+private:
+    // run
+    // filters frames, with the channel count fixed at compile time when
+    // CH is not 0.
+    template <int CH>
+    void run(const SampleT *input, SampleT *out, size_t numFrames);
+
+    // push
+    // adds a frame to the history, and returns the newest length frames.
+    const SampleT *push(const SampleT *x, uint32_t C);
+
+    std::vector<CoefT> gains;    // [tap][channel]
+    std::vector<CoefT> groupGains; // [tap][frame][channel], for 1 or 2 channels.
+    std::vector<SampleT> history; // [frame][channel], each frame written twice.
+    std::vector<AccT> acc;
+    std::vector<SampleT> output;
+    uint32_t numChannels;
+    uint32_t length;
+    uint32_t pos; // frame of the newest input.
+};
+
+template <class SampleT, class CoefT = SampleT, class AccT = SampleT>
+class MultichannelIIRFilter {
+public:
+    // Constructor
+    // Uses the same form as IIRFilter, the feedback taps start at a1.
+    // @param feedForwardCoef - the b taps, forwardLength long if shared, or
+    //                          numChannels runs of forwardLength if not.
+    // @param feedbackCoef - the a taps, in the same layout with backLength.
+    // @param forwardLength - the number of feed forward taps per channel.
+    // @param backLength - the number of feedback taps per channel.
+    // @param numChannels - the number of interleaved channels.
+    // @param perChannel - true if each channel has its own taps.
+    MultichannelIIRFilter(const CoefT *feedForwardCoef, const CoefT *feedbackCoef,
+                        uint32_t forwardLength, uint32_t backLength,
+                        uint32_t numChannels, bool perChannel = false);
+
+    // setGains
+    // Copies in a new set of taps, and clears the history if the length
+    // changed.
+    // @param feedForwardCoef - the b taps.
+    // @param feedbackCoef - the a taps, starting at a1.
+    // @param forwardLength - the number of feed forward taps per channel.
+    // @param backLength - the number of feedback taps per channel.
+    // @param perChannel - true if each channel has its own taps.
+    //
+    // @return - 0 for success, else failure.
+    int setGains(const CoefT *feedForwardCoef, const CoefT *feedbackCoef,
+                uint32_t forwardLength, uint32_t backLength, bool perChannel = false);
+
+    // filterFrame
+    // Filters one frame.
+    // @param in - numChannels inputs.
+    // @param out - numChannels outputs, may be the same as in.
+    void filterFrame(const SampleT *in, SampleT *out);
+
+    // filterBlock
+    // Filters a block of interleaved frames, may be done in place.
+    // @param input - numFrames * numChannels inputs.
+    // @param out - numFrames * numChannels outputs.
+    // @param numFrames - the number of frames.
+    void filterBlock(const SampleT *input, SampleT *out, size_t numFrames);
+
+    // getOutput
+    // @return - the last output frame, numChannels long.
+    const SampleT *getOutput() const { return &output[0]; }
+
+    // reset
+    // clears the state of every channel.
+    void reset();
+
+    uint32_t getNumChannels() const { return numChannels; }
+    uint32_t getFeedForwardLength() const { return ffLength; }
+    uint32_t getFeedbackLength() const { return fbLength; }
+
+private:
+    // run
+    // filters frames, with the channel count fixed at compile time when
+    // CH is not 0.
+    template <int CH>
+    void run(const SampleT *input, SampleT *out, size_t numFrames);
+
+    std::vector<CoefT> ffGains; // [tap][channel]
+    std::vector<CoefT> fbGains; // [tap][channel]
+    std::vector<AccT> history;  // [frame][channel] of w, each frame written twice.
+    std::vector<AccT> acc;
+    std::vector<SampleT> output;
+    uint32_t numChannels;
+    uint32_t ffLength;
+    uint32_t fbLength;
+    uint32_t length; // frames of history, max(ffLength, fbLength + 1).
+    uint32_t pos;    // frame of the newest w.
+};
+
+// include implementation file
+#include "MultichannelFilter.hpp"
+
+#endif
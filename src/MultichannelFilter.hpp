@@ -0,0 +1,396 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// MultichannelFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// MultichannelFilter.h
+//
+// FIR and IIR filters over interleaved frames.
+// The implementation file.
+//
+// The history is a circular buffer of R frames, where each frame is written
+// at pos and pos + R, so the newest R frames are always the contiguous run
+// starting at pos, and the kernel needs no wrap around. The FIR keeps
+// R = length + MULTICHANNEL_FRAMES - 1 so a group of frames can be filtered
+// together, the IIR keeps R = length.
+
+#ifndef __MULTICHANNEL_FILTER_IMPL__
+#define __MULTICHANNEL_FILTER_IMPL__
+
+#include "MultichannelFilter.h"
+#include <algorithm>
+
+// interleaveTaps
+// Copies taps into the [tap][channel] layout used by the kernels.
+// @param coefficients - length taps if shared, or numChannels runs of
+//                       length taps if perChannel.
+// @param length - the number of taps per channel.
+// @param numChannels - the number of channels.
+// @param perChannel - true if each channel has its own taps.
+// @param out - the interleaved taps, resized to length * numChannels.
+template <class C>
+void interleaveTaps(const C *coefficients, uint32_t length, uint32_t numChannels,
+                bool perChannel, std::vector<C> &out)
+{
+    out.resize((size_t)length * numChannels);
+    for (uint32_t i = 0; i < length; i++) {
+        for (uint32_t c = 0; c < numChannels; c++) {
+            size_t src = perChannel ? (size_t)c * length + i : i;
+            out[(size_t)i * numChannels + c] = coefficients[src];
+        }
+    }
+}
+
+
+///////////////////////////// FIR /////////////////////////////
+
+// Constructor
+// @param coefficients - the taps, length long if shared, or numChannels
+//                       runs of length taps (channel 0 first) if not.
+// @param length - the number of taps per channel.
+// @param numChannels - the number of interleaved channels.
+// @param perChannel - true if each channel has its own taps.
+template <class SampleT, class CoefT, class AccT>
+MultichannelFIRFilter<SampleT, CoefT, AccT>::MultichannelFIRFilter(
+        const CoefT *coefficients, uint32_t length, uint32_t numChannels, bool perChannel)
+{
+    this->numChannels = (numChannels > 0) ? numChannels : 1;
+    this->length = 0;
+    output.resize(this->numChannels);
+    if (setGains(coefficients, length, perChannel) != 0) {
+        // a single zero tap, so the filter is still safe to run.
+        CoefT zero = (CoefT)0;
+        setGains(&zero, 1, false);
+    }
+} // end constructor
+
+// setGains
+// Copies in a new set of taps, and clears the history if the length changed.
+// @param coefficients - the taps, in the same layout as the constructor.
+// @param length - the number of taps per channel.
+// @param perChannel - true if each channel has its own taps.
+//
+// @return - 0 for success, else failure.
+template <class SampleT, class CoefT, class AccT>
+int MultichannelFIRFilter<SampleT, CoefT, AccT>::setGains(const CoefT *coefficients,
+                                                uint32_t Length, bool perChannel)
+{
+    if (coefficients == NULL || Length == 0) { return -1; }
+
+    interleaveTaps(coefficients, Length, numChannels, perChannel, gains);
+    if (numChannels <= 2) {
+        // the taps repeated for each frame of a group.
+        groupGains.resize((size_t)Length * MULTICHANNEL_FRAMES * numChannels);
+        for (size_t i = 0; i < Length; i++) {
+            for (uint32_t f = 0; f < MULTICHANNEL_FRAMES; f++) {
+                std::copy(&gains[i * numChannels], &gains[(i + 1) * numChannels],
+                        &groupGains[(i * MULTICHANNEL_FRAMES + f) * numChannels]);
+            }
+        }
+    }
+    if (Length != length) {
+        length = Length;
+        history.resize(2 * ((size_t)length + MULTICHANNEL_FRAMES - 1) * numChannels);
+        acc.resize((size_t)MULTICHANNEL_FRAMES * numChannels);
+        reset();
+    }
+    return 0;
+} // end setGains
+
+// reset
+// clears the history of every channel.
+template <class SampleT, class CoefT, class AccT>
+void MultichannelFIRFilter<SampleT, CoefT, AccT>::reset()
+{
+    std::fill(history.begin(), history.end(), (SampleT)0);
+    std::fill(output.begin(), output.end(), (SampleT)0);
+    pos = 0;
+}
+
+// filterFrame
+// Filters one frame.
+// @param in - numChannels inputs.
+// @param out - numChannels outputs, may be the same as in.
+template <class SampleT, class CoefT, class AccT>
+void MultichannelFIRFilter<SampleT, CoefT, AccT>::filterFrame(const SampleT *in, SampleT *out)
+{
+    filterBlock(in, out, 1);
+}
+
+// filterBlock
+// Filters a block of interleaved frames, may be done in place.
+// @param input - numFrames * numChannels inputs.
+// @param out - numFrames * numChannels outputs.
+// @param numFrames - the number of frames.
+template <class SampleT, class CoefT, class AccT>
+void MultichannelFIRFilter<SampleT, CoefT, AccT>::filterBlock(const SampleT *input,
+                                                SampleT *out, size_t numFrames)
+{
+    if (numFrames == 0) { return; }
+    switch (numChannels) {
+    case 1: run<1>(input, out, numFrames); break;
+    case 2: run<2>(input, out, numFrames); break;
+    case 4: run<4>(input, out, numFrames); break;
+    case 8: run<8>(input, out, numFrames); break;
+    default: run<0>(input, out, numFrames); break;
+    }
+    std::copy(out + (numFrames - 1) * numChannels, out + numFrames * numChannels,
+            output.begin());
+} // end filterBlock
+
+// run
+// filters frames, with the channel count fixed at compile time when CH is
+// not 0. Each channel sums its taps in the same order as FIRFilter.
+// With 1 or 2 channels a frame is too few independent sums to hide the add
+// latency, so MULTICHANNEL_FRAMES frames are done at once, using groupGains.
+template <class SampleT, class CoefT, class AccT>
+template <int CH>
+void MultichannelFIRFilter<SampleT, CoefT, AccT>::run(const SampleT *input,
+                                                SampleT *out, size_t numFrames)
+{
+    const uint32_t C = CH ? CH : numChannels;
+    const uint32_t L = length;
+    const uint32_t G = MULTICHANNEL_FRAMES;
+    // a fixed channel count keeps the sums in registers.
+    AccT local[MULTICHANNEL_FRAMES * (CH ? CH : 1)];
+    AccT *a = CH ? local : &acc[0];
+    const CoefT *g = &gains[0];
+
+    size_t n = 0;
+    // with 4 or more channels there are enough sums in a frame already.
+    if (CH == 1 || CH == 2) {
+        for (; n + G <= numFrames; n += G) {
+            for (uint32_t f = 0; f < G; f++) { push(input + (n + f) * C, C); }
+            // the group is the newest G frames, so tap i of all of them is
+            // the contiguous run of G frames starting i frames back.
+            const SampleT *h = &history[(size_t)pos * C];
+            const CoefT *gg = &groupGains[0];
+            // the sums are kept in memory, as with a local array the compiler
+            // vectorizes over the taps instead, as slow in order reductions.
+            // All products are computed before the sums are stored.
+            AccT *m = &acc[0];
+
+            for (uint32_t j = 0; j < G * C; j++) { m[j] = 0; }
+            for (uint32_t i = 0; i < L; i++) {
+                const SampleT *hi = h + (size_t)i * C;
+                const CoefT *gi = gg + (size_t)i * G * C;
+                AccT p[MULTICHANNEL_FRAMES * 2];
+                for (uint32_t j = 0; j < G * C; j++) { p[j] = (AccT)hi[j] * (AccT)gi[j]; }
+                for (uint32_t j = 0; j < G * C; j++) { m[j] += p[j]; }
+            }
+
+            // the sums are newest frame first.
+            SampleT *y = out + n * C;
+            for (uint32_t f = 0; f < G; f++) {
+                for (uint32_t c = 0; c < C; c++) {
+                    y[f * C + c] = saturateOutput<SampleT>(m[(G - 1 - f) * C + c]);
+                }
+            }
+        }
+    }
+
+    for (; n < numFrames; n++) {
+        const SampleT *h = push(input + n * C, C);
+        for (uint32_t c = 0; c < C; c++) { a[c] = 0; }
+        for (uint32_t i = 0; i < L; i++) {
+            const SampleT *hi = h + (size_t)i * C;
+            const CoefT *gi = g + (size_t)i * C;
+            for (uint32_t c = 0; c < C; c++) { a[c] += (AccT)hi[c] * (AccT)gi[c]; }
+        }
+
+        SampleT *y = out + n * C;
+        for (uint32_t c = 0; c < C; c++) { y[c] = saturateOutput<SampleT>(a[c]); }
+    }
+} // end run
+
+// push
+// adds a frame to the history.
+// @param x - the frame, C samples.
+// @param C - the number of channels.
+//
+// @return - the newest length frames, newest first.
+template <class SampleT, class CoefT, class AccT>
+const SampleT *MultichannelFIRFilter<SampleT, CoefT, AccT>::push(const SampleT *x,
+                                                                uint32_t C)
+{
+    uint32_t R = length + MULTICHANNEL_FRAMES - 1;
+    pos = (pos == 0) ? R - 1 : pos - 1;
+    SampleT *h = &history[(size_t)pos * C];
+    for (uint32_t c = 0; c < C; c++) {
+        h[c] = x[c];
+        h[(size_t)R * C + c] = x[c];
+    }
+    return h;
+}
+
+
+///////////////////////////// IIR /////////////////////////////
+
+// Constructor
+// Uses the same form as IIRFilter, the feedback taps start at a1.
+// @param feedForwardCoef - the b taps, forwardLength long if shared, or
+//                          numChannels runs of forwardLength if not.
+// @param feedbackCoef - the a taps, in the same layout with backLength.
+// @param forwardLength - the number of feed forward taps per channel.
+// @param backLength - the number of feedback taps per channel.
+// @param numChannels - the number of interleaved channels.
+// @param perChannel - true if each channel has its own taps.
+template <class SampleT, class CoefT, class AccT>
+MultichannelIIRFilter<SampleT, CoefT, AccT>::MultichannelIIRFilter(
+        const CoefT *feedForwardCoef, const CoefT *feedbackCoef,
+        uint32_t forwardLength, uint32_t backLength,
+        uint32_t numChannels, bool perChannel)
+{
+    this->numChannels = (numChannels > 0) ? numChannels : 1;
+    length = 0;
+    acc.resize(this->numChannels);
+    output.resize(this->numChannels);
+    if (setGains(feedForwardCoef, feedbackCoef, forwardLength, backLength,
+                perChannel) != 0) {
+        CoefT zero = (CoefT)0;
+        setGains(&zero, NULL, 1, 0, false);
+    }
+} // end constructor
+
+// setGains
+// Copies in a new set of taps, and clears the history if the length changed.
+// @param feedForwardCoef - the b taps.
+// @param feedbackCoef - the a taps, starting at a1.
+// @param forwardLength - the number of feed forward taps per channel.
+// @param backLength - the number of feedback taps per channel.
+// @param perChannel - true if each channel has its own taps.
+//
+// @return - 0 for success, else failure.
+template <class SampleT, class CoefT, class AccT>
+int MultichannelIIRFilter<SampleT, CoefT, AccT>::setGains(const CoefT *feedForwardCoef,
+                const CoefT *feedbackCoef, uint32_t forwardLength, uint32_t backLength,
+                bool perChannel)
+{
+    if (feedForwardCoef == NULL || forwardLength == 0) { return -1; }
+    if (feedbackCoef == NULL && backLength > 0) { return -1; }
+    if (backLength == UINT32_MAX) { return -1; }
+
+    interleaveTaps(feedForwardCoef, forwardLength, numChannels, perChannel, ffGains);
+    if (backLength > 0) {
+        interleaveTaps(feedbackCoef, backLength, numChannels, perChannel, fbGains);
+    } else {
+        fbGains.clear();
+    }
+    ffLength = forwardLength;
+    fbLength = backLength;
+
+    uint32_t newLength = (forwardLength > backLength + 1) ? forwardLength : backLength + 1;
+    if (newLength != length) {
+        length = newLength;
+        history.resize(2 * (size_t)length * numChannels);
+        reset();
+    }
+    return 0;
+} // end setGains
+
+// reset
+// clears the state of every channel.
+template <class SampleT, class CoefT, class AccT>
+void MultichannelIIRFilter<SampleT, CoefT, AccT>::reset()
+{
+    std::fill(history.begin(), history.end(), (AccT)0);
+    std::fill(output.begin(), output.end(), (SampleT)0);
+    pos = 0;
+}
+
+// filterFrame
+// Filters one frame.
+// @param in - numChannels inputs.
+// @param out - numChannels outputs, may be the same as in.
+template <class SampleT, class CoefT, class AccT>
+void MultichannelIIRFilter<SampleT, CoefT, AccT>::filterFrame(const SampleT *in, SampleT *out)
+{
+    filterBlock(in, out, 1);
+}
+
+// filterBlock
+// Filters a block of interleaved frames, may be done in place.
+// @param input - numFrames * numChannels inputs.
+// @param out - numFrames * numChannels outputs.
+// @param numFrames - the number of frames.
+template <class SampleT, class CoefT, class AccT>
+void MultichannelIIRFilter<SampleT, CoefT, AccT>::filterBlock(const SampleT *input,
+                                                SampleT *out, size_t numFrames)
+{
+    if (numFrames == 0) { return; }
+    switch (numChannels) {
+    case 1: run<1>(input, out, numFrames); break;
+    case 2: run<2>(input, out, numFrames); break;
+    case 4: run<4>(input, out, numFrames); break;
+    case 8: run<8>(input, out, numFrames); break;
+    default: run<0>(input, out, numFrames); break;
+    }
+    std::copy(out + (numFrames - 1) * numChannels, out + numFrames * numChannels,
+            output.begin());
+} // end filterBlock
+
+// run
+// filters frames, with the channel count fixed at compile time when CH is
+// not 0. Each channel is computed in the same order as IIRFilter.
+template <class SampleT, class CoefT, class AccT>
+template <int CH>
+void MultichannelIIRFilter<SampleT, CoefT, AccT>::run(const SampleT *input,
+                                                SampleT *out, size_t numFrames)
+{
+    const uint32_t C = CH ? CH : numChannels;
+    const uint32_t L = length;
+    AccT local[CH ? CH : 1];
+    AccT *a = CH ? local : &acc[0];
+    const CoefT *ff = &ffGains[0];
+    const CoefT *fb = fbGains.empty() ? NULL : &fbGains[0];
+
+    for (size_t n = 0; n < numFrames; n++) {
+        const SampleT *x = input + n * C;
+        pos = (pos == 0) ? L - 1 : pos - 1;
+        // h[C...] holds the older w, newest first.
+        AccT *h = &history[(size_t)pos * C];
+
+        for (uint32_t c = 0; c < C; c++) { a[c] = 0; }
+        for (uint32_t i = 0; i < fbLength; i++) {
+            const AccT *hi = h + (size_t)(i + 1) * C;
+            const CoefT *gi = fb + (size_t)i * C;
+            for (uint32_t c = 0; c < C; c++) { a[c] += -hi[c] * (AccT)gi[c]; }
+        }
+        for (uint32_t c = 0; c < C; c++) {
+            AccT w = a[c] + (AccT)x[c];
+            h[c] = w;
+            h[(size_t)L * C + c] = w;
+        }
+
+        for (uint32_t c = 0; c < C; c++) { a[c] = 0; }
+        for (uint32_t i = 0; i < ffLength; i++) {
+            const AccT *hi = h + (size_t)i * C;
+            const CoefT *gi = ff + (size_t)i * C;
+            for (uint32_t c = 0; c < C; c++) { a[c] += hi[c] * (AccT)gi[c]; }
+        }
+
+        SampleT *y = out + n * C;
+        for (uint32_t c = 0; c < C; c++) { y[c] = saturateOutput<SampleT>(a[c]); }
+    }
+} // end run
+
+
+#endif
@@ -0,0 +1,131 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ParallelFIRFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FIRFilter.h
+// ParallelFIRFilter.hpp
+//
+// Offline filtering of large buffers with an FIRFilter across several threads.
+// Each output of an FIR filter only depends on the last length inputs, so the
+// input can be split into chunks, where each chunk reads its first length - 1
+// samples of history from the end of the chunk before it.
+// The output is bit-identical to calling filter on each input in order.
+// The chunks run on a ParallelPool, whose threads are kept between calls.
+//
+// This is kept out of FIRFilter.h so the filters don't require thread support.
+// Link with -pthread.
+
+#ifndef __PARALLEL_FIR_FILTER__
+#define __PARALLEL_FIR_FILTER__
+
+#include "FIRFilter.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A set of worker threads that is kept across calls, so a call doesn't pay
+// for starting and joining threads. The calling thread takes tasks too, so
+// a pool of numThreads has numThreads - 1 workers. If a worker can't be
+// started the pool just has fewer. One run happens at a time, other callers
+// wait for it.
+class ParallelPool {
+public:
+    // Constructor
+    // @param numThreads - the number of threads to use, 0 to use all
+    //                     hardware threads.
+    ParallelPool(unsigned numThreads = 0);
+    ~ParallelPool();
+
+    // run
+    // Calls task(i) for each i in [0, count) over the workers and the
+    // calling thread, and returns when all of them are done.
+    // @param count - the number of tasks.
+    // @param task - the task, called from several threads at once.
+    void run(size_t count, const std::function<void(size_t)> &task);
+
+    // getNumThreads
+    // @return - the number of threads, including the calling thread.
+    unsigned getNumThreads() const { return (unsigned)workers.size() + 1; }
+
+private:
+    ParallelPool(const ParallelPool &) = delete;
+    ParallelPool &operator=(const ParallelPool &) = delete;
+
+    // work
+    // the loop of each worker, waits for a run and takes its tasks.
+    void work();
+
+    // takeTasks
+    // runs tasks of the current run until none are left, with lock held
+    // on entry and exit.
+    void takeTasks(std::unique_lock<std::mutex> &guard);
+
+    std::vector<std::thread> workers;
+    std::mutex runLock;   // one run at a time.
+    std::mutex lock;      // guards the rest.
+    std::condition_variable wake;
+    std::condition_variable finish;
+    const std::function<void(size_t)> *task;
+    size_t count;         // tasks in the current run.
+    size_t next;          // next task to hand out.
+    size_t finished;      // tasks done.
+    uint64_t generation;  // counts runs, so a worker takes part once.
+    bool stopping;
+};
+
+// sharedParallelPool
+// @return - a pool of all hardware threads, started on first use.
+ParallelPool &sharedParallelPool();
+
+// parallelFilter
+// Filters a block of n inputs with the given filter, splitting the work into
+// chunks over the threads of a pool. The filter state is updated the same as
+// if filter had been called on each input, so this can be mixed with serial
+// calls. May be done in place (output == input), which first saves the
+// length - 1 inputs before each chunk, other overlaps aren't supported.
+// @param pool - the threads to use.
+// @param filter - the FIR filter to run.
+// @param input - the array of inputs to the filter.
+// @param output - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+// @param minChunk - the smallest chunk size given to a thread.
+//
+// @return - 0 for success, else failure.
+template <class T, class C, class A>
+int parallelFilter(ParallelPool &pool, FIRFilter<T, C, A> &filter, const T *input,
+                T *output, size_t n, size_t minChunk = 16384);
+
+// parallelFilter
+// As above, on sharedParallelPool split into at most numThreads chunks.
+// @param numThreads - the number of chunks, 0 for the threads of the pool.
+template <class T, class C, class A>
+int parallelFilter(FIRFilter<T, C, A> &filter, const T *input, T *output, size_t n,
+                unsigned numThreads = 0, size_t minChunk = 16384);
+
+
+#include "ParallelFIRFilter.hpp"
+
+#endif
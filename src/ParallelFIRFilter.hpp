@@ -0,0 +1,263 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ParallelFIRFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FIRFilter.h
+// ParallelFIRFilter.h
+//
+// Offline filtering of large buffers with an FIRFilter across several threads.
+// The implementation file.
+
+#ifndef __PARALLEL_FIR_FILTER_IMPL__
+#define __PARALLEL_FIR_FILTER_IMPL__
+
+#include "ParallelFIRFilter.h"
+#include <algorithm>
+#include <system_error>
+
+// Constructor
+// @param numThreads - the number of threads to use, 0 to use all
+//                     hardware threads.
+inline ParallelPool::ParallelPool(unsigned numThreads)
+{
+    task = NULL;
+    count = next = finished = 0;
+    generation = 0;
+    stopping = false;
+    if (numThreads == 0) { numThreads = std::thread::hardware_concurrency(); }
+    if (numThreads == 0) { numThreads = 1; }
+    workers.reserve(numThreads - 1);
+    for (unsigned i = 1; i < numThreads; i++) {
+        try {
+            workers.push_back(std::thread(&ParallelPool::work, this));
+        } catch (const std::system_error &) {
+            break; // carry on with the workers that did start.
+        }
+    }
+}
+
+// Destructor
+// stops and joins the workers.
+inline ParallelPool::~ParallelPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) { workers[i].join(); }
+}
+
+// run
+// Calls task(i) for each i in [0, count) over the workers and the
+// calling thread, and returns when all of them are done.
+// @param Count - the number of tasks.
+// @param Task - the task, called from several threads at once.
+inline void ParallelPool::run(size_t Count, const std::function<void(size_t)> &Task)
+{
+    if (Count == 0) { return; }
+    std::lock_guard<std::mutex> serial(runLock);
+    std::unique_lock<std::mutex> guard(lock);
+    task = &Task;
+    count = Count;
+    next = 0;
+    finished = 0;
+    generation++;
+    wake.notify_all();
+    takeTasks(guard);
+    while (finished < count) { finish.wait(guard); }
+    task = NULL;
+}
+
+// work
+// the loop of each worker, waits for a run and takes its tasks.
+inline void ParallelPool::work()
+{
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        while (!stopping && generation == seen) { wake.wait(guard); }
+        if (stopping) { return; }
+        seen = generation;
+        takeTasks(guard);
+    }
+}
+
+// takeTasks
+// runs tasks of the current run until none are left, with lock held
+// on entry and exit.
+inline void ParallelPool::takeTasks(std::unique_lock<std::mutex> &guard)
+{
+    while (next < count) {
+        size_t i = next++;
+        const std::function<void(size_t)> *t = task;
+        guard.unlock();
+        (*t)(i);
+        guard.lock();
+        if (++finished == count) { finish.notify_all(); }
+    }
+}
+
+// sharedParallelPool
+// @return - a pool of all hardware threads, started on first use.
+inline ParallelPool &sharedParallelPool()
+{
+    static ParallelPool pool;
+    return pool;
+}
+
+// ConvolveChunk
+// a task of parallelFilter, filters chunk c of the block.
+// In place, the inputs before a chunk can be overwritten by the chunk before
+// it, so overlaps holds a copy for each chunk after the first of the history
+// inputs before it and its own first history inputs. The first outputs
+// of those chunks are computed in that copy instead.
+template <class T, class C, class A>
+struct ConvolveChunk {
+    const FIRFilter<T, C, A> *filter;
+    const T *input;
+    T *output;
+    size_t n;
+    size_t chunkLen;
+    T *overlaps;    // NULL unless in place.
+    size_t history; // length - 1 of the filter.
+
+    void operator()(size_t c) const
+    {
+        size_t start = c * chunkLen;
+        size_t end = (start + chunkLen < n) ? start + chunkLen : n;
+        if (start >= end) { return; }
+        if (overlaps == NULL || c == 0) {
+            filter->convolveRange(input, output, start, end);
+            return;
+        }
+        // outputs from first on only read this chunk's inputs, and are
+        // computed last to first, so in place they go before the rest.
+        size_t first = (start + history < end) ? start + history : end;
+        filter->convolveRange(input, output, first, end);
+        T *saved = overlaps + (c - 1) * 2 * history;
+        filter->convolveRange(saved, saved, history, history + first - start);
+        std::copy(saved + history, saved + history + first - start, output + start);
+    }
+};
+
+// splitChunks
+// the number of chunks for a block, at most maxChunks and none shorter
+// than minChunk.
+inline size_t splitChunks(size_t n, size_t maxChunks, size_t minChunk)
+{
+    if (minChunk == 0) { minChunk = 1; }
+    size_t chunks = (n + minChunk - 1) / minChunk;
+    return (maxChunks < chunks) ? maxChunks : chunks;
+}
+
+// runChunks
+// filters the block in numChunks chunks on the pool, then moves the filter
+// state on over it.
+template <class T, class C, class A>
+int runChunks(ParallelPool &pool, FIRFilter<T, C, A> &filter, const T *input, T *output,
+                size_t n, size_t numChunks)
+{
+    if (input == NULL || output == NULL) { return -1; }
+    if (n == 0) { return 0; }
+    if (numChunks == 0) { numChunks = 1; }
+    FILTER_PROBE_START();
+
+    size_t chunkLen = (n + numChunks - 1) / numChunks;
+    size_t history = (filter.getLength() > 0) ? filter.getLength() - 1 : 0;
+    size_t keep = (n < filter.getLength()) ? n : filter.getLength();
+    ConvolveChunk<T, C, A> chunk = {&filter, input, output, n, chunkLen, NULL, history};
+
+    // chunks read the inputs before them, so in place those are saved before
+    // any chunk writes, along with the last inputs for the delay line.
+    std::vector<T> copy;
+    const T *last = input + n - keep;
+    if (input == output) {
+        if (numChunks > 1 && chunkLen < history) {
+            // chunks shorter than the filter, the history spans several
+            // chunks and copying the block is no more work.
+            copy.assign(input, input + n);
+            chunk.input = copy.data();
+            last = copy.data() + n - keep;
+        } else {
+            size_t overlapLen = (numChunks - 1) * 2 * history;
+            copy.resize(overlapLen + keep);
+            for (size_t c = 1; c < numChunks && c * chunkLen < n; c++) {
+                size_t start = c * chunkLen;
+                size_t end = (start + history < n) ? start + history : n;
+                std::copy(input + start - history, input + end,
+                        copy.begin() + (c - 1) * 2 * history);
+            }
+            std::copy(input + n - keep, input + n, copy.begin() + overlapLen);
+            if (overlapLen > 0) { chunk.overlaps = copy.data(); }
+            last = copy.data() + overlapLen;
+        }
+    }
+
+    // each chunk only reads its inputs, the saved overlaps and its own range
+    // of output, and the filter state isn't changed until all chunks are done.
+    pool.run(numChunks, chunk);
+
+    filter.advance(last, keep);
+    FILTER_PROBE_END(filter.getStats(), n);
+#ifdef DSP_LITE_INSTRUMENT
+    for (size_t i = 0; i < n; i++) { FILTER_PROBE_OUTPUT(filter.getStats(), output[i]); }
+#endif
+    return 0;
+} // end runChunks
+
+// parallelFilter
+// Filters a block of n inputs with the given filter, splitting the work into
+// chunks over the threads of a pool. The filter state is updated the same as
+// if filter had been called on each input, so this can be mixed with serial
+// calls. May be done in place (output == input), which first saves the
+// length - 1 inputs before each chunk, other overlaps aren't supported.
+// @param pool - the threads to use.
+// @param filter - the FIR filter to run.
+// @param input - the array of inputs to the filter.
+// @param output - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+// @param minChunk - the smallest chunk size given to a thread.
+//
+// @return - 0 for success, else failure.
+template <class T, class C, class A>
+int parallelFilter(ParallelPool &pool, FIRFilter<T, C, A> &filter, const T *input,
+                T *output, size_t n, size_t minChunk)
+{
+    return runChunks(pool, filter, input, output, n,
+                    splitChunks(n, pool.getNumThreads(), minChunk));
+} // end parallelFilter
+
+// parallelFilter
+// As above, on sharedParallelPool split into at most numThreads chunks.
+// @param numThreads - the number of chunks, 0 for the threads of the pool.
+template <class T, class C, class A>
+int parallelFilter(FIRFilter<T, C, A> &filter, const T *input, T *output, size_t n,
+                unsigned numThreads, size_t minChunk)
+{
+    ParallelPool &pool = sharedParallelPool();
+    if (numThreads == 0) { numThreads = pool.getNumThreads(); }
+    return runChunks(pool, filter, input, output, n, splitChunks(n, numThreads, minChunk));
+} // end parallelFilter
+
+
+#endif
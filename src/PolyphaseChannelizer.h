@@ -0,0 +1,141 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// PolyphaseChannelizer.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FFT.h
+// PolyphaseChannelizer.hpp
+//
+// A polyphase FFT filter bank, which splits a wideband signal into M equally
+// spaced channels at once. Channel k is centered on 2 pi k / M, and is the
+// input mixed down to baseband, low pass filtered by the prototype h and
+// decimated by D:
+//   y_k[m] = sum_n h[n] x[t - n] e^(-2 pi i k (t - n) / M),  t = (m + 1) D - 1
+// so output frame m is made once input t has arrived.
+//
+// The prototype is split into M branches of L = ceil(length / M) taps. Each
+// output frame sums the L taps of every branch, rotates the M branch sums
+// by t mod M and does one inverse FFT of size M, for O(length + M log M) a
+// frame, or O(length / D + (M / D) log M) an input sample, rather than
+// O(M length / D) for a band pass filter per channel.
+// D = M is critically sampled, D = M / 2 is oversampled by 2, which lets
+// the channels overlap so a signal near a band edge isn't lost. Any D from
+// 1 to M works.
+//
+// The prototype is an ordinary low pass, with a cutoff of about pi / M,
+// designed with idealFilterCoef and applyKaiserWindow. Its taps are stored
+// reversed and the history is kept as separate real and imaginary arrays,
+// so the branch sums are contiguous and vectorize.
+//
+// Example:
+// uint32_t N = 16 * 64 - 1;
+// double *h = idealFilterCoef<double>(M_PI / 64, N);
+// applyKaiserWindow(h, N, 70.0);
+// PolyphaseChannelizer<double> bank(h, N, 64, 32);   // oversampled by 2
+// std::vector<std::complex<double> > out(bank.maxOutput(n) * 64);
+// size_t frames = bank.process(in, n, &out[0]);     // out[frame * 64 + k]
+
+#ifndef __POLYPHASE_CHANNELIZER__
+#define __POLYPHASE_CHANNELIZER__
+
+#include "FFT.h"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// the most inputs added to the history between shifts, beyond the prototype length.
+#define CHANNELIZER_CHUNK 256
+
+template <class T>
+class PolyphaseChannelizer {
+public:
+    // Constructor
+    // @param prototype - the low pass prototype taps.
+    // @param length - the number of prototype taps.
+    // @param channels - the number of channels M, at least 1.
+    // @param decimation - the inputs per output frame D, 1 to M (clamped).
+    PolyphaseChannelizer(const T *prototype, uint32_t length, uint32_t channels,
+                         uint32_t decimation);
+
+    // maxOutput
+    // @param n - a number of inputs.
+    //
+    // @return - the most frames process can write for n inputs.
+    size_t maxOutput(size_t n) const { return (phase + n) / decimation; }
+
+    // process
+    // Channelizes a block of real inputs, the phase carries over to the
+    // next block.
+    // @param input - the inputs.
+    // @param n - the number of inputs.
+    // @param output - maxOutput(n) frames of M channels, output[frame * M + k].
+    //
+    // @return - the number of frames written.
+    size_t process(const T *input, size_t n, std::complex<T> *output);
+
+    // process
+    // Channelizes a block of complex inputs.
+    // @param input - the inputs.
+    // @param n - the number of inputs.
+    // @param output - maxOutput(n) frames of M channels, output[frame * M + k].
+    //
+    // @return - the number of frames written.
+    size_t process(const std::complex<T> *input, size_t n, std::complex<T> *output);
+
+    // reset
+    // clears the history and starts the next frame from input 0.
+    void reset();
+
+    uint32_t getChannels() const { return channels; }
+    uint32_t getDecimation() const { return decimation; }
+    uint32_t getBranchLength() const { return branchLength; }
+
+    // getDelay
+    // @return - the group delay of the prototype in inputs, for a symmetric prototype.
+    double getDelay() const { return (length - 1) / 2.0; }
+
+private:
+    // push
+    // adds an input to the history, and makes a frame when one is due.
+    // @return - true if a frame was written to output.
+    bool push(T re, T im, std::complex<T> *output);
+    void makeFrame(std::complex<T> *output);
+
+    uint32_t channels;
+    uint32_t decimation;
+    uint32_t length;
+    uint32_t branchLength;  // L, the taps of each branch.
+    uint32_t phase;         // inputs since the last frame.
+    uint32_t position;      // t mod M of the newest input.
+
+    std::vector<T> taps;    // the prototype reversed, zero padded to L M.
+    std::vector<T> historyRe;
+    std::vector<T> historyIm;
+    size_t used;            // samples in the history, the last L M are the window.
+    std::vector<T> sumRe;   // branch sums, in reversed order.
+    std::vector<T> sumIm;
+    std::vector<std::complex<T> > rotated;
+    FFTPlan<T> plan;
+};
+
+#include "PolyphaseChannelizer.hpp"
+#endif
@@ -0,0 +1,173 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// PolyphaseChannelizer.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// PolyphaseChannelizer.h
+//
+// Implementation of the polyphase FFT channelizer.
+//
+// With n = p + l M, the sum for channel k is
+//   sum_p v_p e^(2 pi i k (p - s) / M),  v_p = sum_l h[p + l M] x[t - p - l M]
+// where s = t mod M, which is the unscaled inverse DFT of v rotated by s.
+
+#ifndef __POLYPHASE_CHANNELIZER_IMPL__
+#define __POLYPHASE_CHANNELIZER_IMPL__
+
+#include "PolyphaseChannelizer.h"
+#include <algorithm>
+
+// Constructor
+// @param prototype - the low pass prototype taps.
+// @param length - the number of prototype taps.
+// @param channels - the number of channels M, at least 1.
+// @param decimation - the inputs per output frame D, 1 to M (clamped).
+template <class T>
+PolyphaseChannelizer<T>::PolyphaseChannelizer(const T *prototype, uint32_t Length,
+                                              uint32_t Channels, uint32_t Decimation)
+    : plan(std::max(Channels, (uint32_t)1))
+{
+    channels = std::max(Channels, (uint32_t)1);
+    decimation = std::min(std::max(Decimation, (uint32_t)1), channels);
+    length = (prototype == NULL) ? 0 : Length;
+    branchLength = std::max((length + channels - 1) / channels, (uint32_t)1);
+
+    // taps[j] = h[L M - 1 - j], so the window and taps line up front to back.
+    size_t window = (size_t)branchLength * channels;
+    taps.assign(window, 0);
+    for (uint32_t n = 0; n < length; n++) { taps[window - 1 - n] = prototype[n]; }
+
+    size_t capacity = window - 1 + std::max(window, (size_t)CHANNELIZER_CHUNK);
+    historyRe.assign(capacity, 0);
+    historyIm.assign(capacity, 0);
+    sumRe.resize(channels);
+    sumIm.resize(channels);
+    rotated.resize(channels);
+    reset();
+}
+
+// reset
+// clears the history and starts the next frame from input 0.
+template <class T>
+void PolyphaseChannelizer<T>::reset()
+{
+    std::fill(historyRe.begin(), historyRe.end(), (T)0);
+    std::fill(historyIm.begin(), historyIm.end(), (T)0);
+    used = taps.size() - 1;
+    phase = 0;
+    position = channels - 1;
+}
+
+// process
+// Channelizes a block of real inputs, the phase carries over to the
+// next block.
+// @param input - the inputs.
+// @param n - the number of inputs.
+// @param output - maxOutput(n) frames of M channels, output[frame * M + k].
+//
+// @return - the number of frames written.
+template <class T>
+size_t PolyphaseChannelizer<T>::process(const T *input, size_t n, std::complex<T> *output)
+{
+    size_t frames = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (push(input[i], (T)0, output + frames * channels)) { frames++; }
+    }
+    return frames;
+}
+
+// process
+// Channelizes a block of complex inputs.
+// @param input - the inputs.
+// @param n - the number of inputs.
+// @param output - maxOutput(n) frames of M channels, output[frame * M + k].
+//
+// @return - the number of frames written.
+template <class T>
+size_t PolyphaseChannelizer<T>::process(const std::complex<T> *input, size_t n,
+                                        std::complex<T> *output)
+{
+    size_t frames = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (push(input[i].real(), input[i].imag(), output + frames * channels)) { frames++; }
+    }
+    return frames;
+}
+
+// push
+// adds an input to the history, and makes a frame when one is due. When
+// the history is full the last L M - 1 inputs are moved to the front.
+// @return - true if a frame was written to output.
+template <class T>
+bool PolyphaseChannelizer<T>::push(T re, T im, std::complex<T> *output)
+{
+    if (used == historyRe.size()) {
+        size_t keep = taps.size() - 1;
+        std::copy(historyRe.end() - keep, historyRe.end(), historyRe.begin());
+        std::copy(historyIm.end() - keep, historyIm.end(), historyIm.begin());
+        used = keep;
+    }
+    historyRe[used] = re;
+    historyIm[used] = im;
+    used++;
+    position = (position + 1 == channels) ? 0 : position + 1;
+    if (++phase < decimation) { return false; }
+    phase = 0;
+    makeFrame(output);
+    return true;
+}
+
+// makeFrame
+// sums the branches over the last L M inputs, rotates them and transforms.
+template <class T>
+void PolyphaseChannelizer<T>::makeFrame(std::complex<T> *output)
+{
+    const uint32_t M = channels;
+    const T *h = &taps[0];
+    const T *xRe = &historyRe[used - taps.size()];
+    const T *xIm = &historyIm[used - taps.size()];
+    T *accRe = &sumRe[0];
+    T *accIm = &sumIm[0];
+    // accRe[q] is v_p for p = M - 1 - q.
+    for (uint32_t q = 0; q < M; q++) {
+        accRe[q] = h[q] * xRe[q];
+        accIm[q] = h[q] * xIm[q];
+    }
+    for (uint32_t l = 1; l < branchLength; l++) {
+        const T *hl = h + (size_t)l * M;
+        const T *rl = xRe + (size_t)l * M;
+        const T *il = xIm + (size_t)l * M;
+        for (uint32_t q = 0; q < M; q++) {
+            accRe[q] += hl[q] * rl[q];
+            accIm[q] += hl[q] * il[q];
+        }
+    }
+
+    // rotated[q] = v_((q + s) mod M).
+    for (uint32_t q = 0; q < M; q++) {
+        uint32_t p = q + position;
+        if (p >= M) { p -= M; }
+        rotated[q] = std::complex<T>(accRe[M - 1 - p], accIm[M - 1 - p]);
+    }
+    plan.inverse(&rotated[0], output);
+}
+
+#endif
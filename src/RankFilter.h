@@ -0,0 +1,221 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// RankFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// RankFilter.hpp
+//
+// Sliding rank order filters, the output is the rank'th smallest of the
+// last length inputs, e.g. a median filter to remove impulse noise before
+// linear filtering. Like the FIR filter, the window starts full of zeros.
+//
+// The window is kept in two indexed heaps over a pool of nodes, one per
+// sample in the window. A max heap holds the rank + 1 smallest samples and
+// a min heap the rest, so the output is the top of the max heap. Each input
+// overwrites the node of the oldest sample and moves it within its heap,
+// then the tops are swapped if they are out of order, so each sample is
+// O(log length) and nothing is allocated after construction.
+// Comparisons with NaN inputs are always false, so NaNs give undefined
+// (but safe) outputs until they leave the window.
+//
+// Example:
+// MedianFilter<float> median(255);
+// RankFilter<float> p90(255, RankFilter<float>::percentileRank(255, 90.0));
+// y = median.filter(x);
+
+#ifndef __RANK_FILTER__
+#define __RANK_FILTER__
+
+#include "Filter.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A sample in the window, and where it is in the heaps.
+template <class T>
+struct RankNode {
+    T value;
+    uint16_t heapPos; // < rank + 1 in the max heap, else the min heap.
+};
+
+// RankWindow
+// The two heaps of one window, over nodes and heap storage owned by the
+// filter, so a multichannel filter keeps every window in one pool.
+template <class T>
+class RankWindow {
+public:
+    // attach
+    // Uses length nodes and heap entries, and fills the window with zeros.
+    // @param nodes - length nodes.
+    // @param heap - length heap entries.
+    // @param length - the size of the window.
+    // @param rank - the rank of the output, 0 is the smallest.
+    void attach(RankNode<T> *nodes, uint16_t *heap, uint16_t length, uint16_t rank);
+
+    // fill
+    // sets every sample in the window to x.
+    void fill(T x);
+
+    // push
+    // replaces the oldest sample with x.
+    // @return - the rank'th smallest sample of the window.
+    T push(T x);
+
+    // get
+    // @return - the rank'th smallest sample of the window.
+    T get() const { return nodes[heap[0]].value; }
+
+private:
+    // siftUp / siftDown
+    // move the node at position i of a heap up or down to where it belongs.
+    // MAX is true for the max heap of the low samples.
+    template <bool MAX>
+    void siftUp(uint32_t base, uint32_t i);
+    template <bool MAX>
+    void siftDown(uint32_t base, uint32_t size, uint32_t i);
+
+    RankNode<T> *nodes;
+    uint16_t *heap;   // [0, lowSize) max heap, then the min heap.
+    uint16_t length;
+    uint16_t lowSize; // rank + 1
+    uint16_t cur;     // node of the oldest sample.
+};
+
+template <class T>
+class RankFilter: public Filter<T> {
+public:
+    // Constructor
+    // @param length - the size of the window, at least 1.
+    // @param rank - the rank of the output, 0 for the minimum, length - 1
+    //               for the maximum. Larger ranks are clamped.
+    RankFilter(uint16_t length, uint16_t rank);
+
+    // filter
+    // @param x - the input to the filter.
+    //
+    // @return - the rank'th smallest of the last length inputs.
+    T filter(T x);
+
+    // getOutput
+    // @return - last output of the filter.
+    T getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n inputs, may be done in place.
+    // @param input - the array of inputs to the filter.
+    // @param output - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const T *input, T *output, size_t n);
+
+    // setSteadyState
+    // fills the window with x, reset() fills it with zeros.
+    void setSteadyState(T x);
+    void reset() { setSteadyState(0); }
+
+    uint16_t getLength() const { return length; }
+    uint16_t getRank() const { return rank; }
+
+    // percentileRank
+    // @param length - the size of the window.
+    // @param percentile - 0 to 100, 50 is the median.
+    //
+    // @return - the rank of the percentile, rounded to the nearest.
+    static uint16_t percentileRank(uint16_t length, double percentile);
+
+private:
+    // the window points into the pool.
+    RankFilter(const RankFilter &) = delete;
+    RankFilter &operator=(const RankFilter &) = delete;
+
+    std::vector<RankNode<T> > nodes;
+    std::vector<uint16_t> heap;
+    RankWindow<T> window;
+    uint16_t length;
+    uint16_t rank;
+    T output;
+};
+
+// MedianFilter
+// A rank filter at the middle of the window, for an even length this is
+// the lower of the two middle samples.
+template <class T>
+class MedianFilter: public RankFilter<T> {
+public:
+    // Constructor
+    // @param length - the size of the window, odd for a true median.
+    MedianFilter(uint16_t length)
+        : RankFilter<T>(length, length > 0 ? (length - 1) / 2 : 0) {}
+};
+
+// MultichannelRankFilter
+// A rank filter per channel over interleaved frames, see MultichannelFilter.h
+// for the layout. The windows of every channel share one pool of nodes.
+template <class T>
+class MultichannelRankFilter {
+public:
+    // Constructor
+    // @param length - the size of the window of each channel.
+    // @param rank - the rank of the output.
+    // @param numChannels - the number of interleaved channels.
+    MultichannelRankFilter(uint16_t length, uint16_t rank, uint16_t numChannels);
+
+    // filterFrame
+    // Filters one frame.
+    // @param in - numChannels inputs.
+    // @param out - numChannels outputs, may be the same as in.
+    void filterFrame(const T *in, T *out);
+
+    // filterBlock
+    // Filters a block of interleaved frames, may be done in place.
+    // @param input - numFrames * numChannels inputs.
+    // @param out - numFrames * numChannels outputs.
+    // @param numFrames - the number of frames.
+    void filterBlock(const T *input, T *out, size_t numFrames);
+
+    // getOutput
+    // @return - the last output frame, numChannels long.
+    const T *getOutput() const { return &output[0]; }
+
+    // reset
+    // fills the window of every channel with zeros.
+    void reset();
+
+    uint16_t getNumChannels() const { return numChannels; }
+    uint16_t getLength() const { return length; }
+    uint16_t getRank() const { return rank; }
+
+private:
+    MultichannelRankFilter(const MultichannelRankFilter &) = delete;
+    MultichannelRankFilter &operator=(const MultichannelRankFilter &) = delete;
+
+    std::vector<RankNode<T> > nodes;  // [channel][node]
+    std::vector<uint16_t> heap;       // [channel][heap entry]
+    std::vector<RankWindow<T> > windows;
+    std::vector<T> output;
+    uint16_t numChannels;
+    uint16_t length;
+    uint16_t rank;
+};
+
+// include implementation file
+#include "RankFilter.hpp"
+#endif
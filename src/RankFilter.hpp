@@ -0,0 +1,293 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// RankFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// RankFilter.h
+//
+// Sliding rank order filters.
+// The implementation file.
+//
+// Both heaps live in one array of node numbers, the max heap of the low
+// samples at [0, rank + 1) and the min heap of the high samples after it,
+// and each node keeps its position in that array. Replacing a sample only
+// ever moves it within its own heap, and afterwards at most one pair
+// (the two tops) is out of order, since every other sample in the max heap
+// is still no more than every sample in the min heap.
+
+#ifndef __RANK_FILTER_IMPL__
+#define __RANK_FILTER_IMPL__
+
+#include "RankFilter.h"
+#include <cmath>
+
+///////////////////////////// window /////////////////////////////
+
+// attach
+// Uses length nodes and heap entries, and fills the window with zeros.
+// @param nodes - length nodes.
+// @param heap - length heap entries.
+// @param length - the size of the window.
+// @param rank - the rank of the output, 0 is the smallest.
+template <class T>
+void RankWindow<T>::attach(RankNode<T> *Nodes, uint16_t *Heap, uint16_t Length, uint16_t rank)
+{
+    nodes = Nodes;
+    heap = Heap;
+    length = Length;
+    lowSize = rank + 1;
+    fill(0);
+}
+
+// fill
+// sets every sample in the window to x, any order is a valid heap.
+template <class T>
+void RankWindow<T>::fill(T x)
+{
+    for (uint16_t i = 0; i < length; i++) {
+        nodes[i].value = x;
+        nodes[i].heapPos = i;
+        heap[i] = i;
+    }
+    cur = 0;
+}
+
+// siftUp
+// moves the node at position i of a heap towards the top.
+// @param base - the start of the heap in the heap array.
+// @param i - the position in the heap.
+template <class T>
+template <bool MAX>
+void RankWindow<T>::siftUp(uint32_t base, uint32_t i)
+{
+    uint16_t *h = heap + base;
+    uint16_t node = h[i];
+    T x = nodes[node].value;
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        T p = nodes[h[parent]].value;
+        if (MAX ? !(x > p) : !(x < p)) { break; }
+        h[i] = h[parent];
+        nodes[h[i]].heapPos = (uint16_t)(base + i);
+        i = parent;
+    }
+    h[i] = node;
+    nodes[node].heapPos = (uint16_t)(base + i);
+}
+
+// siftDown
+// moves the node at position i of a heap away from the top.
+// @param base - the start of the heap in the heap array.
+// @param size - the number of nodes in the heap.
+// @param i - the position in the heap.
+template <class T>
+template <bool MAX>
+void RankWindow<T>::siftDown(uint32_t base, uint32_t size, uint32_t i)
+{
+    uint16_t *h = heap + base;
+    uint16_t node = h[i];
+    T x = nodes[node].value;
+    while (true) {
+        uint32_t child = 2 * i + 1;
+        if (child >= size) { break; }
+        T c = nodes[h[child]].value;
+        if (child + 1 < size) {
+            T right = nodes[h[child + 1]].value;
+            if (MAX ? (right > c) : (right < c)) {
+                child++;
+                c = right;
+            }
+        }
+        if (MAX ? !(c > x) : !(c < x)) { break; }
+        h[i] = h[child];
+        nodes[h[i]].heapPos = (uint16_t)(base + i);
+        i = child;
+    }
+    h[i] = node;
+    nodes[node].heapPos = (uint16_t)(base + i);
+}
+
+// push
+// replaces the oldest sample with x.
+// @return - the rank'th smallest sample of the window.
+template <class T>
+T RankWindow<T>::push(T x)
+{
+    RankNode<T> &node = nodes[cur];
+    T old = node.value;
+    node.value = x;
+    uint32_t pos = node.heapPos;
+    uint32_t highSize = length - lowSize;
+    if (pos < lowSize) {
+        if (x > old) { siftUp<true>(0, pos); }
+        else { siftDown<true>(0, lowSize, pos); }
+    } else {
+        if (x < old) { siftUp<false>(lowSize, pos - lowSize); }
+        else { siftDown<false>(lowSize, highSize, pos - lowSize); }
+    }
+
+    // swap the tops if the largest low sample is above the smallest high one.
+    if (highSize > 0) {
+        uint16_t low = heap[0];
+        uint16_t high = heap[lowSize];
+        if (nodes[low].value > nodes[high].value) {
+            heap[0] = high;
+            nodes[high].heapPos = 0;
+            heap[lowSize] = low;
+            nodes[low].heapPos = lowSize;
+            siftDown<true>(0, lowSize, 0);
+            siftDown<false>(lowSize, highSize, 0);
+        }
+    }
+
+    cur = (cur + 1 == length) ? 0 : cur + 1;
+    return nodes[heap[0]].value;
+} // end push
+
+
+///////////////////////////// filter /////////////////////////////
+
+// Constructor
+// @param length - the size of the window, at least 1.
+// @param rank - the rank of the output, 0 for the minimum, length - 1
+//               for the maximum. Larger ranks are clamped.
+template <class T>
+RankFilter<T>::RankFilter(uint16_t Length, uint16_t Rank)
+{
+    length = (Length > 0) ? Length : 1;
+    rank = (Rank < length) ? Rank : length - 1;
+    nodes.resize(length);
+    heap.resize(length);
+    window.attach(&nodes[0], &heap[0], length, rank);
+    output = 0;
+}
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - the rank'th smallest of the last length inputs.
+template <class T>
+T RankFilter<T>::filter(T x)
+{
+    output = window.push(x);
+    return output;
+}
+
+// filterBlock
+// Filters a block of n inputs, may be done in place.
+// @param input - the array of inputs to the filter.
+// @param output - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void RankFilter<T>::filterBlock(const T *input, T *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) { out[i] = window.push(input[i]); }
+    if (n > 0) { output = out[n - 1]; }
+}
+
+// setSteadyState
+// fills the window with x, reset() fills it with zeros.
+template <class T>
+void RankFilter<T>::setSteadyState(T x)
+{
+    window.fill(x);
+    output = x;
+}
+
+// percentileRank
+// @param length - the size of the window.
+// @param percentile - 0 to 100, 50 is the median.
+//
+// @return - the rank of the percentile, rounded to the nearest.
+template <class T>
+uint16_t RankFilter<T>::percentileRank(uint16_t length, double percentile)
+{
+    if (length == 0 || !(percentile > 0.0)) { return 0; }
+    if (percentile >= 100.0) { return length - 1; }
+    return (uint16_t)std::floor(percentile / 100.0 * (length - 1) + 0.5);
+}
+
+
+///////////////////////////// multichannel /////////////////////////////
+
+// Constructor
+// @param length - the size of the window of each channel.
+// @param rank - the rank of the output.
+// @param numChannels - the number of interleaved channels.
+template <class T>
+MultichannelRankFilter<T>::MultichannelRankFilter(uint16_t Length, uint16_t Rank,
+                                                uint16_t NumChannels)
+{
+    numChannels = (NumChannels > 0) ? NumChannels : 1;
+    length = (Length > 0) ? Length : 1;
+    rank = (Rank < length) ? Rank : length - 1;
+    nodes.resize((size_t)numChannels * length);
+    heap.resize((size_t)numChannels * length);
+    windows.resize(numChannels);
+    output.assign(numChannels, 0);
+    for (uint16_t c = 0; c < numChannels; c++) {
+        windows[c].attach(&nodes[(size_t)c * length], &heap[(size_t)c * length], length, rank);
+    }
+}
+
+// filterFrame
+// Filters one frame.
+// @param in - numChannels inputs.
+// @param out - numChannels outputs, may be the same as in.
+template <class T>
+void MultichannelRankFilter<T>::filterFrame(const T *in, T *out)
+{
+    for (uint16_t c = 0; c < numChannels; c++) {
+        output[c] = windows[c].push(in[c]);
+        out[c] = output[c];
+    }
+}
+
+// filterBlock
+// Filters a block of interleaved frames, may be done in place.
+// @param input - numFrames * numChannels inputs.
+// @param out - numFrames * numChannels outputs.
+// @param numFrames - the number of frames.
+template <class T>
+void MultichannelRankFilter<T>::filterBlock(const T *input, T *out, size_t numFrames)
+{
+    if (numFrames == 0) { return; }
+    // a channel at a time, so each pass stays in one window of the pool.
+    for (uint16_t c = 0; c < numChannels; c++) {
+        RankWindow<T> &window = windows[c];
+        for (size_t n = 0; n < numFrames; n++) {
+            size_t k = n * numChannels + c;
+            out[k] = window.push(input[k]);
+        }
+        output[c] = out[(numFrames - 1) * numChannels + c];
+    }
+}
+
+// reset
+// fills the window of every channel with zeros.
+template <class T>
+void MultichannelRankFilter<T>::reset()
+{
+    for (uint16_t c = 0; c < numChannels; c++) { windows[c].fill(0); }
+    output.assign(numChannels, 0);
+}
+
+#endif
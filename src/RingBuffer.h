@@ -0,0 +1,168 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// RingBuffer.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// RingBuffer.hpp
+//
+// A lock free single producer, single consumer ring buffer of samples, for
+// passing audio from a capture thread to a DSP thread without a mutex.
+// Exactly one thread may call the producer functions (push, beginWrite,
+// commitWrite, writeAvailable) and one other thread the consumer functions
+// (pop, beginRead, commitRead, readAvailable). The counters can be read
+// from any thread.
+//
+// The write and read indices only ever increase, and are masked into the
+// buffer, so the capacity is rounded up to a power of 2. Each index is on
+// its own cache line, with the side's cached copy of the other index, so
+// the two threads only touch each other's line when the cached copy says
+// the buffer is full or empty.
+//
+// Counters:
+// overruns - samples push couldn't write because the buffer was full
+//            (these samples are dropped).
+// underruns - samples pop was asked for that weren't there yet.
+//
+// Example:
+// SPSCRingBuffer<float> ring(4096);
+// capture thread:  ring.push(block, 64);
+// DSP thread:      size_t n = ring.pop(block, 64);
+
+#ifndef __RING_BUFFER__
+#define __RING_BUFFER__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// size of a cache line, the indices are kept this far apart.
+#define RING_CACHE_LINE 64
+
+template <class T>
+class SPSCRingBuffer {
+public:
+    // Constructor
+    // @param capacity - the number of samples, rounded up to a power of 2.
+    SPSCRingBuffer(size_t capacity);
+
+    ///////////////////// producer /////////////////////
+
+    // push
+    // Copies in as many of the samples as there is room for.
+    // @param data - the samples to write.
+    // @param n - the number of samples.
+    //
+    // @return - the number of samples written, the rest count as overruns.
+    size_t push(const T *data, size_t n);
+
+    // beginWrite
+    // Returns the contiguous free space, to write samples in place.
+    // Call commitWrite after writing.
+    // @param n - set to the number of samples that can be written.
+    //
+    // @return - where to write the samples.
+    T *beginWrite(size_t &n);
+
+    // commitWrite
+    // Makes n samples written after beginWrite visible to the consumer.
+    // @param n - the number of samples written, at most what beginWrite gave.
+    void commitWrite(size_t n);
+
+    // writeAvailable
+    // @return - the number of samples that can be written.
+    size_t writeAvailable();
+
+    ///////////////////// consumer /////////////////////
+
+    // pop
+    // Copies out up to n samples.
+    // @param data - where to write the samples.
+    // @param n - the number of samples wanted.
+    //
+    // @return - the number of samples read, the rest count as underruns.
+    size_t pop(T *data, size_t n);
+
+    // beginRead
+    // Returns the contiguous readable samples, to read them in place.
+    // Call commitRead after reading.
+    // @param n - set to the number of samples that can be read.
+    //
+    // @return - the samples.
+    const T *beginRead(size_t &n);
+
+    // commitRead
+    // Frees n samples read after beginRead.
+    // @param n - the number of samples read, at most what beginRead gave.
+    void commitRead(size_t n);
+
+    // readAvailable
+    // @return - the number of samples that can be read.
+    size_t readAvailable();
+
+    ///////////////////// any thread /////////////////////
+
+    // getCapacity
+    // @return - the number of samples the buffer holds.
+    size_t getCapacity() const { return capacity; }
+
+    // getOverruns
+    // @return - the number of samples push dropped.
+    uint64_t getOverruns() const { return producer.overruns.load(std::memory_order_relaxed); }
+
+    // getUnderruns
+    // @return - the number of samples pop was short.
+    uint64_t getUnderruns() const { return consumer.underruns.load(std::memory_order_relaxed); }
+
+private:
+    // freeSpace
+    // the free space, refreshing the cached tail if less than wanted.
+    size_t freeSpace(size_t head, size_t wanted);
+
+    // readySamples
+    // the readable samples, refreshing the cached head if less than wanted.
+    size_t readySamples(size_t tail, size_t wanted);
+
+    // the producer's line, only written by the producer.
+    struct alignas(RING_CACHE_LINE) ProducerIndex {
+        std::atomic<size_t> head;       // next sample to write.
+        size_t cachedTail;              // last tail the producer saw.
+        std::atomic<uint64_t> overruns;
+    };
+    // the consumer's line, only written by the consumer.
+    struct alignas(RING_CACHE_LINE) ConsumerIndex {
+        std::atomic<size_t> tail;       // next sample to read.
+        size_t cachedHead;              // last head the consumer saw.
+        std::atomic<uint64_t> underruns;
+    };
+
+    ProducerIndex producer;
+    ConsumerIndex consumer;
+    // read only after construction.
+    alignas(RING_CACHE_LINE) std::vector<T> buffer;
+    size_t capacity;
+    size_t mask;
+};
+
+// include implementation file
+#include "RingBuffer.hpp"
+
+#endif
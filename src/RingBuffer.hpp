@@ -0,0 +1,203 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// RingBuffer.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// RingBuffer.h
+//
+// A lock free single producer, single consumer ring buffer of samples.
+// The implementation file.
+//
+// The producer publishes samples with a release store of head, and the
+// consumer frees them with a release store of tail. Each side reads the
+// other's index with an acquire load, so the samples are always written
+// before they are read, and read before they are overwritten.
+
+#ifndef __RING_BUFFER_IMPL__
+#define __RING_BUFFER_IMPL__
+
+#include "RingBuffer.h"
+#include <algorithm>
+
+// Constructor
+// @param capacity - the number of samples, rounded up to a power of 2.
+template <class T>
+SPSCRingBuffer<T>::SPSCRingBuffer(size_t Capacity)
+{
+    capacity = 1;
+    while (capacity < Capacity) { capacity <<= 1; }
+    mask = capacity - 1;
+    buffer.resize(capacity);
+
+    producer.head.store(0, std::memory_order_relaxed);
+    producer.cachedTail = 0;
+    producer.overruns.store(0, std::memory_order_relaxed);
+    consumer.tail.store(0, std::memory_order_relaxed);
+    consumer.cachedHead = 0;
+    consumer.underruns.store(0, std::memory_order_relaxed);
+}
+
+// freeSpace
+// the free space, only reading the consumer's index if the cached copy
+// says there is less than wanted.
+template <class T>
+size_t SPSCRingBuffer<T>::freeSpace(size_t head, size_t wanted)
+{
+    size_t space = capacity - (head - producer.cachedTail);
+    if (space < wanted) {
+        producer.cachedTail = consumer.tail.load(std::memory_order_acquire);
+        space = capacity - (head - producer.cachedTail);
+    }
+    return space;
+}
+
+// writeAvailable
+// @return - the number of samples that can be written.
+template <class T>
+size_t SPSCRingBuffer<T>::writeAvailable()
+{
+    return freeSpace(producer.head.load(std::memory_order_relaxed), capacity);
+}
+
+// beginWrite
+// Returns the contiguous free space, to write samples in place.
+// @param n - set to the number of samples that can be written.
+//
+// @return - where to write the samples.
+template <class T>
+T *SPSCRingBuffer<T>::beginWrite(size_t &n)
+{
+    size_t head = producer.head.load(std::memory_order_relaxed);
+    size_t offset = head & mask;
+    n = std::min(freeSpace(head, capacity - offset), capacity - offset);
+    return &buffer[offset];
+}
+
+// commitWrite
+// Makes n samples written after beginWrite visible to the consumer.
+// @param n - the number of samples written.
+template <class T>
+void SPSCRingBuffer<T>::commitWrite(size_t n)
+{
+    size_t head = producer.head.load(std::memory_order_relaxed);
+    producer.head.store(head + n, std::memory_order_release);
+}
+
+// push
+// Copies in as many of the samples as there is room for.
+// @param data - the samples to write.
+// @param n - the number of samples.
+//
+// @return - the number of samples written, the rest count as overruns.
+template <class T>
+size_t SPSCRingBuffer<T>::push(const T *data, size_t n)
+{
+    size_t head = producer.head.load(std::memory_order_relaxed);
+    size_t count = std::min(n, freeSpace(head, n));
+
+    // copy in up to two pieces, either side of the end of the buffer.
+    size_t offset = head & mask;
+    size_t first = std::min(count, capacity - offset);
+    std::copy(data, data + first, &buffer[offset]);
+    std::copy(data + first, data + count, &buffer[0]);
+    producer.head.store(head + count, std::memory_order_release);
+
+    if (count < n) {
+        // only this thread writes the counter, so no read modify write.
+        uint64_t dropped = producer.overruns.load(std::memory_order_relaxed);
+        producer.overruns.store(dropped + (n - count), std::memory_order_relaxed);
+    }
+    return count;
+} // end push
+
+// readySamples
+// the readable samples, only reading the producer's index if the cached
+// copy says there are less than wanted.
+template <class T>
+size_t SPSCRingBuffer<T>::readySamples(size_t tail, size_t wanted)
+{
+    size_t ready = consumer.cachedHead - tail;
+    if (ready < wanted) {
+        consumer.cachedHead = producer.head.load(std::memory_order_acquire);
+        ready = consumer.cachedHead - tail;
+    }
+    return ready;
+}
+
+// readAvailable
+// @return - the number of samples that can be read.
+template <class T>
+size_t SPSCRingBuffer<T>::readAvailable()
+{
+    return readySamples(consumer.tail.load(std::memory_order_relaxed), capacity);
+}
+
+// beginRead
+// Returns the contiguous readable samples, to read them in place.
+// @param n - set to the number of samples that can be read.
+//
+// @return - the samples.
+template <class T>
+const T *SPSCRingBuffer<T>::beginRead(size_t &n)
+{
+    size_t tail = consumer.tail.load(std::memory_order_relaxed);
+    size_t offset = tail & mask;
+    n = std::min(readySamples(tail, capacity - offset), capacity - offset);
+    return &buffer[offset];
+}
+
+// commitRead
+// Frees n samples read after beginRead.
+// @param n - the number of samples read.
+template <class T>
+void SPSCRingBuffer<T>::commitRead(size_t n)
+{
+    size_t tail = consumer.tail.load(std::memory_order_relaxed);
+    consumer.tail.store(tail + n, std::memory_order_release);
+}
+
+// pop
+// Copies out up to n samples.
+// @param data - where to write the samples.
+// @param n - the number of samples wanted.
+//
+// @return - the number of samples read, the rest count as underruns.
+template <class T>
+size_t SPSCRingBuffer<T>::pop(T *data, size_t n)
+{
+    size_t tail = consumer.tail.load(std::memory_order_relaxed);
+    size_t count = std::min(n, readySamples(tail, n));
+
+    size_t offset = tail & mask;
+    size_t first = std::min(count, capacity - offset);
+    std::copy(&buffer[offset], &buffer[offset] + first, data);
+    std::copy(&buffer[0], &buffer[0] + (count - first), data + first);
+    consumer.tail.store(tail + count, std::memory_order_release);
+
+    if (count < n) {
+        uint64_t missing = consumer.underruns.load(std::memory_order_relaxed);
+        consumer.underruns.store(missing + (n - count), std::memory_order_relaxed);
+    }
+    return count;
+} // end pop
+
+
+#endif
@@ -0,0 +1,186 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SampleConvert.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// SampleConvert.hpp
+//
+// Conversion between PCM sample formats and floating point, and filter
+// entry points that take one format in and give another out.
+//
+// Integer formats are scaled to floating point full scale, -1.0 to 1.0:
+//   int16_t      x / 2^15
+//   PackedInt24  x / 2^23    (3 byte little endian samples)
+//   int32_t      x / 2^31
+// float and double pass through with only the gain applied.
+//
+// Converting back to an integer format rounds to the nearest value, and
+// saturates at the limits of the format instead of wrapping. NaN becomes 0.
+// A TPDFDither can be given to add triangular dither of +-1 LSB before
+// rounding.
+//
+// Every function takes a stride, the distance in samples between one sample
+// and the next, so one channel of interleaved audio can be read or written
+// in place. A stride of 1 takes a contiguous loop the compiler vectorizes.
+//
+// filterConvert runs the conversion, filterBlock and conversion back over
+// tiles of CONVERT_TILE samples kept on the stack, so the samples only
+// leave the cache once, and no buffer the size of the input is needed.
+//
+// Example, filtering the left channel of interleaved int16 stereo:
+// filterConvert(leftFilter, pcm, 2, pcm, 2, frames);
+
+#ifndef __SAMPLE_CONVERT__
+#define __SAMPLE_CONVERT__
+
+#include "Filter.h"
+#include <cstddef>
+#include <cstdint>
+
+// number of samples converted and filtered at a time by filterConvert.
+#define CONVERT_TILE 256
+
+// number of independent generators in TPDFDither.
+#define DITHER_LANES 8
+
+// A 24 bit sample packed in 3 bytes, little endian.
+struct PackedInt24 {
+    uint8_t bytes[3];
+};
+
+// SampleFormat
+// The scaling and limits of each sample format, and how to load and store it.
+template <class S> struct SampleFormat;
+
+template <> struct SampleFormat<int16_t> {
+    static const bool isInteger = true;
+    static double fullScale() { return 32768.0; }
+    static double minValue() { return -32768.0; }
+    static double maxValue() { return 32767.0; }
+    static int32_t load(const int16_t &s) { return s; }
+    static void store(int16_t &s, int32_t v) { s = (int16_t)v; }
+};
+
+template <> struct SampleFormat<PackedInt24> {
+    static const bool isInteger = true;
+    static double fullScale() { return 8388608.0; }
+    static double minValue() { return -8388608.0; }
+    static double maxValue() { return 8388607.0; }
+    static int32_t load(const PackedInt24 &s)
+    {
+        // shift up to the top of the word, then back down to sign extend.
+        uint32_t u = (uint32_t)s.bytes[0] << 8 | (uint32_t)s.bytes[1] << 16 |
+                    (uint32_t)s.bytes[2] << 24;
+        return (int32_t)u >> 8;
+    }
+    static void store(PackedInt24 &s, int32_t v)
+    {
+        s.bytes[0] = (uint8_t)v;
+        s.bytes[1] = (uint8_t)(v >> 8);
+        s.bytes[2] = (uint8_t)(v >> 16);
+    }
+};
+
+template <> struct SampleFormat<int32_t> {
+    static const bool isInteger = true;
+    static double fullScale() { return 2147483648.0; }
+    static double minValue() { return -2147483648.0; }
+    static double maxValue() { return 2147483647.0; }
+    static int32_t load(const int32_t &s) { return s; }
+    static void store(int32_t &s, int32_t v) { s = v; }
+};
+
+template <> struct SampleFormat<float> {
+    static const bool isInteger = false;
+    static double fullScale() { return 1.0; }
+};
+
+template <> struct SampleFormat<double> {
+    static const bool isInteger = false;
+    static double fullScale() { return 1.0; }
+};
+
+
+// Triangular (TPDF) dither of +-1 LSB, from DITHER_LANES xorshift
+// generators stepped together, so generating it vectorizes.
+class TPDFDither {
+public:
+    // Constructor
+    // @param seed - the seed, the same seed gives the same dither.
+    TPDFDither(uint32_t seed = 1);
+
+    // generate
+    // Writes n dither values between -1 and 1 (in LSBs).
+    // @param d - the output.
+    // @param n - the number of values.
+    template <class F>
+    void generate(F *d, size_t n);
+
+private:
+    uint32_t state[DITHER_LANES];
+};
+
+
+// convertToFloat
+// Converts samples to floating point full scale, times the gain.
+// @param input - the input samples.
+// @param inStride - the distance between input samples.
+// @param output - the output, n contiguous samples.
+// @param n - the number of samples.
+// @param gain - multiplies the output.
+template <class In, class F>
+void convertToFloat(const In *input, size_t inStride, F *output, size_t n, F gain = 1);
+
+// convertFromFloat
+// Converts floating point full scale samples, times the gain, to another
+// format, with rounding and saturation for integer formats.
+// @param input - n contiguous input samples.
+// @param output - the output samples.
+// @param outStride - the distance between output samples.
+// @param n - the number of samples.
+// @param gain - multiplies the input.
+// @param dither - adds dither before rounding, NULL for none.
+template <class F, class Out>
+void convertFromFloat(const F *input, Out *output, size_t outStride, size_t n,
+                    F gain = 1, TPDFDither *dither = NULL);
+
+// filterConvert
+// Filters samples of one format into another, converting on the way in
+// and out. The input and output may be the same array.
+// @param filter - the filter, working in floating point type F.
+// @param input - the input samples.
+// @param inStride - the distance between input samples.
+// @param output - the output samples.
+// @param outStride - the distance between output samples.
+// @param n - the number of samples.
+// @param inGain - multiplies the input after converting.
+// @param outGain - multiplies the filter output before converting.
+// @param dither - adds dither before rounding, NULL for none.
+template <class In, class Out, class F>
+void filterConvert(Filter<F> &filter, const In *input, size_t inStride,
+                Out *output, size_t outStride, size_t n,
+                F inGain = 1, F outGain = 1, TPDFDither *dither = NULL);
+
+
+#include "SampleConvert.hpp"
+
+#endif
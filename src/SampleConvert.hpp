@@ -0,0 +1,220 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SampleConvert.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// SampleConvert.h
+//
+// Conversion between PCM sample formats and floating point.
+// The implementation file.
+
+#ifndef __SAMPLE_CONVERT_IMPL__
+#define __SAMPLE_CONVERT_IMPL__
+
+#include "SampleConvert.h"
+#include <cmath>
+
+// Constructor
+// @param seed - the seed, the same seed gives the same dither.
+inline TPDFDither::TPDFDither(uint32_t seed)
+{
+    for (int j = 0; j < DITHER_LANES; j++) {
+        // xorshift can't start from 0.
+        state[j] = (seed + 1) * 2654435761u * (uint32_t)(2 * j + 1);
+        if (state[j] == 0) { state[j] = 1; }
+    }
+}
+
+// generate
+// Writes n dither values between -1 and 1 (in LSBs). Each value is the
+// difference of two uniform 16 bit values, which is triangular.
+// @param d - the output.
+// @param n - the number of values.
+template <class F>
+void TPDFDither::generate(F *d, size_t n)
+{
+    const F scale = (F)(1.0 / 65536.0);
+    for (size_t i = 0; i < n; i += DITHER_LANES) {
+        int32_t r[DITHER_LANES];
+        for (int j = 0; j < DITHER_LANES; j++) {
+            uint32_t s = state[j];
+            s ^= s << 13;
+            s ^= s >> 17;
+            s ^= s << 5;
+            state[j] = s;
+            r[j] = (int32_t)(s >> 16) - (int32_t)(s & 0xffff);
+        }
+        size_t len = (n - i < DITHER_LANES) ? n - i : DITHER_LANES;
+        for (size_t j = 0; j < len; j++) { d[i + j] = (F)r[j] * scale; }
+    }
+} // end generate
+
+
+// SampleReader
+// loads samples of any format as F, in integer units.
+template <class In, bool isInteger = SampleFormat<In>::isInteger>
+struct SampleReader {
+    template <class F>
+    static F read(const In &s) { return (F)s; }
+};
+
+template <class In>
+struct SampleReader<In, true> {
+    template <class F>
+    static F read(const In &s) { return (F)SampleFormat<In>::load(s); }
+};
+
+// SampleWriter
+// stores F values, already in integer units, as any format. Integer
+// formats are rounded and saturated.
+template <class Out, bool isInteger = SampleFormat<Out>::isInteger>
+struct SampleWriter {
+    template <class F>
+    static void write(const F *input, Out *output, size_t stride, size_t n,
+                    F scale, const F *dither)
+    {
+        for (size_t i = 0; i < n; i++) { output[i * stride] = (Out)(input[i] * scale); }
+    }
+};
+
+template <class Out>
+struct SampleWriter<Out, true> {
+    template <class F>
+    static void write(const F *input, Out *output, size_t stride, size_t n,
+                    F scale, const F *dither)
+    {
+        F lo = (F)SampleFormat<Out>::minValue();
+        F hi = (F)SampleFormat<Out>::maxValue();
+        // int32 max rounds up in float, which would overflow the cast.
+        if ((double)hi > SampleFormat<Out>::maxValue()) { hi = std::nextafter(hi, (F)0); }
+
+        // the dither test is kept out of the loops, so they vectorize.
+        if (dither == NULL) {
+            for (size_t i = 0; i < n; i++) {
+                SampleFormat<Out>::store(output[i * stride], round(input[i] * scale, lo, hi));
+            }
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                SampleFormat<Out>::store(output[i * stride],
+                                        round(input[i] * scale + dither[i], lo, hi));
+            }
+        }
+    }
+
+    // round
+    // rounds half away from zero and saturates v to lo...hi, with selects
+    // rather than branches. Rounding before saturating keeps GCC from
+    // turning the selects back into branches.
+    template <class F>
+    static int32_t round(F v, F lo, F hi)
+    {
+        v += std::copysign((F)0.5, v);
+        v = (v < lo) ? lo : v;
+        v = (v > hi) ? hi : v;
+        v = (v == v) ? v : (F)0; // NaN
+        return (int32_t)v;
+    }
+};
+
+
+// convertToFloat
+// Converts samples to floating point full scale, times the gain.
+// @param input - the input samples.
+// @param inStride - the distance between input samples.
+// @param output - the output, n contiguous samples.
+// @param n - the number of samples.
+// @param gain - multiplies the output.
+template <class In, class F>
+void convertToFloat(const In *input, size_t inStride, F *output, size_t n, F gain)
+{
+    F scale = gain / (F)SampleFormat<In>::fullScale();
+    if (inStride == 1) {
+        for (size_t i = 0; i < n; i++) {
+            output[i] = SampleReader<In>::template read<F>(input[i]) * scale;
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            output[i] = SampleReader<In>::template read<F>(input[i * inStride]) * scale;
+        }
+    }
+} // end convertToFloat
+
+// convertFromFloat
+// Converts floating point full scale samples, times the gain, to another
+// format, with rounding and saturation for integer formats.
+// @param input - n contiguous input samples.
+// @param output - the output samples.
+// @param outStride - the distance between output samples.
+// @param n - the number of samples.
+// @param gain - multiplies the input.
+// @param dither - adds dither before rounding, NULL for none.
+template <class F, class Out>
+void convertFromFloat(const F *input, Out *output, size_t outStride, size_t n,
+                    F gain, TPDFDither *dither)
+{
+    F scale = gain * (F)SampleFormat<Out>::fullScale();
+    F d[CONVERT_TILE];
+    for (size_t i = 0; i < n; i += CONVERT_TILE) {
+        size_t len = (n - i < CONVERT_TILE) ? n - i : CONVERT_TILE;
+        const F *tileDither = NULL;
+        if (dither != NULL && SampleFormat<Out>::isInteger) {
+            dither->generate(d, len);
+            tileDither = d;
+        }
+        // a constant stride of 1 lets the compiler vectorize.
+        if (outStride == 1) {
+            SampleWriter<Out>::write(input + i, output + i, 1, len, scale, tileDither);
+        } else {
+            SampleWriter<Out>::write(input + i, output + i * outStride, outStride, len,
+                                    scale, tileDither);
+        }
+    }
+} // end convertFromFloat
+
+// filterConvert
+// Filters samples of one format into another, converting on the way in
+// and out, one tile at a time.
+// @param filter - the filter, working in floating point type F.
+// @param input - the input samples.
+// @param inStride - the distance between input samples.
+// @param output - the output samples.
+// @param outStride - the distance between output samples.
+// @param n - the number of samples.
+// @param inGain - multiplies the input after converting.
+// @param outGain - multiplies the filter output before converting.
+// @param dither - adds dither before rounding, NULL for none.
+template <class In, class Out, class F>
+void filterConvert(Filter<F> &filter, const In *input, size_t inStride,
+                Out *output, size_t outStride, size_t n,
+                F inGain, F outGain, TPDFDither *dither)
+{
+    F in[CONVERT_TILE];
+    F out[CONVERT_TILE];
+    for (size_t i = 0; i < n; i += CONVERT_TILE) {
+        size_t len = (n - i < CONVERT_TILE) ? n - i : CONVERT_TILE;
+        convertToFloat(input + i * inStride, inStride, in, len, inGain);
+        filter.filterBlock(in, out, len);
+        convertFromFloat(out, output + i * outStride, outStride, len, outGain, dither);
+    }
+} // end filterConvert
+
+
+#endif
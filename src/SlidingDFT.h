@@ -0,0 +1,147 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SlidingDFT.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// SlidingDFT.hpp
+//
+// A sliding DFT, which tracks chosen bins of the N point DFT of the last N
+// samples. Each sample updates every bin with one complex multiply:
+// X_k = e^(2 pi i k / N) (r X_k + x[n] - r^N x[n - N])
+// r is a damping factor just under 1, which keeps round off from building
+// up forever, at the cost of weighting older samples by up to r^(N-1).
+//
+// Unlike the GoertzelBank, the bins are valid after every sample. The bin
+// powers are computed every hopLength samples, normalized so a sine of
+// amplitude A at a bin gives A^2 / 4.
+//
+// The bins are stored as separate real and imaginary arrays, and each
+// sample updates every bin in one loop across them, so the compiler can
+// vectorize across the bins.
+//
+// T is the sample type, S is the type of the bin state (default double).
+// As a Filter, the output is the largest bin power of the last hop,
+// saturated at the limits of an integer T, use getPower for the full value.
+
+#ifndef __SLIDING_DFT__
+#define __SLIDING_DFT__
+
+#include "Filter.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+template <class T, class S = double>
+class SlidingDFT: public Filter<T> {
+public:
+    // Constructor
+    // @param bins - the DFT bin numbers to track, 0 to N - 1.
+    // @param numBins - the number of bins, with 0 the output is always 0.
+    // @param N - the length of the DFT.
+    // @param hopLength - the number of samples between power outputs.
+    // @param damping - the damping factor r, 1.0 for none.
+    SlidingDFT(const uint32_t *bins, uint16_t numBins, uint32_t N,
+            uint32_t hopLength, double damping = 0.999999);
+
+    // filter
+    // Slides the DFT along by one sample.
+    // @param x - the input to the filter.
+    //
+    // @return - the largest bin power of the last hop.
+    T filter(T x);
+
+    // getOutput
+    // @return - the largest bin power of the last hop.
+    T getOutput();
+
+    // filterBlock
+    // Filters a block of n inputs, this is the same as calling filter on
+    // each input in order, and writing each result to output.
+    // @param input - the array of inputs to the filter.
+    // @param out - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const T *input, T *out, size_t n);
+
+    // getBin
+    // @param bin - the index of the bin (not the DFT bin number).
+    //
+    // @return - the current value of the bin.
+    std::complex<S> getBin(uint16_t bin) const
+    {
+        return std::complex<S>(re[bin], im[bin]);
+    }
+
+    // getPowers
+    // @return - the power of every bin at the last hop.
+    const S *getPowers() const { return power.data(); }
+
+    // getPower
+    // @param bin - the index of the bin.
+    //
+    // @return - the power of the bin at the last hop.
+    S getPower(uint16_t bin) const { return power[bin]; }
+
+    // getHopCount
+    // @return - the number of hops completed.
+    uint32_t getHopCount() const { return hopCount; }
+
+    // getNumBins
+    uint16_t getNumBins() const { return numBins; }
+
+    // getLength
+    // returns the length of the DFT.
+    uint32_t getLength() const { return length; }
+
+    // reset
+    // clears the bins, history, powers and output.
+    void reset();
+
+private:
+    // update
+    // slides n samples in, n must not go past the end of the hop.
+    void update(const T *input, size_t n);
+
+    // finishHop
+    // computes the bin powers.
+    void finishHop();
+
+    std::vector<S> re;
+    std::vector<S> im;
+    std::vector<S> cosW;
+    std::vector<S> sinW;
+    std::vector<S> power;
+    std::vector<T> history; // circular buffer of the last N samples.
+    S damping;
+    S dampingN; // damping^N
+    uint32_t length;
+    uint32_t curBufLoc;
+    uint16_t numBins;
+    uint32_t hopLength;
+    uint32_t count; // samples in the current hop.
+    uint32_t hopCount;
+    T output;
+};
+
+
+#include "SlidingDFT.hpp"
+
+#endif
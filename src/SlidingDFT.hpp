@@ -0,0 +1,162 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SlidingDFT.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// SlidingDFT.h
+//
+// A sliding DFT of chosen bins.
+// The implementation file.
+
+#ifndef __SLIDING_DFT_IMPL__
+#define __SLIDING_DFT_IMPL__
+
+#include "SlidingDFT.h"
+#include <cmath>
+
+// Constructor
+// @param bins - the DFT bin numbers to track, 0 to N - 1.
+// @param numBins - the number of bins, with 0 the output is always 0.
+// @param N - the length of the DFT.
+// @param hopLength - the number of samples between power outputs.
+// @param damping - the damping factor r, 1.0 for none.
+template <class T, class S>
+SlidingDFT<T, S>::SlidingDFT(const uint32_t *bins, uint16_t NumBins, uint32_t N,
+                        uint32_t HopLength, double Damping) :
+    re(NumBins), im(NumBins), cosW(NumBins), sinW(NumBins), power(NumBins),
+    numBins(NumBins)
+{
+    length = (N > 0) ? N : 1;
+    hopLength = (HopLength > 0) ? HopLength : 1;
+    history.resize(length);
+    damping = (S)Damping;
+    dampingN = (S)pow(Damping, (double)length);
+    for (uint16_t k = 0; k < numBins; k++) {
+        double w = 2.0 * M_PI * (double)(bins[k] % length) / length;
+        cosW[k] = (S)cos(w);
+        sinW[k] = (S)sin(w);
+    }
+    reset();
+} // end constructor
+
+// filter
+// Slides the DFT along by one sample.
+// @param x - the input to the filter.
+//
+// @return - the largest bin power of the last hop.
+template <class T, class S>
+T SlidingDFT<T, S>::filter(T x)
+{
+    update(&x, 1);
+    return output;
+}
+
+// getOutput
+// @return - the largest bin power of the last hop.
+template <class T, class S>
+T SlidingDFT<T, S>::getOutput()
+{
+    return output;
+}
+
+// filterBlock
+// Filters a block of n inputs, this is the same as calling filter on
+// each input in order, and writing each result to output.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T, class S>
+void SlidingDFT<T, S>::filterBlock(const T *input, T *out, size_t n)
+{
+    size_t i = 0;
+    while (i < n) {
+        size_t run = hopLength - count;
+        if (run > n - i) { run = n - i; }
+        // the output only changes at the end of a hop.
+        for (size_t j = 0; j < run - 1; j++) { out[i + j] = output; }
+        update(input + i, run);
+        out[i + run - 1] = output;
+        i += run;
+    }
+} // end filterBlock
+
+// reset
+// clears the bins, history, powers and output.
+template <class T, class S>
+void SlidingDFT<T, S>::reset()
+{
+    for (uint16_t k = 0; k < numBins; k++) {
+        re[k] = 0;
+        im[k] = 0;
+        power[k] = 0;
+    }
+    for (uint32_t i = 0; i < length; i++) { history[i] = 0; }
+    curBufLoc = 0;
+    count = 0;
+    hopCount = 0;
+    output = 0;
+}
+
+// update
+// slides n samples in, n must not go past the end of the hop.
+template <class T, class S>
+void SlidingDFT<T, S>::update(const T *input, size_t n)
+{
+    S *a = re.data();
+    S *b = im.data();
+    const S *c = cosW.data();
+    const S *s = sinW.data();
+    for (size_t i = 0; i < n; i++) {
+        // the sample leaving the window is replaced by the new one.
+        S delta = (S)input[i] - dampingN * (S)history[curBufLoc];
+        history[curBufLoc] = input[i];
+        curBufLoc = (curBufLoc + 1 == length) ? 0 : curBufLoc + 1;
+
+        // across the bins, so this loop vectorizes.
+        for (uint16_t k = 0; k < numBins; k++) {
+            S x = damping * a[k] + delta;
+            S y = damping * b[k];
+            a[k] = x * c[k] - y * s[k];
+            b[k] = x * s[k] + y * c[k];
+        }
+    }
+    count += n;
+    if (count >= hopLength) { finishHop(); }
+} // end update
+
+// finishHop
+// computes the bin powers.
+template <class T, class S>
+void SlidingDFT<T, S>::finishHop()
+{
+    S scale = (S)(1.0 / ((double)length * length));
+    S largest = 0;
+    for (uint16_t k = 0; k < numBins; k++) {
+        power[k] = (re[k] * re[k] + im[k] * im[k]) * scale;
+        if (power[k] > largest) { largest = power[k]; }
+    }
+    output = saturateOutput<T>(largest);
+    count = 0;
+    hopCount++;
+} // end finishHop
+
+
+#endif
@@ -0,0 +1,126 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SparseFIRFilter.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// SparseFIRFilter.hpp
+//
+// An FIR filter for long impulse responses that are mostly zero, e.g.
+// multipath and echo models of 20k to 200k samples with tens of taps.
+// Only the nonzero taps are kept, as (delay, gain) pairs, so each output
+// costs O(taps) however long the response is:
+//   y[n] = sum gain[i] x[n - delay[i]]
+//
+// The history is a circular buffer of a power of 2 samples, indexed with
+// 32 bit positions and a mask, long enough for the largest delay and a
+// block of SPARSE_FIR_CHUNK inputs. filterBlock copies a chunk of inputs
+// into the history, then goes through the taps one at a time, adding the
+// run of history each one reads to the outputs. Each run is split at the
+// wrap point at most once, so the inner loop is a plain multiply-add of two
+// contiguous arrays and vectorizes.
+//
+// T should be a floating point type.
+//
+// Example:
+// uint32_t delays[] = {0, 1200, 48000, 150000};
+// float gains[] = {1.0f, 0.5f, 0.25f, 0.1f};
+// SparseFIRFilter<float> echo(delays, gains, 4);
+// echo.filterBlock(in, out, n);
+
+#ifndef __SPARSE_FIR_FILTER__
+#define __SPARSE_FIR_FILTER__
+
+#include "Filter.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// inputs added to the history by each pass of filterBlock.
+#define SPARSE_FIR_CHUNK 256
+
+template <class T>
+class SparseFIRFilter: public Filter<T> {
+public:
+    // Constructor
+    // @param delays - the delay of each tap in samples, in any order.
+    // @param gains - the gain of each tap.
+    // @param numTaps - the number of taps.
+    SparseFIRFilter(const uint32_t *delays, const T *gains, uint32_t numTaps);
+
+    // setTaps
+    // Replaces the taps. The history is kept if it is long enough for the
+    // new taps, including when they are shorter (it never shrinks), else it
+    // is reallocated and cleared.
+    // @param delays - the delay of each tap in samples, in any order.
+    // @param gains - the gain of each tap.
+    // @param numTaps - the number of taps.
+    //
+    // @return - 0 for success, else failure (the taps are unchanged).
+    int setTaps(const uint32_t *delays, const T *gains, uint32_t numTaps);
+
+    // setDenseTaps
+    // Takes the taps of a dense impulse response whose magnitude is above a
+    // threshold.
+    // @param coefficients - the impulse response.
+    // @param length - the length of the impulse response.
+    // @param threshold - taps with a magnitude at or below this are dropped.
+    //
+    // @return - 0 for success, else failure.
+    int setDenseTaps(const T *coefficients, uint32_t length, T threshold = 0);
+
+    // filter
+    // @param x - the input to the filter.
+    //
+    // @return - output of the filter.
+    T filter(T x);
+
+    // getOutput
+    // @return - the last output of the filter.
+    T getOutput() { return output; }
+
+    // filterBlock
+    // Filters a block of n inputs, may be done in place.
+    // @param input - the array of inputs to the filter.
+    // @param output - the array to write the outputs to (length n).
+    // @param n - the number of samples in the block.
+    void filterBlock(const T *input, T *output, size_t n);
+
+    // reset
+    // clears the history.
+    void reset();
+
+    uint32_t getNumTaps() const { return (uint32_t)delays.size(); }
+    uint32_t getMaxDelay() const { return maxDelay; }
+
+private:
+    std::vector<uint32_t> delays; // sorted, so runs are read in order.
+    std::vector<T> gains;
+    std::vector<T> history;       // circular, a power of 2 long.
+    uint32_t mask;
+    uint32_t pos;                 // where the next input goes.
+    uint32_t maxDelay;
+    T output;
+};
+
+// include implementation file
+#include "SparseFIRFilter.hpp"
+#endif
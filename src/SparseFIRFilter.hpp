@@ -0,0 +1,179 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SparseFIRFilter.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// SparseFIRFilter.h
+//
+// Implementation of the sparse FIR filter.
+
+#ifndef __SPARSE_FIR_FILTER_IMPL__
+#define __SPARSE_FIR_FILTER_IMPL__
+
+#include "SparseFIRFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Constructor
+// @param delays - the delay of each tap in samples, in any order.
+// @param gains - the gain of each tap.
+// @param numTaps - the number of taps.
+template <class T>
+SparseFIRFilter<T>::SparseFIRFilter(const uint32_t *Delays, const T *Gains, uint32_t numTaps)
+{
+    mask = 0;
+    pos = 0;
+    maxDelay = 0;
+    output = 0;
+    if (setTaps(Delays, Gains, numTaps) != 0) { setTaps(NULL, NULL, 0); }
+}
+
+// setTaps
+// Replaces the taps. The history is kept if it is long enough for the
+// new taps, including when they are shorter (it never shrinks), else it
+// is reallocated and cleared.
+// @param delays - the delay of each tap in samples, in any order.
+// @param gains - the gain of each tap.
+// @param numTaps - the number of taps.
+//
+// @return - 0 for success, else failure (the taps are unchanged).
+template <class T>
+int SparseFIRFilter<T>::setTaps(const uint32_t *Delays, const T *Gains, uint32_t numTaps)
+{
+    if (numTaps > 0 && (Delays == NULL || Gains == NULL)) { return -1; }
+    std::vector<std::pair<uint32_t, T> > taps(numTaps);
+    uint32_t longest = 0;
+    for (uint32_t i = 0; i < numTaps; i++) {
+        taps[i] = std::make_pair(Delays[i], Gains[i]);
+        longest = std::max(longest, Delays[i]);
+    }
+    // the history has to hold the longest delay and a chunk, in 32 bits.
+    uint64_t needed = (uint64_t)longest + SPARSE_FIR_CHUNK;
+    if (needed > ((uint64_t)1 << 31)) { return -1; }
+    std::sort(taps.begin(), taps.end());
+
+    delays.resize(numTaps);
+    gains.resize(numTaps);
+    for (uint32_t i = 0; i < numTaps; i++) {
+        delays[i] = taps[i].first;
+        gains[i] = taps[i].second;
+    }
+    maxDelay = longest;
+
+    uint32_t size = 1;
+    while (size < needed) { size *= 2; }
+    if (size > history.size()) {
+        history.assign(size, 0);
+        mask = size - 1;
+        pos = 0;
+    }
+    return 0;
+} // end setTaps
+
+// setDenseTaps
+// Takes the taps of a dense impulse response whose magnitude is above a
+// threshold.
+// @param coefficients - the impulse response.
+// @param length - the length of the impulse response.
+// @param threshold - taps with a magnitude at or below this are dropped.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int SparseFIRFilter<T>::setDenseTaps(const T *coefficients, uint32_t length, T threshold)
+{
+    if (coefficients == NULL && length > 0) { return -1; }
+    std::vector<uint32_t> d;
+    std::vector<T> g;
+    for (uint32_t i = 0; i < length; i++) {
+        if (std::fabs(coefficients[i]) > threshold) {
+            d.push_back(i);
+            g.push_back(coefficients[i]);
+        }
+    }
+    return setTaps(d.empty() ? NULL : &d[0], g.empty() ? NULL : &g[0], (uint32_t)d.size());
+}
+
+// filter
+// @param x - the input to the filter.
+//
+// @return - output of the filter.
+template <class T>
+T SparseFIRFilter<T>::filter(T x)
+{
+    history[pos] = x;
+    const T *h = &history[0];
+    T y = 0;
+    for (size_t i = 0; i < delays.size(); i++) {
+        y += gains[i] * h[(pos - delays[i]) & mask];
+    }
+    pos = (pos + 1) & mask;
+    output = y;
+    return y;
+}
+
+// filterBlock
+// Filters a block of n inputs, may be done in place. The inputs of each
+// chunk are copied into the history before any of its outputs are written.
+// @param input - the array of inputs to the filter.
+// @param out - the array to write the outputs to (length n).
+// @param n - the number of samples in the block.
+template <class T>
+void SparseFIRFilter<T>::filterBlock(const T *input, T *out, size_t n)
+{
+    const T *h = &history[0];
+    uint32_t size = mask + 1;
+    size_t done = 0;
+    while (done < n) {
+        uint32_t count = (uint32_t)std::min(n - done, (size_t)SPARSE_FIR_CHUNK);
+        // copy in the chunk, split at the end of the history.
+        uint32_t first = std::min(count, size - pos);
+        std::copy(input + done, input + done + first, history.begin() + pos);
+        std::copy(input + done + first, input + done + count, history.begin());
+
+        T *y = out + done;
+        std::fill(y, y + count, (T)0);
+        for (size_t i = 0; i < delays.size(); i++) {
+            T g = gains[i];
+            // output j reads history[pos + j - delay], split where it wraps.
+            uint32_t start = (pos - delays[i]) & mask;
+            uint32_t run = std::min(count, size - start);
+            const T *x = h + start;
+            for (uint32_t j = 0; j < run; j++) { y[j] += g * x[j]; }
+            for (uint32_t j = run; j < count; j++) { y[j] += g * h[j - run]; }
+        }
+        pos = (pos + count) & mask;
+        done += count;
+    }
+    if (n > 0) { output = out[n - 1]; }
+} // end filterBlock
+
+// reset
+// clears the history.
+template <class T>
+void SparseFIRFilter<T>::reset()
+{
+    std::fill(history.begin(), history.end(), (T)0);
+    pos = 0;
+    output = 0;
+}
+
+#endif
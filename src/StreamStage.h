@@ -0,0 +1,99 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// StreamStage.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// Filter.h
+// RingBuffer.h
+// StreamStage.hpp
+//
+// A streaming stage for the DSP thread, that drains an input ring buffer in
+// blocks through any Filter, and pushes the results to an output ring.
+// The filter reads the input ring and writes the output ring in place, so
+// there are no copies. The stage is the consumer of the input ring and the
+// producer of the output ring.
+//
+// When the output ring is full the stage stops taking input, so a slow
+// reader shows up as overruns on the input ring, where the capture thread
+// can see them, rather than as lost filter output.
+//
+// Example:
+// SPSCRingBuffer<float> in(4096), out(4096);
+// FIRFilter<float> fir(gains, 64);
+// StreamStage<float> stage(fir, in, out, 256);
+// DSP thread: stage.run(running);
+
+#ifndef __STREAM_STAGE__
+#define __STREAM_STAGE__
+
+#include "Filter.h"
+#include "RingBuffer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <class T>
+class StreamStage {
+public:
+    // Constructor
+    // @param filter - the filter to run, its filterBlock must not be in place.
+    // @param input - the ring to read samples from.
+    // @param output - the ring to write filtered samples to.
+    // @param maxBlock - the most samples given to filterBlock at once.
+    StreamStage(Filter<T> &filter, SPSCRingBuffer<T> &input,
+                SPSCRingBuffer<T> &output, size_t maxBlock = 256);
+
+    // process
+    // Filters everything available in the input ring, as far as the output
+    // ring has room for.
+    //
+    // @return - the number of samples filtered.
+    size_t process();
+
+    // run
+    // Calls process until running is false, yielding the thread when there
+    // is nothing to do.
+    // @param running - cleared by another thread to stop.
+    //
+    // @return - the number of samples filtered.
+    uint64_t run(const std::atomic<bool> &running);
+
+    // getSamples
+    // @return - the total number of samples filtered.
+    uint64_t getSamples() const { return samples; }
+
+    // getBlocks
+    // @return - the total number of filterBlock calls.
+    uint64_t getBlocks() const { return blocks; }
+
+private:
+    Filter<T> *filter;
+    SPSCRingBuffer<T> *input;
+    SPSCRingBuffer<T> *output;
+    size_t maxBlock;
+    uint64_t samples;
+    uint64_t blocks;
+};
+
+// include implementation file
+#include "StreamStage.hpp"
+
+#endif
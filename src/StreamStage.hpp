@@ -0,0 +1,103 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// StreamStage.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// StreamStage.h
+//
+// A streaming stage that drains a ring buffer through a filter.
+// The implementation file.
+
+#ifndef __STREAM_STAGE_IMPL__
+#define __STREAM_STAGE_IMPL__
+
+#include "StreamStage.h"
+#include <algorithm>
+#include <thread>
+
+// Constructor
+// @param filter - the filter to run, its filterBlock must not be in place.
+// @param input - the ring to read samples from.
+// @param output - the ring to write filtered samples to.
+// @param maxBlock - the most samples given to filterBlock at once.
+template <class T>
+StreamStage<T>::StreamStage(Filter<T> &filter, SPSCRingBuffer<T> &input,
+                            SPSCRingBuffer<T> &output, size_t maxBlock)
+{
+    this->filter = &filter;
+    this->input = &input;
+    this->output = &output;
+    this->maxBlock = (maxBlock > 0) ? maxBlock : 1;
+    samples = 0;
+    blocks = 0;
+}
+
+// process
+// Filters everything available in the input ring, as far as the output
+// ring has room for.
+//
+// @return - the number of samples filtered.
+template <class T>
+size_t StreamStage<T>::process()
+{
+    size_t total = 0;
+    while (true) {
+        // the regions stop at the end of each buffer, so a wrap around
+        // takes an extra block.
+        size_t ready, space;
+        const T *in = input->beginRead(ready);
+        if (ready == 0) { break; }
+        T *out = output->beginWrite(space);
+        size_t n = std::min(std::min(ready, space), maxBlock);
+        if (n == 0) { break; }
+
+        filter->filterBlock(in, out, n);
+        input->commitRead(n);
+        output->commitWrite(n);
+        total += n;
+        blocks++;
+    }
+    samples += total;
+    return total;
+} // end process
+
+// run
+// Calls process until running is false, yielding the thread when there
+// is nothing to do.
+// @param running - cleared by another thread to stop.
+//
+// @return - the number of samples filtered.
+template <class T>
+uint64_t StreamStage<T>::run(const std::atomic<bool> &running)
+{
+    uint64_t total = 0;
+    while (running.load(std::memory_order_acquire)) {
+        size_t n = process();
+        if (n == 0) { std::this_thread::yield(); }
+        total += n;
+    }
+    // pick up anything pushed before running was cleared.
+    total += process();
+    return total;
+}
+
+
+#endif
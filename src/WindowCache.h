@@ -0,0 +1,158 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// WindowCache.h
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FilterUtility.h
+// WindowCache.hpp
+//
+// Fast window generation, and a cache of window tables.
+// applyHammingWindow and applyKaiserWindow compute a cos or bessel function
+// for every tap each time they are called. When many filters are designed the
+// same window is computed over and over, so the WindowCache stores each
+// table once, keyed by (window type, N, A), and applies it in a single pass.
+//
+// The batch generators compute the whole table at once, in loops that work
+// across the table so the compiler can vectorize them, and only compute half
+// of each symmetric window, the Hamming window and odd length Kaiser windows.
+
+#ifndef __WINDOW_CACHE__
+#define __WINDOW_CACHE__
+
+#include "FilterUtility.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// The windows that can be generated.
+// WINDOW_KAISER_FAST is accurate to about 2e-7, where WINDOW_KAISER is
+// accurate to 1e-9. It uses the polynomial bessel approximation for small
+// alpha, and a shorter bessel series otherwise.
+enum WindowType {
+    WINDOW_RECTANGULAR,
+    WINDOW_HAMMING,
+    WINDOW_KAISER,
+    WINDOW_KAISER_FAST
+};
+
+// besselFuncFast
+// polynomial approximation of the bessel function of the first order.
+// Taken from Abramowitz and Stegun 9.8.1 and 9.8.2, relative error < 2e-7.
+// @param x - the input
+//
+// @return - I0(x)
+inline double besselFuncFast(double x);
+
+// hammingWindow
+// Generates a hamming window into the given array.
+// Matches applyHammingWindow applied to an array of ones.
+// @param window - the array to write the window to.
+// @param N - the length of the window.
+//
+// @return - 0 for success, else failure.
+int hammingWindow(double *window, uint32_t N);
+
+// kaiserWindow
+// Generates a kaiser window into the given array.
+// Matches applyKaiserWindow applied to an array of ones.
+// @param window - the array to write the window to.
+// @param N - the length of the window.
+// @param A - stopband attenuation required in dB
+// @param fast - only compute the window to about 2e-7.
+//
+// @return - 0 for success, else failure.
+int kaiserWindow(double *window, uint32_t N, double A, bool fast = false);
+
+// generateWindow
+// Generates any of the window types into the given array.
+// @param window - the array to write the window to.
+// @param type - the type of window.
+// @param N - the length of the window.
+// @param A - stopband attenuation required in dB, for kaiser windows.
+//
+// @return - 0 for success, else failure.
+int generateWindow(double *window, WindowType type, uint32_t N, double A = 0.0);
+
+// applyWindow
+// Multiplies the input by a window table in one pass.
+// @param input - the array to apply the window to.
+// @param window - the window table.
+// @param N - the length of the input and window.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int applyWindow(T *input, const double *window, uint32_t N);
+
+
+class WindowCache {
+public:
+    WindowCache() {}
+
+    // getWindow
+    // Returns the window table for the given parameters, generating it the
+    // first time it is asked for. The table stays valid until clear is called.
+    // @param type - the type of window.
+    // @param N - the length of the window.
+    // @param A - stopband attenuation required in dB, ignored for non kaiser windows.
+    //
+    // @return - the window table of length N, NULL if it can't be made.
+    const double *getWindow(WindowType type, uint32_t N, double A = 0.0);
+
+    // applyWindow
+    // Applies a cached window to the input in one pass.
+    // @param input - the array to apply the window to.
+    // @param type - the type of window.
+    // @param N - the length of the input.
+    // @param A - stopband attenuation required in dB, for kaiser windows.
+    //
+    // @return - 0 for success, else failure.
+    template <class T>
+    int applyWindow(T *input, WindowType type, uint32_t N, double A = 0.0);
+
+    // size
+    // returns the number of tables in the cache.
+    size_t size() const { return tables.size(); }
+
+    // clear
+    // removes all tables, any pointers from getWindow are no longer valid.
+    void clear() { tables.clear(); }
+
+private:
+    struct Key {
+        WindowType type;
+        uint32_t N;
+        double A;
+
+        bool operator<(const Key &other) const
+        {
+            if (type != other.type) { return type < other.type; }
+            if (N != other.N) { return N < other.N; }
+            return A < other.A;
+        }
+    };
+
+    std::map<Key, std::vector<double> > tables;
+};
+
+
+#include "WindowCache.hpp"
+
+#endif
@@ -0,0 +1,259 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// WindowCache.hpp
+// Written Ian Rankin - October 2026
+//
+// Depends:
+// FilterUtility.h
+// WindowCache.h
+//
+// Fast window generation, and a cache of window tables.
+// The implementation file.
+
+#ifndef __WINDOW_CACHE_IMPL__
+#define __WINDOW_CACHE_IMPL__
+
+#include "WindowCache.h"
+#include <cmath>
+
+// chunk size used for the kaiser bessel series.
+#define WINDOW_CHUNK 64
+
+
+// besselFuncFast
+// polynomial approximation of the bessel function of the first order.
+// Taken from Abramowitz and Stegun 9.8.1 and 9.8.2, relative error < 2e-7.
+// @param x - the input
+//
+// @return - I0(x)
+inline double besselFuncFast(double x)
+{
+    double ax = fabs(x);
+    if (ax <= 3.75) {
+        double t = (x / 3.75) * (x / 3.75);
+        return 1.0 + t * (3.5156229 + t * (3.0899424 + t * (1.2067492 +
+            t * (0.2659732 + t * (0.0360768 + t * 0.0045813)))));
+    }
+    double t = 3.75 / ax;
+    double p = 0.39894228 + t * (0.01328592 + t * (0.00225319 + t * (-0.00157565 +
+        t * (0.00916281 + t * (-0.02057706 + t * (0.02635537 + t * (-0.01647633 +
+        t * 0.00392377)))))));
+    return (exp(ax) / sqrt(ax)) * p;
+} // end besselFuncFast
+
+
+// hammingWindow
+// Generates a hamming window into the given array.
+// Matches applyHammingWindow applied to an array of ones.
+// @param window - the array to write the window to.
+// @param N - the length of the window.
+//
+// @return - 0 for success, else failure.
+inline int hammingWindow(double *window, uint32_t N)
+{
+    if (window == NULL || N == 0) { return -1; }
+    if (N == 1) { window[0] = 1.0; return 0; }
+
+    double theta = 2 * M_PI / (N - 1);
+    uint32_t half = (N + 1) / 2;
+
+    // the cos values are written straight into the window, then turned
+    // into the window values in place.
+    for (uint32_t base = 0; base < half; base += SINCOS_BLOCK_LEN) {
+        uint32_t len = (half - base < SINCOS_BLOCK_LEN) ? half - base : SINCOS_BLOCK_LEN;
+        double *w = window + base;
+        sinCosBlock(theta, base, len, NULL, w);
+        for (uint32_t j = 0; j < len; j++) { w[j] = 0.54 - (0.46 * w[j]); }
+    }
+
+    // the window is symmetric.
+    for (uint32_t n = half; n < N; n++) { window[n] = window[N - 1 - n]; }
+    return 0;
+} // end hammingWindow
+
+
+// kaiserWindow
+// Generates a kaiser window into the given array.
+// Matches applyKaiserWindow applied to an array of ones.
+// @param window - the array to write the window to.
+// @param N - the length of the window.
+// @param A - stopband attenuation required in dB
+// @param fast - only compute the window to about 2e-7.
+//
+// @return - 0 for success, else failure.
+inline int kaiserWindow(double *window, uint32_t N, double A, bool fast)
+{
+    if (window == NULL || N == 0) { return -1; }
+    if (N == 1) { window[0] = 1.0; return 0; }
+
+    double alpha = kaiserAlpha(A);
+    double M = (double)((int)(N / 2));
+    double denominator = fast ? besselFuncFast(alpha) : besselFunc(alpha);
+    // with an odd length the window is symmetric about M, so only taps
+    // 0 ... M are computed and the rest mirrored. An even length isn't
+    // symmetric about M, so all of it is computed.
+    uint32_t count = (N % 2 == 1) ? N / 2 + 1 : N;
+
+    if (fast && alpha <= 3.75) {
+        // every argument is in the polynomial part of besselFuncFast,
+        // which has no branches or exp, so it vectorizes.
+        for (uint32_t n = 0; n < count; n++) {
+            double x = alpha * sqrt(1.0 - ((n - M) * (n - M) / (M * M)));
+            double t = (x / 3.75) * (x / 3.75);
+            window[n] = (1.0 + t * (3.5156229 + t * (3.0899424 + t * (1.2067492 +
+                t * (0.2659732 + t * (0.0360768 + t * 0.0045813)))))) / denominator;
+        }
+        for (uint32_t n = count; n < N; n++) { window[n] = window[N - 1 - n]; }
+        return 0;
+    }
+
+    // the largest argument is alpha, so the number of series terms it
+    // needs is enough for every tap. The fast window stops the series at
+    // about the same accuracy as besselFuncFast.
+    double eps = fast ? 1e-7 : EPS;
+    int terms = 0;
+    double S = 1;
+    double D = 1;
+    while (D > (eps * S)) {
+        double t = alpha / (2 * ++terms);
+        D *= t * t;
+        S += D;
+    }
+    if (fast) { denominator = S; }
+
+    // the series is summed a term at a time across a chunk of taps,
+    // so every tap does the same work and the loops vectorize.
+    double x[WINDOW_CHUNK];
+    double d[WINDOW_CHUNK];
+    for (uint32_t base = 0; base < count; base += WINDOW_CHUNK) {
+        uint32_t len = (count - base < WINDOW_CHUNK) ? count - base : WINDOW_CHUNK;
+        double *w = window + base;
+        for (uint32_t j = 0; j < len; j++) {
+            double n = (double)(base + j);
+            double r = alpha * sqrt(1.0 - ((n - M) * (n - M) / (M * M)));
+            x[j] = (r / 2) * (r / 2);
+            d[j] = 1.0;
+            w[j] = 1.0;
+        }
+        for (int k = 1; k <= terms; k++) {
+            double scale = 1.0 / ((double)k * k);
+            for (uint32_t j = 0; j < len; j++) {
+                d[j] *= x[j] * scale;
+                w[j] += d[j];
+            }
+        }
+        for (uint32_t j = 0; j < len; j++) { w[j] /= denominator; }
+    }
+    for (uint32_t n = count; n < N; n++) { window[n] = window[N - 1 - n]; }
+    return 0;
+} // end kaiserWindow
+
+
+// generateWindow
+// Generates any of the window types into the given array.
+// @param window - the array to write the window to.
+// @param type - the type of window.
+// @param N - the length of the window.
+// @param A - stopband attenuation required in dB, for kaiser windows.
+//
+// @return - 0 for success, else failure.
+inline int generateWindow(double *window, WindowType type, uint32_t N, double A)
+{
+    if (window == NULL || N == 0) { return -1; }
+    switch (type) {
+    case WINDOW_RECTANGULAR:
+        for (uint32_t n = 0; n < N; n++) { window[n] = 1.0; }
+        return 0;
+    case WINDOW_HAMMING:
+        return hammingWindow(window, N);
+    case WINDOW_KAISER:
+        return kaiserWindow(window, N, A, false);
+    case WINDOW_KAISER_FAST:
+        return kaiserWindow(window, N, A, true);
+    }
+    return -1;
+} // end generateWindow
+
+
+// applyWindow
+// Multiplies the input by a window table in one pass.
+// @param input - the array to apply the window to.
+// @param window - the window table.
+// @param N - the length of the input and window.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int applyWindow(T *input, const double *window, uint32_t N)
+{
+    if (input == NULL || window == NULL) { return -1; }
+    for (uint32_t n = 0; n < N; n++) {
+        input[n] = (T)((double)input[n] * window[n]);
+    }
+    return 0;
+} // end applyWindow
+
+
+// getWindow
+// Returns the window table for the given parameters, generating it the
+// first time it is asked for. The table stays valid until clear is called.
+// @param type - the type of window.
+// @param N - the length of the window.
+// @param A - stopband attenuation required in dB, ignored for non kaiser windows.
+//
+// @return - the window table of length N, NULL if it can't be made.
+inline const double *WindowCache::getWindow(WindowType type, uint32_t N, double A)
+{
+    if (N == 0) { return NULL; }
+
+    Key key;
+    key.type = type;
+    key.N = N;
+    // A doesn't change the other windows, so don't store copies for it.
+    key.A = (type == WINDOW_KAISER || type == WINDOW_KAISER_FAST) ? A : 0.0;
+
+    std::map<Key, std::vector<double> >::iterator it = tables.find(key);
+    if (it != tables.end()) { return &it->second[0]; }
+
+    std::vector<double> table(N);
+    if (generateWindow(&table[0], type, N, key.A) != 0) { return NULL; }
+    std::vector<double> &stored = tables[key];
+    stored.swap(table);
+    return &stored[0];
+} // end getWindow
+
+
+// applyWindow
+// Applies a cached window to the input in one pass.
+// @param input - the array to apply the window to.
+// @param type - the type of window.
+// @param N - the length of the input.
+// @param A - stopband attenuation required in dB, for kaiser windows.
+//
+// @return - 0 for success, else failure.
+template <class T>
+int WindowCache::applyWindow(T *input, WindowType type, uint32_t N, double A)
+{
+    const double *window = getWindow(type, N, A);
+    if (window == NULL) { return -1; }
+    return ::applyWindow(input, window, N);
+} // end applyWindow
+
+
+#endif
@@ -0,0 +1,162 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// AdaptiveFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the adaptive filters. Checks the fused LMS kernel
+// against a plain LMS, and that every filter identifies an unknown system.
+
+#include <iostream>
+#include <AdaptiveFilter.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// convolve
+// d[n] = sum h[i] x[n - i], the unknown system.
+vector<double> convolve(const vector<double> &x, const vector<double> &h)
+{
+    vector<double> d(x.size(), 0.0);
+    for (size_t n = 0; n < x.size(); n++) {
+        for (size_t i = 0; i < h.size() && i <= n; i++) { d[n] += h[i] * x[n - i]; }
+    }
+    return d;
+}
+
+int main(int argc, char **argv)
+{
+    vector<double> x = makeNoise<double>(20000, 1);
+
+    ////////////////// Test 1 ///////////////////
+    // the fused kernel matches a plain two pass LMS and NLMS.
+    int lengths[] = {1, 7, 8, 33};
+    for (int l = 0; l < 4; l++) {
+        int L = lengths[l];
+        vector<double> h = makeNoise<double>(L, 99);
+        vector<double> d = convolve(x, h);
+        for (int norm = 0; norm < 2; norm++) {
+            LMSFilter<double> lms(L, norm ? 0.5 : 0.01, norm == 1);
+            vector<double> w(L, 0.0);
+            for (int n = 0; n < 3000; n++) {
+                double y = 0, energy = 0;
+                for (int i = 0; i < L && i <= n; i++) {
+                    y += w[i] * x[n - i];
+                    energy += x[n - i] * x[n - i];
+                }
+                double e = d[n] - y;
+                double g = norm ? 0.5 * e / (1e-6 + energy) : 0.01 * e;
+                for (int i = 0; i < L && i <= n; i++) { w[i] += g * x[n - i]; }
+
+                double err = lms.adapt(x[n], d[n]);
+                if (fabs(err - e) > 1e-9) {
+                    cout << "FAILED: test 1 error L = " << L << " n = " << n << endl;
+                    return -1;
+                }
+            }
+            const double *gains = lms.getGains();
+            for (int i = 0; i < L; i++) {
+                if (fabs(gains[i] - w[i]) > 1e-9) {
+                    cout << "FAILED: test 1 gains L = " << L << endl;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // LMS and NLMS identify an unknown system, and filter doesn't adapt.
+    vector<double> h = makeNoise<double>(64, 5);
+    for (size_t i = 0; i < h.size(); i++) { h[i] *= exp(-0.05 * i); }
+    vector<double> d = convolve(x, h);
+    LMSFilter<double> lms(64, 0.02);
+    NLMSFilter<double> nlms(64, 0.5);
+    lms.adaptBlock(&x[0], &d[0], NULL, x.size());
+    nlms.adaptBlock(&x[0], &d[0], NULL, x.size());
+    const double *lmsGains = lms.getGains();
+    const double *nlmsGains = nlms.getGains();
+    for (int i = 0; i < 64; i++) {
+        if (fabs(lmsGains[i] - h[i]) > 1e-3 || fabs(nlmsGains[i] - h[i]) > 1e-6) {
+            cout << "FAILED: test 2 identify tap " << i << endl;
+            return -1;
+        }
+    }
+    vector<double> before(lmsGains, lmsGains + 64);
+    for (int n = 0; n < 100; n++) { lms.filter(x[n]); }
+    lmsGains = lms.getGains();
+    for (int i = 0; i < 64; i++) {
+        if (lmsGains[i] != before[i]) {
+            cout << "FAILED: test 2 filter adapted" << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // float NLMS converges too.
+    NLMSFilter<float> nlmsF(64, 0.5f);
+    vector<float> err(x.size());
+    for (size_t n = 0; n < x.size(); n++) { err[n] = nlmsF.adapt((float)x[n], (float)d[n]); }
+    double lastPower = 0;
+    for (size_t n = x.size() - 1000; n < x.size(); n++) { lastPower += err[n] * err[n]; }
+    if (lastPower / 1000 > 1e-8) {
+        cout << "FAILED: test 3 float NLMS error power " << lastPower / 1000 << endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // the frequency domain filter identifies a long system with a little
+    // noise, and rejects blocks that aren't a multiple of the length.
+    int L = 512;
+    vector<double> longH = makeNoise<double>(L, 11);
+    for (int i = 0; i < L; i++) { longH[i] *= exp(-0.01 * i); }
+    vector<double> longX = makeNoise<double>(L * 200, 3);
+    vector<double> longD = convolve(longX, longH);
+    vector<double> noise = makeNoise<double>(longD.size(), 17);
+    for (size_t n = 0; n < longD.size(); n++) { longD[n] += 1e-4 * noise[n]; }
+
+    FDAFilter<double> fdaf(L, 0.5);
+    vector<double> fdafErr(longX.size());
+    if (fdaf.adaptBlock(&longX[0], &longD[0], NULL, &fdafErr[0], L + 1) == 0) {
+        cout << "FAILED: test 4 accepted partial block" << endl;
+        return -1;
+    }
+    if (fdaf.adaptBlock(&longX[0], &longD[0], NULL, &fdafErr[0], longX.size()) != 0) {
+        cout << "FAILED: test 4 adaptBlock" << endl;
+        return -1;
+    }
+    double startPower = 0, endPower = 0;
+    for (int n = 0; n < L; n++) {
+        startPower += longD[n] * longD[n];
+        endPower += fdafErr[longX.size() - L + n] * fdafErr[longX.size() - L + n];
+    }
+    vector<double> fdafGains(L);
+    fdaf.getGains(&fdafGains[0]);
+    double gainErr = 0;
+    for (int i = 0; i < L; i++) { gainErr = max(gainErr, fabs(fdafGains[i] - longH[i])); }
+    if (10.0 * log10(endPower / startPower) > -60.0 || gainErr > 1e-3) {
+        cout << "FAILED: test 4 FDAF " << 10.0 * log10(endPower / startPower)
+             << " dB, tap error " << gainErr << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
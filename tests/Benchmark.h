@@ -0,0 +1,217 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Benchmark.h
+// Written Ian Rankin - October 2026
+//
+// A small dependency free benchmark harness for the filter benchmarks.
+// Times a piece of work repeatedly until a minimum time has passed, and
+// collects the results, which can be printed as CSV or JSON so they can
+// be compared between releases.
+//
+// Cycle counts are read from the time stamp counter on x86, on other
+// machines they are reported as -1.
+
+#ifndef __BENCHMARK__
+#define __BENCHMARK__
+
+#include <FilterInstrumentation.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// A single benchmark measurement.
+struct BenchResult {
+    std::string filter;   // name of the filter / kernel.
+    std::string type;     // sample type.
+    uint32_t taps;        // number of taps (or size of the problem).
+    uint32_t block;       // block size, 1 for per sample calls.
+    double samplesPerSec;
+    double nsPerSample;
+    double cyclesPerTap;  // -1 if cycles aren't available.
+    double speedup;       // against a baseline result, 0 if there isn't one.
+};
+
+// Options shared by all of the benchmarks.
+struct BenchOptions {
+    double minSeconds;    // minimum time to run each measurement for.
+    bool json;            // print JSON instead of CSV.
+    bool quick;           // run a smaller sweep.
+    std::string only;     // only run filters with this in the name.
+
+    BenchOptions() : minSeconds(0.02), json(false), quick(false) {}
+
+    // parseArgs
+    // reads the options from the command line.
+    // --json, --quick, --min-time <ms>, --only <name>
+    //
+    // @return - 0 for success, else failure.
+    int parseArgs(int argc, char **argv)
+    {
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--json") == 0) { json = true; }
+            else if (strcmp(argv[i], "--csv") == 0) { json = false; }
+            else if (strcmp(argv[i], "--quick") == 0) { quick = true; }
+            else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+                minSeconds = atof(argv[++i]) / 1000.0;
+            } else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc) {
+                only = argv[++i];
+            } else {
+                fprintf(stderr, "usage: %s [--json|--csv] [--quick] "
+                        "[--min-time ms] [--only name]\n", argv[0]);
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    // enabled
+    // returns true if the benchmark with this name should be run.
+    bool enabled(const std::string &name) const
+    {
+        return only.empty() || name.find(only) != std::string::npos;
+    }
+};
+
+// Collects benchmark results, and prints them.
+class BenchReport {
+public:
+    BenchReport(const BenchOptions &opts) : options(opts) {}
+
+    // measure
+    // Runs work() repeatedly until the minimum time has passed, and records
+    // the average time per sample. work() must process samplesPerCall samples.
+    // @param filter - name of the filter.
+    // @param type - name of the sample type.
+    // @param taps - number of taps.
+    // @param block - the block size.
+    // @param samplesPerCall - the number of samples processed by each call to work.
+    // @param work - the function to time.
+    template <class Work>
+    void measure(const char *filter, const char *type, uint32_t taps,
+                uint32_t block, uint64_t samplesPerCall, Work work)
+    {
+        if (!options.enabled(filter)) { return; }
+
+        // warm up caches and branch predictors.
+        work();
+
+        uint64_t calls = 0;
+        uint64_t cycles = 0;
+        double seconds = 0;
+        uint64_t batch = 1;
+        while (seconds < options.minSeconds) {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            uint64_t c0 = readCycleCounter();
+            for (uint64_t i = 0; i < batch; i++) { work(); }
+            uint64_t c1 = readCycleCounter();
+            std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+            seconds += std::chrono::duration<double>(t1 - t0).count();
+            cycles += c1 - c0;
+            calls += batch;
+            batch *= 2;
+        }
+
+        BenchResult r;
+        r.filter = filter;
+        r.type = type;
+        r.taps = taps;
+        r.block = block;
+        double samples = (double)calls * (double)samplesPerCall;
+        r.samplesPerSec = samples / seconds;
+        r.nsPerSample = seconds * 1e9 / samples;
+        r.cyclesPerTap = DSP_LITE_HAS_CYCLE_COUNTER ? (double)cycles / (samples * (taps ? taps : 1)) : -1;
+        r.speedup = 0;
+        results.push_back(r);
+
+        // print progress, so long sweeps show something.
+        fprintf(stderr, "%s %s taps=%u block=%u: %.3f ns/sample\n",
+                filter, type, taps, block, r.nsPerSample);
+    }
+
+    // relativeTo
+    // sets the speedup of the last result, if it is of filter, against the
+    // latest result of baseline with the same type and taps.
+    // @param filter - the name of the filter just measured.
+    // @param baseline - the name of the filter to compare to.
+    void relativeTo(const char *filter, const char *baseline)
+    {
+        if (results.empty() || results.back().filter != filter) { return; }
+        BenchResult &last = results.back();
+        for (size_t i = results.size() - 1; i > 0; i--) {
+            const BenchResult &r = results[i - 1];
+            if (r.filter == baseline && r.type == last.type && r.taps == last.taps) {
+                last.speedup = r.nsPerSample / last.nsPerSample;
+                fprintf(stderr, "%s %s taps=%u block=%u: %.2fx speedup over %s\n", filter,
+                        last.type.c_str(), last.taps, last.block, last.speedup, baseline);
+                return;
+            }
+        }
+    }
+
+    // print
+    // prints all the results as CSV or JSON. The speedup is left empty
+    // (null in JSON) for results without a baseline.
+    // @param out - where to print the results.
+    void print(FILE *out) const
+    {
+        if (options.json) {
+            fprintf(out, "[\n");
+            for (size_t i = 0; i < results.size(); i++) {
+                const BenchResult &r = results[i];
+                fprintf(out, "  {\"filter\": \"%s\", \"type\": \"%s\", \"taps\": %u, "
+                        "\"block\": %u, \"samples_per_sec\": %.6g, \"ns_per_sample\": %.6g, "
+                        "\"cycles_per_tap\": %.6g, \"speedup\": %s}%s\n",
+                        r.filter.c_str(), r.type.c_str(), r.taps, r.block,
+                        r.samplesPerSec, r.nsPerSample, r.cyclesPerTap,
+                        speedupText(r, "null").c_str(), (i + 1 < results.size()) ? "," : "");
+            }
+            fprintf(out, "]\n");
+        } else {
+            fprintf(out, "filter,type,taps,block,samples_per_sec,ns_per_sample,cycles_per_tap,"
+                    "speedup\n");
+            for (size_t i = 0; i < results.size(); i++) {
+                const BenchResult &r = results[i];
+                fprintf(out, "%s,%s,%u,%u,%.6g,%.6g,%.6g,%s\n",
+                        r.filter.c_str(), r.type.c_str(), r.taps, r.block,
+                        r.samplesPerSec, r.nsPerSample, r.cyclesPerTap,
+                        speedupText(r, "").c_str());
+            }
+        }
+    }
+
+private:
+    static std::string speedupText(const BenchResult &r, const char *none)
+    {
+        if (r.speedup <= 0) { return none; }
+        char text[32];
+        snprintf(text, sizeof(text), "%.6g", r.speedup);
+        return text;
+    }
+
+    const BenchOptions &options;
+    std::vector<BenchResult> results;
+};
+
+#endif
@@ -0,0 +1,143 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// CoefficientBankSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the shared coefficient sets, and saving and mapping
+// coefficient banks.
+
+#include <iostream>
+#include <CoefficientBank.h>
+#include <FIRFilter.h>
+#include <FilterUtility.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+#define BANK_PATH "CoefficientBankSuite.coef"
+
+int main(int argc, char **argv)
+{
+    const uint16_t L = 63;
+    vector<float> lowpass(L), highpass(L), input(500);
+    idealFilterCoef(&lowpass[0], (float)(M_PI / 4.0), L);
+    idealFilterCoef(&highpass[0], (float)(M_PI / 2.0), L, true);
+    for (size_t i = 0; i < input.size(); i++) { input[i] = (float)sin(0.3 * i) + (i % 7) * 0.1f; }
+
+    ////////////////// Test 1 ///////////////////
+    // sets are shared, identical taps are stored once, and names are unique.
+    CoefficientBank<float> bank;
+    CoefficientBank<float>::SetPtr low = bank.add("lowpass", &lowpass[0], L);
+    CoefficientBank<float>::SetPtr high = bank.add("highpass", &highpass[0], L);
+    CoefficientBank<float>::SetPtr same = bank.add("lowpass_copy", &lowpass[0], L);
+    if (!low || !high || same != low || bank.getCount() != 3 || bank.getSetCount() != 2 ||
+            bank.add("lowpass", &highpass[0], L) ||
+            bank.add("a name that is far too long for the file", &lowpass[0], L) ||
+            bank.add("empty", &lowpass[0], 0) || bank.get("missing") ||
+            bank.get("highpass") != high || low->getData() == &lowpass[0]) {
+        cout << "FAILED: test 1 bank contents" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // filters using a shared set match filters using the raw taps, and keep
+    // the set alive after the bank is gone.
+    FIRFilter<float> raw(&lowpass[0], L);
+    FIRFilter<float> *sharedFilter;
+    {
+        CoefficientBank<float> scoped;
+        sharedFilter = new FIRFilter<float>(scoped.add("lowpass", &lowpass[0], L));
+        scoped.clear();
+    }
+    for (size_t i = 0; i < input.size(); i++) {
+        if (sharedFilter->filter(input[i]) != raw.filter(input[i])) {
+            cout << "FAILED: test 2 shared filter output i = " << i << endl;
+            return -1;
+        }
+    }
+    delete sharedFilter;
+    FIRFilter<float> invalid(&lowpass[0], L);
+    if (invalid.setGains(CoefficientBank<float>::SetPtr()) == 0 || invalid.getLength() != L) {
+        cout << "FAILED: test 2 NULL set" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // save and map a bank, the taps are the same and shared sets stay shared.
+    if (bank.save(BANK_PATH) != 0) {
+        cout << "FAILED: test 3 save" << endl;
+        return -1;
+    }
+    vector<FIRFilter<float> *> filters(1000);
+    {
+        CoefficientBank<float> loaded;
+        if (loaded.load(BANK_PATH, true) != 0 || loaded.getCount() != 3 ||
+                loaded.getSetCount() != 2 || loaded.get("lowpass") != loaded.get("lowpass_copy")) {
+            cout << "FAILED: test 3 load" << endl;
+            return -1;
+        }
+        CoefficientBank<float>::SetPtr mapped = loaded.get("highpass");
+        if (mapped->getLength() != L || ((uintptr_t)mapped->getData() % COEFFICIENT_ALIGN) != 0 ||
+                memcmp(mapped->getData(), &highpass[0], L * sizeof(float)) != 0) {
+            cout << "FAILED: test 3 mapped taps" << endl;
+            return -1;
+        }
+        for (size_t f = 0; f < filters.size(); f++) {
+            filters[f] = new FIRFilter<float>(loaded.get((f & 1) ? "highpass" : "lowpass"));
+        }
+    }
+    // the bank is gone, the mapping is kept by the filters.
+    FIRFilter<float> rawHigh(&highpass[0], L);
+    FIRFilter<float> rawLow(&lowpass[0], L);
+    for (size_t i = 0; i < input.size(); i++) {
+        float yl = rawLow.filter(input[i]), yh = rawHigh.filter(input[i]);
+        if (filters[0]->filter(input[i]) != yl || filters[999]->filter(input[i]) != yh) {
+            cout << "FAILED: test 3 mapped filter output i = " << i << endl;
+            return -1;
+        }
+    }
+    for (size_t f = 0; f < filters.size(); f++) { delete filters[f]; }
+
+    ////////////////// Test 4 ///////////////////
+    // the wrong type or a damaged file doesn't load, and leaves the bank alone.
+    CoefficientBank<double> wrongType;
+    if (wrongType.load(BANK_PATH) == 0 || bank.load("CoefficientBankSuite.missing") == 0 ||
+            bank.getCount() != 3) {
+        cout << "FAILED: test 4 wrong type" << endl;
+        return -1;
+    }
+    FILE *file = fopen(BANK_PATH, "r+b");
+    fseek(file, sizeof(CoefficientFileHeader) + sizeof(CoefficientEntry) +
+        COEFFICIENT_NAME_LENGTH, SEEK_SET);
+    uint64_t badOffset = 1u << 20;
+    fwrite(&badOffset, sizeof(badOffset), 1, file);
+    fclose(file);
+    if (bank.load(BANK_PATH) == 0 || bank.get("lowpass") != low) {
+        cout << "FAILED: test 4 damaged file" << endl;
+        return -1;
+    }
+
+    remove(BANK_PATH);
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,185 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ComplexFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the complex (I/Q) sample FIR and IIR filters.
+
+#include <iostream>
+#include <ComplexFilter.h>
+#include <FIRFilter.h>
+#include <IIRFilter.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace std;
+
+typedef complex<double> cd;
+
+// convolve
+// the direct convolution of complex taps with the whole input.
+vector<cd> convolve(const vector<cd> &h, const vector<cd> &x)
+{
+    vector<cd> y(x.size(), 0.0);
+    for (size_t n = 0; n < x.size(); n++) {
+        for (size_t i = 0; i < h.size() && i <= n; i++) { y[n] += h[i] * x[n - i]; }
+    }
+    return y;
+}
+
+// filterInBlocks
+// runs a filter over x in uneven interleaved and split blocks, in place.
+template <class F>
+vector<cd> filterInBlocks(F &filter, const vector<cd> &x)
+{
+    vector<cd> y = x;
+    vector<double> re(x.size()), im(x.size());
+    for (size_t i = 0; i < x.size(); i++) { re[i] = x[i].real(); im[i] = x[i].imag(); }
+    size_t sizes[] = {1, 17, 300, 5, 64};
+    size_t at = 0;
+    for (int k = 0; at < x.size(); k++) {
+        size_t n = min(sizes[k % 5], x.size() - at);
+        if (k % 2 == 0) {
+            filter.filterBlock(&y[at], &y[at], n);
+        } else {
+            filter.filterBlock(&re[at], &im[at], &re[at], &im[at], n);
+            for (size_t i = at; i < at + n; i++) { y[i] = cd(re[i], im[i]); }
+        }
+        at += n;
+    }
+    return y;
+}
+
+// close
+// true if every output is within tolerance of the expected output.
+bool close(const vector<cd> &y, const vector<cd> &expected, double tolerance)
+{
+    for (size_t i = 0; i < y.size(); i++) {
+        if (abs(y[i] - expected[i]) > tolerance) {
+            cout << "sample " << i << " = " << y[i] << " expected " << expected[i] << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    vector<cd> x = makeComplexNoise<double>(2000, 3);
+
+    ////////////////// Test 1 ///////////////////
+    // real taps are I and Q through two real FIR filters.
+    uint16_t lengths[] = {1, 3, 8, 63, 300};
+    for (int l = 0; l < 5; l++) {
+        vector<double> taps(lengths[l]);
+        for (size_t i = 0; i < taps.size(); i++) { taps[i] = cos(0.3 * i) / (i + 2.0); }
+        ComplexFIRFilter<double> fir(&taps[0], lengths[l]);
+        FIRFilter<double> firRe(&taps[0], lengths[l]);
+        FIRFilter<double> firIm(&taps[0], lengths[l]);
+        vector<cd> expected(x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            expected[i] = cd(firRe.filter(x[i].real()), firIm.filter(x[i].imag()));
+        }
+        if (!fir.hasRealTaps() || !close(filterInBlocks(fir, x), expected, 1e-12)) {
+            cout << "FAILED: test 1 real taps length = " << lengths[l] << endl;
+            return -1;
+        }
+        fir.reset();
+        for (size_t i = 0; i < x.size(); i++) {
+            complex<double> y = fir.filter(x[i]);
+            if (abs(y - expected[i]) > 1e-12 || fir.getOutput() != y) {
+                cout << "FAILED: test 1 filter length = " << lengths[l] << endl;
+                return -1;
+            }
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // complex taps match the direct convolution.
+    for (int l = 0; l < 5; l++) {
+        vector<cd> taps = makeComplexNoise<double>(lengths[l], 5 + l);
+        ComplexFIRFilter<double> fir(&taps[0], lengths[l]);
+        vector<cd> expected = convolve(taps, x);
+        if (fir.hasRealTaps() || !close(filterInBlocks(fir, x), expected, 1e-12)) {
+            cout << "FAILED: test 2 complex taps length = " << lengths[l] << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // real IIR coefficients are I and Q through two IIRFilters.
+    double b[] = {0.0675, 0.1349, 0.0675};
+    double a[] = {-1.1430, 0.4128};
+    ComplexIIRFilter<double> iir(b, a, 3, 2);
+    IIRFilter<double> iirRe(b, a, 3, 2);
+    IIRFilter<double> iirIm(b, a, 3, 2);
+    vector<cd> expected(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        expected[i] = cd(iirRe.filter(x[i].real()), iirIm.filter(x[i].imag()));
+    }
+    if (!iir.hasRealCoefficients() || !close(filterInBlocks(iir, x), expected, 1e-12)) {
+        cout << "FAILED: test 3 real coefficients" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // complex coefficients, a one pole resonator y = x + p y[n-1] followed
+    // by a complex zero, against the recursion written out.
+    cd p = polar(0.95, 0.7);
+    cd zero = polar(0.5, -1.2);
+    cd ff[] = {1.0, -zero};
+    cd fb[] = {-p};
+    ComplexIIRFilter<double> resonator(ff, fb, 2, 1);
+    cd last = 0.0, lastW = 0.0;
+    for (size_t i = 0; i < x.size(); i++) {
+        cd w = x[i] + p * lastW;
+        expected[i] = w - zero * lastW;
+        lastW = w;
+    }
+    if (resonator.hasRealCoefficients() || !close(filterInBlocks(resonator, x), expected, 1e-12)) {
+        cout << "FAILED: test 4 complex coefficients" << endl;
+        return -1;
+    }
+    resonator.reset();
+    for (size_t i = 0; i < x.size(); i++) {
+        last = resonator.filter(x[i]);
+        if (abs(last - expected[i]) > 1e-12 || resonator.getOutput() != last) {
+            cout << "FAILED: test 4 filter i = " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // float samples through the Filter interface.
+    float taps[] = {0.25f, 0.5f, 0.25f};
+    ComplexFIRFilter<float> fir(taps, 3);
+    Filter<complex<float> > *filter = &fir;
+    complex<float> y1 = filter->filter(complex<float>(4.0f, -8.0f));
+    complex<float> y2 = filter->filter(complex<float>(0.0f, 0.0f));
+    if (y1 != complex<float>(1.0f, -2.0f) || y2 != complex<float>(2.0f, -4.0f)) {
+        cout << "FAILED: test 5 Filter interface" << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+}
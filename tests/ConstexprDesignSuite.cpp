@@ -0,0 +1,174 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ConstexprDesignSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the compile time filter designs, checked against the
+// runtime designs.
+
+#include <iostream>
+#include <ConstexprDesign.h>
+#include <FIRFilter.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// the tables are built by the compiler, constexpr makes sure of that.
+constexpr std::array<double, 101> lowpass = constexprIdealFilterCoef<double, 101>(0.3);
+constexpr std::array<double, 1001> highpass =
+    constexprIdealFilterCoef<double, 1001>(2.9, true);
+constexpr std::array<double, 117> differentiator =
+    constexprIdealDifferentiatorCoef<double, 117>();
+constexpr std::array<double, 255> hamming = constexprHammingWindow<double, 255>();
+constexpr std::array<double, 255> kaiser60 = constexprKaiserWindow<double, 255>(60.0);
+constexpr std::array<double, 255> kaiser40 = constexprKaiserWindow<double, 255>(40.0);
+constexpr std::array<float, 129> kaiserLowpass =
+    constexprDesign<float, 129>(DESIGN_LOWPASS, 0.25, WINDOW_KAISER, 70.0);
+constexpr std::array<double, 63> hammingHighpass =
+    constexprDesign<double, 63>(DESIGN_HIGHPASS, 1.2, WINDOW_HAMMING);
+
+static_assert(constexprSin(0.0) == 0.0, "sin(0)");
+static_assert(constexprCos(0.0) == 1.0, "cos(0)");
+static_assert(constexprSqrt(4.0) == 2.0, "sqrt(4)");
+static_assert(constexprExp(0.0) == 1.0, "exp(0)");
+static_assert(constexprLog(1.0) == 0.0, "log(1)");
+
+// compare
+// checks a table against a runtime design.
+template <class T, size_t N>
+bool compare(const std::array<T, N> &table, const T *expected, double tolerance)
+{
+    for (size_t i = 0; i < N; i++) {
+        if (fabs((double)table[i] - (double)expected[i]) > tolerance) {
+            cout << "tap " << i << " = " << table[i] << " expected " << expected[i] << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // the constexpr maths functions match the standard library.
+    for (double x = -200.0; x < 200.0; x += 0.0137) {
+        if (fabs(constexprSin(x) - sin(x)) > 1e-14 || fabs(constexprCos(x) - cos(x)) > 1e-14) {
+            cout << "FAILED: test 1 sin/cos x = " << x << endl;
+            return -1;
+        }
+    }
+    for (double x = 1e-6; x < 1e4; x *= 1.37) {
+        if (fabs(constexprSqrt(x) - sqrt(x)) > 1e-15 * sqrt(x) ||
+            fabs(constexprLog(x) - log(x)) > 1e-14 * (1 + fabs(log(x)))) {
+            cout << "FAILED: test 1 sqrt/log x = " << x << endl;
+            return -1;
+        }
+    }
+    for (double x = -30.0; x < 30.0; x += 0.173) {
+        if (fabs(constexprExp(x) - exp(x)) > 1e-13 * exp(x)) {
+            cout << "FAILED: test 1 exp x = " << x << endl;
+            return -1;
+        }
+    }
+    for (double x = 0.0; x < 20.0; x += 0.21) {
+        if (fabs(constexprBesselFunc(x) - besselFunc(x)) > 1e-12 * besselFunc(x)) {
+            cout << "FAILED: test 1 bessel x = " << x << endl;
+            return -1;
+        }
+    }
+    for (double A = 10.0; A < 120.0; A += 1.5) {
+        if (fabs(constexprKaiserAlpha(A) - kaiserAlpha(A)) > 1e-13) {
+            cout << "FAILED: test 1 kaiserAlpha A = " << A << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // ideal filters and differentiators match the runtime designs.
+    vector<double> gains(1001);
+    idealFilterCoef(&gains[0], 0.3, 101);
+    if (!compare(lowpass, &gains[0], 1e-15)) {
+        cout << "FAILED: test 2 lowpass" << endl;
+        return -1;
+    }
+    idealFilterCoef(&gains[0], 2.9, 1001, true);
+    if (!compare(highpass, &gains[0], 1e-15)) {
+        cout << "FAILED: test 2 highpass" << endl;
+        return -1;
+    }
+    idealDifferentiatorCoef(&gains[0], 117);
+    if (!compare(differentiator, &gains[0], 0.0)) {
+        cout << "FAILED: test 2 differentiator" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // windows match applyHammingWindow and applyKaiserWindow.
+    vector<double> ones(255, 1.0);
+    applyHammingWindow(&ones[0], 255);
+    if (!compare(hamming, &ones[0], 1e-15)) {
+        cout << "FAILED: test 3 hamming" << endl;
+        return -1;
+    }
+    double attenuations[] = {60.0, 40.0};
+    const std::array<double, 255> *kaisers[] = {&kaiser60, &kaiser40};
+    for (int k = 0; k < 2; k++) {
+        ones.assign(255, 1.0);
+        applyKaiserWindow(&ones[0], 255, attenuations[k]);
+        if (!compare(*kaisers[k], &ones[0], 1e-13)) {
+            cout << "FAILED: test 3 kaiser A = " << attenuations[k] << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // windowed designs match the design cache.
+    DesignCache<float> floatCache(2, 255);
+    if (!compare(kaiserLowpass, floatCache.design(DESIGN_LOWPASS, 0.25, 129, WINDOW_KAISER, 70.0),
+                 1e-7)) {
+        cout << "FAILED: test 4 kaiser lowpass" << endl;
+        return -1;
+    }
+    DesignCache<double> doubleCache(2, 255);
+    if (!compare(hammingHighpass, doubleCache.design(DESIGN_HIGHPASS, 1.2, 63, WINDOW_HAMMING),
+                 1e-15)) {
+        cout << "FAILED: test 4 hamming highpass" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // a table drives an FIR filter directly, the same as the runtime design.
+    FIRFilter<float> fixed(const_cast<float *>(kaiserLowpass.data()), 129);
+    float *runtime = idealFilterCoef<float>(0.25, 129);
+    applyKaiserWindow(runtime, 129, 70.0);
+    FIRFilter<float> designed(runtime, 129);
+    for (int n = 0; n < 1000; n++) {
+        float x = (float)sin(0.05 * n) + (float)((n % 7) - 3) * 0.1f;
+        if (fabs(fixed.filter(x) - designed.filter(x)) > 1e-5) {
+            cout << "FAILED: test 5 n = " << n << endl;
+            return -1;
+        }
+    }
+    delete[] runtime;
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+}
@@ -0,0 +1,238 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FFTTestSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the FFT plans, checked against a direct DFT.
+
+#include <iostream>
+#include <FFT.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace std;
+
+// naiveDFT
+// the O(N^2) transform, computed in double.
+void naiveDFT(const complex<double> *x, complex<double> *X, int N, bool inverse)
+{
+    double sign = inverse ? 1.0 : -1.0;
+    for (int k = 0; k < N; k++) {
+        complex<double> sum(0, 0);
+        for (int n = 0; n < N; n++) {
+            double angle = sign * 2.0 * M_PI * (double)((long)k * n % N) / N;
+            sum += x[n] * complex<double>(cos(angle), sin(angle));
+        }
+        X[k] = sum;
+    }
+}
+
+// maxError
+// returns the largest error between a and b, relative to the largest of b.
+template <class T>
+double maxError(const complex<T> *a, const complex<double> *b, int N)
+{
+    double err = 0, scale = 1e-300;
+    for (int i = 0; i < N; i++) {
+        err = max(err, abs(complex<double>(a[i].real(), a[i].imag()) - b[i]));
+        scale = max(scale, abs(b[i]));
+    }
+    return err / scale;
+}
+
+// makeSignal
+// a deterministic pseudo random complex signal.
+vector<complex<double> > makeSignal(int N)
+{
+    vector<complex<double> > x(N);
+    uint32_t seed = 42;
+    for (int i = 0; i < N; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        double re = (double)(seed >> 8) / (1 << 24) - 0.5;
+        seed = seed * 1664525u + 1013904223u;
+        double im = (double)(seed >> 8) / (1 << 24) - 0.5;
+        x[i] = complex<double>(re, im);
+    }
+    return x;
+}
+
+int main(int argc, char **argv)
+{
+    // sizes with radix 4, 2, 3 and 5 stages, other primes up to 64, and
+    // larger primes that use Bluestein's algorithm.
+    int sizes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 15, 16, 25, 27, 30, 45, 49, 61, 64,
+                   67, 75, 97, 100, 125, 128, 134, 194, 243, 256, 257, 360, 1000,
+                   1009, 1024, 2048, 2310, 4096};
+    int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    for (int s = 0; s < numSizes; s++) {
+        int N = sizes[s];
+        vector<complex<double> > x = makeSignal(N);
+        vector<complex<double> > expected(N);
+        vector<complex<double> > output(N);
+
+        ////////////////// Test 1 ///////////////////
+        // forward and inverse match the DFT in double.
+        FFTPlan<double> plan(N);
+        if (plan.getSize() != (uint32_t)N) {
+            cout << "FAILED: test 1 plan size " << N << endl;
+            return -1;
+        }
+        naiveDFT(&x[0], &expected[0], N, false);
+        plan.forward(&x[0], &output[0]);
+        if (maxError(&output[0], &expected[0], N) > 1e-12) {
+            cout << "FAILED: test 1 forward N = " << N << endl;
+            return -1;
+        }
+        naiveDFT(&x[0], &expected[0], N, true);
+        plan.inverse(&x[0], &output[0]);
+        if (maxError(&output[0], &expected[0], N) > 1e-12) {
+            cout << "FAILED: test 1 inverse N = " << N << endl;
+            return -1;
+        }
+
+        ////////////////// Test 2 ///////////////////
+        // float transforms are close to the DFT.
+        FFTPlan<float> planF(N);
+        vector<complex<float> > xf(N), outputF(N);
+        for (int i = 0; i < N; i++) {
+            xf[i] = complex<float>((float)x[i].real(), (float)x[i].imag());
+        }
+        naiveDFT(&x[0], &expected[0], N, false);
+        planF.forward(&xf[0], &outputF[0]);
+        if (maxError(&outputF[0], &expected[0], N) > 1e-5) {
+            cout << "FAILED: test 2 float forward N = " << N << endl;
+            return -1;
+        }
+
+        ////////////////// Test 3 ///////////////////
+        // forward then inverse gives back N times the input.
+        vector<complex<double> > roundTrip(N);
+        plan.forward(&x[0], &output[0]);
+        plan.inverse(&output[0], &roundTrip[0]);
+        for (int i = 0; i < N; i++) { roundTrip[i] /= (double)N; }
+        if (maxError(&roundTrip[0], &x[0], N) > 1e-13) {
+            cout << "FAILED: test 3 round trip N = " << N << endl;
+            return -1;
+        }
+
+        ////////////////// Test 4 ///////////////////
+        // the real transform matches the complex transform of the real part,
+        // and its inverse gives back N times the input.
+        if (N % 2 == 0) {
+            vector<double> real(N), realOut(N);
+            vector<complex<double> > realAsComplex(N);
+            for (int i = 0; i < N; i++) {
+                real[i] = x[i].real();
+                realAsComplex[i] = complex<double>(real[i], 0);
+            }
+            naiveDFT(&realAsComplex[0], &expected[0], N, false);
+
+            RealFFTPlan<double> realPlan(N);
+            vector<complex<double> > bins(N / 2 + 1);
+            realPlan.forward(&real[0], &bins[0]);
+            if (maxError(&bins[0], &expected[0], N / 2 + 1) > 1e-12) {
+                cout << "FAILED: test 4 real forward N = " << N << endl;
+                return -1;
+            }
+            realPlan.inverse(&bins[0], &realOut[0]);
+            for (int i = 0; i < N; i++) {
+                if (fabs(realOut[i] / N - real[i]) > 1e-13) {
+                    cout << "FAILED: test 4 real inverse N = " << N << endl;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // welch of a sine puts its power in the right bin, and the bins sum to
+    // the mean square of the signal.
+    int N = 256;
+    int n = 8192;
+    vector<double> x(n);
+    for (int i = 0; i < n; i++) { x[i] = 2.0 * sin(2.0 * M_PI * 32.0 * i / N); }
+    vector<double> window(N);
+    for (int i = 0; i < N; i++) { window[i] = 0.5 - 0.5 * cos(2.0 * M_PI * i / N); }
+
+    RealFFTPlan<double> welchPlan(N);
+    vector<double> psd(N / 2 + 1);
+    size_t segments = welchPSD(welchPlan, &x[0], n, &window[0], N / 2, &psd[0]);
+    if (segments != (size_t)(n / (N / 2) - 1)) {
+        cout << "FAILED: test 5 segment count " << segments << endl;
+        return -1;
+    }
+    double total = 0;
+    int peak = 0;
+    for (int k = 0; k <= N / 2; k++) {
+        total += psd[k];
+        if (psd[k] > psd[peak]) { peak = k; }
+    }
+    if (peak != 32 || fabs(total - 2.0) > 1e-9) {
+        cout << "FAILED: test 5 welch peak " << peak << " total " << total << endl;
+        return -1;
+    }
+
+    ////////////////// Test 6 ///////////////////
+    // welch rejects bad arguments.
+    if (welchPSD(welchPlan, &x[0], N - 1, &window[0], 0, &psd[0]) != 0 ||
+        welchPSD(welchPlan, &x[0], n, &window[0], N, &psd[0]) != 0) {
+        cout << "FAILED: test 6 welch arguments" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 7 ///////////////////
+    // a large prime is fast, round trips, and matches a few direct bins.
+    int P = 65537;
+    vector<complex<double> > big = makeSignal(P);
+    vector<complex<double> > bigOut(P), bigBack(P);
+    FFTPlan<double> primePlan(P);
+    primePlan.forward(&big[0], &bigOut[0]);
+    primePlan.inverse(&bigOut[0], &bigBack[0]);
+    for (int i = 0; i < P; i++) { bigBack[i] /= (double)P; }
+    if (maxError(&bigBack[0], &big[0], P) > 1e-12) {
+        cout << "FAILED: test 7 prime round trip" << endl;
+        return -1;
+    }
+    int bins[] = {0, 1, 12345, P - 1};
+    for (int b = 0; b < 4; b++) {
+        complex<double> sum(0, 0);
+        for (int i = 0; i < P; i++) {
+            double angle = -2.0 * M_PI * (double)((long)bins[b] * i % P) / P;
+            sum += big[i] * complex<double>(cos(angle), sin(angle));
+        }
+        if (abs(sum - bigOut[bins[b]]) > 1e-9 * P) {
+            cout << "FAILED: test 7 prime bin " << bins[b] << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 8 ///////////////////
+    // an odd real size is rejected instead of rounded down.
+    RealFFTPlan<double> oddPlan(255);
+    if (oddPlan.getSize() != 0 || welchPSD(oddPlan, &x[0], n, NULL, 0, &psd[0]) != 0) {
+        cout << "FAILED: test 8 odd real size " << oddPlan.getSize() << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -26,11 +26,15 @@
 #include <iostream>
 #include <FIRFilter.h>
 #include <FilterUtility.h>
+#include <FrequencyResponse.h>
 #include <cmath>
 #include <iostream>
 
 using namespace std;
 
+// in FilterUtilityUnit.cpp.
+uint32_t otherUnitKaiser(double A, double deltaW, double *window);
+
 int main(int argc, char **argv)
 {
     float *lowPassGains = idealFilterCoef<float>(M_PI / 2.0, 15);
@@ -97,5 +101,26 @@ int main(int argc, char **argv)
         }
     }
 
+    ////////////////// Test the kaiser design meets the spec across the band.
+    // calcKaiserLen takes the transition width in cycles per sample.
+    FrequencyResponse freq(4096);
+    std::vector<double> mag(freq.getNumPoints());
+    freq.magnitudeBatch(gains, 1, length, &mag[0]);
+    double stopEdge = M_PI / 2.0 + M_PI * M_PI / 100.0;
+    for (uint32_t k = 0; k < freq.getNumPoints(); k++) {
+        if (freq.getFrequency(k) > stopEdge && 20.0 * log10(mag[k]) > -A + 1.0) {
+            cout << "FAILED: kaiser stopband " << 20.0 * log10(mag[k])
+                 << " dB at w = " << freq.getFrequency(k) << endl;
+            return -1;
+        }
+    }
+
+    // the same window from another translation unit.
+    std::vector<double> other(length);
+    if (otherUnitKaiser(A, M_PI / 100.0, &other[0]) != length) {
+        cout << "FAILED: kaiser window from another unit" << endl;
+        return -1;
+    }
+
     cout << "Passed" << std::endl;
 } // end main
@@ -87,6 +87,73 @@ int main(int argc, char **argv)
         return -1;
     }
 
+    ///////////////////// Test 4 /////////////////////////
+    // block filtering is bit-identical to filtering each sample.
+
+    float gains4[] = {0.3f, -0.7f, 1.1f, 0.25f, 0.05f, -0.4f, 0.9f};
+    FIRFilter<float> serial4(gains4, 7);
+    FIRFilter<float> block4(gains4, 7);
+    float x4[40];
+    float y4[40];
+    for (int i = 0; i < 40; i++) { x4[i] = (float)((i * 37) % 11) - 5.3f; }
+
+    // uneven block sizes, including ones shorter than the filter.
+    int blockSizes[] = {1, 3, 9, 2, 25};
+    int offset = 0;
+    for (int b = 0; b < 5; b++) {
+        block4.filterBlock(x4 + offset, y4 + offset, blockSizes[b]);
+        offset += blockSizes[b];
+    }
+    for (int i = 0; i < 40; i++) {
+        if (serial4.filter(x4[i]) != y4[i]) {
+            std::cerr << "FAILED: test 4 block filtering at i = " << i << std::endl;
+            return -1;
+        }
+    }
+    if (block4.getOutput() != serial4.getOutput() ||
+        block4.filter(1.5f) != serial4.filter(1.5f)) {
+        std::cerr << "FAILED: test 4 block filtering state." << std::endl;
+        return -1;
+    }
+
+    ///////////////////// Test 5 /////////////////////////
+    // block filtering in place gives the same outputs and state.
+
+    float gains5[] = {0.5f, 0.25f, 0.25f};
+    FIRFilter<float> serial5(gains5, 3);
+    FIRFilter<float> inPlace5(gains5, 3);
+    float x5[40];
+    for (int i = 0; i < 40; i++) { x5[i] = (float)((i * 37) % 11) - 5.3f; }
+    float y5[40];
+    for (int i = 0; i < 40; i++) { y5[i] = serial5.filter(x5[i]); }
+    offset = 0;
+    for (int b = 0; b < 5; b++) {
+        inPlace5.filterBlock(x5 + offset, x5 + offset, blockSizes[b]);
+        offset += blockSizes[b];
+    }
+    for (int i = 0; i < 40; i++) {
+        if (x5[i] != y5[i]) {
+            std::cerr << "FAILED: test 5 in place at i = " << i << std::endl;
+            return -1;
+        }
+    }
+    if (inPlace5.getOutput() != serial5.getOutput() ||
+        inPlace5.filter(1.5f) != serial5.filter(1.5f)) {
+        std::cerr << "FAILED: test 5 in place state." << std::endl;
+        return -1;
+    }
+
+    ///////////////////// Test 6 /////////////////////////
+    // a copy has its own delay line, and deleting through Filter frees it.
+
+    FIRFilter<float> copy6(serial5);
+    copy6.filter(100.0f);
+    if (copy6.getOutput() == serial5.getOutput() ||
+        copy6.getDelayLine() == serial5.getDelayLine()) {
+        std::cerr << "FAILED: test 6 copy shares the delay line." << std::endl;
+        return -1;
+    }
+    delete filter1;
 
     // test passed if reached here.
     std::cout << "PASSED all tests!" << std::endl;
@@ -0,0 +1,194 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FIRTunerSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the FIR kernels and the tuner that picks between them.
+
+#include <iostream>
+#include <FIRTuner.h>
+#include <FIRFilter.h>
+#include <FilterUtility.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+#define TABLE_PATH "FIRTunerSuite.txt"
+
+// checkKernel
+// runs a kernel and FIRFilter over the input in uneven blocks, and
+// compares them.
+// @return - 0 if they match to within the tolerance.
+template <class T>
+int checkKernel(Filter<T> *kernel, const T *taps, uint16_t length, const vector<T> &x,
+                double tolerance)
+{
+    if (kernel == NULL) { return -1; }
+    FIRFilter<T> reference(const_cast<T *>(taps), length);
+    vector<T> y(x.size());
+    size_t sizes[] = {1, 7, 64, 3, 300, 1};
+    size_t at = 0;
+    for (int b = 0; at < x.size(); b = (b + 1) % 6) {
+        size_t n = min(sizes[b], x.size() - at);
+        if (n == 1) { y[at] = kernel->filter(x[at]); }
+        else { kernel->filterBlock(&x[at], &y[at], n); }
+        at += n;
+    }
+    double scale = 0.0;
+    for (uint16_t i = 0; i < length; i++) { scale += fabs((double)taps[i]); }
+    for (size_t i = 0; i < x.size(); i++) {
+        if (fabs((double)y[i] - (double)reference.filter(x[i])) > tolerance * scale) {
+            cout << "mismatch at " << i << endl;
+            delete kernel;
+            return -1;
+        }
+    }
+    if (kernel->getOutput() != y.back()) {
+        delete kernel;
+        return -1;
+    }
+    delete kernel;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    vector<double> x = makeNoise<double>(2000, 1);
+    vector<float> xf(x.begin(), x.end());
+
+    ////////////////// Test 1 ///////////////////
+    // every kernel matches FIRFilter, for random and symmetric taps.
+    uint16_t lengths[] = {1, 2, 7, 8, 64, 301};
+    for (int l = 0; l < 6; l++) {
+        uint16_t L = lengths[l];
+        vector<double> taps = makeNoise<double>(L, 2 + L);
+        vector<double> sym(taps);
+        for (uint16_t i = 0; i < L / 2; i++) { sym[L - 1 - i] = sym[i]; }
+        size_t blocks[] = {1, 16, 200};
+        for (int b = 0; b < 3; b++) {
+            for (int k = 0; k < FIR_KERNEL_COUNT; k++) {
+                FIRKernel kernel = (FIRKernel)k;
+                if (kernel != FIR_KERNEL_SYMMETRIC &&
+                        checkKernel(FIRTuner<double>::make(kernel, &taps[0], L, blocks[b]),
+                                    &taps[0], L, x, 1e-12) != 0) {
+                    cout << "FAILED: test 1 " << firKernelName(kernel) << " L = " << L
+                        << " block = " << blocks[b] << endl;
+                    return -1;
+                }
+                if (checkKernel(FIRTuner<double>::make(kernel, &sym[0], L, blocks[b]),
+                                &sym[0], L, x, 1e-12) != 0) {
+                    cout << "FAILED: test 1 symmetric taps " << firKernelName(kernel)
+                        << " L = " << L << " block = " << blocks[b] << endl;
+                    return -1;
+                }
+            }
+        }
+        if (L > 2 && FIRTuner<double>::make(FIR_KERNEL_SYMMETRIC, &taps[0], L, 1) != NULL) {
+            cout << "FAILED: test 1 symmetric kernel for asymmetric taps" << endl;
+            return -1;
+        }
+    }
+
+    // every kernel can filter in place.
+    vector<double> taps = makeNoise<double>(64, 3);
+    for (uint16_t i = 0; i < 32; i++) { taps[63 - i] = taps[i]; }
+    for (int k = FIR_KERNEL_DIRECT; k < FIR_KERNEL_COUNT; k++) {
+        Filter<double> *a = FIRTuner<double>::make((FIRKernel)k, &taps[0], 64, 16);
+        Filter<double> *b = FIRTuner<double>::make((FIRKernel)k, &taps[0], 64, 16);
+        vector<double> y(x.size()), z(x);
+        a->filterBlock(&x[0], &y[0], x.size());
+        b->filterBlock(&z[0], &z[0], z.size());
+        delete a;
+        delete b;
+        if (y != z) {
+            cout << "FAILED: test 1 in place " << firKernelName((FIRKernel)k) << endl;
+            return -1;
+        }
+    }
+
+    // FFT sizes stop at FIR_FFT_MAX_SIZE instead of wrapping, and the FFT
+    // kernel isn't made past it.
+    if (firFFTSize(64, 16) != 128 || firFFTSize(1u << 30, 1u << 30) != FIR_FFT_MAX_SIZE ||
+            firFFTSize(1u << 30, (1u << 30) + 2) != 0 || firFFTSize(UINT32_MAX, 1) != 0 ||
+            FIRTuner<double>::make(FIR_KERNEL_FFT, &taps[0], 64, FIR_FFT_MAX_SIZE) != NULL) {
+        cout << "FAILED: test 1 FFT size limit" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // the tuner times each shape once, saves the table, and a new tuner
+    // reading the table doesn't time anything.
+    remove(TABLE_PATH);
+    const uint16_t L = 101;
+    vector<float> lowpass(L);
+    idealFilterCoef(&lowpass[0], (float)(M_PI / 4.0), L);
+    applyHammingWindow(&lowpass[0], L);
+    vector<float> random = makeNoise<float>(L, 5);
+    FIRKernel chosen[3];
+    {
+        FIRTuner<float> tuner(TABLE_PATH, 0.0005);
+        chosen[0] = tuner.choose(&lowpass[0], L, 1);
+        chosen[1] = tuner.choose(&lowpass[0], L, 256);
+        chosen[2] = tuner.choose(&random[0], L, 256);
+        Filter<float> *filter = tuner.create(&lowpass[0], L, 256);
+        if (tuner.getMeasurements() != 3 || chosen[2] == FIR_KERNEL_SYMMETRIC ||
+                checkKernel(filter, &lowpass[0], L, xf, 1e-5) != 0) {
+            cout << "FAILED: test 2 tuning" << endl;
+            return -1;
+        }
+    }
+    FIRTuner<float> loaded(TABLE_PATH);
+    Filter<float> *filter = loaded.create(&lowpass[0], L, 1);
+    if (loaded.choose(&lowpass[0], L, 256) != chosen[1] ||
+            loaded.choose(&random[0], L, 256) != chosen[2] ||
+            loaded.choose(&lowpass[0], L, 1) != chosen[0] || loaded.getMeasurements() != 0 ||
+            checkKernel(filter, &lowpass[0], L, xf, 1e-5) != 0) {
+        cout << "FAILED: test 2 loaded table" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // bad lines in the table are skipped, and other types are kept.
+    FILE *file = fopen(TABLE_PATH, "a");
+    fprintf(file, "garbage\n%u 101 7 0 symmetric 1.0\n%u 101 7 0 nonsense 1.0\n",
+            (unsigned)snapshotTypeCode<float>(), (unsigned)snapshotTypeCode<float>());
+    fclose(file);
+    FIRTuner<double> doubles(TABLE_PATH, 0.0005);
+    doubles.choose(&x[0], 9, 4);
+    FIRTuner<float> reread(TABLE_PATH, 0.0005);
+    if (reread.choose(&random[0], L, 7) == FIR_KERNEL_SYMMETRIC ||
+            reread.getMeasurements() != 1 || reread.choose(&lowpass[0], L, 256) != chosen[1]) {
+        cout << "FAILED: test 3 bad lines" << endl;
+        return -1;
+    }
+    FIRTuner<double> doublesAgain(TABLE_PATH);
+    doublesAgain.choose(&x[0], 9, 4);
+    if (doublesAgain.getMeasurements() != 0) {
+        cout << "FAILED: test 3 other types" << endl;
+        return -1;
+    }
+
+    remove(TABLE_PATH);
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,165 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FarrowFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the Farrow fractional delay filter and resampler.
+
+#include <iostream>
+#include <FarrowFilter.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// cubic
+// a test polynomial, which a 4 tap Lagrange interpolator reproduces exactly.
+double cubic(double t)
+{
+    return 0.5 + 0.25 * t - 0.01 * t * t + 0.0003 * t * t * t;
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // whole sample delays, and linear interpolation with 2 taps.
+    FarrowFilter<double> cubicDelay(4);
+    FarrowFilter<double> linear(2);
+    linear.setDelay(0.5);
+    for (int n = 0; n < 50; n++) {
+        double x = sin(0.1 * n);
+        double y = cubicDelay.filter(x);
+        double expected = (n >= 1) ? sin(0.1 * (n - 1)) : 0.0;
+        if (fabs(y - expected) > 1e-12 || fabs(cubicDelay.interpolate(1.0) -
+                ((n >= 2) ? sin(0.1 * (n - 2)) : 0.0)) > 1e-12) {
+            cout << "FAILED: test 1 whole delays n = " << n << endl;
+            return -1;
+        }
+        double average = (n >= 1) ? 0.5 * (x + sin(0.1 * (n - 1))) : 0.5 * x;
+        if (fabs(linear.filter(x) - average) > 1e-12) {
+            cout << "FAILED: test 1 linear n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // a cubic input is interpolated exactly at any delay.
+    double delays[] = {0.0, 0.1, 0.37, 0.5, 0.93};
+    for (int d = 0; d < 5; d++) {
+        FarrowFilter<double> filter(4);
+        filter.setDelay(delays[d]);
+        if (fabs(filter.getDelay() - (1.0 + delays[d])) > 1e-12) {
+            cout << "FAILED: test 2 getDelay" << endl;
+            return -1;
+        }
+        for (int n = 0; n < 40; n++) {
+            double y = filter.filter(cubic(n));
+            if (n >= 3 && fabs(y - cubic(n - 1.0 - delays[d])) > 1e-9) {
+                cout << "FAILED: test 2 mu = " << delays[d] << " n = " << n << endl;
+                return -1;
+            }
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // longer interpolators are more accurate on a sine, and a design given
+    // as coefficients matches the built in one.
+    double lastError = 1.0;
+    uint16_t tapCounts[] = {2, 4, 6, 8};
+    for (int t = 0; t < 4; t++) {
+        uint16_t taps = tapCounts[t];
+        vector<float> coefficients((size_t)taps * taps);
+        farrowLagrangeCoef(&coefficients[0], taps);
+        FarrowFilter<float> built(taps);
+        FarrowFilter<float> given(&coefficients[0], taps, taps - 1);
+        built.setDelay(0.3);
+        given.setDelay(0.3);
+        double error = 0.0;
+        for (int n = 0; n < 400; n++) {
+            float x = (float)sin(0.2 * n);
+            float y = built.filter(x);
+            if (y != given.filter(x)) {
+                cout << "FAILED: test 3 given coefficients taps = " << taps << endl;
+                return -1;
+            }
+            if (n >= taps) { error = fmax(error, fabs(y - sin(0.2 * (n - built.getDelay())))); }
+        }
+        if (!(error < lastError)) {
+            cout << "FAILED: test 3 accuracy taps = " << taps << " error = " << error << endl;
+            return -1;
+        }
+        lastError = error;
+    }
+    if (lastError > 1e-5) {
+        cout << "FAILED: test 3 8 tap accuracy " << lastError << endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // resampling a cubic by 2 gives the samples in between, and the output
+    // count follows the ratio.
+    FarrowResampler<double> doubler(2.0, 4);
+    vector<double> in(100), out(doubler.maxOutput(100));
+    for (size_t n = 0; n < in.size(); n++) { in[n] = cubic((double)n); }
+    size_t count = doubler.process(&in[0], in.size(), &out[0]);
+    if (count != 200 || doubler.getDelay() != 2.0) {
+        cout << "FAILED: test 4 count = " << count << endl;
+        return -1;
+    }
+    for (size_t j = 8; j < count; j++) {
+        if (fabs(out[j] - cubic(j * 0.5 - doubler.getDelay())) > 1e-9) {
+            cout << "FAILED: test 4 doubled j = " << j << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // blocks and a ratio changing each block, against one block at a time
+    // per sample.
+    FarrowResampler<float> blocks(0.9, 6);
+    FarrowResampler<float> single(0.9, 6);
+    vector<float> x(3000);
+    for (size_t n = 0; n < x.size(); n++) { x[n] = (float)sin(0.05 * n); }
+    vector<float> a, b;
+    double ratios[] = {0.9, 1.0001, 0.73, 1.6, 0.9999};
+    size_t at = 0;
+    for (int k = 0; k < 5; k++) {
+        blocks.setRatio(ratios[k]);
+        single.setRatio(ratios[k]);
+        vector<float> y(blocks.maxOutput(600));
+        size_t m = blocks.process(&x[at], 600, &y[0]);
+        a.insert(a.end(), y.begin(), y.begin() + m);
+        for (size_t n = 0; n < 600; n++) {
+            float z[4];
+            size_t c = single.process(&x[at + n], 1, z);
+            b.insert(b.end(), z, z + c);
+        }
+        at += 600;
+    }
+    double expected = 600 * (0.9 + 1.0001 + 0.73 + 1.6 + 0.9999);
+    if (a != b || fabs(a.size() - expected) > 2.0 || blocks.setRatio(0.0) == 0 ||
+            blocks.getRatio() != 0.9999) {
+        cout << "FAILED: test 5 blocks " << a.size() << " " << b.size() << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,150 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FiltFiltSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for zero-phase forward-backward filtering. The results are
+// checked against a direct implementation of the standard filtfilt method
+// using full extended copies of the signal.
+
+#include <iostream>
+#include <FIRFilter.h>
+#include <IIRFilter.h>
+#include <FilterUtility.h>
+#include <FiltFilt.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// lfilter
+// direct form difference equation, with the history before the start set
+// to the steady state for a constant input of x[0].
+// a starts at a1, the same as IIRFilter.
+vector<double> lfilter(const vector<double> &b, const vector<double> &a,
+                    const vector<double> &x)
+{
+    double sumB = 0, sumA = 1;
+    for (size_t i = 0; i < b.size(); i++) { sumB += b[i]; }
+    for (size_t i = 0; i < a.size(); i++) { sumA += a[i]; }
+    double y0 = x[0] * sumB / sumA;
+
+    vector<double> y(x.size());
+    for (size_t n = 0; n < x.size(); n++) {
+        double acc = 0;
+        for (size_t k = 0; k < b.size(); k++) { acc += b[k] * ((n >= k) ? x[n - k] : x[0]); }
+        for (size_t k = 0; k < a.size(); k++) { acc -= a[k] * ((n >= k + 1) ? y[n - k - 1] : y0); }
+        y[n] = acc;
+    }
+    return y;
+}
+
+// referenceFiltFilt
+// filtfilt with full extended copies of the signal.
+vector<double> referenceFiltFilt(const vector<double> &b, const vector<double> &a,
+                    const vector<double> &x, size_t padLen)
+{
+    size_t n = x.size();
+    vector<double> ext;
+    for (size_t k = padLen; k > 0; k--) { ext.push_back(2 * x[0] - x[k]); }
+    ext.insert(ext.end(), x.begin(), x.end());
+    for (size_t k = 1; k <= padLen; k++) { ext.push_back(2 * x[n - 1] - x[n - 1 - k]); }
+
+    vector<double> y = lfilter(b, a, ext);
+    vector<double> rev(y.rbegin(), y.rend());
+    y = lfilter(b, a, rev);
+    return vector<double>(y.rbegin() + padLen, y.rbegin() + padLen + n);
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = 3000;
+    vector<double> x(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = 1.0 + sin(0.02 * i) + 0.3 * sin(2.5 * i) + 0.001 * i;
+    }
+
+    ////////////////// Test 1 ///////////////////
+    // IIR filtfilt matches the reference.
+    double ffGains[] = {0.0675, 0.1349, 0.0675};
+    double fbGains[] = {-1.1430, 0.4128};
+    IIRFilter<double> iir(ffGains, fbGains, 3, 2);
+
+    vector<double> y(n);
+    if (filtfilt(iir, &x[0], &y[0], n) != 0) {
+        cout << "FAILED: test 1 IIR filtfilt returned error." << endl;
+        return -1;
+    }
+    vector<double> ref = referenceFiltFilt(vector<double>(ffGains, ffGains + 3),
+                            vector<double>(fbGains, fbGains + 2), x, 9);
+    for (size_t i = 0; i < n; i++) {
+        if (fabs(y[i] - ref[i]) > 1e-9) {
+            cout << "FAILED: test 1 IIR filtfilt y[" << i << "] = " << y[i]
+                 << " ref = " << ref[i] << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // FIR filtfilt matches the reference, in place.
+    double *gains = idealFilterCoef<double>(M_PI / 8.0, 31);
+    applyHammingWindow(gains, 31);
+    FIRFilter<double> fir(gains, 31);
+
+    vector<double> inPlace(x);
+    if (filtfilt(fir, &inPlace[0], &inPlace[0], n) != 0) {
+        cout << "FAILED: test 2 FIR filtfilt returned error." << endl;
+        return -1;
+    }
+    ref = referenceFiltFilt(vector<double>(gains, gains + 31), vector<double>(), x, 93);
+    for (size_t i = 0; i < n; i++) {
+        if (fabs(inPlace[i] - ref[i]) > 1e-9) {
+            cout << "FAILED: test 2 FIR filtfilt y[" << i << "] = " << inPlace[i]
+                 << " ref = " << ref[i] << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // zero phase: a slow sine comes out without delay, only scaled by
+    // the squared DC gain of the filter.
+    double dcGain = 0;
+    for (int i = 0; i < 31; i++) { dcGain += gains[i]; }
+    for (size_t i = 100; i < n - 100; i++) {
+        double expected = dcGain * dcGain * (1.0 + sin(0.02 * i) + 0.001 * i);
+        if (fabs(inPlace[i] - expected) > 0.01) {
+            cout << "FAILED: test 3 zero phase output = " << inPlace[i]
+                 << " expected = " << expected << " at i = " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // too short signals are rejected.
+    if (filtfilt(fir, &x[0], &y[0], 93) == 0) {
+        cout << "FAILED: test 4 short signal accepted." << endl;
+        return -1;
+    }
+
+    delete[] gains;
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,1425 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FilterBenchmark.cpp
+// Written Ian Rankin - October 2026
+//
+// Micro-benchmarks of the filters. Sweeps filter type, sample type,
+// number of taps and block size, and prints samples/sec, ns/sample and
+// cycles/tap as CSV (or JSON with --json).
+//
+// Run with: make bench
+
+#include <FIRFilter.h>
+#include <ParallelFIRFilter.h>
+#include <IIRFilter.h>
+#include <SampleConvert.h>
+#include <FilterUtility.h>
+#include <WindowCache.h>
+#include <DesignCache.h>
+#include <AdaptiveFilter.h>
+#include <FFT.h>
+#include <FrequencyResponse.h>
+#include <GoertzelBank.h>
+#include <HalfBandFilter.h>
+#include <MultichannelFilter.h>
+#include <FilterSnapshot.h>
+#include <CoefficientBank.h>
+#include <RankFilter.h>
+#include <FarrowFilter.h>
+#include <FIRTuner.h>
+#include <SparseFIRFilter.h>
+#include <PolyphaseChannelizer.h>
+#include <ComplexFilter.h>
+#include <SlidingDFT.h>
+#include <BFloat16.h>
+#include <Benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// keeps the compiler from throwing away the filter outputs.
+volatile double benchSink;
+
+// TypeName
+// the name printed for each sample type.
+template <class T> struct TypeName { static const char *get(); };
+template <> const char *TypeName<int16_t>::get() { return "int16"; }
+template <> const char *TypeName<float>::get() { return "float"; }
+template <> const char *TypeName<double>::get() { return "double"; }
+template <> const char *TypeName<BFloat16>::get() { return "bf16"; }
+
+// typeLabel
+// the type column for a filter with sample type T, coefficient type C and
+// accumulator type A. Just the sample type when all three are the same.
+template <class T, class C, class A>
+std::string typeLabel()
+{
+    if (std::is_same<T, C>::value && std::is_same<T, A>::value) {
+        return TypeName<T>::get();
+    }
+    return std::string(TypeName<T>::get()) + "/" + TypeName<C>::get() + "/" +
+            TypeName<A>::get();
+}
+
+// makeSignal
+// makes a test input, kept small enough that int16 won't overflow much.
+template <class T>
+std::vector<T> makeSignal(size_t n)
+{
+    std::vector<T> x(n);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        x[i] = (T)((int)(seed >> 24) - 128) / (T)16;
+    }
+    return x;
+}
+
+// Runs a filter over an input, either per sample or in blocks.
+template <class T, class F>
+struct FilterWork {
+    F *filter;
+    const T *input;
+    T *output;
+    size_t n;
+    uint32_t block;
+
+    void operator()()
+    {
+        if (block <= 1) {
+            T acc = 0;
+            for (size_t i = 0; i < n; i++) { acc += filter->filter(input[i]); }
+            benchSink = (double)acc;
+        } else {
+            for (size_t i = 0; i < n; i += block) {
+                size_t len = (n - i < block) ? n - i : block;
+                filter->filterBlock(input + i, output + i, len);
+            }
+            benchSink = (double)output[n - 1];
+        }
+    }
+};
+
+// benchFIR
+// sweeps the FIR filter over taps and block sizes for sample type T,
+// coefficient type C and accumulator type A.
+template <class T, class C = T, class A = T>
+void benchFIR(BenchReport &report, const std::vector<uint32_t> &taps,
+            const std::vector<uint32_t> &blocks)
+{
+    for (size_t t = 0; t < taps.size(); t++) {
+        std::vector<C> gains = makeSignal<C>(taps[t]);
+        // keep enough samples per call so short filters aren't all overhead.
+        size_t n = 4096;
+        std::vector<T> input = makeSignal<T>(n);
+        std::vector<T> output(n);
+
+        for (size_t b = 0; b < blocks.size(); b++) {
+            FIRFilter<T, C, A> filter(&gains[0], taps[t]);
+            FilterWork<T, FIRFilter<T, C, A> > work = {&filter, &input[0], &output[0],
+                                                        n, blocks[b]};
+            report.measure("fir", typeLabel<T, C, A>().c_str(), taps[t], blocks[b], n, work);
+        }
+    }
+}
+
+// benchIIR
+// sweeps the IIR filter over taps and block sizes for sample type T,
+// coefficient type C and accumulator type A.
+// The feedback gains are kept small so the filter is stable.
+template <class T, class C = T, class A = T>
+void benchIIR(BenchReport &report, const std::vector<uint32_t> &taps,
+            const std::vector<uint32_t> &blocks)
+{
+    for (size_t t = 0; t < taps.size(); t++) {
+        uint32_t len = taps[t];
+        std::vector<C> ffGains(len, (C)1);
+        std::vector<C> fbGains(len - 1, (C)0);
+        for (uint32_t i = 0; i < len - 1; i++) { fbGains[i] = (C)(0.5 / len); }
+        size_t n = 4096;
+        std::vector<T> input = makeSignal<T>(n);
+        std::vector<T> output(n);
+
+        for (size_t b = 0; b < blocks.size(); b++) {
+            IIRFilter<T, C, A> filter(&ffGains[0], &fbGains[0], len, len - 1);
+            FilterWork<T, IIRFilter<T, C, A> > work = {&filter, &input[0], &output[0],
+                                                        n, blocks[b]};
+            report.measure("iir", typeLabel<T, C, A>().c_str(), len, blocks[b], n, work);
+        }
+    }
+}
+
+// Times one way of windowing a set of coefficients.
+struct WindowWork {
+    int method;
+    uint16_t N;
+    double *gains;
+    WindowCache *cache;
+    double attenuation;
+
+    void operator()()
+    {
+        for (uint16_t i = 0; i < N; i++) { gains[i] = 1.0; }
+        switch (method) {
+        case 0: applyKaiserWindow(gains, N, attenuation); break;
+        case 1: kaiserWindow(gains, N, attenuation); break;
+        case 2: kaiserWindow(gains, N, attenuation, true); break;
+        case 3: cache->applyWindow(gains, WINDOW_KAISER, N, attenuation); break;
+        case 4: applyHammingWindow(gains, N); break;
+        case 5: hammingWindow(gains, N); break;
+        }
+        benchSink = gains[N / 2];
+    }
+};
+
+// benchWindows
+// compares the window functions, reported per tap of the window.
+void benchWindows(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *names[] = {"window_kaiser_apply", "window_kaiser_generate",
+        "window_kaiser_fast", "window_kaiser_cached", "window_hamming_apply",
+        "window_hamming_generate"};
+    WindowCache cache;
+    for (size_t t = 0; t < taps.size(); t++) {
+        std::vector<double> gains(taps[t]);
+        for (int m = 0; m < 6; m++) {
+            WindowWork work = {m, (uint16_t)taps[t], &gains[0], &cache, 60.0};
+            report.measure(names[m], "double", taps[t], taps[t], taps[t], work);
+        }
+    }
+}
+
+// Times one way of designing a kaiser windowed low pass filter.
+struct DesignWork {
+    int method;
+    uint16_t N;
+    float *gains;
+    double *window;
+    DesignCache<float> *cache;
+
+    void operator()()
+    {
+        switch (method) {
+        case 0: {
+            float *g = idealFilterCoef<float>(1.0, N);
+            applyKaiserWindow(g, N, 60.0);
+            benchSink = g[N / 2];
+            delete[] g;
+            return;
+        }
+        case 1:
+            idealFilterCoef(gains, 1.0, N);
+            kaiserWindow(window, N, 60.0);
+            applyWindow(gains, window, N);
+            break;
+        case 2:
+            cache->design(gains, DESIGN_LOWPASS, 1.0, N, WINDOW_KAISER, 60.0);
+            break;
+        }
+        benchSink = gains[N / 2];
+    }
+};
+
+// benchDesign
+// compares designing filters by allocation, into a buffer, and from the
+// design cache. Reported per tap of the filter.
+void benchDesign(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *names[] = {"design_alloc", "design_buffer", "design_cached"};
+    for (size_t t = 0; t < taps.size(); t++) {
+        uint16_t N = (uint16_t)(taps[t] | 1);
+        std::vector<float> gains(N);
+        std::vector<double> window(N);
+        DesignCache<float> cache(4, N);
+        for (int m = 0; m < 3; m++) {
+            DesignWork work = {m, N, &gains[0], &window[0], &cache};
+            report.measure(names[m], "float", N, N, N, work);
+        }
+    }
+}
+
+// Times one transform of a spectrum method.
+struct FFTWork {
+    int method;
+    uint32_t N;
+    const std::complex<double> *input;
+    const double *realInput;
+    std::complex<double> *output;
+    const std::complex<double> *roots; // e^(-2 pi i k / N) for the direct DFT.
+    FFTPlan<double> *plan;
+    RealFFTPlan<double> *realPlan;
+
+    void operator()()
+    {
+        switch (method) {
+        case 0:
+            // direct DFT, with the trig precomputed to be fair.
+            for (uint32_t k = 0; k < N; k++) {
+                std::complex<double> sum(0, 0);
+                for (uint32_t n = 0, idx = 0; n < N; n++, idx = (idx + k) % N) {
+                    sum += input[n] * roots[idx];
+                }
+                output[k] = sum;
+            }
+            break;
+        case 1: plan->forward(input, output); break;
+        case 2: realPlan->forward(realInput, output); break;
+        }
+        benchSink = output[N / 4].real();
+    }
+};
+
+// benchFFT
+// compares the FFT plans with a direct DFT, reported per point of the
+// transform. The DFT is only timed for the smaller sizes.
+void benchFFT(BenchReport &report, const std::vector<uint32_t> &sizes)
+{
+    const char *names[] = {"dft_direct", "fft_complex", "fft_real"};
+    for (size_t s = 0; s < sizes.size(); s++) {
+        uint32_t N = sizes[s];
+        std::vector<double> real = makeSignal<double>(N);
+        std::vector<std::complex<double> > input(N), output(N), roots(N);
+        for (uint32_t i = 0; i < N; i++) {
+            input[i] = std::complex<double>(real[i], real[(i + 1) % N]);
+            roots[i] = std::polar(1.0, -2.0 * M_PI * i / N);
+        }
+        FFTPlan<double> plan(N);
+        RealFFTPlan<double> realPlan(N);
+        for (int m = (N <= 1024) ? 0 : 1; m < 3; m++) {
+            FFTWork work = {m, N, &input[0], &real[0], &output[0], &roots[0],
+                            &plan, &realPlan};
+            report.measure(names[m], "double", N, N, N, work);
+        }
+    }
+}
+
+// Times evaluating the magnitude response of a bank of filters.
+struct ResponseWork {
+    int method;
+    uint32_t taps;
+    uint32_t numFilters;
+    const double *bank;
+    double *magnitude;
+    FrequencyResponse *freq;
+
+    void operator()()
+    {
+        uint32_t M = freq->getNumPoints();
+        if (method == 0) {
+            // direct sum of the DTFT at each grid point.
+            for (uint32_t f = 0; f < numFilters; f++) {
+                const double *b = bank + (size_t)f * taps;
+                for (uint32_t k = 0; k < M; k++) {
+                    double w = freq->getFrequency(k);
+                    double re = 0, im = 0;
+                    for (uint32_t n = 0; n < taps; n++) {
+                        re += b[n] * cos(w * n);
+                        im -= b[n] * sin(w * n);
+                    }
+                    magnitude[(size_t)f * M + k] = sqrt(re * re + im * im);
+                }
+            }
+        } else {
+            freq->magnitudeBatch(bank, numFilters, taps, magnitude);
+        }
+        benchSink = magnitude[M / 2];
+    }
+};
+
+// benchResponse
+// compares the FFT frequency response with the direct sum, for a bank of
+// 16 filters on a 1025 point grid, reported per filter.
+void benchResponse(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *names[] = {"response_direct", "response_fft"};
+    uint32_t numFilters = 16;
+    FrequencyResponse freq(2048);
+    std::vector<double> magnitude((size_t)numFilters * freq.getNumPoints());
+    for (size_t t = 0; t < taps.size(); t++) {
+        std::vector<double> bank = makeSignal<double>((size_t)numFilters * taps[t]);
+        for (int m = (taps[t] <= 512) ? 0 : 1; m < 2; m++) {
+            ResponseWork work = {m, taps[t], numFilters, &bank[0], &magnitude[0], &freq};
+            report.measure(names[m], "double", taps[t], numFilters, numFilters, work);
+        }
+    }
+}
+
+// Runs a band pass FIR filter per tone, the approach the tone detectors
+// replace.
+struct ToneFIRWork {
+    std::vector<FIRFilter<float> *> *filters;
+    const float *input;
+    float *output;
+    size_t n;
+
+    void operator()()
+    {
+        for (size_t f = 0; f < filters->size(); f++) {
+            (*filters)[f]->filterBlock(input, output, n);
+        }
+        benchSink = output[n - 1];
+    }
+};
+
+// benchTones
+// compares a Goertzel bank and sliding DFT against a 128 tap band pass
+// FIR filter per tone, with the number of tones in the taps column.
+void benchTones(BenchReport &report, const std::vector<uint32_t> &tones)
+{
+    size_t n = 4096;
+    std::vector<float> input = makeSignal<float>(n);
+    std::vector<float> output(n);
+    std::vector<float> gains = makeSignal<float>(128);
+    for (size_t t = 0; t < tones.size(); t++) {
+        uint16_t K = (uint16_t)tones[t];
+        std::vector<double> freqs(K);
+        std::vector<uint32_t> bins(K);
+        for (uint16_t k = 0; k < K; k++) {
+            bins[k] = 1 + k * 3;
+            freqs[k] = 2.0 * M_PI * bins[k] / 512.0;
+        }
+
+        GoertzelBank<float, float> bank(&freqs[0], K, 205);
+        FilterWork<float, GoertzelBank<float, float> > goertzel =
+            {&bank, &input[0], &output[0], n, (uint32_t)n};
+        report.measure("tone_goertzel", "float", K, 205, n, goertzel);
+
+        SlidingDFT<float, float> sdft(&bins[0], K, 512, 128);
+        FilterWork<float, SlidingDFT<float, float> > sliding =
+            {&sdft, &input[0], &output[0], n, (uint32_t)n};
+        report.measure("tone_sliding_dft", "float", K, 128, n, sliding);
+
+        // FIRFilter copies share a buffer, so each is made separately.
+        std::vector<FIRFilter<float> *> filters(K);
+        for (uint16_t k = 0; k < K; k++) { filters[k] = new FIRFilter<float>(&gains[0], 128); }
+        ToneFIRWork fir = {&filters, &input[0], &output[0], n};
+        report.measure("tone_fir_bank", "float", K, (uint32_t)n, n, fir);
+        for (uint16_t k = 0; k < K; k++) { delete filters[k]; }
+    }
+}
+
+// Times the adaptive filters. Method 0 is an FIRFilter with the taps
+// updated through getGains, the way it was done before LMSFilter.
+struct AdaptiveWork {
+    int method;
+    uint32_t taps;
+    const float *x;
+    const float *d;
+    float *e;
+    size_t n;
+    FIRFilter<float> *fir;
+    float *history;
+    LMSFilter<float> *lms;
+    FDAFilter<float> *fdaf;
+
+    void operator()()
+    {
+        switch (method) {
+        case 0: {
+            float *w = fir->getGains();
+            uint32_t pos = 0;
+            for (size_t i = 0; i < n; i++) {
+                float err = d[i] - fir->filter(x[i]);
+                pos = (pos == 0) ? taps - 1 : pos - 1;
+                history[pos] = x[i];
+                float g = 0.001f * err;
+                for (uint32_t j = 0; j < taps; j++) { w[j] += g * history[(pos + j) % taps]; }
+                e[i] = err;
+            }
+            break;
+        }
+        case 1: lms->adaptBlock(x, d, e, n); break;
+        case 2: fdaf->adaptBlock(x, d, NULL, e, n); break;
+        }
+        benchSink = e[n - 1];
+    }
+};
+
+// benchAdaptive
+// compares LMS on FIRFilter, the fused NLMS kernel, and the frequency
+// domain adaptive filter.
+void benchAdaptive(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *names[] = {"adaptive_fir_lms", "adaptive_nlms", "adaptive_fdaf"};
+    for (size_t t = 0; t < taps.size(); t++) {
+        uint32_t L = taps[t];
+        size_t n = (L > 4096) ? L : 4096;
+        std::vector<float> x = makeSignal<float>(n);
+        std::vector<float> d = makeSignal<float>(n + 1);
+        std::vector<float> e(n);
+        std::vector<float> gains(L, 0.0f);
+        std::vector<float> history(L, 0.0f);
+        FIRFilter<float> fir(&gains[0], L);
+        NLMSFilter<float> lms(L, 0.1f);
+        FDAFilter<float> fdaf(L, 0.1f);
+        for (int m = 0; m < 3; m++) {
+            AdaptiveWork work = {m, L, &x[0], &d[1], &e[0], n, &fir, &history[0],
+                                &lms, &fdaf};
+            report.measure(names[m], "float", L, (m == 2) ? L : 1, n, work);
+        }
+    }
+}
+
+// Times 2x decimation, with FIRFilter computing every output, and with
+// the half band filter.
+struct DecimateWork {
+    int method;
+    const float *input;
+    float *output;
+    size_t n;
+    FIRFilter<float> *fir;
+    HalfBandFilter<float> *halfBand;
+    HalfBandCascade<float> *cascade;
+
+    void operator()()
+    {
+        switch (method) {
+        case 0:
+            fir->filterBlock(input, output, n);
+            for (size_t i = 0; i < n / 2; i++) { output[i] = output[2 * i]; }
+            break;
+        case 1: halfBand->filterBlock(input, output, n); break;
+        case 2: halfBand->decimate(input, output, n); break;
+        case 3: cascade->decimate(input, output, n); break;
+        }
+        benchSink = output[0];
+    }
+};
+
+// benchHalfBand
+// compares half band filtering and decimation with FIRFilter, reported per
+// input sample, for half band designs of about each number of taps.
+void benchHalfBand(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *names[] = {"decimate2_fir", "halfband_full", "halfband_decimate2",
+                           "halfband_decimate8"};
+    size_t n = 4096;
+    std::vector<float> input = makeSignal<float>(n);
+    std::vector<float> output(n);
+    for (size_t t = 0; t < taps.size(); t++) {
+        // half band lengths are 4K - 1.
+        uint16_t N = (uint16_t)((taps[t] < 8) ? 7 : (taps[t] / 4) * 4 - 1);
+        std::vector<float> gains(N);
+        idealFilterCoef(&gains[0], M_PI / 2.0, N);
+        FIRFilter<float> fir(&gains[0], N);
+        HalfBandFilter<float> halfBand(&gains[0], N);
+        HalfBandCascade<float> cascade(&gains[0], N, 3);
+        for (int m = 0; m < 4; m++) {
+            DecimateWork work = {m, &input[0], &output[0], n, &fir, &halfBand, &cascade};
+            report.measure(names[m], "float", N, (uint32_t)n, n, work);
+        }
+    }
+}
+
+// Times int16 conversion and filtering. Method 0 converts each sample and
+// calls filter, the way it was done before filterConvert.
+struct ConvertWork {
+    int method;
+    const int16_t *pcm;
+    int16_t *out;
+    float *scratch;
+    size_t n;
+    FIRFilter<float> *filter;
+    TPDFDither *dither;
+
+    void operator()()
+    {
+        switch (method) {
+        case 0:
+            for (size_t i = 0; i < n; i++) {
+                float y = filter->filter(pcm[i] / 32768.0f) * 32768.0f;
+                y = (y > 32767.0f) ? 32767.0f : ((y < -32768.0f) ? -32768.0f : y);
+                out[i] = (int16_t)lrintf(y);
+            }
+            break;
+        case 1: filterConvert(*filter, pcm, 1, out, 1, n); break;
+        case 2: filterConvert(*filter, pcm, 1, out, 1, n, 1.0f, 1.0f, dither); break;
+        case 3:
+            convertToFloat(pcm, 1, scratch, n);
+            convertFromFloat(scratch, out, 1, n);
+            break;
+        case 4:
+            convertToFloat(pcm, 1, scratch, n);
+            convertFromFloat(scratch, out, 1, n, 1.0f, dither);
+            break;
+        }
+        benchSink = out[n - 1];
+    }
+};
+
+// benchConvert
+// compares filtering int16 with per sample conversion against
+// filterConvert, and times the conversion kernels alone (taps = 0).
+void benchConvert(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *names[] = {"convert_fir_scalar", "convert_fir_fused",
+                           "convert_fir_fused_dither", "convert_round_trip",
+                           "convert_round_trip_dither"};
+    size_t n = 4096;
+    std::vector<int16_t> pcm(n), out(n);
+    std::vector<float> scratch(n);
+    for (size_t i = 0; i < n; i++) { pcm[i] = (int16_t)(i * 7919); }
+    TPDFDither dither;
+    for (size_t t = 0; t < taps.size() && taps[t] <= 128; t++) {
+        std::vector<float> gains = makeSignal<float>(taps[t]);
+        FIRFilter<float> filter(&gains[0], taps[t]);
+        for (int m = 0; m < 3; m++) {
+            ConvertWork work = {m, &pcm[0], &out[0], &scratch[0], n, &filter, &dither};
+            report.measure(names[m], "int16", taps[t], (uint32_t)n, n, work);
+        }
+    }
+    for (int m = 3; m < 5; m++) {
+        ConvertWork work = {m, &pcm[0], &out[0], &scratch[0], n, NULL, &dither};
+        report.measure(names[m], "int16", 0, (uint32_t)n, n, work);
+    }
+}
+
+// Times interleaved filtering. Methods 0 and 2 deinterleave, run an
+// FIRFilter / IIRFilter per channel and interleave again, the way it was
+// done before the multichannel filters, 1 and 3 run them on the frames.
+struct MultichannelWork {
+    int method;
+    const float *input;
+    float *output;
+    float *planar;
+    size_t frames;
+    uint16_t channels;
+    std::vector<FIRFilter<float>*> *firs;
+    std::vector<IIRFilter<float>*> *iirs;
+    MultichannelFIRFilter<float> *fir;
+    MultichannelIIRFilter<float> *iir;
+
+    void operator()()
+    {
+        if (method == 1) {
+            fir->filterBlock(input, output, frames);
+        } else if (method == 3) {
+            iir->filterBlock(input, output, frames);
+        } else {
+            for (uint16_t c = 0; c < channels; c++) {
+                float *x = planar + c * frames;
+                for (size_t n = 0; n < frames; n++) { x[n] = input[n * channels + c]; }
+                float *y = planar + (channels + c) * frames;
+                if (method == 0) { (*firs)[c]->filterBlock(x, y, frames); }
+                else { (*iirs)[c]->filterBlock(x, y, frames); }
+                for (size_t n = 0; n < frames; n++) { output[n * channels + c] = y[n]; }
+            }
+        }
+        benchSink = output[frames * channels - 1];
+    }
+};
+
+// benchMultichannel
+// compares the interleaved FIR and IIR against a filter per channel, for
+// stereo and 8 channels. The block column is the number of channels.
+void benchMultichannel(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *names[] = {"multichannel_fir_split", "multichannel_fir",
+                           "multichannel_iir_split", "multichannel_iir"};
+    uint16_t channelCounts[] = {2, 8};
+    size_t frames = 1024;
+    for (int k = 0; k < 2; k++) {
+        uint16_t C = channelCounts[k];
+        std::vector<float> input = makeSignal<float>(frames * C);
+        std::vector<float> output(frames * C), planar(2 * frames * C);
+        for (size_t t = 0; t < taps.size() && taps[t] <= 128; t++) {
+            uint16_t len = (uint16_t)taps[t];
+            std::vector<float> gains = makeSignal<float>(len);
+            // a second order section, and the same filter for every channel.
+            float b[] = {0.2f, 0.4f, 0.2f};
+            float a[] = {-0.5f, 0.25f};
+            std::vector<FIRFilter<float>*> firs(C);
+            std::vector<IIRFilter<float>*> iirs(C);
+            for (uint16_t c = 0; c < C; c++) {
+                firs[c] = new FIRFilter<float>(&gains[0], len);
+                iirs[c] = new IIRFilter<float>(b, a, 3, 2);
+            }
+            MultichannelFIRFilter<float> fir(&gains[0], len, C);
+            MultichannelIIRFilter<float> iir(b, a, 3, 2, C);
+            for (int m = 0; m < 4; m++) {
+                // the IIR doesn't depend on taps, so only time it once.
+                if (m >= 2 && t > 0) { break; }
+                MultichannelWork work = {m, &input[0], &output[0], &planar[0], frames, C,
+                                         &firs, &iirs, &fir, &iir};
+                report.measure(names[m], "float", (m >= 2) ? 3 : len, C, frames * C, work);
+            }
+            for (uint16_t c = 0; c < C; c++) {
+                delete firs[c];
+                delete iirs[c];
+            }
+        }
+    }
+}
+
+// Times saving every filter to one snapshot file (method 0), and restoring
+// every filter from the open snapshot (method 1).
+struct SnapshotWork {
+    int method;
+    const char *path;
+    std::vector<FIRFilter<float>*> *firs;
+    SnapshotReader *reader;
+
+    void operator()()
+    {
+        size_t n = firs->size();
+        if (method == 0) {
+            SnapshotWriter writer;
+            writer.open(path);
+            for (size_t f = 0; f < n; f++) { writer.add(*(*firs)[f], f); }
+            writer.close();
+        } else {
+            for (size_t f = 0; f < n; f++) { reader->restore((uint32_t)f, *(*firs)[f]); }
+        }
+        benchSink = (*firs)[n - 1]->getOutput();
+    }
+};
+
+// benchSnapshot
+// saving and restoring the state of 1000 FIR filters, the numbers are per
+// filter.
+void benchSnapshot(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *path = "FilterBenchmark.snap";
+    const size_t numFilters = 1000;
+    for (size_t t = 0; t < taps.size() && taps[t] <= 512; t++) {
+        uint16_t len = (uint16_t)taps[t];
+        std::vector<float> gains = makeSignal<float>(len);
+        std::vector<float> input = makeSignal<float>(len);
+        std::vector<FIRFilter<float>*> firs(numFilters);
+        for (size_t f = 0; f < numFilters; f++) {
+            firs[f] = new FIRFilter<float>(&gains[0], len);
+            for (uint16_t i = 0; i <= f % len; i++) { firs[f]->filter(input[i]); }
+        }
+        SnapshotReader reader;
+        SnapshotWork save = {0, path, &firs, &reader};
+        report.measure("snapshot_save", "float", len, 1, numFilters, save);
+        save();
+        if (reader.open(path) == 0) {
+            SnapshotWork restore = {1, path, &firs, &reader};
+            report.measure("snapshot_restore", "float", len, 1, numFilters, restore);
+        }
+        reader.close();
+        for (size_t f = 0; f < numFilters; f++) { delete firs[f]; }
+    }
+    remove(path);
+}
+
+// Times starting up 1000 filters from a file of 40 tap sets. Method 0
+// reads the taps and gives each filter its own copy, method 1 maps a
+// coefficient bank and shares the sets.
+struct CoefficientLoadWork {
+    int method;
+    const char *path;
+    size_t numFilters;
+    std::vector<FIRFilter<float>*> *firs;
+
+    void operator()()
+    {
+        if (method == 0) {
+            std::vector<float*> owned;
+            FILE *file = fopen(path, "rb");
+            fseek(file, 0, SEEK_END);
+            std::vector<uint8_t> bytes((size_t)ftell(file));
+            fseek(file, 0, SEEK_SET);
+            size_t got = fread(&bytes[0], 1, bytes.size(), file);
+            fclose(file);
+            const CoefficientFileHeader *header = (const CoefficientFileHeader *)&bytes[0];
+            const CoefficientEntry *entries = (const CoefficientEntry *)(header + 1);
+            for (size_t f = 0; f < numFilters && got == bytes.size(); f++) {
+                const CoefficientEntry &entry = entries[f % header->count];
+                float *gains = new float[entry.length];
+                memcpy(gains, &bytes[entry.offset], entry.length * sizeof(float));
+                owned.push_back(gains);
+                firs->push_back(new FIRFilter<float>(gains, (uint16_t)entry.length));
+            }
+            benchSink = firs->back()->getGains()[0];
+            for (size_t f = 0; f < firs->size(); f++) { delete (*firs)[f]; }
+            for (size_t f = 0; f < owned.size(); f++) { delete[] owned[f]; }
+        } else {
+            CoefficientBank<float> bank;
+            bank.load(path);
+            char name[16];
+            std::vector<CoefficientBank<float>::SetPtr> sets(bank.getCount());
+            for (size_t k = 0; k < sets.size(); k++) {
+                snprintf(name, sizeof(name), "set%u", (unsigned)k);
+                sets[k] = bank.get(name);
+            }
+            for (size_t f = 0; f < numFilters; f++) {
+                firs->push_back(new FIRFilter<float>(sets[f % sets.size()]));
+            }
+            benchSink = firs->back()->getGains()[0];
+            for (size_t f = 0; f < firs->size(); f++) { delete (*firs)[f]; }
+        }
+        firs->clear();
+    }
+};
+
+// benchCoefficients
+// loading the taps of 1000 filters from 40 sets, per filter.
+void benchCoefficients(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    const char *path = "FilterBenchmark.coef";
+    const char *names[] = {"coefficient_load_copy", "coefficient_load_shared"};
+    const uint32_t numSets = 40;
+    for (size_t t = 0; t < taps.size() && taps[t] <= 2048; t++) {
+        uint32_t len = taps[t];
+        CoefficientBank<float> bank;
+        char name[16];
+        for (uint32_t k = 0; k < numSets; k++) {
+            std::vector<float> gains = makeSignal<float>(len + k);
+            snprintf(name, sizeof(name), "set%u", (unsigned)k);
+            bank.add(name, &gains[k], len);
+        }
+        if (bank.save(path) != 0) { continue; }
+        std::vector<FIRFilter<float>*> firs;
+        for (int m = 0; m < 2; m++) {
+            CoefficientLoadWork work = {m, path, 1000, &firs};
+            report.measure(names[m], "float", len, 1, 1000, work);
+        }
+    }
+    remove(path);
+}
+
+// Times a sliding median. Method 0 copies each window and finds the median
+// with nth_element, method 1 runs the MedianFilter.
+struct MedianWork {
+    int method;
+    const float *input;
+    float *output;
+    size_t n;
+    uint16_t length;
+    std::vector<float> *window;
+    MedianFilter<float> *median;
+
+    void operator()()
+    {
+        if (method == 0) {
+            size_t mid = (length - 1) / 2;
+            for (size_t i = 0; i < n; i++) {
+                // input has length - 1 samples of history before each block.
+                window->assign(input + i, input + i + length);
+                std::nth_element(window->begin(), window->begin() + mid, window->end());
+                output[i] = (*window)[mid];
+            }
+        } else {
+            median->filterBlock(input + length - 1, output, n);
+        }
+        benchSink = output[n - 1];
+    }
+};
+
+// benchMedian
+// the median filter against selecting the median of each window.
+void benchMedian(BenchReport &report, const std::vector<uint32_t> &lengths)
+{
+    const char *names[] = {"median_select", "median_heap"};
+    size_t n = 1024;
+    for (size_t k = 0; k < lengths.size(); k++) {
+        uint16_t len = (uint16_t)lengths[k];
+        std::vector<float> input = makeSignal<float>(n + len);
+        std::vector<float> output(n), window(len);
+        MedianFilter<float> median(len);
+        for (int m = 0; m < 2; m++) {
+            MedianWork work = {m, &input[0], &output[0], n, len, &window, &median};
+            report.measure(names[m], "float", len, (uint32_t)n, n, work);
+        }
+    }
+}
+
+// sincResample
+// The windowed sinc reference resampler, with the weights of every output
+// computed from sin and the kaiser window, as an arbitrary ratio needs.
+// Output j is the input at time delay + j / ratio.
+// @return - the number of outputs written.
+size_t sincResample(const float *x, size_t n, double ratio, int half, double delay, float *y)
+{
+    double beta = kaiserAlpha(80.0);
+    double norm = besselFunc(beta);
+    size_t count = 0;
+    for (double t = delay; t + half < (double)n; t = delay + (double)count / ratio) {
+        long base = (long)std::floor(t);
+        double acc = 0.0;
+        for (long k = base - half + 1; k <= base + half; k++) {
+            if (k < 0) { continue; }
+            double d = t - (double)k;
+            double w = d / half;
+            double sinc = (fabs(d) < 1e-12) ? 1.0 : sin(M_PI * d) / (M_PI * d);
+            acc += x[k] * sinc * besselFunc(beta * sqrt(fmax(0.0, 1.0 - w * w))) / norm;
+        }
+        y[count++] = (float)acc;
+    }
+    return count;
+}
+
+// Times resampling a block. Method 0 is the windowed sinc reference,
+// method 1 the Farrow resampler.
+struct ResampleWork {
+    int method;
+    const float *input;
+    float *output;
+    size_t n;
+    double ratio;
+    int half;
+    FarrowResampler<float> *resampler;
+
+    void operator()()
+    {
+        size_t count = (method == 0) ? sincResample(input, n, ratio, half, half, output)
+                                     : resampler->process(input, n, output);
+        benchSink = output[count / 2];
+    }
+};
+
+// resampleSignal
+// the test signal for the resamplers, at time t in samples.
+double resampleSignal(double t)
+{
+    return 0.5 * sin(0.2 * t) + 0.3 * sin(0.45 * t + 1.0) + 0.2 * sin(0.6 * t + 2.0);
+}
+
+// resampleSNR
+// the SNR in dB of outputs against the signal at the times they stand for.
+double resampleSNR(const float *y, size_t count, double ratio, double delay, size_t skip)
+{
+    double signal = 0.0, noise = 0.0;
+    for (size_t j = skip; j < count; j++) {
+        double s = resampleSignal(j / ratio - delay);
+        signal += s * s;
+        noise += (y[j] - s) * (y[j] - s);
+    }
+    return 10.0 * log10(signal / noise);
+}
+
+// benchResample
+// the Farrow resampler against a windowed sinc, for a drifting clock. The
+// accuracy of each is printed with the progress, as SNR against the exact
+// signal, which is below 0.1 of the sample rate.
+void benchResample(BenchReport &report, const BenchOptions &options)
+{
+    const size_t n = 1024;
+    const double ratio = 0.9973;
+    std::vector<float> input(n), output(2 * n);
+    for (size_t i = 0; i < n; i++) { input[i] = (float)resampleSignal((double)i); }
+
+    const int half = 16;
+    ResampleWork sinc = {0, &input[0], &output[0], n, ratio, half, NULL};
+    report.measure("sinc_resample", "float", 2 * half, (uint32_t)n, n, sinc);
+    if (options.enabled("sinc_resample")) {
+        size_t count = sincResample(&input[0], n, ratio, half, half, &output[0]);
+        // output j of the reference is the input at time half + j / ratio.
+        double snr = resampleSNR(&output[0], count, ratio, -(double)half, 0);
+        fprintf(stderr, "sinc_resample float taps=%d: %.1f dB SNR\n", 2 * half, snr);
+    }
+
+    uint16_t tapCounts[] = {4, 6, 8};
+    for (int t = 0; t < 3; t++) {
+        FarrowResampler<float> resampler(ratio, tapCounts[t]);
+        ResampleWork farrow = {1, &input[0], &output[0], n, ratio, half, &resampler};
+        report.measure("farrow_resample", "float", tapCounts[t], (uint32_t)n, n, farrow);
+        if (options.enabled("farrow_resample")) {
+            resampler.reset();
+            size_t count = resampler.process(&input[0], n, &output[0]);
+            double snr = resampleSNR(&output[0], count, ratio, resampler.getDelay(),
+                                    tapCounts[t]);
+            fprintf(stderr, "farrow_resample float taps=%u: %.1f dB SNR\n", tapCounts[t], snr);
+        }
+    }
+}
+
+// benchKernels
+// each FIR kernel the tuner chooses from, on symmetric taps so they all
+// run, and the kernel the tuner picks for each shape.
+void benchKernels(BenchReport &report, const BenchOptions &options,
+                const std::vector<uint32_t> &taps, const std::vector<uint32_t> &blocks)
+{
+    const char *names[] = {"fir_kernel_direct", "fir_kernel_lanes",
+                           "fir_kernel_symmetric", "fir_kernel_fft",
+                           "fir_kernel_segmented"};
+    FIRTuner<float> tuner;
+    for (size_t t = 0; t < taps.size(); t++) {
+        uint32_t len = taps[t];
+        std::vector<float> gains = makeSignal<float>(len);
+        for (uint32_t i = 0; i < len / 2; i++) { gains[len - 1 - i] = gains[i]; }
+        for (size_t b = 0; b < blocks.size(); b++) {
+            size_t n = 4096;
+            std::vector<float> input = makeSignal<float>(n);
+            std::vector<float> output(n);
+            for (int k = 0; k < FIR_KERNEL_COUNT; k++) {
+                if (k == FIR_KERNEL_FFT && blocks[b] < FIR_TUNE_MIN_FFT_BLOCK) { continue; }
+                if (k == FIR_KERNEL_SEGMENTED && len < FIR_SEGMENT_TAPS) { continue; }
+                Filter<float> *filter = FIRTuner<float>::make((FIRKernel)k, &gains[0], len,
+                                                            blocks[b]);
+                FilterWork<float, Filter<float> > work = {filter, &input[0], &output[0],
+                                                        n, blocks[b]};
+                report.measure(names[k], "float", len, blocks[b], n, work);
+                delete filter;
+            }
+            if (options.enabled("fir_kernel")) {
+                fprintf(stderr, "fir_tuner float taps=%u block=%u: %s\n", len, blocks[b],
+                        firKernelName(tuner.choose(&gains[0], len, blocks[b])));
+            }
+        }
+    }
+}
+
+// benchLongFIR
+// filters past the old 65535 tap limit, where the taps and history no
+// longer fit in cache, the direct and lane kernels against the segmented
+// one, in blocks of FIR_KERNEL_CHUNK.
+void benchLongFIR(BenchReport &report, const std::vector<uint32_t> &lengths)
+{
+    for (size_t t = 0; t < lengths.size(); t++) {
+        uint32_t len = lengths[t];
+        std::vector<float> gains = makeSignal<float>(len);
+        size_t n = 1024;
+        std::vector<float> input = makeSignal<float>(n);
+        std::vector<float> output(n);
+
+        FIRFilter<float> fir(&gains[0], len);
+        FilterWork<float, FIRFilter<float> > firWork = {&fir, &input[0], &output[0],
+                                                       n, FIR_KERNEL_CHUNK};
+        report.measure("long_fir_direct", "float", len, FIR_KERNEL_CHUNK, n, firWork);
+
+        LaneFIRFilter<float> lanes(&gains[0], len);
+        FilterWork<float, LaneFIRFilter<float> > laneWork = {&lanes, &input[0], &output[0],
+                                                            n, FIR_KERNEL_CHUNK};
+        report.measure("long_fir_lanes", "float", len, FIR_KERNEL_CHUNK, n, laneWork);
+
+        SegmentedFIRFilter<float> segmented(&gains[0], len);
+        FilterWork<float, SegmentedFIRFilter<float> > work = {&segmented, &input[0],
+                                                             &output[0], n, FIR_KERNEL_CHUNK};
+        report.measure("long_fir_segmented", "float", len, FIR_KERNEL_CHUNK, n, work);
+    }
+}
+
+// Runs parallelFilter over a block on a pool.
+struct ParallelWork {
+    ParallelPool *pool;
+    FIRFilter<float> *filter;
+    const float *input;
+    float *output;
+    size_t n;
+
+    void operator()()
+    {
+        parallelFilter(*pool, *filter, input, output, n, n / pool->getNumThreads());
+        benchSink = (double)output[n - 1];
+    }
+};
+
+// benchParallel
+// parallelFilter over a large block for 1, 2, 4, ... threads up to the
+// hardware threads, given in the block column, with the speedup against
+// a single filterBlock call.
+void benchParallel(BenchReport &report, const std::vector<uint32_t> &taps)
+{
+    std::vector<unsigned> threads;
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned t = 1; t < hardware; t *= 2) { threads.push_back(t); }
+    threads.push_back((hardware > 0) ? hardware : 1);
+
+    size_t n = 1 << 20;
+    std::vector<float> input = makeSignal<float>(n);
+    std::vector<float> output(n);
+    for (size_t t = 0; t < taps.size(); t++) {
+        std::vector<float> gains = makeSignal<float>(taps[t]);
+        FIRFilter<float> serial(&gains[0], taps[t]);
+        FilterWork<float, FIRFilter<float> > serialWork = {&serial, &input[0], &output[0],
+                                                          n, (uint32_t)n};
+        report.measure("parallel_fir_serial", "float", taps[t], 1, n, serialWork);
+
+        for (size_t c = 0; c < threads.size(); c++) {
+            ParallelPool pool(threads[c]);
+            FIRFilter<float> filter(&gains[0], taps[t]);
+            ParallelWork work = {&pool, &filter, &input[0], &output[0], n};
+            report.measure("parallel_fir", "float", taps[t], threads[c], n, work);
+            report.relativeTo("parallel_fir", "parallel_fir_serial");
+        }
+    }
+}
+
+// benchSparse
+// a sparse response of tens of taps against the same taps in a dense FIR
+// filter of the longest length it can hold, then the sparse filter over a
+// 200000 sample span.
+void benchSparse(BenchReport &report, const std::vector<uint32_t> &blocks)
+{
+    uint32_t counts[] = {16, 64};
+    for (int c = 0; c < 2; c++) {
+        std::vector<float> gains = makeSignal<float>(counts[c]);
+        std::vector<uint32_t> shortDelays(counts[c]);
+        std::vector<uint32_t> longDelays(counts[c]);
+        std::vector<float> dense(4095, 0.0f);
+        for (uint32_t i = 0; i < counts[c]; i++) {
+            shortDelays[i] = (i * 4094) / (counts[c] - 1);
+            longDelays[i] = (i * 200000) / (counts[c] - 1);
+            dense[shortDelays[i]] = gains[i];
+        }
+        for (size_t b = 0; b < blocks.size(); b++) {
+            size_t n = 4096;
+            std::vector<float> input = makeSignal<float>(n);
+            std::vector<float> output(n);
+
+            FIRFilter<float> fir(&dense[0], (uint16_t)dense.size());
+            FilterWork<float, FIRFilter<float> > firWork = {&fir, &input[0], &output[0],
+                                                           n, blocks[b]};
+            report.measure("sparse_fir_dense", "float", counts[c], blocks[b], n, firWork);
+
+            SparseFIRFilter<float> sparse(&shortDelays[0], &gains[0], counts[c]);
+            FilterWork<float, SparseFIRFilter<float> > work = {&sparse, &input[0],
+                                                              &output[0], n, blocks[b]};
+            report.measure("sparse_fir", "float", counts[c], blocks[b], n, work);
+
+            SparseFIRFilter<float> span(&longDelays[0], &gains[0], counts[c]);
+            FilterWork<float, SparseFIRFilter<float> > spanWork = {&span, &input[0],
+                                                                  &output[0], n, blocks[b]};
+            report.measure("sparse_fir_200k", "float", counts[c], blocks[b], n, spanWork);
+        }
+    }
+}
+
+// ChannelizerWork
+// channelizes n real inputs with the polyphase FFT filter bank.
+struct ChannelizerWork {
+    PolyphaseChannelizer<float> *bank;
+    const float *input;
+    std::complex<float> *output;
+    size_t n;
+
+    void operator()()
+    {
+        size_t frames = bank->process(input, n, output);
+        benchSink = output[frames / 2].real();
+    }
+};
+
+// ChannelBankWork
+// the same channels from one band pass filter per channel, with the mixer
+// folded into complex taps, computed only at the decimated rate.
+struct ChannelBankWork {
+    const std::vector<std::complex<float> > *bandpass; // [k][n] = h[n] e^(2 pi i k n / M)
+    const std::vector<std::complex<float> > *mixer;    // [j] = e^(-2 pi i j / M)
+    const float *input;   // preceded by taps - 1 zeros.
+    std::complex<float> *output;
+    size_t n;
+    uint32_t channels;
+    uint32_t decimation;
+    uint32_t taps;
+
+    void operator()()
+    {
+        size_t frames = 0;
+        for (size_t t = decimation - 1; t < n; t += decimation, frames++) {
+            const float *x = input + t + taps - 1;
+            for (uint32_t k = 0; k < channels; k++) {
+                const std::complex<float> *h = &(*bandpass)[(size_t)k * taps];
+                float re = 0, im = 0;
+                for (uint32_t i = 0; i < taps; i++) {
+                    re += h[i].real() * x[-(long)i];
+                    im += h[i].imag() * x[-(long)i];
+                }
+                output[frames * channels + k] = std::complex<float>(re, im) *
+                    (*mixer)[(k * (uint64_t)t) % channels];
+            }
+        }
+        benchSink = output[frames / 2].real();
+    }
+};
+
+// benchChannelizer
+// the polyphase FFT channelizer against a band pass filter per channel,
+// critically sampled and oversampled by 2, with 16 taps a branch. The
+// band pass taps take M times the prototype, so they stop at 256 channels.
+void benchChannelizer(BenchReport &report, const std::vector<uint32_t> &channels)
+{
+    const size_t n = 4096;
+    for (size_t c = 0; c < channels.size(); c++) {
+        uint32_t M = channels[c];
+        uint16_t taps = (uint16_t)(16 * M - 1);
+        float *h = idealFilterCoef<float>(M_PI / M, taps);
+        applyKaiserWindow(h, taps, 70.0);
+
+        std::vector<float> input(n + taps - 1, 0.0f);
+        std::vector<float> signal = makeSignal<float>(n);
+        std::copy(signal.begin(), signal.end(), input.begin() + taps - 1);
+        std::vector<std::complex<float> > output(n * 2);
+
+        bool withBank = (M <= 256);
+        std::vector<std::complex<float> > bandpass(withBank ? (size_t)M * taps : 0);
+        std::vector<std::complex<float> > mixer(M);
+        for (uint32_t k = 0; k < M && withBank; k++) {
+            mixer[k] = std::polar(1.0f, (float)(-2.0 * M_PI * k / M));
+            for (uint32_t i = 0; i < taps; i++) {
+                bandpass[(size_t)k * taps + i] = h[i] *
+                    std::polar(1.0f, (float)(2.0 * M_PI * ((k * (uint64_t)i) % M) / M));
+            }
+        }
+
+        uint32_t decimations[] = {M, M / 2};
+        const char *names[] = {"channelizer_critical", "channelizer_oversampled"};
+        const char *bankNames[] = {"channel_bank_critical", "channel_bank_oversampled"};
+        for (int d = 0; d < 2; d++) {
+            PolyphaseChannelizer<float> bank(h, taps, M, decimations[d]);
+            ChannelizerWork work = {&bank, &signal[0], &output[0], n};
+            report.measure(names[d], "float", taps, M, n, work);
+
+            if (withBank) {
+                ChannelBankWork direct = {&bandpass, &mixer, &input[0], &output[0], n, M,
+                                          decimations[d], taps};
+                report.measure(bankNames[d], "float", taps, M, n, direct);
+            }
+        }
+        delete[] h;
+    }
+}
+
+// ComplexWork
+// runs a filter over n complex samples, one at a time when block <= 1.
+template <class F>
+struct ComplexWork {
+    F *filter;
+    const std::complex<float> *input;
+    std::complex<float> *output;
+    size_t n;
+    uint32_t block;
+
+    void operator()()
+    {
+        if (block <= 1) {
+            std::complex<float> acc = 0;
+            for (size_t i = 0; i < n; i++) { acc += filter->filter(input[i]); }
+            benchSink = acc.real();
+        } else {
+            for (size_t i = 0; i < n; i += block) {
+                size_t len = (n - i < block) ? n - i : block;
+                filter->filterBlock(input + i, output + i, len);
+            }
+            benchSink = output[n - 1].real();
+        }
+    }
+};
+
+// SplitComplexWork
+// runs a filter over n complex samples held as split I and Q arrays.
+template <class F>
+struct SplitComplexWork {
+    F *filter;
+    const float *inRe;
+    const float *inIm;
+    float *outRe;
+    float *outIm;
+    size_t n;
+    uint32_t block;
+
+    void operator()()
+    {
+        for (size_t i = 0; i < n; i += block) {
+            size_t len = (n - i < block) ? n - i : block;
+            filter->filterBlock(inRe + i, inIm + i, outRe + i, outIm + i, len);
+        }
+        benchSink = outRe[n - 1];
+    }
+};
+
+// benchComplex
+// complex I/Q filtering with real and complex coefficients, against
+// FIRFilter and IIRFilter on std::complex samples.
+void benchComplex(BenchReport &report, const std::vector<uint32_t> &taps,
+                  const std::vector<uint32_t> &blocks)
+{
+    const size_t n = 4096;
+    std::vector<float> re = makeSignal<float>(2 * n);
+    std::vector<float> im(re.begin() + n, re.end());
+    re.resize(n);
+    std::vector<std::complex<float> > input(n), output(n);
+    for (size_t i = 0; i < n; i++) { input[i] = std::complex<float>(re[i], im[i]); }
+    std::vector<float> outRe(n), outIm(n);
+
+    for (size_t t = 0; t < taps.size(); t++) {
+        uint16_t len = (uint16_t)taps[t];
+        std::vector<float> gains = makeSignal<float>(2 * len);
+        std::vector<std::complex<float> > complexGains(len), realGains(len);
+        for (uint16_t i = 0; i < len; i++) {
+            complexGains[i] = std::complex<float>(gains[i], gains[len + i]);
+            realGains[i] = gains[i];
+        }
+        for (size_t b = 0; b < blocks.size(); b++) {
+            uint32_t block = blocks[b];
+            FIRFilter<std::complex<float> > stdReal(&realGains[0], len);
+            ComplexWork<FIRFilter<std::complex<float> > > stdRealWork =
+                {&stdReal, &input[0], &output[0], n, block};
+            report.measure("complex_fir_std_real_taps", "cfloat", len, block, n, stdRealWork);
+
+            ComplexFIRFilter<float> realTaps(&gains[0], len);
+            ComplexWork<ComplexFIRFilter<float> > realWork =
+                {&realTaps, &input[0], &output[0], n, block};
+            report.measure("complex_fir_real_taps", "cfloat", len, block, n, realWork);
+
+            FIRFilter<std::complex<float> > stdComplex(&complexGains[0], len);
+            ComplexWork<FIRFilter<std::complex<float> > > stdComplexWork =
+                {&stdComplex, &input[0], &output[0], n, block};
+            report.measure("complex_fir_std", "cfloat", len, block, n, stdComplexWork);
+
+            ComplexFIRFilter<float> complexTaps(&complexGains[0], len);
+            ComplexWork<ComplexFIRFilter<float> > complexWork =
+                {&complexTaps, &input[0], &output[0], n, block};
+            report.measure("complex_fir", "cfloat", len, block, n, complexWork);
+
+            if (block > 1) {
+                SplitComplexWork<ComplexFIRFilter<float> > splitWork =
+                    {&complexTaps, &re[0], &im[0], &outRe[0], &outIm[0], n, block};
+                report.measure("complex_fir_split", "cfloat", len, block, n, splitWork);
+            }
+        }
+    }
+
+    // a 4th order low pass, with real and complex (frequency shifted) coefficients.
+    float b[] = {0.0048f, 0.0193f, 0.0289f, 0.0193f, 0.0048f};
+    float a[] = {-2.3695f, 2.3140f, -1.0547f, 0.1874f};
+    std::complex<float> cb[5], ca[4];
+    std::complex<float> shift = std::polar(1.0f, 0.5f);
+    std::complex<float> power = shift;
+    for (int i = 0; i < 5; i++) {
+        cb[i] = b[i] * std::pow(shift, (float)i);
+        if (i < 4) { ca[i] = a[i] * power; power *= shift; }
+    }
+    for (size_t bl = 0; bl < blocks.size(); bl++) {
+        uint32_t block = blocks[bl];
+        IIRFilter<std::complex<float>, float, std::complex<float> > stdReal(b, a, 5, 4);
+        ComplexWork<IIRFilter<std::complex<float>, float, std::complex<float> > > stdRealWork =
+            {&stdReal, &input[0], &output[0], n, block};
+        report.measure("complex_iir_std_real_coef", "cfloat", 9, block, n, stdRealWork);
+
+        ComplexIIRFilter<float> realCoef(b, a, 5, 4);
+        ComplexWork<ComplexIIRFilter<float> > realWork = {&realCoef, &input[0], &output[0],
+                                                          n, block};
+        report.measure("complex_iir_real_coef", "cfloat", 9, block, n, realWork);
+
+        IIRFilter<std::complex<float> > stdComplex(cb, ca, 5, 4);
+        ComplexWork<IIRFilter<std::complex<float> > > stdComplexWork =
+            {&stdComplex, &input[0], &output[0], n, block};
+        report.measure("complex_iir_std", "cfloat", 9, block, n, stdComplexWork);
+
+        ComplexIIRFilter<float> complexCoef(cb, ca, 5, 4);
+        ComplexWork<ComplexIIRFilter<float> > complexWork = {&complexCoef, &input[0],
+                                                             &output[0], n, block};
+        report.measure("complex_iir", "cfloat", 9, block, n, complexWork);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    if (options.parseArgs(argc, argv) != 0) { return -1; }
+    BenchReport report(options);
+
+    std::vector<uint32_t> taps;
+    std::vector<uint32_t> blocks;
+    if (options.quick) {
+        uint32_t t[] = {8, 128, 2048};
+        uint32_t b[] = {1, 256};
+        taps.assign(t, t + 3);
+        blocks.assign(b, b + 2);
+    } else {
+        uint32_t t[] = {8, 32, 128, 512, 2048, 8192};
+        uint32_t b[] = {1, 64, 1024};
+        taps.assign(t, t + 6);
+        blocks.assign(b, b + 3);
+    }
+
+    benchFIR<int16_t>(report, taps, blocks);
+    benchFIR<float>(report, taps, blocks);
+    benchFIR<double>(report, taps, blocks);
+    // mixed types, int16 samples with float gains, bf16 gains to halve the
+    // gain bandwidth, and float samples with a double accumulator.
+    benchFIR<int16_t, float, float>(report, taps, blocks);
+    benchFIR<float, BFloat16, float>(report, taps, blocks);
+    benchFIR<float, float, double>(report, taps, blocks);
+
+    benchIIR<int16_t>(report, taps, blocks);
+    benchIIR<float>(report, taps, blocks);
+    benchIIR<double>(report, taps, blocks);
+    benchIIR<int16_t, float, float>(report, taps, blocks);
+    benchIIR<float, double, double>(report, taps, blocks);
+
+    benchWindows(report, taps);
+    benchDesign(report, taps);
+
+    // FFT sizes, powers of 2 and a mixed radix size.
+    std::vector<uint32_t> sizes;
+    if (options.quick) {
+        uint32_t f[] = {256, 1000, 4096};
+        sizes.assign(f, f + 3);
+    } else {
+        uint32_t f[] = {64, 256, 1000, 1024, 4096, 65536};
+        sizes.assign(f, f + 6);
+    }
+    benchFFT(report, sizes);
+    benchResponse(report, taps);
+
+    std::vector<uint32_t> tones;
+    uint32_t k[] = {8, 32, 128};
+    tones.assign(k, k + (options.quick ? 2 : 3));
+    benchTones(report, tones);
+    benchAdaptive(report, taps);
+    benchHalfBand(report, taps);
+    benchConvert(report, taps);
+    benchMultichannel(report, taps);
+    benchSnapshot(report, taps);
+    benchCoefficients(report, taps);
+
+    // median window lengths.
+    std::vector<uint32_t> windows;
+    uint32_t w[] = {15, 255, 4095};
+    windows.assign(w, w + (options.quick ? 2 : 3));
+    benchMedian(report, windows);
+    benchResample(report, options);
+    benchKernels(report, options, taps, blocks);
+
+    // lengths past 65535 taps.
+    std::vector<uint32_t> lengths;
+    uint32_t lf[] = {16384, 131072, 1048576};
+    lengths.assign(lf, lf + (options.quick ? 2 : 3));
+    benchLongFIR(report, lengths);
+
+    // parallel taps, over a block of 2^20 samples.
+    std::vector<uint32_t> parallelTaps;
+    uint32_t pt[] = {255, 1023};
+    parallelTaps.assign(pt, pt + (options.quick ? 1 : 2));
+    benchParallel(report, parallelTaps);
+    benchSparse(report, blocks);
+
+    // channelizer channel counts, given in the block column.
+    std::vector<uint32_t> channels;
+    uint32_t ch[] = {64, 256, 1024};
+    channels.assign(ch, ch + (options.quick ? 2 : 3));
+    benchChannelizer(report, channels);
+    benchComplex(report, taps, blocks);
+
+    report.print(stdout);
+    return 0;
+} // end main
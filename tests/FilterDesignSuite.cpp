@@ -0,0 +1,139 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FilterDesignSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the allocation free filter design functions and
+// the design cache.
+
+#include <iostream>
+#include <FilterUtility.h>
+#include <WindowCache.h>
+#include <DesignCache.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    uint16_t lengths[] = {1, 3, 15, 117, 1001, 9999};
+
+    for (int l = 0; l < 6; l++) {
+        uint16_t N = lengths[l];
+        int M = N / 2;
+        vector<double> gains(N);
+
+        ////////////////// Test 1 ///////////////////
+        // designs match the sinc formula evaluated directly.
+        double cutoffs[] = {0.1, M_PI / 2.0, 2.9};
+        for (int c = 0; c < 3; c++) {
+            for (int hp = 0; hp < 2; hp++) {
+                if (idealFilterCoef(&gains[0], cutoffs[c], N, hp == 1) != 0) {
+                    cout << "FAILED: test 1 design returned error." << endl;
+                    return -1;
+                }
+                for (int k = 0; k < N; k++) {
+                    double w;
+                    if (k == M) { w = hp ? 1.0 - cutoffs[c] / M_PI : cutoffs[c] / M_PI; }
+                    else { w = (hp ? -1 : 1) * sin(cutoffs[c] * (k - M)) / (M_PI * (k - M)); }
+                    if (fabs(gains[k] - w) > 1e-13) {
+                        cout << "FAILED: test 1 N = " << N << " k = " << k
+                             << " gain = " << gains[k] << " expected = " << w << endl;
+                        return -1;
+                    }
+                }
+            }
+        }
+
+        ////////////////// Test 2 ///////////////////
+        // differentiator matches the formula evaluated directly.
+        idealDifferentiatorCoef(&gains[0], N);
+        for (int k = 0; k < N; k++) {
+            double w = 0.0;
+            if (k != M) {
+                w = (cos(M_PI * (k - M)) / (k - M)) -
+                    (sin(M_PI * (k - M)) / (M_PI * (k - M) * (k - M)));
+            }
+            if (fabs(gains[k] - w) > 1e-12) {
+                cout << "FAILED: test 2 differentiator N = " << N << " k = " << k << endl;
+                return -1;
+            }
+        }
+    }
+
+    double evenGains[14];
+    if (idealFilterCoef((double *)NULL, 1.0, 15) == 0 ||
+        idealFilterCoef(evenGains, 1.0, 14) == 0) {
+        cout << "FAILED: test 2 bad arguments accepted." << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // cached designs match designing by hand.
+    DesignCache<float> cache(2, 255);
+    float *reference = idealFilterCoef<float>(1.0, 101);
+    applyKaiserWindow(reference, 101, 60.0);
+    float gains[255];
+
+    if (cache.design(gains, DESIGN_LOWPASS, 1.0, 101, WINDOW_KAISER, 60.0) != 0) {
+        cout << "FAILED: test 3 design returned error." << endl;
+        return -1;
+    }
+    for (int i = 0; i < 101; i++) {
+        if (fabs(gains[i] - reference[i]) > 1e-7) {
+            cout << "FAILED: test 3 cached design differs at " << i << endl;
+            return -1;
+        }
+    }
+    delete[] reference;
+
+    ////////////////// Test 4 ///////////////////
+    // repeated designs are hits, and the least recently used is replaced.
+    const float *a = cache.design(DESIGN_LOWPASS, 1.0, 101, WINDOW_KAISER, 60.0);
+    const float *b = cache.design(DESIGN_HIGHPASS, 1.0, 101, WINDOW_HAMMING);
+    const float *a2 = cache.design(DESIGN_LOWPASS, 1.0, 101, WINDOW_KAISER, 60.0);
+    if (cache.getHits() != 2 || cache.getMisses() != 2 || a != a2 || a == b) {
+        cout << "FAILED: test 4 hits = " << cache.getHits() << " misses = "
+             << cache.getMisses() << endl;
+        return -1;
+    }
+    // b is now the oldest, so a new design replaces it.
+    const float *c = cache.design(DESIGN_DIFFERENTIATOR, 5.0, 31);
+    cache.design(DESIGN_LOWPASS, 1.0, 101, WINDOW_KAISER, 60.0);
+    if (c != b || cache.getHits() != 3 || cache.getMisses() != 3) {
+        cout << "FAILED: test 4 least recently used replacement." << endl;
+        return -1;
+    }
+    // the cutoff of a differentiator doesn't matter.
+    cache.design(DESIGN_DIFFERENTIATOR, 1.0, 31);
+    if (cache.getHits() != 4) {
+        cout << "FAILED: test 4 differentiator key." << endl;
+        return -1;
+    }
+    if (cache.design(DESIGN_LOWPASS, 1.0, 257) != NULL ||
+        cache.design(DESIGN_LOWPASS, 1.0, 100) != NULL) {
+        cout << "FAILED: test 4 bad lengths accepted." << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
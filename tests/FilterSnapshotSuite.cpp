@@ -0,0 +1,176 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FilterSnapshotSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for saving and restoring filter state, checking a restored
+// filter carries on with exactly the output of one that never stopped.
+
+#include <iostream>
+#include <FilterSnapshot.h>
+#include <FIRFilter.h>
+#include <IIRFilter.h>
+#include <FilterUtility.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+#define SNAPSHOT_PATH "FilterSnapshotSuite.snap"
+
+int main(int argc, char **argv)
+{
+    const uint32_t numFilters = 500;
+    const uint16_t L = 47;
+    vector<float> x = makeNoise<float>(4000, 1);
+    vector<float> gains(L);
+    idealFilterCoef(&gains[0], (float)(M_PI / 3.0), L);
+    double ff[] = {0.1, 0.2, 0.1};
+    double fb[] = {-1.2, 0.5};
+
+    ////////////////// Test 1 ///////////////////
+    // many FIR and IIR filters, each run over a different amount of input,
+    // are saved, restored into new filters, and carry on identically.
+    vector<FIRFilter<float> *> firs(numFilters), restoredFirs(numFilters);
+    vector<IIRFilter<float, double, double> *> iirs(numFilters), restoredIirs(numFilters);
+    for (uint32_t f = 0; f < numFilters; f++) {
+        firs[f] = new FIRFilter<float>(&gains[0], L);
+        iirs[f] = new IIRFilter<float, double, double>(ff, fb, 3, 2);
+        restoredFirs[f] = new FIRFilter<float>(&gains[0], L);
+        restoredIirs[f] = new IIRFilter<float, double, double>(ff, fb, 3, 2);
+        size_t n = 100 + (f * 37) % 200;
+        for (size_t i = 0; i < n; i++) {
+            firs[f]->filter(x[i + f]);
+            iirs[f]->filter(x[i + f]);
+        }
+    }
+
+    SnapshotWriter writer;
+    if (writer.open(SNAPSHOT_PATH) != 0) {
+        cout << "FAILED: test 1 open for writing" << endl;
+        return -1;
+    }
+    for (uint32_t f = 0; f < numFilters; f++) {
+        if (writer.add(*firs[f], f) != 0 || writer.add(*iirs[f], 1000 + f) != 0) {
+            cout << "FAILED: test 1 add f = " << f << endl;
+            return -1;
+        }
+    }
+    if (writer.getCount() != 2 * numFilters || writer.close() != 0) {
+        cout << "FAILED: test 1 close" << endl;
+        return -1;
+    }
+
+    SnapshotReader reader;
+    if (reader.open(SNAPSHOT_PATH) != 0 || reader.getCount() != 2 * numFilters) {
+        cout << "FAILED: test 1 open for reading" << endl;
+        return -1;
+    }
+    // restore in reverse order, the table gives any record directly.
+    for (uint32_t f = numFilters; f-- > 0;) {
+        if (reader.restore(2 * f + 1, *restoredIirs[f]) != 0 ||
+                reader.restore(2 * f, *restoredFirs[f]) != 0 ||
+                reader.getRecord(2 * f + 1)->tag != 1000 + f) {
+            cout << "FAILED: test 1 restore f = " << f << endl;
+            return -1;
+        }
+    }
+    for (uint32_t f = 0; f < numFilters; f++) {
+        if (restoredFirs[f]->getOutput() != firs[f]->getOutput()) {
+            cout << "FAILED: test 1 restored output f = " << f << endl;
+            return -1;
+        }
+        for (size_t i = 3000; i < 3100; i++) {
+            if (restoredFirs[f]->filter(x[i]) != firs[f]->filter(x[i]) ||
+                    restoredIirs[f]->filter(x[i]) != iirs[f]->filter(x[i])) {
+                cout << "FAILED: test 1 continued output f = " << f << endl;
+                return -1;
+            }
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // records are only restored into matching filters.
+    vector<float> otherGains(gains);
+    otherGains[3] += 0.001f;
+    FIRFilter<float> otherTaps(&otherGains[0], L);
+    FIRFilter<float> shorter(&gains[0], L - 1);
+    FIRFilter<double> otherType((double *)NULL, 0);
+    vector<double> doubleGains(gains.begin(), gains.end());
+    otherType.setGains(&doubleGains[0], L);
+    IIRFilter<float> floatState(NULL, NULL, 3, 2);
+    float ffF[] = {0.1f, 0.2f, 0.1f}, fbF[] = {-1.2f, 0.5f};
+    floatState.setGains(ffF, fbF, 3, 2);
+    if (reader.restore(0, otherTaps) == 0 || reader.restore(0, shorter) == 0 ||
+            reader.restore(0, otherType) == 0 || reader.restore(1, *restoredFirs[0]) == 0 ||
+            reader.restore(1, floatState) == 0 || reader.restore(2 * numFilters, *restoredFirs[0]) == 0 ||
+            reader.getRecord(2 * numFilters) != NULL) {
+        cout << "FAILED: test 2 mismatched restore" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // a snapshot in memory, and damaged snapshots are rejected.
+    FILE *file = fopen(SNAPSHOT_PATH, "rb");
+    fseek(file, 0, SEEK_END);
+    size_t size = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+    vector<uint64_t> bytes((size + 7) / 8);
+    if (fread(&bytes[0], 1, size, file) != size) {
+        cout << "FAILED: test 3 read file" << endl;
+        return -1;
+    }
+    fclose(file);
+    SnapshotReader memory;
+    if (memory.openMemory(&bytes[0], size) != 0 || memory.restore(0, *restoredFirs[1]) != 0 ||
+            reader.restore(0, *restoredFirs[0]) != 0 ||
+            restoredFirs[1]->filter(x[0]) != restoredFirs[0]->filter(x[0])) {
+        cout << "FAILED: test 3 open memory" << endl;
+        return -1;
+    }
+    SnapshotReader damaged;
+    if (damaged.openMemory(&bytes[0], size - 8) == 0 ||
+            damaged.openMemory((const uint8_t *)&bytes[0] + 4, size - 8) == 0 ||
+            damaged.open("FilterSnapshotSuite.missing") == 0) {
+        cout << "FAILED: test 3 damaged snapshot" << endl;
+        return -1;
+    }
+    // a bad offset in the table.
+    const SnapshotTrailer *trailer = (const SnapshotTrailer *)((const uint8_t *)&bytes[0] +
+                                        size - sizeof(SnapshotTrailer));
+    bytes[trailer->tableOffset / 8] = size;
+    if (damaged.openMemory(&bytes[0], size) != 0 || damaged.getRecord(0) != NULL ||
+            damaged.restore(0, *restoredFirs[2]) == 0) {
+        cout << "FAILED: test 3 bad record offset" << endl;
+        return -1;
+    }
+
+    for (uint32_t f = 0; f < numFilters; f++) {
+        delete firs[f];
+        delete iirs[f];
+        delete restoredFirs[f];
+        delete restoredIirs[f];
+    }
+    remove(SNAPSHOT_PATH);
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
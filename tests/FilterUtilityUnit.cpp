@@ -0,0 +1,43 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FilterUtilityUnit.cpp
+// Written Ian Rankin - October 2026
+//
+// A second translation unit including FilterUtility.h, linked into
+// FIRIdealFilterSuite, so a function defined in the header without inline
+// fails to link.
+
+#include <FilterUtility.h>
+
+// otherUnitKaiser
+// designs a Kaiser window here instead of in the suite.
+// @return - the length of the window, 0 on failure.
+uint32_t otherUnitKaiser(double A, double deltaW, double *window)
+{
+    uint32_t N = calcKaiserLen(A, deltaW);
+    for (uint32_t i = 0; i < N; i++) { window[i] = 1.0; }
+    double s[SINCOS_BLOCK_LEN];
+    sinCosBlock(0.1, 1, 4, s, NULL);
+    if (kaiserAlpha(A) <= 0.0 || besselFunc(0.0) != 1.0 ||
+            applyKaiserWindow(window, N, A) != 0) {
+        return 0;
+    }
+    return N;
+}
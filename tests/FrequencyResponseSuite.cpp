@@ -0,0 +1,198 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// FrequencyResponseSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the frequency response evaluation, checked against the
+// direct sum of the transfer function, and against known delays.
+
+#include <iostream>
+#include <FrequencyResponse.h>
+#include <FilterUtility.h>
+#include <FIRFilter.h>
+#include <IIRFilter.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace std;
+
+// directResponse
+// sums B(e^jw) / A(e^jw) directly.
+complex<double> directResponse(const double *b, int bLength, const double *a,
+                            int aLength, double w)
+{
+    complex<double> B(0, 0), A(1, 0);
+    for (int n = 0; n < bLength; n++) { B += b[n] * polar(1.0, -w * n); }
+    for (int n = 0; n < aLength; n++) { A += a[n] * polar(1.0, -w * (n + 1)); }
+    return B / A;
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // FIR response matches the direct sum, for taps shorter and longer
+    // than the FFT size.
+    int lengths[] = {1, 5, 31, 64, 100, 301};
+    for (int l = 0; l < 6; l++) {
+        int L = lengths[l];
+        vector<double> b(L);
+        for (int i = 0; i < L; i++) { b[i] = sin(0.37 * i + 0.1) / (i + 1); }
+
+        FrequencyResponse freq(128);
+        vector<complex<double> > H(freq.getNumPoints());
+        if (freq.getNumPoints() != 65 ||
+            freq.response(&b[0], L, (const double *)NULL, 0, &H[0]) != 0) {
+            cout << "FAILED: test 1 response call" << endl;
+            return -1;
+        }
+        for (uint32_t k = 0; k < freq.getNumPoints(); k++) {
+            complex<double> expected = directResponse(&b[0], L, NULL, 0, freq.getFrequency(k));
+            if (abs(H[k] - expected) > 1e-12) {
+                cout << "FAILED: test 1 FIR response L = " << L << " k = " << k << endl;
+                return -1;
+            }
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // IIR response matches the direct sum, and the filter's impulse response.
+    double b[] = {0.2, 0.3, 0.1};
+    double a[] = {-0.9, 0.2};
+    IIRFilter<double> iir(b, a, 3, 2);
+    FrequencyResponse freq(256);
+    uint32_t M = freq.getNumPoints();
+    vector<complex<double> > H(M);
+    freq.response(iir, &H[0]);
+
+    vector<double> impulse(400);
+    for (int n = 0; n < 400; n++) { impulse[n] = iir.filter(n == 0 ? 1.0 : 0.0); }
+    for (uint32_t k = 0; k < M; k++) {
+        double w = freq.getFrequency(k);
+        complex<double> expected = directResponse(b, 3, a, 2, w);
+        complex<double> fromImpulse = directResponse(&impulse[0], 400, NULL, 0, w);
+        if (abs(H[k] - expected) > 1e-12 || abs(H[k] - fromImpulse) > 1e-9) {
+            cout << "FAILED: test 2 IIR response k = " << k << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // symmetric FIR filters have a constant delay of (L - 1) / 2, and a one
+    // pole filter matches its closed form delay.
+    float *lowPass = idealFilterCoef<float>(M_PI / 3.0, 41);
+    FIRFilter<float> fir(lowPass, 41);
+    vector<double> delay(M);
+    freq.groupDelay(fir.getGains(), 41, (const float *)NULL, 0, &delay[0]);
+    for (uint32_t k = 0; k < M; k++) {
+        // zero where the response is zero.
+        if (delay[k] != 0.0 && fabs(delay[k] - 20.0) > 1e-6) {
+            cout << "FAILED: test 3 linear phase delay " << delay[k] << " k = " << k << endl;
+            return -1;
+        }
+    }
+    delete[] lowPass;
+
+    double one[] = {1.0};
+    double pole[] = {-0.8};
+    freq.groupDelay(one, 1, pole, 1, &delay[0]);
+    for (uint32_t k = 0; k < M; k++) {
+        double w = freq.getFrequency(k);
+        double expected = (0.8 * cos(w) - 0.64) / (1.0 - 1.6 * cos(w) + 0.64);
+        if (fabs(delay[k] - expected) > 1e-9) {
+            cout << "FAILED: test 3 one pole delay k = " << k << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // a pure delay has magnitude 1, and unwrapped phase -d w.
+    double pureDelay[] = {0, 0, 0, 0, 0, 1};
+    freq.response(pureDelay, 6, (const double *)NULL, 0, &H[0]);
+    vector<double> mag(M), phase(M), db(M);
+    responseMagnitude(&H[0], &mag[0], M);
+    responseMagnitudeDb(&H[0], &db[0], M);
+    responsePhase(&H[0], &phase[0], M);
+    for (uint32_t k = 0; k < M; k++) {
+        if (fabs(mag[k] - 1.0) > 1e-12 || fabs(db[k]) > 1e-10 ||
+            fabs(phase[k] + 5.0 * freq.getFrequency(k)) > 1e-9) {
+            cout << "FAILED: test 4 pure delay k = " << k << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // batch results match single filters, and a bank of kaiser designs
+    // meets its stopband spec.
+    double A = 60.0;
+    // calcKaiserLen takes the transition width in cycles per sample,
+    // pi / 20 radians.
+    uint16_t L = calcKaiserLen(A, 1.0 / 40.0);
+    int numFilters = 16;
+    vector<double> bank((size_t)numFilters * L);
+    for (int f = 0; f < numFilters; f++) {
+        double cutoff = M_PI * (f + 2) / (numFilters + 4);
+        idealFilterCoef(&bank[(size_t)f * L], cutoff, L);
+        applyKaiserWindow(&bank[(size_t)f * L], L, A);
+    }
+    FrequencyResponse bankFreq(2048);
+    uint32_t bankM = bankFreq.getNumPoints();
+    vector<double> bankMag((size_t)numFilters * bankM);
+    bankFreq.magnitudeBatch(&bank[0], numFilters, L, &bankMag[0]);
+
+    vector<complex<double> > single(bankM);
+    for (int f = 0; f < numFilters; f++) {
+        double cutoff = M_PI * (f + 2) / (numFilters + 4);
+        bankFreq.response(&bank[(size_t)f * L], L, (const double *)NULL, 0, &single[0]);
+        for (uint32_t k = 0; k < bankM; k++) {
+            double w = bankFreq.getFrequency(k);
+            double m = bankMag[(size_t)f * bankM + k];
+            if (fabs(m - abs(single[k])) > 1e-15) {
+                cout << "FAILED: test 5 batch mismatch filter " << f << endl;
+                return -1;
+            }
+            // half the transition band either side of the cutoff.
+            if (w > cutoff + M_PI / 40.0 && 20.0 * log10(m) > -A + 1.0) {
+                cout << "FAILED: test 5 stopband filter " << f << " w = " << w << endl;
+                return -1;
+            }
+            if (w < cutoff - M_PI / 40.0 && fabs(m - 1.0) > 0.01) {
+                cout << "FAILED: test 5 passband filter " << f << " w = " << w << endl;
+                return -1;
+            }
+        }
+    }
+
+    vector<complex<double> > iirBatch(2 * M);
+    double bs[] = {0.2, 0.3, 0.1, 1.0, 0.0, 0.0};
+    double as[] = {-0.9, 0.2, -0.5, 0.0};
+    freq.responseBatch(bs, 3, as, 2, 2, &iirBatch[0]);
+    for (uint32_t k = 0; k < M; k++) {
+        double w = freq.getFrequency(k);
+        if (abs(iirBatch[k] - directResponse(bs, 3, as, 2, w)) > 1e-12 ||
+            abs(iirBatch[M + k] - directResponse(bs + 3, 3, as + 2, 2, w)) > 1e-12) {
+            cout << "FAILED: test 5 IIR batch k = " << k << endl;
+            return -1;
+        }
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,166 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// HalfBandFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the half band filter, checked against FIRFilter with
+// the full design.
+
+#include <iostream>
+#include <HalfBandFilter.h>
+#include <FIRFilter.h>
+#include <FilterUtility.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    vector<double> x = makeNoise<double>(1000, 3);
+    int lengths[] = {3, 7, 9, 11, 13, 19, 31, 33, 63, 127};
+
+    for (int l = 0; l < 10; l++) {
+        uint16_t N = lengths[l];
+        vector<double> gains(N);
+        idealFilterCoef(&gains[0], M_PI / 2.0, N);
+        applyKaiserWindow(&gains[0], N, 60.0);
+        // designs of length 4K + 1 are one sample earlier than FIRFilter.
+        int shift = (N % 4 == 1) ? 1 : 0;
+
+        ////////////////// Test 1 ///////////////////
+        // full rate matches FIRFilter.
+        HalfBandFilter<double> hb(&gains[0], N);
+        FIRFilter<double> fir(&gains[0], N);
+        vector<double> expected(x.size()), actual(x.size());
+        for (size_t n = 0; n < x.size(); n++) {
+            expected[n] = fir.filter(x[n]);
+            actual[n] = hb.filter(x[n]);
+        }
+        if (hb.getDelay() != (N - 1) / 2 - shift || hb.getNumTaps() != (N + 1) / 4) {
+            cout << "FAILED: test 1 delay / taps N = " << N << endl;
+            return -1;
+        }
+        for (size_t n = 0; n + shift < x.size(); n++) {
+            if (fabs(actual[n] - expected[n + shift]) > 1e-12) {
+                cout << "FAILED: test 1 full rate N = " << N << " n = " << n << endl;
+                return -1;
+            }
+        }
+
+        ////////////////// Test 2 ///////////////////
+        // decimate gives the even outputs, across odd block sizes.
+        HalfBandFilter<double> dec(&gains[0], N);
+        vector<double> decOut(x.size() / 2 + 1);
+        size_t count = dec.decimate(&x[0], &decOut[0], 333);
+        count += dec.decimate(&x[333], &decOut[count], x.size() - 333);
+        if (count != x.size() / 2) {
+            cout << "FAILED: test 2 decimate count N = " << N << endl;
+            return -1;
+        }
+        for (size_t m = 0; m < count; m++) {
+            if (decOut[m] != actual[2 * m]) {
+                cout << "FAILED: test 2 decimate N = " << N << " m = " << m << endl;
+                return -1;
+            }
+        }
+
+        ////////////////// Test 3 ///////////////////
+        // interpolate matches FIRFilter on the input with zeros between
+        // samples, times 2.
+        HalfBandFilter<double> interp(&gains[0], N);
+        FIRFilter<double> firInterp(&gains[0], N);
+        vector<double> interpOut(2 * x.size());
+        if (interp.interpolate(&x[0], &interpOut[0], x.size()) != 2 * x.size()) {
+            cout << "FAILED: test 3 interpolate count N = " << N << endl;
+            return -1;
+        }
+        vector<double> stuffed(2 * x.size());
+        for (size_t n = 0; n < stuffed.size(); n++) {
+            stuffed[n] = 2.0 * firInterp.filter((n % 2) ? 0.0 : x[n / 2]);
+        }
+        for (size_t n = 0; n + shift < stuffed.size(); n++) {
+            if (fabs(interpOut[n] - stuffed[n + shift]) > 1e-12) {
+                cout << "FAILED: test 3 interpolate N = " << N << " n = " << n << endl;
+                return -1;
+            }
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // a 3 stage cascade matches the stages run by hand, passes a low tone
+    // and removes a high one.
+    uint16_t N = 31;
+    vector<float> gains(N);
+    idealFilterCoef(&gains[0], M_PI / 2.0, N);
+    applyKaiserWindow(&gains[0], N, 60.0);
+
+    HalfBandCascade<float> cascade(&gains[0], N, 3);
+    HalfBandFilter<float> s0(&gains[0], N), s1(&gains[0], N), s2(&gains[0], N);
+    size_t n = 4096;
+    vector<float> tone(n), mixed(n);
+    for (size_t i = 0; i < n; i++) {
+        tone[i] = (float)sin(2.0 * M_PI * 0.01 * i);
+        mixed[i] = tone[i] + (float)sin(2.0 * M_PI * 0.2 * i);
+    }
+    vector<float> out(n / 8 + 1), a(n / 2), b(n / 4), c(n / 8 + 1);
+    size_t count = cascade.decimate(&mixed[0], &out[0], n);
+    s0.decimate(&mixed[0], &a[0], n);
+    s1.decimate(&a[0], &b[0], n / 2);
+    s2.decimate(&b[0], &c[0], n / 4);
+    if (count != n / 8 || cascade.getNumStages() != 3) {
+        cout << "FAILED: test 4 cascade count" << endl;
+        return -1;
+    }
+    // the delay of 15 samples at each rate, in input samples.
+    size_t delay = 15 + 2 * 15 + 4 * 15;
+    for (size_t m = 0; m < count; m++) {
+        if (out[m] != c[m]) {
+            cout << "FAILED: test 4 cascade mismatch m = " << m << endl;
+            return -1;
+        }
+        if (m > 20 && fabs(out[m] - tone[8 * m - delay]) > 0.01) {
+            cout << "FAILED: test 4 cascade tone m = " << m << " " << out[m] << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // cascade interpolation of a low tone gets the tone back at 8x.
+    HalfBandCascade<float> up(&gains[0], N, 3);
+    vector<float> low(512), high(8 * 512);
+    for (size_t i = 0; i < 512; i++) { low[i] = (float)sin(2.0 * M_PI * 0.04 * i); }
+    if (up.interpolate(&low[0], &high[0], 512) != 8 * 512) {
+        cout << "FAILED: test 5 cascade interpolate count" << endl;
+        return -1;
+    }
+    size_t upDelay = 4 * 15 + 2 * 15 + 15;
+    for (size_t i = 400; i < high.size(); i++) {
+        double expected = sin(2.0 * M_PI * 0.005 * ((double)i - upDelay));
+        if (fabs(high[i] - expected) > 0.01) {
+            cout << "FAILED: test 5 cascade interpolate i = " << i << endl;
+            return -1;
+        }
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
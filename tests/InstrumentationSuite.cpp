@@ -0,0 +1,171 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// InstrumentationSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the filter instrumentation counters.
+// Built with DSP_LITE_INSTRUMENT defined.
+
+#ifndef DSP_LITE_INSTRUMENT
+#define DSP_LITE_INSTRUMENT
+#endif
+
+#include <iostream>
+#include <FIRFilter.h>
+#include <IIRFilter.h>
+#include <ParallelFIRFilter.h>
+#include <Filter.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // samples and calls are counted for filter and filterBlock.
+    float gains[] = {0.5, 0.25, 0.25};
+    FIRFilter<float> fir(gains, 3);
+    float x[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    float y[10];
+
+    for (int i = 0; i < 4; i++) { fir.filter(x[i]); }
+    fir.filterBlock(x + 4, y, 6);
+
+    FilterStatsSnapshot s = fir.getStats().snapshot();
+    if (s.samples != 10 || s.calls != 5) {
+        std::cerr << "FAILED: test 1 samples = " << s.samples << " calls = " << s.calls << std::endl;
+        return -1;
+    }
+    if (s.maxCycles == 0 || s.totalCycles < s.maxCycles || s.averageCycles() <= 0) {
+        std::cerr << "FAILED: test 1 cycle counts." << std::endl;
+        return -1;
+    }
+    if (s.saturated != 0 || s.nonFinite != 0) {
+        std::cerr << "FAILED: test 1 false health counts." << std::endl;
+        return -1;
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // an integer output exactly at the limit isn't saturated.
+    int16_t gains2[] = {32767, 1};
+    FIRFilter<int16_t> sat(gains2, 2);
+    if (sat.filter(1) != 32767 || sat.getStats().snapshot().saturated != 0) {
+        std::cerr << "FAILED: test 2 saturation count." << std::endl;
+        return -1;
+    }
+
+    // a wider accumulator past the limits is counted, one sample at a time
+    // and in blocks, and the output is clamped instead of wrapping.
+    float gains2b[] = {1.0f, 1.0f};
+    FIRFilter<int16_t, float, float> over(gains2b, 2);
+    int16_t loud[6] = {30000, 30000, 100, -30000, -30000, 100};
+    int16_t loudOut[6];
+    over.filter(loud[0]);
+    if (over.filter(loud[1]) != 32767 || over.getStats().snapshot().saturated != 1) {
+        std::cerr << "FAILED: test 2 accumulator overflow." << std::endl;
+        return -1;
+    }
+    over.filterBlock(loud + 2, loudOut, 4);
+    if (loudOut[2] != -32768 || over.getStats().snapshot().saturated != 2) {
+        std::cerr << "FAILED: test 2 block accumulator overflow." << std::endl;
+        return -1;
+    }
+    // a block whose last output saturates is only counted once.
+    FIRFilter<int16_t, float, float> last(gains2b, 2);
+    int16_t lastIn[4] = {100, 100, 30000, 30000};
+    int16_t lastOut[4];
+    last.filterBlock(lastIn, lastOut, 4);
+    if (lastOut[3] != 32767 || last.getStats().snapshot().saturated != 1) {
+        std::cerr << "FAILED: test 2 last sample of block counted "
+                  << last.getStats().snapshot().saturated << " times." << std::endl;
+        return -1;
+    }
+    float ffLoud[] = {2.0f};
+    float fbLoud[] = {0.0f};
+    IIRFilter<int16_t, float, float> iirOver(ffLoud, fbLoud, 1, 1);
+    if (iirOver.filter(20000) != 32767 || iirOver.getStats().snapshot().saturated != 1) {
+        std::cerr << "FAILED: test 2 IIR accumulator overflow." << std::endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // an unstable IIR filter ends up with Inf / NaN in its state.
+    double ffGains[] = {1.0, 0.0};
+    double fbGains[] = {-10.0};
+    IIRFilter<double> unstable(ffGains, fbGains, 2, 1);
+    double in[400];
+    double out[400];
+    for (int i = 0; i < 400; i++) { in[i] = 1.0; }
+    unstable.filterBlock(in, out, 400);
+
+    s = unstable.getStats().snapshot();
+    if (s.nonFinite == 0 || s.samples != 400 || s.calls != 1) {
+        std::cerr << "FAILED: test 3 non finite count = " << s.nonFinite << std::endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // another thread can read the counters while the filter runs.
+    FIRFilter<float> running(gains, 3);
+    std::atomic<bool> done(false);
+    uint64_t lastSeen = 0;
+    bool decreased = false;
+    std::thread reader([&]() {
+        while (!done.load()) {
+            uint64_t samples = running.getStats().snapshot().samples;
+            if (samples < lastSeen) { decreased = true; }
+            lastSeen = samples;
+        }
+    });
+    for (int i = 0; i < 100000; i++) { running.filter(1.0f); }
+    done.store(true);
+    reader.join();
+    if (decreased || running.getStats().snapshot().samples != 100000) {
+        std::cerr << "FAILED: test 4 concurrent read." << std::endl;
+        return -1;
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // parallelFilter counts its block as one call, and each saturated
+    // output once, over all of its threads.
+    float gains5[] = {1.0f, 1.0f};
+    FIRFilter<int16_t, float, float> parallel(gains5, 2);
+    ParallelPool pool5(4);
+    std::vector<int16_t> in5(4000, 100);
+    in5[999] = 30000;
+    in5[1000] = 30000;
+    in5[3999] = 30000;
+    in5[3998] = 30000;
+    std::vector<int16_t> out5(4000);
+    if (parallelFilter(pool5, parallel, &in5[0], &out5[0], in5.size(), 1000) != 0) {
+        std::cerr << "FAILED: test 5 parallelFilter failed." << std::endl;
+        return -1;
+    }
+    s = parallel.getStats().snapshot();
+    if (s.samples != 4000 || s.calls != 1 || s.saturated != 2) {
+        std::cerr << "FAILED: test 5 parallel counts, samples = " << s.samples
+                  << " calls = " << s.calls << " saturated = " << s.saturated << std::endl;
+        return -1;
+    }
+
+    // test passed if reached here.
+    std::cout << "PASSED all tests!" << std::endl;
+    return 0;
+} // end main
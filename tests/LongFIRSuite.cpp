@@ -0,0 +1,170 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// LongFIRSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for filters and designs longer than 65535 taps.
+
+#include <iostream>
+#include <FIRFilter.h>
+#include <FIRKernels.h>
+#include <FilterUtility.h>
+#include <FilterSnapshot.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#define SNAPSHOT_PATH "LongFIRSuite.snap"
+
+using namespace std;
+
+// directOutput
+// the output at n of the taps convolved with the whole input.
+double directOutput(const vector<double> &taps, const vector<double> &x, size_t n)
+{
+    double y = 0.0;
+    for (size_t k = 0; k < taps.size() && k <= n; k++) { y += taps[k] * x[n - k]; }
+    return y;
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // Kaiser lengths past 65535, and 0 instead of a wrapped length.
+    double D = (80.0 - 7.95) / 14.36;
+    uint32_t N = calcKaiserLen(80.0, 2e-5);
+    if (N <= 65535 || N % 2 == 0 || N < ceil(D / 2e-5 + 1) || N > ceil(D / 2e-5 + 1) + 1) {
+        cout << "FAILED: test 1 long Kaiser length " << N << endl;
+        return -1;
+    }
+    if (calcKaiserLen(80.0, 1e-12) != 0 || calcKaiserLen(80.0, 0.0) != 0 ||
+            calcKaiserLen(80.0, -0.1) != 0 || calcKaiserLen(80.0, 0.1) != 53) {
+        cout << "FAILED: test 1 Kaiser length limits" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // an ideal low pass and Kaiser window of 200001 taps.
+    const uint32_t designLen = 200001;
+    const uint32_t M = designLen / 2;
+    const double cutoff = M_PI / 3.0;
+    vector<double> design(designLen);
+    if (idealFilterCoef(&design[0], cutoff, designLen) != 0) {
+        cout << "FAILED: test 2 idealFilterCoef" << endl;
+        return -1;
+    }
+    uint32_t checks[] = {1, 65535, 65536, 70000, M};
+    for (int i = 0; i < 5; i++) {
+        uint32_t j = checks[i];
+        double expected = sin(cutoff * j) / (M_PI * j);
+        if (fabs(design[M + j] - expected) > 1e-9 || design[M - j] != design[M + j]) {
+            cout << "FAILED: test 2 tap " << j << endl;
+            return -1;
+        }
+    }
+    if (applyKaiserWindow(&design[0], designLen, 80.0) != 0 ||
+            fabs(design[M] - cutoff / M_PI) > 1e-12 || design[0] != design[designLen - 1] ||
+            fabs(design[0]) > 1e-6) {
+        cout << "FAILED: test 2 Kaiser window" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // a 100000 tap FIRFilter, moved past a wrap of its delay line with
+    // advance, then filtered against the direct convolution.
+    const uint32_t L = 100000;
+    vector<double> taps = makeNoise<double>(L, 3);
+    vector<double> x = makeNoise<double>(150400, 5);
+    FIRFilter<double> fir(&taps[0], L);
+    if (fir.getLength() != L) {
+        cout << "FAILED: test 3 getLength" << endl;
+        return -1;
+    }
+    fir.advance(&x[0], 150000);
+    vector<double> y(200);
+    fir.filterBlock(&x[150000], &y[0], 200);
+    for (size_t n = 0; n < 200; n++) {
+        if (fabs(y[n] - directOutput(taps, x, 150000 + n)) > 1e-9) {
+            cout << "FAILED: test 3 n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // the long filter's state survives a snapshot.
+    SnapshotWriter writer;
+    if (writer.open(SNAPSHOT_PATH) != 0 || writer.add(fir) != 0 || writer.close() != 0) {
+        cout << "FAILED: test 4 write" << endl;
+        return -1;
+    }
+    FIRFilter<double> restored(&taps[0], L);
+    SnapshotReader reader;
+    if (reader.open(SNAPSHOT_PATH) != 0 || reader.getRecord(0) == NULL ||
+            reader.getRecord(0)->length != L || reader.restore(0, restored) != 0) {
+        cout << "FAILED: test 4 restore" << endl;
+        return -1;
+    }
+    reader.close();
+    remove(SNAPSHOT_PATH);
+    for (size_t n = 150200; n < x.size(); n++) {
+        double expected = directOutput(taps, x, n);
+        if (fabs(fir.filter(x[n]) - expected) > 1e-9 || restored.filter(x[n]) != fir.getOutput()) {
+            cout << "FAILED: test 4 n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // the segmented kernel over several segments, in uneven blocks, one at
+    // a time and in place.
+    const uint32_t segLen = 2 * FIR_SEGMENT_TAPS + 907;
+    vector<double> segTaps = makeNoise<double>(segLen, 7);
+    vector<double> u = makeNoise<double>(3 * FIR_KERNEL_CHUNK + 2 * segLen, 9);
+    SegmentedFIRFilter<double> seg(&segTaps[0], segLen);
+    SegmentedFIRFilter<double> inPlace(&segTaps[0], segLen);
+    vector<double> out(u.size()), z(u);
+    size_t blocks[] = {1, 37, FIR_KERNEL_CHUNK, 3 * FIR_KERNEL_CHUNK + 5};
+    size_t done = 0;
+    for (int b = 0; done < u.size(); b = (b + 1) % 4) {
+        size_t count = min(blocks[b], u.size() - done);
+        if (b == 0) {
+            out[done] = seg.filter(u[done]);
+        } else {
+            seg.filterBlock(&u[done], &out[done], count);
+        }
+        inPlace.filterBlock(&z[done], &z[done], count);
+        done += count;
+    }
+    for (size_t n = 0; n < u.size(); n++) {
+        if (fabs(out[n] - directOutput(segTaps, u, n)) > 1e-10 || z[n] != out[n]) {
+            cout << "FAILED: test 5 n = " << n << endl;
+            return -1;
+        }
+    }
+    seg.reset();
+    if (seg.filter(1.0) != segTaps[0] || seg.getLength() != segLen) {
+        cout << "FAILED: test 5 reset" << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+}
@@ -0,0 +1,192 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// MixedTypeFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for filters with different sample, coefficient and
+// accumulator types, checked against filters of a single type.
+
+#include <iostream>
+#include <BFloat16.h>
+#include <FIRFilter.h>
+#include <IIRFilter.h>
+#include <ParallelFIRFilter.h>
+#include <FrequencyResponse.h>
+#include <FilterUtility.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// the defaults keep the single type filters the same.
+static_assert(is_same<FIRFilter<float>, FIRFilter<float, float, float> >::value,
+            "FIRFilter defaults changed");
+static_assert(is_same<IIRFilter<double>, IIRFilter<double, double, double> >::value,
+            "IIRFilter defaults changed");
+
+int main(int argc, char **argv)
+{
+    const size_t n = 4000;
+    vector<double> x = makeNoise<double>(n, 11);
+
+    ////////////////// Test 1 ///////////////////
+    // bf16 rounding, ties to even, and special values.
+    float exact[] = {0.0f, 1.0f, -2.5f, 0.15625f, 65536.0f, INFINITY};
+    for (int i = 0; i < 6; i++) {
+        if ((float)BFloat16(exact[i]) != exact[i]) {
+            cout << "FAILED: test 1 exact value " << exact[i] << endl;
+            return -1;
+        }
+    }
+    // 1 + 2^-8 is half way between 1 and 1 + 2^-7, so rounds to even (1).
+    // 1 + 3 * 2^-8 is half way between 1 + 2^-7 and 1 + 2^-6, so rounds up.
+    if ((float)BFloat16(1.0f + 1.0f / 256) != 1.0f ||
+            (float)BFloat16(1.0f + 3.0f / 256) != 1.0f + 4.0f / 256) {
+        cout << "FAILED: test 1 ties to even" << endl;
+        return -1;
+    }
+    if (!std::isnan((float)BFloat16(NAN)) || BFloat16::fromBits(0x3f80) != 1.0f) {
+        cout << "FAILED: test 1 NaN / fromBits" << endl;
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        float v = (float)(x[i] * 1000.0);
+        if (fabs((float)BFloat16(v) - v) > fabs(v) / 256) {
+            cout << "FAILED: test 1 rounding error i = " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // float samples with bf16 gains match a float filter with the rounded
+    // gains, and the block path matches filter.
+    const uint16_t L = 63;
+    vector<double> design(L);
+    idealFilterCoef(&design[0], M_PI / 4.0, L);
+    applyHammingWindow(&design[0], L);
+    vector<BFloat16> bfGains(L);
+    vector<float> roundedGains(L);
+    for (uint16_t i = 0; i < L; i++) {
+        bfGains[i] = BFloat16((float)design[i]);
+        roundedGains[i] = bfGains[i];
+    }
+    FIRFilter<float, BFloat16, float> bfFir(&bfGains[0], L);
+    FIRFilter<float, BFloat16, float> bfBlock(&bfGains[0], L);
+    FIRFilter<float> floatFir(&roundedGains[0], L);
+    vector<float> xf(n), block(n);
+    for (size_t i = 0; i < n; i++) { xf[i] = (float)x[i]; }
+    bfBlock.filterBlock(&xf[0], &block[0], n);
+    for (size_t i = 0; i < n; i++) {
+        float expected = floatFir.filter(xf[i]);
+        float y = bfFir.filter(xf[i]);
+        if (y != expected || block[i] != expected) {
+            cout << "FAILED: test 2 bf16 gains i = " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // int16 samples with float gains are computed in float and truncated.
+    vector<float> floatGains(L);
+    for (uint16_t i = 0; i < L; i++) { floatGains[i] = (float)design[i]; }
+    FIRFilter<int16_t, float, float> intFir(&floatGains[0], L);
+    FIRFilter<float> reference(&floatGains[0], L);
+    vector<int16_t> xi(n), yi(n);
+    for (size_t i = 0; i < n; i++) { xi[i] = (int16_t)(x[i] * 20000.0); }
+    intFir.filterBlock(&xi[0], &yi[0], n / 2);
+    for (size_t i = n / 2; i < n; i++) { yi[i] = intFir.filter(xi[i]); }
+    for (size_t i = 0; i < n; i++) {
+        int16_t expected = (int16_t)reference.filter((float)xi[i]);
+        if (yi[i] != expected) {
+            cout << "FAILED: test 3 int16 samples i = " << i << endl;
+            return -1;
+        }
+    }
+    // the gains sum to about 1, so the steady state is about the input.
+    intFir.setSteadyState(1000);
+    if (abs(intFir.getOutput() - 1000) > 10) {
+        cout << "FAILED: test 3 steady state " << intFir.getOutput() << endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // float samples with a double recursion match a double filter, and are
+    // closer to it than a float only filter, for a narrow band resonator.
+    double r = 0.9995, theta = 0.002;
+    double ffD[] = {1e-5, 0.0, 0.0};
+    double fbD[] = {-2.0 * r * cos(theta), r * r};
+    float ffF[] = {1e-5f, 0.0f, 0.0f};
+    float fbF[] = {(float)fbD[0], (float)fbD[1]};
+    IIRFilter<double> iirDouble(ffD, fbD, 3, 2);
+    IIRFilter<float, double, double> iirMixed(ffD, fbD, 3, 2);
+    IIRFilter<float> iirFloat(ffF, fbF, 3, 2);
+    double mixedError = 0.0, floatError = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double expected = iirDouble.filter((double)xf[i]);
+        float y = iirMixed.filter(xf[i]);
+        if (y != (float)expected) {
+            cout << "FAILED: test 4 mixed IIR i = " << i << endl;
+            return -1;
+        }
+        mixedError = max(mixedError, fabs(y - expected));
+        floatError = max(floatError, fabs(iirFloat.filter(xf[i]) - expected));
+    }
+    if (mixedError > floatError) {
+        cout << "FAILED: test 4 error " << mixedError << " " << floatError << endl;
+        return -1;
+    }
+    iirMixed.setSteadyState(1.0f);
+    iirDouble.setSteadyState(1.0);
+    if (iirMixed.getOutput() != (float)iirDouble.getOutput()) {
+        cout << "FAILED: test 4 steady state" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // the parallel filter and the frequency response take mixed filters.
+    FIRFilter<float, BFloat16, float> bfParallel(&bfGains[0], L);
+    vector<float> par(n);
+    if (parallelFilter(bfParallel, &xf[0], &par[0], n, 4, 256) != 0) {
+        cout << "FAILED: test 5 parallel filter returned error" << endl;
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (par[i] != block[i]) {
+            cout << "FAILED: test 5 parallel i = " << i << endl;
+            return -1;
+        }
+    }
+    FrequencyResponse freq(256);
+    vector<complex<double> > H(freq.getNumPoints()), expectedH(freq.getNumPoints());
+    freq.response(bfFir, &H[0]);
+    freq.response(&roundedGains[0], L, (const float *)NULL, 0, &expectedH[0]);
+    for (uint32_t k = 0; k < freq.getNumPoints(); k++) {
+        if (abs(H[k] - expectedH[k]) > 1e-12) {
+            cout << "FAILED: test 5 response k = " << k << endl;
+            return -1;
+        }
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
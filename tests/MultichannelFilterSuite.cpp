@@ -0,0 +1,225 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// MultichannelFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the interleaved multichannel filters, checked against
+// one FIRFilter / IIRFilter per channel.
+
+#include <iostream>
+#include <MultichannelFilter.h>
+#include <FIRFilter.h>
+#include <IIRFilter.h>
+#include <FilterUtility.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    const size_t frames = 700;
+    uint16_t channelCounts[] = {1, 2, 3, 4, 8, 11};
+    const uint16_t L = 31;
+
+    for (int k = 0; k < 6; k++) {
+        uint16_t C = channelCounts[k];
+        vector<double> xd = makeNoise<double>(frames * C, 5);
+        vector<float> x(xd.begin(), xd.end());
+
+        // each channel gets its own cutoff.
+        vector<float> taps((size_t)C * L);
+        for (uint16_t c = 0; c < C; c++) {
+            vector<double> design(L);
+            idealFilterCoef(&design[0], M_PI / (2.0 + c), L);
+            applyHammingWindow(&design[0], L);
+            for (uint16_t i = 0; i < L; i++) { taps[(size_t)c * L + i] = (float)design[i]; }
+        }
+
+        ////////////////// Test 1 ///////////////////
+        // shared and per channel taps match an FIRFilter per channel, both
+        // a frame at a time and in blocks.
+        for (int perChannel = 0; perChannel < 2; perChannel++) {
+            MultichannelFIRFilter<float> frameFilter(&taps[0], L, C, perChannel != 0);
+            MultichannelFIRFilter<float> blockFilter(&taps[0], L, C, perChannel != 0);
+            vector<FIRFilter<float>*> singles(C);
+            for (uint16_t c = 0; c < C; c++) {
+                singles[c] = new FIRFilter<float>(&taps[perChannel ? (size_t)c * L : 0], L);
+            }
+
+            vector<float> frameOut(x.size()), blockOut(x.size());
+            for (size_t n = 0; n < frames; n++) {
+                frameFilter.filterFrame(&x[n * C], &frameOut[n * C]);
+            }
+            // odd block sizes, and the last block in place.
+            size_t n = 0;
+            size_t sizes[] = {1, 7, 64, 200};
+            for (int s = 0; n < frames; s = (s + 1) % 4) {
+                size_t len = min(sizes[s], frames - n);
+                blockFilter.filterBlock(&x[n * C], &blockOut[n * C], len);
+                n += len;
+            }
+
+            for (size_t f = 0; f < frames; f++) {
+                for (uint16_t c = 0; c < C; c++) {
+                    float expected = singles[c]->filter(x[f * C + c]);
+                    if (frameOut[f * C + c] != expected || blockOut[f * C + c] != expected) {
+                        cout << "FAILED: test 1 FIR C = " << C << " per channel "
+                            << perChannel << " frame " << f << endl;
+                        return -1;
+                    }
+                }
+            }
+            for (uint16_t c = 0; c < C; c++) {
+                if (blockFilter.getOutput()[c] != singles[c]->getOutput()) {
+                    cout << "FAILED: test 1 getOutput C = " << C << endl;
+                    return -1;
+                }
+                delete singles[c];
+            }
+        }
+
+        ////////////////// Test 2 ///////////////////
+        // in place filtering, and reset.
+        MultichannelFIRFilter<float> inPlace(&taps[0], L, C, true);
+        MultichannelFIRFilter<float> reference(&taps[0], L, C, true);
+        vector<float> y(x), expected(x.size());
+        inPlace.filterBlock(&y[0], &y[0], 100);
+        inPlace.reset();
+        inPlace.filterBlock(&y[0], &y[0], frames);
+        reference.filterBlock(&x[0], &expected[0], frames);
+        // the first 100 frames were filtered twice, and are in the history
+        // for another L - 1 frames.
+        for (size_t i = (100 + L) * C; i < x.size(); i++) {
+            if (y[i] != expected[i]) {
+                cout << "FAILED: test 2 in place C = " << C << " i = " << i << endl;
+                return -1;
+            }
+        }
+
+        ////////////////// Test 3 ///////////////////
+        // IIR with per channel biquads, and mixed types, matches IIRFilter.
+        vector<double> ff((size_t)C * 3), fb((size_t)C * 2);
+        for (uint16_t c = 0; c < C; c++) {
+            double r = 0.95 - 0.02 * c, theta = 0.1 + 0.05 * c;
+            ff[c * 3] = 0.1;
+            ff[c * 3 + 1] = 0.2;
+            ff[c * 3 + 2] = 0.1;
+            fb[c * 2] = -2.0 * r * cos(theta);
+            fb[c * 2 + 1] = r * r;
+        }
+        MultichannelIIRFilter<float, double, double> iir(&ff[0], &fb[0], 3, 2, C, true);
+        vector<IIRFilter<float, double, double>*> iirSingles(C);
+        for (uint16_t c = 0; c < C; c++) {
+            iirSingles[c] = new IIRFilter<float, double, double>(&ff[c * 3], &fb[c * 2], 3, 2);
+        }
+        vector<float> iirOut(x.size());
+        iir.filterBlock(&x[0], &iirOut[0], frames / 2);
+        for (size_t f = frames / 2; f < frames; f++) {
+            iir.filterFrame(&x[f * C], &iirOut[f * C]);
+        }
+        for (size_t f = 0; f < frames; f++) {
+            for (uint16_t c = 0; c < C; c++) {
+                if (iirOut[f * C + c] != iirSingles[c]->filter(x[f * C + c])) {
+                    cout << "FAILED: test 3 IIR C = " << C << " frame " << f << endl;
+                    return -1;
+                }
+            }
+        }
+        for (uint16_t c = 0; c < C; c++) { delete iirSingles[c]; }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // int16 stereo with shared integer taps matches FIRFilter<int16_t>.
+    int16_t gains[] = {1, 2, 3, 2, 1};
+    MultichannelFIRFilter<int16_t> stereo(gains, 5, 2);
+    FIRFilter<int16_t> left(gains, 5), right(gains, 5);
+    for (int16_t i = 0; i < 200; i++) {
+        int16_t in[2] = {(int16_t)(i * 7 % 101 - 50), (int16_t)(i * 13 % 37)};
+        int16_t out[2];
+        stereo.filterFrame(in, out);
+        if (out[0] != left.filter(in[0]) || out[1] != right.filter(in[1])) {
+            cout << "FAILED: test 4 int16 stereo i = " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // bad taps are rejected, and leave a filter that outputs 0.
+    MultichannelFIRFilter<float> bad((const float *)NULL, 4, 2);
+    float in[2] = {1.0f, 2.0f}, out[2] = {5.0f, 5.0f};
+    bad.filterFrame(in, out);
+    if (bad.setGains(NULL, 3) != -1 || out[0] != 0.0f || out[1] != 0.0f) {
+        cout << "FAILED: test 5 bad taps" << endl;
+        return -1;
+    }
+    float b0 = 1.0f;
+    MultichannelIIRFilter<float> badIIR(&b0, NULL, 1, 2, 2);
+    badIIR.filterFrame(in, out);
+    if (out[0] != 0.0f || badIIR.getFeedbackLength() != 0) {
+        cout << "FAILED: test 5 bad IIR taps" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 6 ///////////////////
+    // int16 outputs saturate instead of wrapping, one frame at a time and
+    // in blocks, the same as FIRFilter / IIRFilter.
+    float sum[] = {1.0f, 1.0f};
+    int16_t loud[8] = {30000, -30000, 30000, -30000, 30000, -30000, 30000, -30000};
+    int16_t loudOut[8];
+    MultichannelFIRFilter<int16_t, float, float> loudFrame(sum, 2, 2);
+    loudFrame.filterFrame(loud, loudOut);
+    loudFrame.filterFrame(loud + 2, loudOut + 2);
+    if (loudOut[2] != 32767 || loudOut[3] != -32768) {
+        cout << "FAILED: test 6 FIR frame saturation " << loudOut[2] << endl;
+        return -1;
+    }
+    // the mono and stereo block kernels filter several frames at once.
+    int16_t mono[8] = {30000, 30000, 30000, 30000, 30000, 30000, 30000, 30000};
+    MultichannelFIRFilter<int16_t, float, float> monoBlock(sum, 2, 1);
+    monoBlock.filterBlock(mono, loudOut, 8);
+    for (int i = 1; i < 8; i++) {
+        if (loudOut[i] != 32767) {
+            cout << "FAILED: test 6 mono block saturation i = " << i << endl;
+            return -1;
+        }
+    }
+    MultichannelFIRFilter<int16_t, float, float> stereoBlock(sum, 2, 2);
+    stereoBlock.filterBlock(loud, loudOut, 4);
+    for (int i = 2; i < 8; i++) {
+        if (loudOut[i] != ((i % 2 == 0) ? 32767 : -32768)) {
+            cout << "FAILED: test 6 stereo block saturation i = " << i << endl;
+            return -1;
+        }
+    }
+    float ffLoud[] = {2.0f};
+    float fbLoud[] = {0.0f};
+    MultichannelIIRFilter<int16_t, float, float> loudIIR(ffLoud, fbLoud, 1, 1, 2);
+    int16_t iirIn[2] = {20000, -20000};
+    loudIIR.filterFrame(iirIn, loudOut);
+    if (loudOut[0] != 32767 || loudOut[1] != -32768) {
+        cout << "FAILED: test 6 IIR saturation " << loudOut[0] << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,136 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ParallelFIRTestSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// This is a test suite for the parallel offline FIR filtering, to make sure
+// the output matches serial filtering exactly.
+
+#include <iostream>
+#include <FIRFilter.h>
+#include <ParallelFIRFilter.h>
+#include <FilterUtility.h>
+#include <cmath>
+
+int main(int argc, char **argv)
+{
+    const size_t n = 100003;
+    double *x = new double[n];
+    double *ySerial = new double[n];
+    double *yParallel = new double[n];
+    for (size_t i = 0; i < n; i++) { x[i] = sin(0.01 * i) + ((i * 7919) % 13) * 0.1; }
+
+    double *gains = idealFilterCoef<double>(M_PI / 3.0, 101);
+    applyHammingWindow(gains, 101);
+
+    ////////////////// Test 1 ///////////////////
+    // parallel output is bit-identical to serial output.
+    FIRFilter<double> serial(gains, 101);
+    FIRFilter<double> parallel(gains, 101);
+    for (size_t i = 0; i < n; i++) { ySerial[i] = serial.filter(x[i]); }
+
+    if (parallelFilter(parallel, x, yParallel, n, 7, 1000) != 0) {
+        std::cerr << "FAILED: test 1 parallel filter returned error." << std::endl;
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (ySerial[i] != yParallel[i]) {
+            std::cerr << "FAILED: test 1 parallel output differs at i = " << i << std::endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // state carries over between serial and parallel calls.
+    FIRFilter<double> mixed(gains, 101);
+    FIRFilter<double> reference(gains, 101);
+    for (size_t i = 0; i < 50; i++) { yParallel[i] = mixed.filter(x[i]); }
+    parallelFilter(mixed, x + 50, yParallel + 50, 5000, 4, 64);
+    parallelFilter(mixed, x + 5050, yParallel + 5050, 30, 4, 1);
+    for (size_t i = 5080; i < 6000; i++) { yParallel[i] = mixed.filter(x[i]); }
+
+    for (size_t i = 0; i < 6000; i++) {
+        if (reference.filter(x[i]) != yParallel[i]) {
+            std::cerr << "FAILED: test 2 mixed serial/parallel differs at i = " << i << std::endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // a pool of threads kept over several calls, in place.
+    ParallelPool pool(4);
+    if (pool.getNumThreads() < 1 || pool.getNumThreads() > 4) {
+        std::cerr << "FAILED: test 3 pool threads." << std::endl;
+        return -1;
+    }
+    FIRFilter<double> pooled(gains, 101);
+    for (size_t i = 0; i < n; i++) { yParallel[i] = x[i]; }
+    size_t done = 0;
+    for (int call = 0; done < n; call++) {
+        size_t count = (n - done < 30011) ? n - done : 30011;
+        if (parallelFilter(pool, pooled, yParallel + done, yParallel + done, count, 500) != 0) {
+            std::cerr << "FAILED: test 3 call " << call << " returned error." << std::endl;
+            return -1;
+        }
+        done += count;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (ySerial[i] != yParallel[i]) {
+            std::cerr << "FAILED: test 3 in place differs at i = " << i << std::endl;
+            return -1;
+        }
+    }
+    if (pooled.getOutput() != serial.getOutput()) {
+        std::cerr << "FAILED: test 3 state." << std::endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // in place with chunks shorter than the filter, a last chunk shorter
+    // than the filter, and a single chunk.
+    FIRFilter<double> small(gains, 101);
+    for (size_t i = 0; i < n; i++) { yParallel[i] = x[i]; }
+    size_t sizes[] = {300, 401, 2000, 77};
+    size_t minChunks[] = {16, 101, 4000, 1};
+    done = 0;
+    for (int call = 0; call < 4; call++) {
+        if (parallelFilter(pool, small, yParallel + done, yParallel + done, sizes[call],
+                        minChunks[call]) != 0) {
+            std::cerr << "FAILED: test 4 call " << call << " returned error." << std::endl;
+            return -1;
+        }
+        done += sizes[call];
+    }
+    for (size_t i = 0; i < done; i++) {
+        if (ySerial[i] != yParallel[i]) {
+            std::cerr << "FAILED: test 4 in place differs at i = " << i << std::endl;
+            return -1;
+        }
+    }
+
+    delete[] x;
+    delete[] ySerial;
+    delete[] yParallel;
+    delete[] gains;
+
+    // test passed if reached here.
+    std::cout << "PASSED all tests!" << std::endl;
+    return 0;
+} // end main
@@ -0,0 +1,161 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// PolyphaseChannelizerSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the polyphase FFT channelizer.
+
+#include <iostream>
+#include <PolyphaseChannelizer.h>
+#include <FilterUtility.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace std;
+
+typedef complex<double> cd;
+
+// direct
+// channel k of frame m worked out from the definition.
+cd direct(const vector<double> &h, const vector<cd> &x, uint32_t M, uint32_t D,
+          uint32_t k, size_t m)
+{
+    long t = (long)((m + 1) * D) - 1;
+    cd sum = 0.0;
+    for (long n = 0; n < (long)h.size() && n <= t; n++) {
+        sum += h[n] * x[t - n] * polar(1.0, -2.0 * M_PI * k * ((t - n) % M) / M);
+    }
+    return sum;
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // critically sampled, oversampled and odd decimations match the
+    // definition, with a prototype that isn't a multiple of M long and
+    // blocks that don't line up with frames.
+    uint32_t shapes[][3] = {{8, 8, 61}, {8, 4, 61}, {12, 5, 37}, {16, 16, 200}, {1, 1, 9}};
+    vector<cd> x = makeComplexNoise<double>(600, 11);
+    for (int s = 0; s < 5; s++) {
+        uint32_t M = shapes[s][0], D = shapes[s][1];
+        vector<double> h(shapes[s][2]);
+        for (size_t n = 0; n < h.size(); n++) { h[n] = sin(0.37 * n + 0.2) / (n + 1.0); }
+        PolyphaseChannelizer<double> bank(&h[0], (uint32_t)h.size(), M, D);
+        vector<cd> out(bank.maxOutput(x.size()) * M);
+        size_t frames = 0;
+        size_t sizes[] = {1, 13, 100, 7};
+        for (size_t at = 0, b = 0; at < x.size(); b++) {
+            size_t n = min(sizes[b % 4], x.size() - at);
+            if (bank.maxOutput(n) > (out.size() / M) - frames) {
+                cout << "FAILED: test 1 maxOutput" << endl;
+                return -1;
+            }
+            frames += bank.process(&x[at], n, &out[frames * M]);
+            at += n;
+        }
+        if (frames != x.size() / D) {
+            cout << "FAILED: test 1 frames = " << frames << endl;
+            return -1;
+        }
+        for (size_t m = 0; m < frames; m++) {
+            for (uint32_t k = 0; k < M; k++) {
+                if (abs(out[m * M + k] - direct(h, x, M, D, k, m)) > 1e-12) {
+                    cout << "FAILED: test 1 M = " << M << " D = " << D << " m = " << m
+                         << " k = " << k << endl;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // a tone at the center of a channel comes out of that channel only,
+    // with a Kaiser designed prototype.
+    uint32_t M = 16;
+    uint16_t N = 8 * M - 1;
+    double *h = idealFilterCoef<double>(M_PI / M, N);
+    applyKaiserWindow(h, N, 70.0);
+    for (uint32_t D = M / 2; D <= M; D += M / 2) {
+        PolyphaseChannelizer<double> bank(h, N, M, D);
+        vector<cd> tone(4000);
+        for (size_t n = 0; n < tone.size(); n++) { tone[n] = polar(1.0, 2.0 * M_PI * 5 * n / M); }
+        vector<cd> out(bank.maxOutput(tone.size()) * M);
+        size_t frames = bank.process(&tone[0], tone.size(), &out[0]);
+        for (size_t m = N / D + 1; m < frames; m++) {
+            for (uint32_t k = 0; k < M; k++) {
+                double level = abs(out[m * M + k]);
+                if ((k == 5 && fabs(level - 1.0) > 1e-3) || (k != 5 && level > 1e-3)) {
+                    cout << "FAILED: test 2 D = " << D << " k = " << k << " level = "
+                         << level << endl;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // real inputs are the same as complex inputs with no imaginary part,
+    // and reset starts over.
+    PolyphaseChannelizer<double> realBank(h, N, M, M / 2);
+    PolyphaseChannelizer<double> complexBank(h, N, M, M / 2);
+    vector<double> real(1000);
+    vector<cd> asComplex(real.size());
+    for (size_t n = 0; n < real.size(); n++) {
+        real[n] = x[n % x.size()].real();
+        asComplex[n] = real[n];
+    }
+    vector<cd> a(realBank.maxOutput(real.size()) * M), b(a.size());
+    realBank.process(&real[0], 333, &a[0]);
+    realBank.reset();
+    size_t frames = realBank.process(&real[0], real.size(), &a[0]);
+    complexBank.process(&asComplex[0], asComplex.size(), &b[0]);
+    for (size_t i = 0; i < frames * M; i++) {
+        if (abs(a[i] - b[i]) > 1e-15) {
+            cout << "FAILED: test 3 i = " << i << endl;
+            return -1;
+        }
+    }
+    // a real input gives conjugate symmetric channels.
+    for (size_t m = 0; m < frames; m++) {
+        for (uint32_t k = 1; k < M; k++) {
+            if (abs(a[m * M + k] - conj(a[m * M + M - k])) > 1e-12) {
+                cout << "FAILED: test 3 symmetry m = " << m << " k = " << k << endl;
+                return -1;
+            }
+        }
+    }
+    delete[] h;
+
+    ////////////////// Test 4 ///////////////////
+    // the decimation is clamped to 1 ... M.
+    double one = 1.0;
+    PolyphaseChannelizer<double> clamped(&one, 1, 4, 9);
+    PolyphaseChannelizer<double> zero(&one, 1, 4, 0);
+    if (clamped.getDecimation() != 4 || zero.getDecimation() != 1 ||
+        clamped.getBranchLength() != 1 || clamped.maxOutput(7) != 1) {
+        cout << "FAILED: test 4 clamping" << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+}
@@ -0,0 +1,141 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// RankFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the sliding median and rank filters, checked against
+// sorting each window.
+
+#include <iostream>
+#include <RankFilter.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// rankOfWindow
+// sorts the window ending at sample n, with zeros before the start.
+template <class T>
+T rankOfWindow(const vector<T> &x, size_t n, uint16_t length, uint16_t rank)
+{
+    vector<T> window(length, 0);
+    for (uint16_t i = 0; i < length && i <= n; i++) { window[i] = x[n - i]; }
+    sort(window.begin(), window.end());
+    return window[rank];
+}
+
+// makeNoise
+// a deterministic pseudo random signal in [-range, range).
+template <class T>
+vector<T> makeNoise(size_t n, int range, uint32_t seed)
+{
+    vector<T> x(n);
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        x[i] = (T)((int)((seed >> 8) % (2 * range)) - range);
+    }
+    return x;
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // every rank of a few window lengths, with lots of equal samples.
+    vector<int16_t> ints = makeNoise<int16_t>(600, 20, 1);
+    uint16_t lengths[] = {1, 2, 3, 8, 31};
+    for (int l = 0; l < 5; l++) {
+        uint16_t L = lengths[l];
+        for (uint16_t rank = 0; rank < L; rank++) {
+            RankFilter<int16_t> filter(L, rank);
+            for (size_t n = 0; n < ints.size(); n++) {
+                if (filter.filter(ints[n]) != rankOfWindow(ints, n, L, rank)) {
+                    cout << "FAILED: test 1 L = " << L << " rank = " << rank
+                        << " n = " << n << endl;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // a long median over floats, by sample and by block, with impulses.
+    const uint16_t L = 255;
+    vector<float> x = makeNoise<float>(3000, 1000, 2);
+    for (size_t n = 0; n < x.size(); n += 37) { x[n] = (n & 1) ? 1e6f : -1e6f; }
+    MedianFilter<float> median(L);
+    MedianFilter<float> blockMedian(L);
+    vector<float> y(x.size());
+    blockMedian.filterBlock(&x[0], &y[0], 1000);
+    blockMedian.filterBlock(&x[1000], &y[1000], x.size() - 1000);
+    for (size_t n = 0; n < x.size(); n++) {
+        float expected = rankOfWindow(x, n, L, (L - 1) / 2);
+        if (median.filter(x[n]) != expected || y[n] != expected) {
+            cout << "FAILED: test 2 n = " << n << endl;
+            return -1;
+        }
+    }
+    if (median.getOutput() != y.back() || median.getRank() != 127) {
+        cout << "FAILED: test 2 getOutput" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // percentile ranks, clamping, and steady state.
+    RankFilter<float> clamped(10, 50);
+    if (RankFilter<float>::percentileRank(101, 90.0) != 90 ||
+            RankFilter<float>::percentileRank(101, 0.0) != 0 ||
+            RankFilter<float>::percentileRank(101, 100.0) != 100 ||
+            RankFilter<float>::percentileRank(4, 50.0) != 2 || clamped.getRank() != 9) {
+        cout << "FAILED: test 3 ranks" << endl;
+        return -1;
+    }
+    median.setSteadyState(5.0f);
+    if (median.filter(-100.0f) != 5.0f || median.getOutput() != 5.0f) {
+        cout << "FAILED: test 3 steady state" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // the multichannel filter matches a filter per channel, in place.
+    const uint16_t C = 3;
+    const size_t frames = 800;
+    vector<float> frameData = makeNoise<float>(frames * C, 50, 3);
+    vector<float> expected(frames * C);
+    for (uint16_t c = 0; c < C; c++) {
+        RankFilter<float> single(63, 40);
+        for (size_t n = 0; n < frames; n++) {
+            expected[n * C + c] = single.filter(frameData[n * C + c]);
+        }
+    }
+    MultichannelRankFilter<float> multi(63, 40, C);
+    float frame[C];
+    multi.filterFrame(&frameData[0], frame);
+    multi.filterBlock(&frameData[C], &frameData[C], frames - 1);
+    for (uint16_t c = 0; c < C; c++) { frameData[c] = frame[c]; }
+    if (!equal(frameData.begin(), frameData.end(), expected.begin()) ||
+            multi.getOutput()[C - 1] != expected.back()) {
+        cout << "FAILED: test 4 multichannel" << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,209 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// RingBufferSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the SPSC ring buffer and the streaming stage, single
+// threaded for the counters and wrap around, and across threads for the
+// ordering.
+
+#include <iostream>
+#include <RingBuffer.h>
+#include <StreamStage.h>
+#include <FIRFilter.h>
+#include <FilterUtility.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // capacity is rounded up to a power of 2.
+    SPSCRingBuffer<float> r1(1000), r2(1), r3(64);
+    if (r1.getCapacity() != 1024 || r2.getCapacity() != 1 || r3.getCapacity() != 64) {
+        cout << "FAILED: test 1 capacity" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // push and pop around the end of the buffer, and the counters.
+    SPSCRingBuffer<int> ring(8);
+    int data[20], out[20];
+    for (int i = 0; i < 20; i++) { data[i] = i; }
+    if (ring.push(data, 5) != 5 || ring.pop(out, 3) != 3 || out[2] != 2) {
+        cout << "FAILED: test 2 first push / pop" << endl;
+        return -1;
+    }
+    // 2 left, room for 6, so 4 of 10 are dropped.
+    if (ring.push(data + 5, 10) != 6 || ring.getOverruns() != 4 || ring.readAvailable() != 8 ||
+            ring.writeAvailable() != 0) {
+        cout << "FAILED: test 2 overrun" << endl;
+        return -1;
+    }
+    // 8 there, 12 asked for.
+    if (ring.pop(out, 12) != 8 || ring.getUnderruns() != 4) {
+        cout << "FAILED: test 2 underrun" << endl;
+        return -1;
+    }
+    for (int i = 0; i < 8; i++) {
+        if (out[i] != i + 3) {
+            cout << "FAILED: test 2 order i = " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // the in place regions stop at the end of the buffer.
+    size_t n;
+    int *w = ring.beginWrite(n);
+    // 11 written so far, so offset 3 with 5 to the end.
+    if (n != 5) {
+        cout << "FAILED: test 3 write region " << n << endl;
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) { w[i] = 100 + (int)i; }
+    ring.commitWrite(n);
+    w = ring.beginWrite(n);
+    if (n != 3 || w != ring.beginWrite(n)) {
+        cout << "FAILED: test 3 second write region " << n << endl;
+        return -1;
+    }
+    w[0] = 105;
+    ring.commitWrite(1);
+    const int *r = ring.beginRead(n);
+    if (n != 5 || r[0] != 100 || r[4] != 104) {
+        cout << "FAILED: test 3 read region" << endl;
+        return -1;
+    }
+    ring.commitRead(n);
+    r = ring.beginRead(n);
+    if (n != 1 || r[0] != 105) {
+        cout << "FAILED: test 3 second read region" << endl;
+        return -1;
+    }
+    ring.commitRead(1);
+
+    ////////////////// Test 4 ///////////////////
+    // a producer and consumer thread keep every sample in order.
+    const uint32_t total = 2000000;
+    SPSCRingBuffer<uint32_t> shared(256);
+    thread producer([&shared, total]() {
+        uint32_t next = 0;
+        uint32_t batch[37];
+        while (next < total) {
+            uint32_t len = 1 + next % 37;
+            if (len > total - next) { len = total - next; }
+            for (uint32_t i = 0; i < len; i++) { batch[i] = next + i; }
+            size_t done = 0;
+            while (done < len) {
+                size_t space;
+                uint32_t *dst = shared.beginWrite(space);
+                size_t m = min(space, (size_t)len - done);
+                for (size_t i = 0; i < m; i++) { dst[i] = batch[done + i]; }
+                shared.commitWrite(m);
+                done += m;
+            }
+            next += len;
+        }
+    });
+    uint32_t expected = 0;
+    bool ordered = true;
+    uint32_t got[64];
+    while (expected < total) {
+        size_t m = shared.pop(got, 1 + expected % 64);
+        for (size_t i = 0; i < m; i++) {
+            if (got[i] != expected + i) { ordered = false; }
+        }
+        expected += (uint32_t)m;
+    }
+    producer.join();
+    if (!ordered || shared.getOverruns() != 0) {
+        cout << "FAILED: test 4 threaded order" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // a stream stage on its own thread gives the same output as filtering
+    // the whole signal at once.
+    const size_t len = 200000;
+    vector<float> x(len), direct(len), streamed(len);
+    for (size_t i = 0; i < len; i++) { x[i] = (float)sin(0.01 * i) + (float)((i * 7919) % 13) * 0.05f; }
+    vector<float> gains(33);
+    idealFilterCoef(&gains[0], (float)(M_PI / 4.0), 33);
+    FIRFilter<float> reference(&gains[0], 33);
+    reference.filterBlock(&x[0], &direct[0], len);
+
+    FIRFilter<float> fir(&gains[0], 33);
+    SPSCRingBuffer<float> in(1024), outRing(512);
+    StreamStage<float> stage(fir, in, outRing, 128);
+    atomic<bool> running(true);
+    thread dsp([&stage, &running]() { stage.run(running); });
+    thread capture([&in, &x, len]() {
+        size_t pos = 0;
+        while (pos < len) {
+            size_t m = min((size_t)64, len - pos);
+            size_t space;
+            float *dst = in.beginWrite(space);
+            m = min(m, space);
+            for (size_t i = 0; i < m; i++) { dst[i] = x[pos + i]; }
+            in.commitWrite(m);
+            pos += m;
+            if (m == 0) { this_thread::yield(); }
+        }
+    });
+    size_t received = 0;
+    while (received < len) {
+        received += outRing.pop(&streamed[received], min((size_t)100, len - received));
+    }
+    capture.join();
+    running.store(false);
+    dsp.join();
+    for (size_t i = 0; i < len; i++) {
+        if (streamed[i] != direct[i]) {
+            cout << "FAILED: test 5 stream output i = " << i << endl;
+            return -1;
+        }
+    }
+    if (stage.getSamples() != len || stage.getBlocks() < len / 128) {
+        cout << "FAILED: test 5 stage counters" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 6 ///////////////////
+    // a full output ring stops the stage, and the capture side sees overruns.
+    FIRFilter<float> fir2(&gains[0], 33);
+    SPSCRingBuffer<float> in2(64), out2(32);
+    StreamStage<float> stalled(fir2, in2, out2, 16);
+    if (in2.push(&x[0], 64) != 64 || stalled.process() != 32) {
+        cout << "FAILED: test 6 back pressure" << endl;
+        return -1;
+    }
+    if (in2.push(&x[0], 64) != 32 || in2.getOverruns() != 32 || stalled.process() != 0) {
+        cout << "FAILED: test 6 input overrun" << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
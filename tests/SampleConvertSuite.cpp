@@ -0,0 +1,185 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SampleConvertSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the sample format conversions, and filtering with
+// conversion on the way in and out.
+
+#include <iostream>
+#include <SampleConvert.h>
+#include <FIRFilter.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // every int16 value survives a round trip through float.
+    vector<int16_t> all(65536), back(65536);
+    vector<float> asFloat(65536);
+    for (int i = 0; i < 65536; i++) { all[i] = (int16_t)(i - 32768); }
+    convertToFloat(&all[0], 1, &asFloat[0], 65536);
+    convertFromFloat(&asFloat[0], &back[0], 1, 65536);
+    for (int i = 0; i < 65536; i++) {
+        if (back[i] != all[i] || asFloat[i] != (float)all[i] / 32768.0f) {
+            cout << "FAILED: test 1 int16 round trip " << all[i] << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // saturation and rounding at the limits of each format.
+    float edge[] = {2.0f, -2.0f, 1.0f, -1.0f, 0.0f, NAN, INFINITY, -INFINITY,
+                    0.5f / 32768.0f, -0.5f / 32768.0f, 1.4f / 32768.0f};
+    int16_t expect16[] = {32767, -32768, 32767, -32768, 0, 0, 32767, -32768, 1, -1, 1};
+    int32_t expect24[] = {8388607, -8388608, 8388607, -8388608, 0, 0, 8388607, -8388608,
+                        128, -128, 358};
+    int16_t out16[11];
+    PackedInt24 out24[11];
+    int32_t out32[11];
+    convertFromFloat(edge, out16, 1, 11);
+    convertFromFloat(edge, out24, 1, 11);
+    convertFromFloat(edge, out32, 1, 11);
+    for (int i = 0; i < 11; i++) {
+        if (out16[i] != expect16[i] || SampleFormat<PackedInt24>::load(out24[i]) != expect24[i]) {
+            cout << "FAILED: test 2 saturation " << i << endl;
+            return -1;
+        }
+    }
+    if (out32[0] != 2147483520 || out32[1] != -2147483647 - 1 || out32[5] != 0) {
+        cout << "FAILED: test 2 int32 saturation " << out32[0] << endl;
+        return -1;
+    }
+    double edgeD[] = {2.0, -2.0, 1.0};
+    convertFromFloat(edgeD, out32, 1, 3);
+    if (out32[0] != 2147483647 || out32[1] != -2147483647 - 1 || out32[2] != 2147483647) {
+        cout << "FAILED: test 2 int32 double saturation" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // packed 24 bit samples are little endian, sign extend, and round trip
+    // through double.
+    PackedInt24 packed[4] = {{{0x01, 0x02, 0x03}}, {{0xff, 0xff, 0xff}},
+                            {{0x00, 0x00, 0x80}}, {{0xff, 0xff, 0x7f}}};
+    int32_t expectPacked[] = {0x030201, -1, -8388608, 8388607};
+    double packedD[4];
+    PackedInt24 packedBack[4];
+    convertToFloat(packed, 1, packedD, 4);
+    convertFromFloat(packedD, packedBack, 1, 4);
+    for (int i = 0; i < 4; i++) {
+        if (SampleFormat<PackedInt24>::load(packed[i]) != expectPacked[i] ||
+            packedD[i] != expectPacked[i] / 8388608.0 ||
+            SampleFormat<PackedInt24>::load(packedBack[i]) != expectPacked[i]) {
+            cout << "FAILED: test 3 packed 24 bit " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // dither is within +-1 LSB, has zero mean, is repeatable, and turns
+    // silence into -1, 0 and 1.
+    vector<float> silence(10000, 0.0f);
+    vector<int16_t> dithered(10000), dithered2(10000);
+    TPDFDither dither(5), dither2(5);
+    convertFromFloat(&silence[0], &dithered[0], 1, 10000, 1.0f, &dither);
+    convertFromFloat(&silence[0], &dithered2[0], 1, 10000, 1.0f, &dither2);
+    double sum = 0;
+    int nonZero = 0;
+    for (int i = 0; i < 10000; i++) {
+        if (dithered[i] < -1 || dithered[i] > 1 || dithered[i] != dithered2[i]) {
+            cout << "FAILED: test 4 dither value " << dithered[i] << endl;
+            return -1;
+        }
+        sum += dithered[i];
+        nonZero += (dithered[i] != 0);
+    }
+    // triangular dither rounds to +-1 a quarter of the time.
+    if (fabs(sum / 10000) > 0.05 || nonZero < 2000 || nonZero > 3000) {
+        cout << "FAILED: test 4 dither statistics " << sum << " " << nonZero << endl;
+        return -1;
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // strided conversion reads and writes one channel of interleaved stereo.
+    int16_t stereo[] = {1, -1, 2, -2, 3, -3, 4, -4};
+    float right[4];
+    convertToFloat(stereo + 1, 2, right, 4, 32768.0f);
+    for (int i = 0; i < 4; i++) { right[i] *= 2.0f; }
+    convertFromFloat(right, stereo + 1, 2, 4, 1.0f / 32768.0f);
+    for (int i = 0; i < 4; i++) {
+        if (stereo[2 * i] != i + 1 || stereo[2 * i + 1] != -2 * (i + 1)) {
+            cout << "FAILED: test 5 stride " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 6 ///////////////////
+    // filterConvert on interleaved int16 stereo, in place, matches
+    // converting each sample and calling filter, across several tiles.
+    size_t frames = 1000;
+    vector<int16_t> pcm(2 * frames), expected(2 * frames);
+    uint32_t seed = 9;
+    for (size_t i = 0; i < pcm.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        pcm[i] = (int16_t)(seed >> 16);
+    }
+    float gains[] = {0.25f, 0.5f, 0.25f, 0.125f, -0.1f};
+    for (int c = 0; c < 2; c++) {
+        FIRFilter<float> reference(gains, 5);
+        for (size_t i = 0; i < frames; i++) {
+            float y = reference.filter(pcm[2 * i + c] / 32768.0f);
+            float v = y * 32768.0f;
+            v = (v > 32767.0f) ? 32767.0f : ((v < -32768.0f) ? -32768.0f : v);
+            expected[2 * i + c] = (int16_t)(v + ((v < 0) ? -0.5f : 0.5f));
+        }
+    }
+    FIRFilter<float> left(gains, 5), rightFilter(gains, 5);
+    filterConvert(left, &pcm[0], 2, &pcm[0], 2, 300);
+    filterConvert(left, &pcm[600], 2, &pcm[600], 2, frames - 300);
+    filterConvert(rightFilter, &pcm[1], 2, &pcm[1], 2, frames);
+    for (size_t i = 0; i < pcm.size(); i++) {
+        if (pcm[i] != expected[i]) {
+            cout << "FAILED: test 6 filterConvert i = " << i << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 7 ///////////////////
+    // filterConvert from int32 to 24 bit with gain.
+    int32_t in32[3] = {1 << 30, -(1 << 30), 1 << 20};
+    PackedInt24 out24b[3];
+    double unity[] = {1.0};
+    FIRFilter<double> pass(unity, 1);
+    filterConvert(pass, in32, 1, out24b, 1, 3, 2.0, 1.0);
+    int32_t expect24b[] = {8388607, -8388608, 8192};
+    for (int i = 0; i < 3; i++) {
+        if (SampleFormat<PackedInt24>::load(out24b[i]) != expect24b[i]) {
+            cout << "FAILED: test 7 int32 to 24 bit " << i << endl;
+            return -1;
+        }
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -0,0 +1,189 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// SparseFIRFilterSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the sparse FIR filter.
+
+#include <iostream>
+#include <SparseFIRFilter.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// reference
+// the direct convolution of the taps with the whole input.
+vector<double> reference(const vector<uint32_t> &delays, const vector<double> &gains,
+                         const vector<double> &x)
+{
+    vector<double> y(x.size(), 0.0);
+    for (size_t n = 0; n < x.size(); n++) {
+        for (size_t i = 0; i < delays.size(); i++) {
+            if (n >= delays[i]) { y[n] += gains[i] * x[n - delays[i]]; }
+        }
+    }
+    return y;
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // a short filter one sample at a time, with the taps out of order.
+    uint32_t d1[] = {5, 0, 2, 9};
+    double g1[] = {0.25, 1.0, -0.5, 0.125};
+    SparseFIRFilter<double> small(d1, g1, 4);
+    if (small.getNumTaps() != 4 || small.getMaxDelay() != 9) {
+        cout << "FAILED: test 1 getNumTaps/getMaxDelay" << endl;
+        return -1;
+    }
+    vector<double> x = makeNoise<double>(1000, 7);
+    vector<double> expected = reference(vector<uint32_t>(d1, d1 + 4),
+                                        vector<double>(g1, g1 + 4), x);
+    for (size_t n = 0; n < x.size(); n++) {
+        double out = small.filter(x[n]);
+        if (fabs(out - expected[n]) > 1e-12 || small.getOutput() != out) {
+            cout << "FAILED: test 1 n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // long delays in uneven blocks, through several wraps of the history.
+    vector<uint32_t> delays;
+    vector<double> gains;
+    for (int i = 0; i < 20; i++) {
+        delays.push_back((uint32_t)(i * 5003 + i * i));
+        gains.push_back(1.0 / (i + 1));
+    }
+    delays.push_back(100000);
+    gains.push_back(-0.75);
+    x = makeNoise<double>(300000, 7);
+    expected = reference(delays, gains, x);
+    SparseFIRFilter<double> echo(&delays[0], &gains[0], (uint32_t)delays.size());
+    vector<double> y(x.size());
+    size_t sizes[] = {1, 7, 256, 1000, 3, 4096, 255, 257};
+    size_t at = 0;
+    for (int k = 0; at < x.size(); k++) {
+        size_t n = min(sizes[k % 8], x.size() - at);
+        echo.filterBlock(&x[at], &y[at], n);
+        at += n;
+    }
+    for (size_t n = 0; n < x.size(); n++) {
+        if (fabs(y[n] - expected[n]) > 1e-9) {
+            cout << "FAILED: test 2 n = " << n << endl;
+            return -1;
+        }
+    }
+    if (echo.getOutput() != y.back()) {
+        cout << "FAILED: test 2 getOutput" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // in place blocks, mixed with single samples, and reset.
+    echo.reset();
+    y = x;
+    for (at = 0; at < y.size();) {
+        if ((at / 1000) % 2 == 0) {
+            y[at] = echo.filter(y[at]);
+            at++;
+        } else {
+            size_t n = min((size_t)777, y.size() - at);
+            echo.filterBlock(&y[at], &y[at], n);
+            at += n;
+        }
+    }
+    for (size_t n = 0; n < x.size(); n++) {
+        if (fabs(y[n] - expected[n]) > 1e-9) {
+            cout << "FAILED: test 3 n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // dense taps with a threshold, and float samples.
+    vector<float> dense(70000, 0.0f);
+    dense[0] = 0.5f;
+    dense[12345] = -0.25f;
+    dense[69999] = 0.125f;
+    dense[500] = 1e-6f;
+    SparseFIRFilter<float> fromDense(NULL, NULL, 0);
+    if (fromDense.setDenseTaps(&dense[0], (uint32_t)dense.size(), 1e-4f) != 0 ||
+        fromDense.getNumTaps() != 3 || fromDense.getMaxDelay() != 69999) {
+        cout << "FAILED: test 4 setDenseTaps" << endl;
+        return -1;
+    }
+    vector<float> impulse(80000, 0.0f);
+    impulse[0] = 1.0f;
+    fromDense.filterBlock(&impulse[0], &impulse[0], impulse.size());
+    for (size_t n = 0; n < impulse.size(); n++) {
+        float want = (n < dense.size() && fabs(dense[n]) > 1e-4f) ? dense[n] : 0.0f;
+        if (impulse[n] != want) {
+            cout << "FAILED: test 4 impulse n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // bad taps are refused and leave the filter as it was.
+    if (echo.setTaps(NULL, NULL, 3) == 0 || echo.getNumTaps() != delays.size()) {
+        cout << "FAILED: test 5 NULL taps" << endl;
+        return -1;
+    }
+    uint32_t tooLong = 0xF0000000u;
+    double one = 1.0;
+    if (echo.setTaps(&tooLong, &one, 1) == 0 || echo.getMaxDelay() != 100000) {
+        cout << "FAILED: test 5 delay too long" << endl;
+        return -1;
+    }
+    // an empty filter outputs zeros.
+    SparseFIRFilter<double> empty(NULL, NULL, 0);
+    double block[4] = {1, 2, 3, 4};
+    empty.filterBlock(block, block, 4);
+    if (empty.filter(1.0) != 0.0 || block[0] != 0.0 || block[3] != 0.0) {
+        cout << "FAILED: test 5 empty filter" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 6 ///////////////////
+    // shorter taps keep the history, longer taps clear it.
+    uint32_t longDelay = 5000;
+    uint32_t shortDelay = 3;
+    SparseFIRFilter<double> retap(&longDelay, &one, 1);
+    vector<double> in6 = makeNoise<double>(6000, 9);
+    for (size_t n = 0; n < in6.size(); n++) { retap.filter(in6[n]); }
+    retap.setTaps(&shortDelay, &one, 1);
+    if (retap.filter(0.5) != in6[in6.size() - 3]) {
+        cout << "FAILED: test 6 history kept for shorter taps" << endl;
+        return -1;
+    }
+    uint32_t longer = 20000;
+    retap.setTaps(&longer, &one, 1);
+    retap.setTaps(&shortDelay, &one, 1);
+    if (retap.filter(0.5) != 0.0) {
+        cout << "FAILED: test 6 history cleared for longer taps" << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+}
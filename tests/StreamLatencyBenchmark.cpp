@@ -0,0 +1,254 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// StreamLatencyBenchmark.cpp
+// Written Ian Rankin - October 2026
+//
+// Measures the latency from a capture thread pushing a block, to the
+// filtered block reaching the reader, through a DSP thread running an FIR
+// filter. Compares the SPSC ring buffer and StreamStage against a mutex
+// protected queue, the way the threads were connected before.
+//
+// A capture thread pushes a block every period, the DSP thread filters, and
+// the main thread reads the output and records the latency of each block.
+// Prints the percentiles, then a histogram with power of 2 buckets, as CSV.
+// The three threads spin (with yields), so the numbers only mean anything
+// with at least three cores free. If the DSP thread falls behind by more
+// than the ring size, the capture side drops samples, which are reported.
+//
+// Run with: make latency
+// Options: --quick, --blocks <n>, --block <samples>, --period-us <us>
+
+#include <RingBuffer.h>
+#include <StreamStage.h>
+#include <FIRFilter.h>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+// number of histogram buckets, bucket b counts latencies below 2^b ns.
+#define LATENCY_BUCKETS 32
+
+// A queue of samples behind a mutex.
+struct MutexQueue {
+    std::mutex lock;
+    std::deque<float> samples;
+
+    void push(const float *data, size_t n)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        samples.insert(samples.end(), data, data + n);
+    }
+
+    size_t pop(float *data, size_t n)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        n = std::min(n, samples.size());
+        std::copy(samples.begin(), samples.begin() + n, data);
+        samples.erase(samples.begin(), samples.begin() + n);
+        return n;
+    }
+};
+
+// Settings for one run.
+struct LatencyOptions {
+    size_t blocks;
+    size_t block;
+    double periodUs;
+    uint16_t taps;
+};
+
+// nanosSince
+// nanoseconds from start to now.
+int64_t nanosSince(Clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+// capture
+// pushes a block every period, and records when each was pushed.
+template <class Push>
+void capture(const LatencyOptions &options, Clock::time_point start,
+            std::vector<int64_t> &pushTimes, Push push)
+{
+    std::vector<float> block(options.block);
+    for (size_t b = 0; b < options.blocks; b++) {
+        int64_t due = (int64_t)(b * options.periodUs * 1000.0);
+        // spin, a sleep is too coarse for a capture period.
+        while (nanosSince(start) < due) { std::this_thread::yield(); }
+        for (size_t i = 0; i < options.block; i++) { block[i] = (float)((b + i) % 17) - 8.0f; }
+        pushTimes[b] = nanosSince(start);
+        push(&block[0], options.block);
+    }
+}
+
+// readOutput
+// reads the filtered output, and records the latency of each whole block.
+// Gives up if nothing arrives for a second, so dropped samples can't hang.
+template <class Pop>
+void readOutput(const LatencyOptions &options, Clock::time_point start,
+                const std::vector<int64_t> &pushTimes, std::vector<int64_t> &latencies,
+                Pop pop)
+{
+    std::vector<float> buf(options.block);
+    size_t received = 0;
+    size_t total = options.blocks * options.block;
+    int64_t lastSeen = nanosSince(start);
+    while (received < total) {
+        size_t n = pop(&buf[0], std::min(options.block, total - received));
+        int64_t now = nanosSince(start);
+        if (n == 0) {
+            if (now - lastSeen > 1000000000) { break; }
+            std::this_thread::yield();
+            continue;
+        }
+        lastSeen = now;
+        size_t before = received / options.block;
+        received += n;
+        for (size_t b = before; b < received / options.block; b++) {
+            latencies.push_back(now - pushTimes[b]);
+        }
+    }
+}
+
+// report
+// prints the percentiles and histogram of the latencies.
+void report(const char *name, std::vector<int64_t> latencies, uint64_t dropped, bool header)
+{
+    if (latencies.empty()) {
+        printf("%s,no output\n", name);
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double fractions[] = {0.5, 0.9, 0.99, 0.999};
+    if (header) { printf("queue,blocks,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,dropped\n"); }
+    printf("%s,%zu", name, latencies.size());
+    for (int i = 0; i < 4; i++) {
+        size_t idx = (size_t)(fractions[i] * (latencies.size() - 1));
+        printf(",%lld", (long long)latencies[idx]);
+    }
+    printf(",%lld,%llu\n", (long long)latencies.back(), (unsigned long long)dropped);
+
+    uint64_t counts[LATENCY_BUCKETS] = {0};
+    for (size_t i = 0; i < latencies.size(); i++) {
+        int b = 0;
+        while (b < LATENCY_BUCKETS - 1 && latencies[i] >= ((int64_t)1 << b)) { b++; }
+        counts[b]++;
+    }
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        if (counts[b] > 0) {
+            printf("%s_hist,below_ns,%lld,%llu\n", name, (long long)1 << b,
+                    (unsigned long long)counts[b]);
+        }
+    }
+}
+
+// runRing
+// capture -> ring -> StreamStage -> ring -> reader.
+void runRing(const LatencyOptions &options, const std::vector<float> &gains)
+{
+    FIRFilter<float> fir(const_cast<float *>(&gains[0]), options.taps);
+    SPSCRingBuffer<float> in(16 * options.block), out(16 * options.block);
+    StreamStage<float> stage(fir, in, out, options.block);
+    std::vector<int64_t> pushTimes(options.blocks), latencies;
+    latencies.reserve(options.blocks);
+    std::atomic<bool> running(true);
+    Clock::time_point start = Clock::now();
+
+    std::thread dsp([&stage, &running]() { stage.run(running); });
+    std::thread producer([&]() {
+        capture(options, start, pushTimes, [&in](const float *d, size_t n) { in.push(d, n); });
+    });
+    readOutput(options, start, pushTimes, latencies,
+            [&out](float *d, size_t n) { return out.pop(d, n); });
+    producer.join();
+    running.store(false);
+    dsp.join();
+    report("spsc_ring", latencies, in.getOverruns(), true);
+}
+
+// runMutex
+// capture -> mutex queue -> filter thread -> mutex queue -> reader.
+void runMutex(const LatencyOptions &options, const std::vector<float> &gains)
+{
+    FIRFilter<float> fir(const_cast<float *>(&gains[0]), options.taps);
+    MutexQueue in, out;
+    std::vector<int64_t> pushTimes(options.blocks), latencies;
+    latencies.reserve(options.blocks);
+    std::atomic<bool> running(true);
+    Clock::time_point start = Clock::now();
+
+    std::thread dsp([&]() {
+        std::vector<float> x(options.block), y(options.block);
+        while (true) {
+            size_t n = in.pop(&x[0], options.block);
+            if (n == 0) {
+                if (!running.load()) { break; }
+                std::this_thread::yield();
+                continue;
+            }
+            fir.filterBlock(&x[0], &y[0], n);
+            out.push(&y[0], n);
+        }
+    });
+    std::thread producer([&]() {
+        capture(options, start, pushTimes, [&in](const float *d, size_t n) { in.push(d, n); });
+    });
+    readOutput(options, start, pushTimes, latencies,
+            [&out](float *d, size_t n) { return out.pop(d, n); });
+    producer.join();
+    running.store(false);
+    dsp.join();
+    report("mutex_queue", latencies, 0, false);
+}
+
+int main(int argc, char **argv)
+{
+    LatencyOptions options = {20000, 64, 50.0, 64};
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) { options.blocks = 2000; }
+        else if (strcmp(argv[i], "--blocks") == 0 && i + 1 < argc) {
+            options.blocks = (size_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            options.block = (size_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--period-us") == 0 && i + 1 < argc) {
+            options.periodUs = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--quick] [--blocks n] [--block samples] "
+                    "[--period-us us]\n", argv[0]);
+            return -1;
+        }
+    }
+    if (options.blocks == 0 || options.block == 0) { return -1; }
+
+    std::vector<float> gains(options.taps, 1.0f / options.taps);
+    runRing(options, gains);
+    runMutex(options, gains);
+    return 0;
+} // end main
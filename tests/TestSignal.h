@@ -0,0 +1,64 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// TestSignal.h
+// Written Ian Rankin - October 2026
+//
+// Repeatable test signals shared by the test suites. The noise comes from
+// a linear congruential generator instead of rand(), so each seed gives the
+// same signal on every platform.
+
+#ifndef __TEST_SIGNAL__
+#define __TEST_SIGNAL__
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// makeNoise
+// a deterministic pseudo random signal between -1 and 1, computed in T.
+// @param n - the number of samples.
+// @param seed - the generator seed, each seed gives a different signal.
+template <class T>
+std::vector<T> makeNoise(size_t n, uint32_t seed)
+{
+    std::vector<T> x(n);
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        x[i] = (T)(seed >> 8) / (1 << 23) - 1;
+    }
+    return x;
+}
+
+// makeComplexNoise
+// a deterministic pseudo random complex signal, with the real and
+// imaginary parts between -1 and 1.
+// @param n - the number of samples.
+// @param seed - the generator seed, each seed gives a different signal.
+template <class T>
+std::vector<std::complex<T> > makeComplexNoise(size_t n, uint32_t seed)
+{
+    std::vector<T> parts = makeNoise<T>(2 * n, seed);
+    std::vector<std::complex<T> > x(n);
+    for (size_t i = 0; i < n; i++) { x[i] = std::complex<T>(parts[2 * i], parts[2 * i + 1]); }
+    return x;
+}
+
+#endif
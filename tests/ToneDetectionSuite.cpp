@@ -0,0 +1,220 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// ToneDetectionSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the Goertzel bank and sliding DFT, checked against
+// a direct DFT of the same samples.
+
+#include <iostream>
+#include <GoertzelBank.h>
+#include <SlidingDFT.h>
+#include <TestSignal.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace std;
+
+// directPower
+// |sum x[n] e^(-i w n)|^2 / N^2
+double directPower(const double *x, int N, double w)
+{
+    complex<double> sum(0, 0);
+    for (int n = 0; n < N; n++) { sum += x[n] * polar(1.0, -w * n); }
+    return norm(sum) / ((double)N * N);
+}
+
+int main(int argc, char **argv)
+{
+    ////////////////// Test 1 ///////////////////
+    // Goertzel powers match the direct DFT for every block, at frequencies
+    // that aren't on DFT bins.
+    double freqs[] = {0.1, 0.5, 1.0, 1.37, 2.0, 2.9, 3.1};
+    int numBins = 7;
+    int blockLength = 97;
+    vector<double> x = makeNoise<double>(blockLength * 5, 7);
+
+    GoertzelBank<double> bank(freqs, numBins, blockLength);
+    for (int block = 0; block < 5; block++) {
+        for (int n = 0; n < blockLength; n++) { bank.filter(x[block * blockLength + n]); }
+        if (bank.getBlockCount() != (uint32_t)block + 1) {
+            cout << "FAILED: test 1 block count" << endl;
+            return -1;
+        }
+        double largest = 0;
+        for (int k = 0; k < numBins; k++) {
+            double expected = directPower(&x[block * blockLength], blockLength, freqs[k]);
+            if (fabs(bank.getPower(k) - expected) > 1e-12) {
+                cout << "FAILED: test 1 Goertzel power bin " << k << endl;
+                return -1;
+            }
+            largest = max(largest, expected);
+        }
+        if (fabs(bank.getOutput() - largest) > 1e-12) {
+            cout << "FAILED: test 1 Goertzel output" << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 2 ///////////////////
+    // filterBlock matches filter, across uneven block sizes.
+    GoertzelBank<double> single(freqs, numBins, blockLength);
+    GoertzelBank<double> blocked(freqs, numBins, blockLength);
+    vector<double> expectedOut(x.size()), blockOut(x.size());
+    for (size_t n = 0; n < x.size(); n++) { expectedOut[n] = single.filter(x[n]); }
+    size_t chunks[] = {1, 50, 200, 3, 131};
+    for (size_t i = 0, c = 0; i < x.size(); c++) {
+        size_t len = min(chunks[c % 5], x.size() - i);
+        blocked.filterBlock(&x[i], &blockOut[i], len);
+        i += len;
+    }
+    for (size_t n = 0; n < x.size(); n++) {
+        if (blockOut[n] != expectedOut[n]) {
+            cout << "FAILED: test 2 Goertzel block output n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // DTMF detection on int16 samples: the digit 5 (770 Hz + 1336 Hz) at
+    // 8 kHz is found in the two strongest bins, with power A^2 / 4 each.
+    double dtmf[] = {697, 770, 852, 941, 1209, 1336, 1477, 1633};
+    double dtmfW[8];
+    for (int k = 0; k < 8; k++) { dtmfW[k] = 2.0 * M_PI * dtmf[k] / 8000.0; }
+    GoertzelBank<int16_t> detector(dtmfW, 8, 205);
+    vector<int16_t> tone(205);
+    for (int n = 0; n < 205; n++) {
+        tone[n] = (int16_t)(4000.0 * sin(2.0 * M_PI * 770.0 * n / 8000.0) +
+                            4000.0 * sin(2.0 * M_PI * 1336.0 * n / 8000.0));
+    }
+    vector<int16_t> toneOut(205);
+    detector.filterBlock(&tone[0], &toneOut[0], 205);
+    for (int k = 0; k < 8; k++) {
+        bool expectTone = (k == 1 || k == 5);
+        double p = detector.getPower(k);
+        if ((expectTone && fabs(p - 4e6) > 0.1 * 4e6) || (!expectTone && p > 0.05 * 4e6)) {
+            cout << "FAILED: test 3 DTMF bin " << k << " power " << p << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // with no damping, the sliding DFT bins match the direct DFT of the
+    // last N samples at every hop.
+    uint32_t N = 64;
+    uint32_t bins[] = {0, 1, 5, 17, 32, 63};
+    SlidingDFT<double> sdft(bins, 6, N, 16, 1.0);
+    vector<double> noise = makeNoise<double>(1000, 7);
+    for (int n = 0; n < 1000; n++) {
+        sdft.filter(noise[n]);
+        if (n >= (int)N && (n + 1) % 16 == 0) {
+            for (int k = 0; k < 6; k++) {
+                double w = 2.0 * M_PI * bins[k] / N;
+                double expected = directPower(&noise[n + 1 - N], N, w);
+                if (fabs(sdft.getPower(k) - expected) > 1e-12) {
+                    cout << "FAILED: test 4 sliding DFT n = " << n << " bin " << k << endl;
+                    return -1;
+                }
+            }
+        }
+    }
+    if (sdft.getHopCount() != 1000 / 16) {
+        cout << "FAILED: test 4 hop count" << endl;
+        return -1;
+    }
+
+    ////////////////// Test 5 ///////////////////
+    // the damped sliding DFT stays close to the direct DFT after a long run,
+    // and decays to nothing once the input stops.
+    SlidingDFT<float, float> damped(bins, 6, N, 1, 0.9999);
+    vector<double> longNoise = makeNoise<double>(200000, 7);
+    for (size_t n = 0; n < longNoise.size(); n++) { damped.filter((float)longNoise[n]); }
+    for (int k = 0; k < 6; k++) {
+        double w = 2.0 * M_PI * bins[k] / N;
+        double expected = directPower(&longNoise[longNoise.size() - N], N, w);
+        if (fabs(damped.getPower(k) - expected) > 0.01 * expected + 1e-4) {
+            cout << "FAILED: test 5 damped sliding DFT bin " << k << endl;
+            return -1;
+        }
+    }
+    for (uint32_t n = 0; n < N; n++) { damped.filter(0.0f); }
+    if (damped.getOutput() > 1e-6) {
+        cout << "FAILED: test 5 sliding DFT didn't decay " << damped.getOutput() << endl;
+        return -1;
+    }
+
+    ////////////////// Test 6 ///////////////////
+    // sliding DFT filterBlock matches filter.
+    SlidingDFT<double> sdftSingle(bins, 6, N, 10);
+    SlidingDFT<double> sdftBlock(bins, 6, N, 10);
+    vector<double> sdftExpected(1000), sdftOut(1000);
+    for (int n = 0; n < 1000; n++) { sdftExpected[n] = sdftSingle.filter(noise[n]); }
+    sdftBlock.filterBlock(&noise[0], &sdftOut[0], 333);
+    sdftBlock.filterBlock(&noise[333], &sdftOut[333], 667);
+    for (int n = 0; n < 1000; n++) {
+        if (sdftOut[n] != sdftExpected[n]) {
+            cout << "FAILED: test 6 sliding DFT block output n = " << n << endl;
+            return -1;
+        }
+    }
+
+    ////////////////// Test 7 ///////////////////
+    // a full scale int16 tone has a power far above 32767, the int16 output
+    // saturates instead of wrapping, and getPower keeps the full value.
+    const double fullScale = 32767.0;
+    double fullW = 2.0 * M_PI * 20.0 / 205.0;
+    GoertzelBank<int16_t> fullBank(&fullW, 1, 205);
+    uint32_t fullBin = 8;
+    SlidingDFT<int16_t> fullDFT(&fullBin, 1, 64, 64, 1.0);
+    vector<int16_t> full(205), fullOut(205);
+    for (int n = 0; n < 205; n++) { full[n] = (int16_t)(fullScale * sin(fullW * n)); }
+    fullBank.filterBlock(&full[0], &fullOut[0], 205);
+    double expectedPower = fullScale * fullScale / 4.0;
+    if (fullBank.getOutput() != 32767 ||
+            fabs(fullBank.getPower(0) - expectedPower) > 0.01 * expectedPower) {
+        cout << "FAILED: test 7 Goertzel full scale " << fullBank.getOutput() << endl;
+        return -1;
+    }
+    for (int n = 0; n < 128; n++) {
+        fullDFT.filter((int16_t)(fullScale * sin(2.0 * M_PI * fullBin * n / 64.0)));
+    }
+    if (fullDFT.getOutput() != 32767 ||
+            fabs(fullDFT.getPower(0) - expectedPower) > 0.01 * expectedPower) {
+        cout << "FAILED: test 7 sliding DFT full scale " << fullDFT.getOutput() << endl;
+        return -1;
+    }
+
+    ////////////////// Test 8 ///////////////////
+    // with no bins the blocks still count, and the output stays 0.
+    GoertzelBank<double> noBins(NULL, 0, 16);
+    SlidingDFT<double> noDFTBins(NULL, 0, 16, 16);
+    vector<double> emptyOut(64);
+    noBins.filterBlock(&x[0], &emptyOut[0], 64);
+    noDFTBins.filterBlock(&x[0], &emptyOut[0], 64);
+    if (noBins.getBlockCount() != 4 || noBins.getOutput() != 0.0 ||
+            noDFTBins.getHopCount() != 4 || noDFTBins.getOutput() != 0.0) {
+        cout << "FAILED: test 8 no bins" << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
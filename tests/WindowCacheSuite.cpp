@@ -0,0 +1,133 @@
+/* Copyright 2026 Ian Rankin
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// WindowCacheSuite.cpp
+// Written Ian Rankin - October 2026
+//
+// A test suite for the window generators and window cache, checked
+// against applyHammingWindow and applyKaiserWindow.
+
+#include <iostream>
+#include <FilterUtility.h>
+#include <WindowCache.h>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// maxRelError
+// returns the largest relative error between a and b.
+double maxRelError(const double *a, const double *b, int N)
+{
+    double err = 0;
+    for (int i = 0; i < N; i++) {
+        double e = fabs(a[i] - b[i]) / (fabs(b[i]) > 1e-300 ? fabs(b[i]) : 1.0);
+        if (e > err) { err = e; }
+    }
+    return err;
+}
+
+int main(int argc, char **argv)
+{
+    int lengths[] = {1, 2, 7, 15, 64, 117, 1001, 4097};
+
+    for (int l = 0; l < 8; l++) {
+        int N = lengths[l];
+        vector<double> reference(N, 1.0);
+        vector<double> window(N);
+
+        ////////////////// Test 1 ///////////////////
+        // hamming generator matches applyHammingWindow.
+        if (N > 1) {
+            applyHammingWindow(&reference[0], N);
+            hammingWindow(&window[0], N);
+            if (maxRelError(&window[0], &reference[0], N) > 1e-12) {
+                cout << "FAILED: test 1 hamming window N = " << N << endl;
+                return -1;
+            }
+        }
+
+        ////////////////// Test 2 ///////////////////
+        // kaiser generator matches applyKaiserWindow, and the fast
+        // version is close.
+        if (N > 1) {
+            double attenuation[] = {30.0, 60.0, 100.0};
+            for (int a = 0; a < 3; a++) {
+                reference.assign(N, 1.0);
+                applyKaiserWindow(&reference[0], N, attenuation[a]);
+                kaiserWindow(&window[0], N, attenuation[a]);
+                if (maxRelError(&window[0], &reference[0], N) > 1e-9) {
+                    cout << "FAILED: test 2 kaiser window N = " << N
+                         << " A = " << attenuation[a] << endl;
+                    return -1;
+                }
+                // an odd length window is mirrored exactly.
+                for (int n = 0; N % 2 == 1 && n < N; n++) {
+                    if (window[n] != window[N - 1 - n]) {
+                        cout << "FAILED: test 2 kaiser symmetry N = " << N << endl;
+                        return -1;
+                    }
+                }
+                kaiserWindow(&window[0], N, attenuation[a], true);
+                if (maxRelError(&window[0], &reference[0], N) > 1e-6) {
+                    cout << "FAILED: test 2 fast kaiser window N = " << N
+                         << " A = " << attenuation[a] << endl;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    ////////////////// Test 3 ///////////////////
+    // the cache stores each table once.
+    WindowCache cache;
+    const double *k1 = cache.getWindow(WINDOW_KAISER, 117, 60.0);
+    const double *k2 = cache.getWindow(WINDOW_KAISER, 117, 60.0);
+    const double *k3 = cache.getWindow(WINDOW_KAISER, 117, 80.0);
+    const double *h1 = cache.getWindow(WINDOW_HAMMING, 117, 60.0);
+    const double *h2 = cache.getWindow(WINDOW_HAMMING, 117);
+    if (k1 == NULL || k1 != k2 || k1 == k3 || h1 != h2 || cache.size() != 3) {
+        cout << "FAILED: test 3 cache lookups." << endl;
+        return -1;
+    }
+
+    ////////////////// Test 4 ///////////////////
+    // applying a cached window matches applying the window directly.
+    float *gains = idealFilterCoef<float>(M_PI / 4.0, 117);
+    float *cached = idealFilterCoef<float>(M_PI / 4.0, 117);
+    applyKaiserWindow(gains, 117, 60.0);
+    cache.applyWindow(cached, WINDOW_KAISER, 117, 60.0);
+    for (int i = 0; i < 117; i++) {
+        if (fabs(gains[i] - cached[i]) > 1e-7) {
+            cout << "FAILED: test 4 cached kaiser window at " << i << endl;
+            return -1;
+        }
+    }
+    delete[] gains;
+    delete[] cached;
+
+    cache.clear();
+    if (cache.size() != 0) {
+        cout << "FAILED: test 4 clear." << endl;
+        return -1;
+    }
+
+    cout << "PASSED all tests!" << endl;
+    return 0;
+} // end main
@@ -1,3 +1,27 @@
 ./FIRTestSuite
 ./IIRTestSuite
 ./FIRIdealFilterSuite
+./ParallelFIRTestSuite
+./FiltFiltSuite
+./InstrumentationSuite
+./WindowCacheSuite
+./FilterDesignSuite
+./FFTTestSuite
+./FrequencyResponseSuite
+./ToneDetectionSuite
+./AdaptiveFilterSuite
+./HalfBandFilterSuite
+./SampleConvertSuite
+./MixedTypeFilterSuite
+./MultichannelFilterSuite
+./RingBufferSuite
+./FilterSnapshotSuite
+./CoefficientBankSuite
+./RankFilterSuite
+./FarrowFilterSuite
+./FIRTunerSuite
+./SparseFIRFilterSuite
+./ConstexprDesignSuite
+./PolyphaseChannelizerSuite
+./ComplexFilterSuite
+./LongFIRSuite